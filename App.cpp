@@ -1,14 +1,25 @@
 #include "App.h"
+#include "Broadcast.h"
 #include "Debugger.h"
+#include "DrawList.h"
+#include "Font.h"
+#include "FrameRecorder.h"
 #include "Game.h"
-#include "Render.h"
+#include "InputRecording.h"
+#include "Leaderboard.h"
+#include "NullRenderer.h"
+#include "Profiler.h"
+#include "Rollback.h"
+#include "SdlRenderer.h"
+#include "Spectator.h"
 #include <SDL.h>
-#include <SDL_ttf.h>
 #ifdef __VCCOREVER__ //raspberry Pi
 #include <GLES2/gl2.h>
 #endif // __VCCOREVER__
 #include <stdio.h>
+#include <time.h>
 #include <chrono>
+#include <thread>
 
 //=====================================================================================
 
@@ -22,6 +33,12 @@ static bool operator==(SDL_version& a, SDL_version& b)
 	return (a.major == b.major) && (a.minor == b.minor) && (a.patch == b.patch);
 }
 
+// set with SDL_LogSetAllPriority, e.g. from --verbose
+static bool IsVerboseLogging()
+{
+	return SDL_LogGetPriority(SDL_LOG_CATEGORY_APPLICATION) <= SDL_LOG_PRIORITY_VERBOSE;
+}
+
 #ifdef GL_ES_VERSION_2_0
 
 static void SetGLAttribute(SDL_GLattr attr, int value)
@@ -52,21 +69,57 @@ static void PrintGLString(GLenum name)
 
 App::App()
 	: m_Window(0)
+	, m_GlyphAtlas(0)
 	, m_Renderer(0)
+	, m_DrawList(0)
+	, m_DrawListPlayer(0)
 	, m_Game(0)
+	, m_FrameRecorder(0)
+	, m_Spectator(0)
+	, m_Versus(0)
+	, m_Broadcast(0)
+	, m_Leaderboard(0)
+	, m_InputRecording(0)
+	, m_InputRecordingPath(0)
+	, m_ScoreSubmitted(false)
+	, m_RendererBackend(kRendererBackend_Sdl)
+	, m_StartupBeginNs(0)
+	, m_StartupPhaseNs(0)
+	, m_FirstFramePresented(false)
 {
 
 }
 
-bool App::Init(bool FullScreen, unsigned int Width, unsigned int Height)
+void App::EndStartupPhase(const char* name)
+{
+	const uint64_t nowNs = Profiler::GetTimeNs();
+	printf("Startup: %-20s %8.2f ms (%.2f ms total)\n", name, (nowNs - m_StartupPhaseNs) * 1e-6, (nowNs - m_StartupBeginNs) * 1e-6);
+	m_StartupPhaseNs = nowNs;
+}
+
+bool App::Init(bool FullScreen, unsigned int Width, unsigned int Height, RendererBackend rendererBackend)
 {
-	if (SDL_Init(SDL_INIT_EVERYTHING) != 0)
+	HP_PROFILE_SCOPE("App::Init");
+
+	m_StartupBeginNs = Profiler::GetTimeNs();
+	m_StartupPhaseNs = m_StartupBeginNs;
+	m_RendererBackend = rendererBackend;
+
+	// Only what the game uses: video, which brings the event queue, and the
+	// timer. Audio, haptics and joysticks are never started, input is keyboard
+	// only. Headless runs skip video but keep events so Ctrl-C quits.
+	const Uint32 sdlSubsystems = (rendererBackend == kRendererBackend_Null) ? (SDL_INIT_TIMER | SDL_INIT_EVENTS) : (SDL_INIT_TIMER | SDL_INIT_VIDEO);
 	{
-		fprintf(stderr, "SDL failed to initalize: %s\n", SDL_GetError());
-		return false;
+		HP_PROFILE_SCOPE("SDL_Init");
+		if (SDL_Init(sdlSubsystems) != 0)
+		{
+			fprintf(stderr, "SDL failed to initalize: %s\n", SDL_GetError());
+			return false;
+		}
 	}
 
 	printf("SDL initalized\n");
+	EndStartupPhase("SDL_Init");
 
 	SDL_version compiledVersion;
 	SDL_version linkedVersion;
@@ -76,8 +129,76 @@ bool App::Init(bool FullScreen, unsigned int Width, unsigned int Height)
 	print_SDL_version("Linking against SDL version", linkedVersion);
 	SDL_assert_release((compiledVersion == linkedVersion));
 
-	int numDisplays = SDL_GetNumVideoDisplays();
-	printf("%d video displays\n", numDisplays);
+	// glyphs are compiled in and shared by whichever backend is used, they are
+	// unpacked on a worker thread while the window is created
+	m_GlyphAtlas = new GlyphAtlas();
+	GlyphAtlas* glyphAtlas = m_GlyphAtlas;
+	std::thread assetThread([glyphAtlas]()
+	{
+		Profiler::SetThreadName("Startup");
+		LoadGlyphAtlasBaked(*glyphAtlas);
+	});
+
+	// the null backend needs no window
+	bool videoInitialised = true;
+	if (rendererBackend != kRendererBackend_Null)
+	{
+		videoInitialised = InitVideo(FullScreen, Width, Height);
+	}
+
+	{
+		HP_PROFILE_SCOPE("Wait for assets");
+		assetThread.join();
+	}
+	EndStartupPhase("Wait for assets");
+
+	if (!videoInitialised)
+		return false;
+
+	unsigned int logicalWidth = 1280;
+	unsigned int logicalHeight = 720;
+	switch (rendererBackend)
+	{
+	case kRendererBackend_Sdl:
+		m_Renderer = new SdlRenderer(*m_Window, logicalWidth, logicalHeight, *m_GlyphAtlas);
+		break;
+	case kRendererBackend_Software:
+		m_Renderer = new SdlSoftwareRenderer(*m_Window, logicalWidth, logicalHeight, *m_GlyphAtlas);
+		break;
+	case kRendererBackend_Null:
+		m_Renderer = new NullRenderer(logicalWidth, logicalHeight);
+		break;
+	default:
+		HP_FATAL_ERROR("Unhandled case");
+		return false;
+	}
+	EndStartupPhase("Create renderer");
+
+	// the game records into a draw list which is then submitted to the backend
+	m_DrawList = new DrawList(logicalWidth, logicalHeight, m_Renderer->SupportsRenderTargets());
+	m_DrawListPlayer = new DrawListPlayer(*m_Renderer);
+
+	m_Game = new Game();
+
+	if (!m_Game->Init())
+	{
+		fprintf(stderr, "ERROR - Game failed to initialise\n");
+		return false;
+	}
+	EndStartupPhase("Game::Init");
+
+	return true;
+}
+
+bool App::InitVideo(bool FullScreen, unsigned int Width, unsigned int Height)
+{
+	HP_PROFILE_SCOPE("App::InitVideo");
+
+	const int numDisplays = IsVerboseLogging() ? SDL_GetNumVideoDisplays() : 0;
+	if (numDisplays > 0)
+	{
+		printf("%d video displays\n", numDisplays);
+	}
 	for (int i = 0; i < numDisplays; ++i)
 	{
 		SDL_DisplayMode displayMode;
@@ -113,6 +234,7 @@ bool App::Init(bool FullScreen, unsigned int Width, unsigned int Height)
 		printf("Failed to create SDL window: %s\n", SDL_GetError());
 		return false;
 	}
+	EndStartupPhase("Create window");
 
 	SDL_Surface* surface;
 
@@ -159,48 +281,224 @@ bool App::Init(bool FullScreen, unsigned int Width, unsigned int Height)
 	SDL_FreeSurface(surface);
 
 #ifdef GL_ES_VERSION_2_0
-	SDL_GLContext gl_context = SDL_GL_CreateContext(m_Window);
-	printf("GL_VERSION: ");
-	PrintGLString(GL_VERSION);
-	printf("GL_RENDERER: ");
-	PrintGLString(GL_RENDERER);
-	printf("GL_SHADING_LANGUAGE_VERSION: ");
-	PrintGLString(GL_SHADING_LANGUAGE_VERSION);
-	printf("GL_EXTENSIONS: ");
-	PrintGLString(GL_EXTENSIONS);
-	SDL_GL_DeleteContext(gl_context);
+	// a whole context just to print strings, so only when asked for
+	if (IsVerboseLogging())
+	{
+		SDL_GLContext gl_context = SDL_GL_CreateContext(m_Window);
+		printf("GL_VERSION: ");
+		PrintGLString(GL_VERSION);
+		printf("GL_RENDERER: ");
+		PrintGLString(GL_RENDERER);
+		printf("GL_SHADING_LANGUAGE_VERSION: ");
+		PrintGLString(GL_SHADING_LANGUAGE_VERSION);
+		printf("GL_EXTENSIONS: ");
+		PrintGLString(GL_EXTENSIONS);
+		SDL_GL_DeleteContext(gl_context);
+	}
 #endif // GL_ES_VERSION_2_0
 
-	if (TTF_Init() == -1)
+	return true;
+}
+
+bool App::StartRecording(const char* path)
+{
+	HP_ASSERT(m_Renderer && !m_FrameRecorder);
+
+	// the game updates with a variable time step, frames are tagged at the vsync rate
+	const unsigned int framesPerSecond = 60;
+	m_FrameRecorder = new FrameRecorder();
+	if (!m_FrameRecorder->Open(path, m_Renderer->GetWidth(), m_Renderer->GetHeight(), framesPerSecond))
 	{
-		fprintf(stderr, "Failed to initalize ttf: %s\n", TTF_GetError());
+		delete m_FrameRecorder;
+		m_FrameRecorder = 0;
 		return false;
 	}
+	return true;
+}
 
-	printf("SDL_ttf initalized\n");
+bool App::StartSpectating(unsigned int numBoards)
+{
+	HP_ASSERT(m_Renderer && !m_Spectator);
 
-	SDL_TTF_VERSION(&compiledVersion);
-	const SDL_version* pLinkedVersion = TTF_Linked_Version();
-	print_SDL_version("Compiled against SDL_ttf version", compiledVersion);
-	print_SDL_version("Linking against SDL_ttf version", *pLinkedVersion);
+	m_Spectator = new SpectatorGrid();
+	if (!m_Spectator->Init(numBoards, m_Renderer->GetWidth(), m_Renderer->GetHeight()))
+	{
+		m_Spectator->Shutdown();
+		delete m_Spectator;
+		m_Spectator = 0;
+		return false;
+	}
+	return true;
+}
 
-	unsigned int logicalWidth = 1280;
-	unsigned int logicalHeight = 720;
-	m_Renderer = new Renderer(*m_Window, logicalWidth, logicalHeight);
+bool App::StartVersus(unsigned int localPlayer, uint16_t localPort, const char* peerAddress)
+{
+	HP_ASSERT(m_Renderer && !m_Versus);
 
-	m_Game = new Game();
+	NetAddress peer;
+	if (!ParseNetAddress(peerAddress, peer))
+		return false;
 
-	if (!m_Game->Init())
+	m_Versus = new RollbackSession();
+	if (!m_Versus->Open(localPlayer, localPort, peer))
 	{
-		fprintf(stderr, "ERROR - Game failed to initialise\n");
+		delete m_Versus;
+		m_Versus = 0;
+		return false;
+	}
+	return true;
+}
+
+bool App::StartBroadcast(uint16_t port)
+{
+	HP_ASSERT(m_Game && !m_Broadcast);
+
+	m_Broadcast = new BroadcastServer();
+	if (m_Versus)
+	{
+		for (unsigned int i = 0; i < VersusMatch::kNumPlayers; ++i)
+		{
+			m_Broadcast->AddGame(&m_Versus->GetMatch().GetGame(i));
+		}
+	}
+	else if (m_Spectator)
+	{
+		for (unsigned int i = 0; i < m_Spectator->GetNumBoards(); ++i)
+		{
+			m_Broadcast->AddGame(&m_Spectator->GetGame(i));
+		}
+	}
+	else
+	{
+		m_Broadcast->AddGame(m_Game);
+	}
+
+	if (!m_Broadcast->Open(port))
+	{
+		delete m_Broadcast;
+		m_Broadcast = 0;
+		return false;
+	}
+	return true;
+}
+
+bool App::StartLeaderboard(const char* path)
+{
+	HP_ASSERT(m_Game && !m_Leaderboard);
+
+	m_Leaderboard = new Leaderboard();
+	if (!m_Leaderboard->Open(path))
+	{
+		delete m_Leaderboard;
+		m_Leaderboard = 0;
 		return false;
 	}
+	return true;
+}
 
+bool App::StartInputRecording(const char* path)
+{
+	HP_ASSERT(m_Game && !m_InputRecording);
+
+	// a fresh seed recorded with the inputs, the game plays from it
+	const uint32_t seed = (uint32_t)time(NULL) ^ (uint32_t)SDL_GetPerformanceCounter();
+	m_InputRecording = new InputRecording();
+	m_InputRecording->Begin(*m_Game, seed);
+	m_InputRecordingPath = path;
 	return true;
 }
 
+void App::UpdateLeaderboard()
+{
+	HP_PROFILE_SCOPE("App::UpdateLeaderboard");
+
+	// the best score from every run, once the log has been read
+	const unsigned int highScore = m_Leaderboard->GetHighScore();
+	if (highScore > m_Game->GetHiScore())
+	{
+		m_Game->SetHiScore(highScore);
+	}
+
+	// each finished game once, a full queue is tried again next frame
+	if (!m_Game->IsGameOver())
+	{
+		m_ScoreSubmitted = false;
+	}
+	else if (!m_ScoreSubmitted)
+	{
+		m_ScoreSubmitted = m_Leaderboard->Submit(m_Game->GetScore(), m_Game->GetNumLinesCleared());
+	}
+
+	ScoreSubmitResult result;
+	while (m_Leaderboard->PopResult(result))
+	{
+		printf("Score %u ranks %llu of %llu\n", result.score, (unsigned long long)result.rank, (unsigned long long)result.numEntries);
+	}
+}
+
+void App::CaptureFrame()
+{
+	HP_PROFILE_SCOPE("App::CaptureFrame");
+
+	uint32_t* pixels = m_FrameRecorder->AcquireFrame();
+	if (!pixels)
+		return;
+
+	if (m_Renderer->ReadPixels(pixels))
+		m_FrameRecorder->SubmitFrame(pixels);
+	else
+		m_FrameRecorder->DropFrame();
+}
+
 void App::ShutDown()
 {
+	if (m_FrameRecorder)
+	{
+		m_FrameRecorder->Close();
+		delete m_FrameRecorder;
+		m_FrameRecorder = 0;
+	}
+
+	// before the games it reads from go
+	if (m_Broadcast)
+	{
+		m_Broadcast->PrintStats();
+		m_Broadcast->Close();
+		delete m_Broadcast;
+		m_Broadcast = 0;
+	}
+
+	// waits for the last score to reach the disk
+	if (m_Leaderboard)
+	{
+		m_Leaderboard->Close();
+		delete m_Leaderboard;
+		m_Leaderboard = 0;
+	}
+
+	if (m_InputRecording)
+	{
+		if (m_InputRecording->Save(m_InputRecordingPath))
+			printf("Saved %u frames of input to %s\n", m_InputRecording->GetNumFrames(), m_InputRecordingPath);
+		delete m_InputRecording;
+		m_InputRecording = 0;
+	}
+
+	if (m_Versus)
+	{
+		m_Versus->PrintStats();
+		m_Versus->Close();
+		delete m_Versus;
+		m_Versus = 0;
+	}
+
+	if (m_Spectator)
+	{
+		m_Spectator->Shutdown();
+		delete m_Spectator;
+		m_Spectator = 0;
+	}
+
 	if (m_Game)
 	{
 		m_Game->Shutdown();
@@ -208,10 +506,22 @@ void App::ShutDown()
 		m_Game = 0;
 	}
 
+	if (m_Renderer && m_RendererBackend == kRendererBackend_Null)
+	{
+		static_cast<NullRenderer*>(m_Renderer)->PrintStats();
+	}
+
+	delete m_DrawListPlayer;
+	m_DrawListPlayer = 0;
+
+	delete m_DrawList;
+	m_DrawList = 0;
+
 	delete m_Renderer;
 	m_Renderer = 0;
 
-	TTF_Quit();
+	delete m_GlyphAtlas;
+	m_GlyphAtlas = 0;
 
 	SDL_DestroyWindow(m_Window);
 	SDL_Quit();
@@ -219,12 +529,16 @@ void App::ShutDown()
 
 void App::Run()
 {
+	HP_PROFILE_SCOPE("App::Run");
+
 	Uint32 lastTimeMs = SDL_GetTicks();
 	auto lastTime = std::chrono::high_resolution_clock::now();
 
 	bool Done = false;
 	while (!Done)
 	{
+		HP_PROFILE_SCOPE("Frame");
+
 		GameInput input = { 0 };
 
 		SDL_Event event;
@@ -235,6 +549,17 @@ void App::Run()
 				Done = true;
 			}
 
+			// a device reset loses every texture, not just what was drawn into targets
+			if (event.type == SDL_RENDER_TARGETS_RESET || event.type == SDL_RENDER_DEVICE_RESET)
+			{
+				if (event.type == SDL_RENDER_DEVICE_RESET)
+				{
+					m_Renderer->RecreateTextures();
+				}
+				m_Renderer->InvalidateRenderTargets();
+				m_DrawList->InvalidateRenderTargets();
+			}
+
 			if (event.type == SDL_KEYDOWN)
 			{
 				if (event.key.keysym.sym == SDLK_ESCAPE)
@@ -255,11 +580,11 @@ void App::Run()
 				}
 				else if (event.key.keysym.sym == SDLK_z)
 				{
-					input.rotClockwise = true;
+					input.rotAnticlockwise = true;
 				}
 				else if (event.key.keysym.sym == SDLK_x)
 				{
-					input.rotAnticlockwise = true;
+					input.rotClockwise = true;
 				}
 				else if (event.key.keysym.sym == SDLK_UP)
 				{
@@ -287,10 +612,63 @@ void App::Run()
 		float deltaTimeSeconds = 0.000001f * (float)deltaTimeMicroSeconds.count();
 		lastTime = currentTime;
 
-		m_Game->Update(input, deltaTimeSeconds);
+		if (m_Versus)
+		{
+			m_Versus->Tick(input);
+		}
+		else if (m_Spectator)
+		{
+			m_Spectator->Update(deltaTimeSeconds);
+		}
+		else
+		{
+			m_Game->Update(input, deltaTimeSeconds);
+			if (m_InputRecording)
+			{
+				m_InputRecording->AddFrame(input);
+			}
+			if (m_Leaderboard)
+			{
+				UpdateLeaderboard();
+			}
+		}
+
+		if (m_Broadcast)
+		{
+			m_Broadcast->Tick();
+			m_Broadcast->Poll(0);
+		}
+
+		m_DrawList->Reset();
+		m_DrawList->Clear();
+		if (m_Versus)
+		{
+			m_Versus->Draw(*m_DrawList);
+		}
+		else if (m_Spectator)
+		{
+			m_Spectator->Draw(*m_DrawList);
+		}
+		else
+		{
+			m_Game->Draw(*m_DrawList);
+		}
+		m_DrawList->Present();
+
+		m_DrawListPlayer->Submit(*m_DrawList);
+		if (m_FrameRecorder)
+		{
+			CaptureFrame();
+		}
+		{
+			HP_PROFILE_SCOPE("Renderer::Present");
+			m_Renderer->Present();
+		}
 
-		m_Renderer->Clear();
-		m_Game->Draw(*m_Renderer);
-		m_Renderer->Present();
+		if (!m_FirstFramePresented)
+		{
+			m_FirstFramePresented = true;
+			EndStartupPhase("First frame");
+		}
 	}
 }
@@ -2,24 +2,78 @@
 #ifndef APP_H_INCLUDED
 #define APP_H_INCLUDED
 
+#include <stdint.h>
+
 struct SDL_Window;
+struct GlyphAtlas;
 
+class BroadcastServer;
+class DrawList;
+class DrawListPlayer;
+class FrameRecorder;
 class Game;
+class InputRecording;
+class Leaderboard;
 class Renderer;
+class RollbackSession;
+class SpectatorGrid;
+
+enum RendererBackend
+{
+	kRendererBackend_Sdl = 0,
+	kRendererBackend_Software,
+	kRendererBackend_Null,
+	kNumRendererBackends
+};
 
 class App
 {
 public:
 	App();
-	bool Init(bool FullScreen, unsigned int Width, unsigned int Height);
+	bool Init(bool FullScreen, unsigned int Width, unsigned int Height, RendererBackend rendererBackend);
 	void ShutDown();
 	void Run();
 
+	// records every presented frame to path until ShutDown, call after Init
+	bool StartRecording(const char* path);
+	// shows numBoards bot played games instead of the player's game, call after Init
+	bool StartSpectating(unsigned int numBoards);
+	// plays against the peer at "host:port" instead of alone, call after Init
+	bool StartVersus(unsigned int localPlayer, uint16_t localPort, const char* peerAddress);
+	// streams whichever games are running to TCP viewers, call after starting a mode
+	bool StartBroadcast(uint16_t port);
+	// keeps the player's scores in the log at path across runs, call after Init
+	bool StartLeaderboard(const char* path);
+	// saves the player's inputs to path at ShutDown so the game can be
+	// replayed headless, call after Init, path must outlive the app
+	bool StartInputRecording(const char* path);
+
 private:
+	bool InitVideo(bool FullScreen, unsigned int Width, unsigned int Height);
+	// prints the time since the previous phase ended and since Init began
+	void EndStartupPhase(const char* name);
+	void CaptureFrame();
+	void UpdateLeaderboard();
 
 	SDL_Window* m_Window;
+	GlyphAtlas* m_GlyphAtlas;
 	Renderer* m_Renderer;
+	DrawList* m_DrawList;
+	DrawListPlayer* m_DrawListPlayer;
 	Game* m_Game;
+	FrameRecorder* m_FrameRecorder;
+	SpectatorGrid* m_Spectator;
+	RollbackSession* m_Versus;
+	BroadcastServer* m_Broadcast;
+	Leaderboard* m_Leaderboard;
+	InputRecording* m_InputRecording;
+	const char* m_InputRecordingPath;
+	bool m_ScoreSubmitted;
+	RendererBackend m_RendererBackend;
+
+	uint64_t m_StartupBeginNs;
+	uint64_t m_StartupPhaseNs;
+	bool m_FirstFramePresented;
 };
 
 #endif // APP_H_INCLUDED
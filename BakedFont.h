@@ -0,0 +1,498 @@
+// Generated by tools/BakeFont.cpp from Coder's Crux.ttf at 48 points, do not edit.
+#pragma once
+#ifndef BAKED_FONT_H_INCLUDED
+#define BAKED_FONT_H_INCLUDED
+
+#include "Font.h"
+#include <stdint.h>
+
+static constexpr int s_kBakedFontPointSize = 48;
+static constexpr unsigned int s_kBakedFontWidth = 288;
+static constexpr unsigned int s_kBakedFontHeight = 168;
+static constexpr int s_kBakedFontLineHeight = 28;
+static constexpr unsigned int s_kBakedFontBitsPerPixel = 1;
+
+// x, y, width, height, advance
+static constexpr GlyphAtlas::Glyph s_kBakedFontGlyphs[GlyphAtlas::kNumGlyphs] =
+{
+	{ 0, 0, 18, 28, 18 },	// ' '
+	{ 18, 0, 18, 28, 18 },	// '!'
+	{ 36, 0, 18, 28, 18 },	// '"'
+	{ 54, 0, 18, 28, 18 },	// '#'
+	{ 72, 0, 18, 28, 18 },	// '$'
+	{ 90, 0, 18, 28, 18 },	// '%'
+	{ 108, 0, 18, 28, 18 },	// '&'
+	{ 126, 0, 18, 28, 18 },	// '''
+	{ 144, 0, 18, 28, 18 },	// '('
+	{ 162, 0, 18, 28, 18 },	// ')'
+	{ 180, 0, 18, 28, 18 },	// '*'
+	{ 198, 0, 18, 28, 18 },	// '+'
+	{ 216, 0, 18, 28, 18 },	// ','
+	{ 234, 0, 18, 28, 18 },	// '-'
+	{ 252, 0, 18, 28, 18 },	// '.'
+	{ 270, 0, 18, 28, 18 },	// '/'
+	{ 0, 28, 18, 28, 18 },	// '0'
+	{ 18, 28, 18, 28, 18 },	// '1'
+	{ 36, 28, 18, 28, 18 },	// '2'
+	{ 54, 28, 18, 28, 18 },	// '3'
+	{ 72, 28, 18, 28, 18 },	// '4'
+	{ 90, 28, 18, 28, 18 },	// '5'
+	{ 108, 28, 18, 28, 18 },	// '6'
+	{ 126, 28, 18, 28, 18 },	// '7'
+	{ 144, 28, 18, 28, 18 },	// '8'
+	{ 162, 28, 18, 28, 18 },	// '9'
+	{ 180, 28, 18, 28, 18 },	// ':'
+	{ 198, 28, 18, 28, 18 },	// ';'
+	{ 216, 28, 18, 28, 18 },	// '<'
+	{ 234, 28, 18, 28, 18 },	// '='
+	{ 252, 28, 18, 28, 18 },	// '>'
+	{ 270, 28, 18, 28, 18 },	// '?'
+	{ 0, 56, 18, 28, 18 },	// '@'
+	{ 18, 56, 18, 28, 18 },	// 'A'
+	{ 36, 56, 18, 28, 18 },	// 'B'
+	{ 54, 56, 18, 28, 18 },	// 'C'
+	{ 72, 56, 18, 28, 18 },	// 'D'
+	{ 90, 56, 18, 28, 18 },	// 'E'
+	{ 108, 56, 18, 28, 18 },	// 'F'
+	{ 126, 56, 18, 28, 18 },	// 'G'
+	{ 144, 56, 18, 28, 18 },	// 'H'
+	{ 162, 56, 18, 28, 18 },	// 'I'
+	{ 180, 56, 18, 28, 18 },	// 'J'
+	{ 198, 56, 18, 28, 18 },	// 'K'
+	{ 216, 56, 18, 28, 18 },	// 'L'
+	{ 234, 56, 18, 28, 18 },	// 'M'
+	{ 252, 56, 18, 28, 18 },	// 'N'
+	{ 270, 56, 18, 28, 18 },	// 'O'
+	{ 0, 84, 18, 28, 18 },	// 'P'
+	{ 18, 84, 18, 28, 18 },	// 'Q'
+	{ 36, 84, 18, 28, 18 },	// 'R'
+	{ 54, 84, 18, 28, 18 },	// 'S'
+	{ 72, 84, 18, 28, 18 },	// 'T'
+	{ 90, 84, 18, 28, 18 },	// 'U'
+	{ 108, 84, 18, 28, 18 },	// 'V'
+	{ 126, 84, 18, 28, 18 },	// 'W'
+	{ 144, 84, 18, 28, 18 },	// 'X'
+	{ 162, 84, 18, 28, 18 },	// 'Y'
+	{ 180, 84, 18, 28, 18 },	// 'Z'
+	{ 198, 84, 18, 28, 18 },	// '['
+	{ 216, 84, 18, 28, 18 },	// backslash
+	{ 234, 84, 18, 28, 18 },	// ']'
+	{ 252, 84, 18, 28, 18 },	// '^'
+	{ 270, 84, 18, 28, 18 },	// '_'
+	{ 0, 112, 18, 28, 18 },	// '`'
+	{ 18, 112, 18, 28, 18 },	// 'a'
+	{ 36, 112, 18, 28, 18 },	// 'b'
+	{ 54, 112, 18, 28, 18 },	// 'c'
+	{ 72, 112, 18, 28, 18 },	// 'd'
+	{ 90, 112, 18, 28, 18 },	// 'e'
+	{ 108, 112, 18, 28, 18 },	// 'f'
+	{ 126, 112, 18, 28, 18 },	// 'g'
+	{ 144, 112, 18, 28, 18 },	// 'h'
+	{ 162, 112, 18, 28, 18 },	// 'i'
+	{ 180, 112, 18, 28, 18 },	// 'j'
+	{ 198, 112, 18, 28, 18 },	// 'k'
+	{ 216, 112, 18, 28, 18 },	// 'l'
+	{ 234, 112, 18, 28, 18 },	// 'm'
+	{ 252, 112, 18, 28, 18 },	// 'n'
+	{ 270, 112, 18, 28, 18 },	// 'o'
+	{ 0, 140, 18, 28, 18 },	// 'p'
+	{ 18, 140, 18, 28, 18 },	// 'q'
+	{ 36, 140, 18, 28, 18 },	// 'r'
+	{ 54, 140, 18, 28, 18 },	// 's'
+	{ 72, 140, 18, 28, 18 },	// 't'
+	{ 90, 140, 18, 28, 18 },	// 'u'
+	{ 108, 140, 18, 28, 18 },	// 'v'
+	{ 126, 140, 18, 28, 18 },	// 'w'
+	{ 144, 140, 18, 28, 18 },	// 'x'
+	{ 162, 140, 18, 28, 18 },	// 'y'
+	{ 180, 140, 18, 28, 18 },	// 'z'
+	{ 198, 140, 18, 28, 18 },	// '{'
+	{ 216, 140, 18, 28, 18 },	// '|'
+	{ 234, 140, 18, 28, 18 },	// '}'
+	{ 252, 140, 18, 28, 18 },	// '~'
+};
+
+// rows of 36 bytes, one bit per pixel with the leftmost pixel in the high bit
+static constexpr uint8_t s_kBakedFontPixels[6048] =
+{
+	0x00, 0x00, 0x00, 0xe0, 0x0e, 0x38, 0x00, 0x71, 0xc0, 0x1f, 0xfe, 0x3f, 0x03, 0x81, 0xf8, 0x03,
+	0x80, 0x00, 0x00, 0x70, 0x07, 0x00, 0x0e, 0x38, 0xe0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x38, 0x00, 0x00, 0x00, 0xe0, 0x0e, 0x38, 0x00, 0x71, 0xc0, 0x1f, 0xfe, 0x3f,
+	0x03, 0x81, 0xf8, 0x03, 0x80, 0x00, 0x00, 0x70, 0x07, 0x00, 0x0e, 0x38, 0xe0, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x38, 0x00, 0x00, 0x00, 0xe0, 0x0e, 0x38, 0x00, 0x71,
+	0xc0, 0x1f, 0xfe, 0x3f, 0x03, 0x81, 0xf8, 0x03, 0x80, 0x00, 0x00, 0x70, 0x07, 0x00, 0x0e, 0x38,
+	0xe0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x38, 0x00, 0x00, 0x00, 0xe0,
+	0x0e, 0x38, 0x00, 0x71, 0xc0, 0xe3, 0x80, 0x3f, 0x03, 0x8e, 0x07, 0x03, 0x80, 0x00, 0x03, 0x80,
+	0x00, 0xe0, 0x01, 0xff, 0x00, 0x0e, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x38,
+	0x00, 0x00, 0x00, 0xe0, 0x0e, 0x38, 0x00, 0x71, 0xc0, 0xe3, 0x80, 0x3f, 0x03, 0x8e, 0x07, 0x03,
+	0x80, 0x00, 0x03, 0x80, 0x00, 0xe0, 0x01, 0xff, 0x00, 0x0e, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x38, 0x00, 0x00, 0x00, 0xe0, 0x0e, 0x38, 0x00, 0x71, 0xc0, 0xe3, 0x80, 0x3f,
+	0x03, 0x8e, 0x07, 0x03, 0x80, 0x00, 0x03, 0x80, 0x00, 0xe0, 0x01, 0xff, 0x00, 0x0e, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x38, 0x00, 0x00, 0x00, 0xe0, 0x00, 0x00, 0x03, 0xff,
+	0xf8, 0xe3, 0x80, 0x00, 0x1c, 0x0e, 0x07, 0x00, 0x00, 0x00, 0x1c, 0x00, 0x00, 0x1c, 0x0e, 0x38,
+	0xe0, 0x0e, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0xc0, 0x00, 0x00, 0x00, 0xe0,
+	0x00, 0x00, 0x03, 0xff, 0xf8, 0xe3, 0x80, 0x00, 0x1c, 0x0e, 0x07, 0x00, 0x00, 0x00, 0x1c, 0x00,
+	0x00, 0x1c, 0x0e, 0x38, 0xe0, 0x0e, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0xc0,
+	0x00, 0x00, 0x00, 0xe0, 0x00, 0x00, 0x03, 0xff, 0xf8, 0xe3, 0x80, 0x00, 0x1c, 0x0e, 0x07, 0x00,
+	0x00, 0x00, 0x1c, 0x00, 0x00, 0x1c, 0x0e, 0x38, 0xe0, 0x0e, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x01, 0xc0, 0x00, 0x00, 0x00, 0xe0, 0x00, 0x00, 0x00, 0x71, 0xc0, 0x1f, 0xf0, 0x00,
+	0xe0, 0x01, 0xf8, 0xe0, 0x00, 0x00, 0x1c, 0x00, 0x00, 0x1c, 0x00, 0x00, 0x03, 0xff, 0xf8, 0x00,
+	0x00, 0x3f, 0xff, 0x80, 0x00, 0x00, 0x0e, 0x00, 0x00, 0x00, 0x00, 0xe0, 0x00, 0x00, 0x00, 0x71,
+	0xc0, 0x1f, 0xf0, 0x00, 0xe0, 0x01, 0xf8, 0xe0, 0x00, 0x00, 0x1c, 0x00, 0x00, 0x1c, 0x00, 0x00,
+	0x03, 0xff, 0xf8, 0x00, 0x00, 0x3f, 0xff, 0x80, 0x00, 0x00, 0x0e, 0x00, 0x00, 0x00, 0x00, 0xe0,
+	0x00, 0x00, 0x00, 0x71, 0xc0, 0x1f, 0xf0, 0x00, 0xe0, 0x01, 0xf8, 0xe0, 0x00, 0x00, 0x1c, 0x00,
+	0x00, 0x1c, 0x00, 0x00, 0x03, 0xff, 0xf8, 0x00, 0x00, 0x3f, 0xff, 0x80, 0x00, 0x00, 0x0e, 0x00,
+	0x00, 0x00, 0x00, 0xe0, 0x00, 0x00, 0x03, 0xff, 0xf8, 0x03, 0x8e, 0x07, 0x00, 0x0e, 0x07, 0x00,
+	0x00, 0x00, 0x1c, 0x00, 0x00, 0x1c, 0x00, 0x00, 0x00, 0x0e, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x70, 0x00, 0x00, 0x00, 0x00, 0xe0, 0x00, 0x00, 0x03, 0xff, 0xf8, 0x03, 0x8e, 0x07,
+	0x00, 0x0e, 0x07, 0x00, 0x00, 0x00, 0x1c, 0x00, 0x00, 0x1c, 0x00, 0x00, 0x00, 0x0e, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x70, 0x00, 0x00, 0x00, 0x00, 0xe0, 0x00, 0x00, 0x03, 0xff,
+	0xf8, 0x03, 0x8e, 0x07, 0x00, 0x0e, 0x07, 0x00, 0x00, 0x00, 0x1c, 0x00, 0x00, 0x1c, 0x00, 0x00,
+	0x00, 0x0e, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x70, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x71, 0xc0, 0x03, 0x8e, 0x38, 0x1f, 0x8e, 0x07, 0x00, 0x00, 0x00, 0x03, 0x80,
+	0x00, 0xe0, 0x00, 0x00, 0x00, 0x0e, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x80, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x71, 0xc0, 0x03, 0x8e, 0x38, 0x1f, 0x8e, 0x07, 0x00,
+	0x00, 0x00, 0x03, 0x80, 0x00, 0xe0, 0x00, 0x00, 0x00, 0x0e, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x03, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x71, 0xc0, 0x03, 0x8e, 0x38,
+	0x1f, 0x8e, 0x07, 0x00, 0x00, 0x00, 0x03, 0x80, 0x00, 0xe0, 0x00, 0x00, 0x00, 0x0e, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x80, 0x00, 0x00, 0x00, 0x00, 0xe0, 0x00, 0x00, 0x00, 0x71,
+	0xc0, 0xff, 0xf0, 0x38, 0x1f, 0x81, 0xf8, 0xe0, 0x00, 0x00, 0x00, 0x70, 0x07, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x03, 0x80, 0x00, 0x00, 0x00, 0x38, 0x03, 0x80, 0x00, 0x00, 0x00, 0x00, 0xe0,
+	0x00, 0x00, 0x00, 0x71, 0xc0, 0xff, 0xf0, 0x38, 0x1f, 0x81, 0xf8, 0xe0, 0x00, 0x00, 0x00, 0x70,
+	0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x80, 0x00, 0x00, 0x00, 0x38, 0x03, 0x80, 0x00,
+	0x00, 0x00, 0x00, 0xe0, 0x00, 0x00, 0x00, 0x71, 0xc0, 0xff, 0xf0, 0x38, 0x1f, 0x81, 0xf8, 0xe0,
+	0x00, 0x00, 0x00, 0x70, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x80, 0x00, 0x00, 0x00,
+	0x38, 0x03, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03,
+	0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x03, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x1f, 0xf0, 0x00, 0xe0, 0x01, 0xff, 0x00, 0x7f, 0xc0, 0x00, 0x0e, 0x3f, 0xff, 0x81, 0xff, 0x03,
+	0xff, 0xf8, 0x1f, 0xf0, 0x07, 0xfc, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x70, 0x00, 0x00, 0x01,
+	0xc0, 0x00, 0x7f, 0xc0, 0x1f, 0xf0, 0x00, 0xe0, 0x01, 0xff, 0x00, 0x7f, 0xc0, 0x00, 0x0e, 0x3f,
+	0xff, 0x81, 0xff, 0x03, 0xff, 0xf8, 0x1f, 0xf0, 0x07, 0xfc, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x70, 0x00, 0x00, 0x01, 0xc0, 0x00, 0x7f, 0xc0, 0x1f, 0xf0, 0x00, 0xe0, 0x01, 0xff, 0x00, 0x7f,
+	0xc0, 0x00, 0x0e, 0x3f, 0xff, 0x81, 0xff, 0x03, 0xff, 0xf8, 0x1f, 0xf0, 0x07, 0xfc, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x70, 0x00, 0x00, 0x01, 0xc0, 0x00, 0x7f, 0xc0, 0xe0, 0x0e, 0x07, 0xe0,
+	0x0e, 0x00, 0xe3, 0x80, 0x38, 0x00, 0x7e, 0x38, 0x00, 0x0e, 0x00, 0xe0, 0x00, 0x38, 0xe0, 0x0e,
+	0x38, 0x03, 0x80, 0x00, 0x00, 0x00, 0x00, 0x03, 0x80, 0x00, 0x00, 0x00, 0x38, 0x03, 0x80, 0x38,
+	0xe0, 0x0e, 0x07, 0xe0, 0x0e, 0x00, 0xe3, 0x80, 0x38, 0x00, 0x7e, 0x38, 0x00, 0x0e, 0x00, 0xe0,
+	0x00, 0x38, 0xe0, 0x0e, 0x38, 0x03, 0x80, 0x00, 0x00, 0x00, 0x00, 0x03, 0x80, 0x00, 0x00, 0x00,
+	0x38, 0x03, 0x80, 0x38, 0xe0, 0x0e, 0x07, 0xe0, 0x0e, 0x00, 0xe3, 0x80, 0x38, 0x00, 0x7e, 0x38,
+	0x00, 0x0e, 0x00, 0xe0, 0x00, 0x38, 0xe0, 0x0e, 0x38, 0x03, 0x80, 0x00, 0x00, 0x00, 0x00, 0x03,
+	0x80, 0x00, 0x00, 0x00, 0x38, 0x03, 0x80, 0x38, 0xe0, 0x0e, 0x00, 0xe0, 0x00, 0x00, 0xe0, 0x00,
+	0x38, 0x03, 0x8e, 0x38, 0x00, 0x0e, 0x00, 0x00, 0x01, 0xc0, 0xe0, 0x0e, 0x38, 0x03, 0x80, 0x38,
+	0x00, 0x0e, 0x00, 0x1c, 0x00, 0x3f, 0xff, 0x80, 0x07, 0x00, 0x00, 0x38, 0xe0, 0x0e, 0x00, 0xe0,
+	0x00, 0x00, 0xe0, 0x00, 0x38, 0x03, 0x8e, 0x38, 0x00, 0x0e, 0x00, 0x00, 0x01, 0xc0, 0xe0, 0x0e,
+	0x38, 0x03, 0x80, 0x38, 0x00, 0x0e, 0x00, 0x1c, 0x00, 0x3f, 0xff, 0x80, 0x07, 0x00, 0x00, 0x38,
+	0xe0, 0x0e, 0x00, 0xe0, 0x00, 0x00, 0xe0, 0x00, 0x38, 0x03, 0x8e, 0x38, 0x00, 0x0e, 0x00, 0x00,
+	0x01, 0xc0, 0xe0, 0x0e, 0x38, 0x03, 0x80, 0x38, 0x00, 0x0e, 0x00, 0x1c, 0x00, 0x3f, 0xff, 0x80,
+	0x07, 0x00, 0x00, 0x38, 0xe3, 0x8e, 0x00, 0xe0, 0x01, 0xff, 0x00, 0x7f, 0xc0, 0x1c, 0x0e, 0x3f,
+	0xfc, 0x0f, 0xff, 0x00, 0x0e, 0x00, 0x1f, 0xf0, 0x07, 0xff, 0x80, 0x00, 0x00, 0x00, 0x00, 0xe0,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0xe0, 0x0f, 0xc0, 0xe3, 0x8e, 0x00, 0xe0, 0x01, 0xff, 0x00, 0x7f,
+	0xc0, 0x1c, 0x0e, 0x3f, 0xfc, 0x0f, 0xff, 0x00, 0x0e, 0x00, 0x1f, 0xf0, 0x07, 0xff, 0x80, 0x00,
+	0x00, 0x00, 0x00, 0xe0, 0x00, 0x00, 0x00, 0x00, 0x00, 0xe0, 0x0f, 0xc0, 0xe3, 0x8e, 0x00, 0xe0,
+	0x01, 0xff, 0x00, 0x7f, 0xc0, 0x1c, 0x0e, 0x3f, 0xfc, 0x0f, 0xff, 0x00, 0x0e, 0x00, 0x1f, 0xf0,
+	0x07, 0xff, 0x80, 0x00, 0x00, 0x00, 0x00, 0xe0, 0x00, 0x00, 0x00, 0x00, 0x00, 0xe0, 0x0f, 0xc0,
+	0xe0, 0x0e, 0x00, 0xe0, 0x0e, 0x00, 0x00, 0x00, 0x38, 0xff, 0xfe, 0x00, 0x03, 0x8e, 0x00, 0xe0,
+	0x70, 0x00, 0xe0, 0x0e, 0x00, 0x03, 0x80, 0x38, 0x00, 0x0e, 0x00, 0x1c, 0x00, 0x3f, 0xff, 0x80,
+	0x07, 0x00, 0x0e, 0x00, 0xe0, 0x0e, 0x00, 0xe0, 0x0e, 0x00, 0x00, 0x00, 0x38, 0xff, 0xfe, 0x00,
+	0x03, 0x8e, 0x00, 0xe0, 0x70, 0x00, 0xe0, 0x0e, 0x00, 0x03, 0x80, 0x38, 0x00, 0x0e, 0x00, 0x1c,
+	0x00, 0x3f, 0xff, 0x80, 0x07, 0x00, 0x0e, 0x00, 0xe0, 0x0e, 0x00, 0xe0, 0x0e, 0x00, 0x00, 0x00,
+	0x38, 0xff, 0xfe, 0x00, 0x03, 0x8e, 0x00, 0xe0, 0x70, 0x00, 0xe0, 0x0e, 0x00, 0x03, 0x80, 0x38,
+	0x00, 0x0e, 0x00, 0x1c, 0x00, 0x3f, 0xff, 0x80, 0x07, 0x00, 0x0e, 0x00, 0xe0, 0x0e, 0x00, 0xe0,
+	0x0e, 0x00, 0x03, 0x80, 0x38, 0x00, 0x0e, 0x38, 0x03, 0x8e, 0x00, 0xe3, 0x80, 0x00, 0xe0, 0x0e,
+	0x38, 0x03, 0x80, 0x00, 0x00, 0x70, 0x00, 0x03, 0x80, 0x00, 0x00, 0x00, 0x38, 0x00, 0x00, 0x00,
+	0xe0, 0x0e, 0x00, 0xe0, 0x0e, 0x00, 0x03, 0x80, 0x38, 0x00, 0x0e, 0x38, 0x03, 0x8e, 0x00, 0xe3,
+	0x80, 0x00, 0xe0, 0x0e, 0x38, 0x03, 0x80, 0x00, 0x00, 0x70, 0x00, 0x03, 0x80, 0x00, 0x00, 0x00,
+	0x38, 0x00, 0x00, 0x00, 0xe0, 0x0e, 0x00, 0xe0, 0x0e, 0x00, 0x03, 0x80, 0x38, 0x00, 0x0e, 0x38,
+	0x03, 0x8e, 0x00, 0xe3, 0x80, 0x00, 0xe0, 0x0e, 0x38, 0x03, 0x80, 0x00, 0x00, 0x70, 0x00, 0x03,
+	0x80, 0x00, 0x00, 0x00, 0x38, 0x00, 0x00, 0x00, 0x1f, 0xf0, 0x07, 0xfc, 0x0f, 0xff, 0xe0, 0x7f,
+	0xc0, 0x00, 0x0e, 0x07, 0xfc, 0x01, 0xff, 0x03, 0x80, 0x00, 0x1f, 0xf0, 0x07, 0xfc, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x70, 0x00, 0x00, 0x01, 0xc0, 0x00, 0x0e, 0x00, 0x1f, 0xf0, 0x07, 0xfc,
+	0x0f, 0xff, 0xe0, 0x7f, 0xc0, 0x00, 0x0e, 0x07, 0xfc, 0x01, 0xff, 0x03, 0x80, 0x00, 0x1f, 0xf0,
+	0x07, 0xfc, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x70, 0x00, 0x00, 0x01, 0xc0, 0x00, 0x0e, 0x00,
+	0x1f, 0xf0, 0x07, 0xfc, 0x0f, 0xff, 0xe0, 0x7f, 0xc0, 0x00, 0x0e, 0x07, 0xfc, 0x01, 0xff, 0x03,
+	0x80, 0x00, 0x1f, 0xf0, 0x07, 0xfc, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x70, 0x00, 0x00, 0x01,
+	0xc0, 0x00, 0x0e, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x07, 0xfc, 0x0f, 0xff, 0x00, 0x7f, 0xc0, 0xff, 0xf0, 0x3f, 0xff, 0x8f, 0xff, 0xe0,
+	0x7f, 0xc0, 0xe0, 0x0e, 0x07, 0xfc, 0x00, 0x3f, 0xe3, 0x80, 0x38, 0xe0, 0x00, 0x38, 0x03, 0x8e,
+	0x00, 0xe0, 0x7f, 0xc0, 0x00, 0x00, 0x07, 0xfc, 0x0f, 0xff, 0x00, 0x7f, 0xc0, 0xff, 0xf0, 0x3f,
+	0xff, 0x8f, 0xff, 0xe0, 0x7f, 0xc0, 0xe0, 0x0e, 0x07, 0xfc, 0x00, 0x3f, 0xe3, 0x80, 0x38, 0xe0,
+	0x00, 0x38, 0x03, 0x8e, 0x00, 0xe0, 0x7f, 0xc0, 0x00, 0x00, 0x07, 0xfc, 0x0f, 0xff, 0x00, 0x7f,
+	0xc0, 0xff, 0xf0, 0x3f, 0xff, 0x8f, 0xff, 0xe0, 0x7f, 0xc0, 0xe0, 0x0e, 0x07, 0xfc, 0x00, 0x3f,
+	0xe3, 0x80, 0x38, 0xe0, 0x00, 0x38, 0x03, 0x8e, 0x00, 0xe0, 0x7f, 0xc0, 0x00, 0x00, 0x38, 0x03,
+	0x8e, 0x00, 0xe3, 0x80, 0x38, 0xe0, 0x0e, 0x38, 0x00, 0x0e, 0x00, 0x03, 0x80, 0x38, 0xe0, 0x0e,
+	0x00, 0xe0, 0x00, 0x07, 0x03, 0x81, 0xc0, 0xe0, 0x00, 0x3f, 0x1f, 0x8f, 0xc0, 0xe3, 0x80, 0x38,
+	0x00, 0x00, 0x38, 0x03, 0x8e, 0x00, 0xe3, 0x80, 0x38, 0xe0, 0x0e, 0x38, 0x00, 0x0e, 0x00, 0x03,
+	0x80, 0x38, 0xe0, 0x0e, 0x00, 0xe0, 0x00, 0x07, 0x03, 0x81, 0xc0, 0xe0, 0x00, 0x3f, 0x1f, 0x8f,
+	0xc0, 0xe3, 0x80, 0x38, 0x00, 0x00, 0x38, 0x03, 0x8e, 0x00, 0xe3, 0x80, 0x38, 0xe0, 0x0e, 0x38,
+	0x00, 0x0e, 0x00, 0x03, 0x80, 0x38, 0xe0, 0x0e, 0x00, 0xe0, 0x00, 0x07, 0x03, 0x81, 0xc0, 0xe0,
+	0x00, 0x3f, 0x1f, 0x8f, 0xc0, 0xe3, 0x80, 0x38, 0x1f, 0xf0, 0x38, 0x03, 0x8e, 0x00, 0xe3, 0x80,
+	0x00, 0xe0, 0x0e, 0x38, 0x00, 0x0e, 0x00, 0x03, 0x80, 0x00, 0xe0, 0x0e, 0x00, 0xe0, 0x00, 0x07,
+	0x03, 0x8e, 0x00, 0xe0, 0x00, 0x38, 0xe3, 0x8f, 0xc0, 0xe3, 0x80, 0x38, 0x1f, 0xf0, 0x38, 0x03,
+	0x8e, 0x00, 0xe3, 0x80, 0x00, 0xe0, 0x0e, 0x38, 0x00, 0x0e, 0x00, 0x03, 0x80, 0x00, 0xe0, 0x0e,
+	0x00, 0xe0, 0x00, 0x07, 0x03, 0x8e, 0x00, 0xe0, 0x00, 0x38, 0xe3, 0x8f, 0xc0, 0xe3, 0x80, 0x38,
+	0x1f, 0xf0, 0x38, 0x03, 0x8e, 0x00, 0xe3, 0x80, 0x00, 0xe0, 0x0e, 0x38, 0x00, 0x0e, 0x00, 0x03,
+	0x80, 0x00, 0xe0, 0x0e, 0x00, 0xe0, 0x00, 0x07, 0x03, 0x8e, 0x00, 0xe0, 0x00, 0x38, 0xe3, 0x8f,
+	0xc0, 0xe3, 0x80, 0x38, 0xe0, 0x0e, 0x3f, 0xff, 0x8f, 0xff, 0x03, 0x80, 0x00, 0xe0, 0x0e, 0x3f,
+	0xfc, 0x0f, 0xff, 0x03, 0x8f, 0xf8, 0xff, 0xfe, 0x00, 0xe0, 0x00, 0x07, 0x03, 0xf0, 0x00, 0xe0,
+	0x00, 0x38, 0x03, 0x8e, 0x38, 0xe3, 0x80, 0x38, 0xe0, 0x0e, 0x3f, 0xff, 0x8f, 0xff, 0x03, 0x80,
+	0x00, 0xe0, 0x0e, 0x3f, 0xfc, 0x0f, 0xff, 0x03, 0x8f, 0xf8, 0xff, 0xfe, 0x00, 0xe0, 0x00, 0x07,
+	0x03, 0xf0, 0x00, 0xe0, 0x00, 0x38, 0x03, 0x8e, 0x38, 0xe3, 0x80, 0x38, 0xe0, 0x0e, 0x3f, 0xff,
+	0x8f, 0xff, 0x03, 0x80, 0x00, 0xe0, 0x0e, 0x3f, 0xfc, 0x0f, 0xff, 0x03, 0x8f, 0xf8, 0xff, 0xfe,
+	0x00, 0xe0, 0x00, 0x07, 0x03, 0xf0, 0x00, 0xe0, 0x00, 0x38, 0x03, 0x8e, 0x38, 0xe3, 0x80, 0x38,
+	0xe3, 0xf0, 0x38, 0x03, 0x8e, 0x00, 0xe3, 0x80, 0x00, 0xe0, 0x0e, 0x38, 0x00, 0x0e, 0x00, 0x03,
+	0x80, 0x38, 0xe0, 0x0e, 0x00, 0xe0, 0x00, 0x07, 0x03, 0x8e, 0x00, 0xe0, 0x00, 0x38, 0x03, 0x8e,
+	0x07, 0xe3, 0x80, 0x38, 0xe3, 0xf0, 0x38, 0x03, 0x8e, 0x00, 0xe3, 0x80, 0x00, 0xe0, 0x0e, 0x38,
+	0x00, 0x0e, 0x00, 0x03, 0x80, 0x38, 0xe0, 0x0e, 0x00, 0xe0, 0x00, 0x07, 0x03, 0x8e, 0x00, 0xe0,
+	0x00, 0x38, 0x03, 0x8e, 0x07, 0xe3, 0x80, 0x38, 0xe3, 0xf0, 0x38, 0x03, 0x8e, 0x00, 0xe3, 0x80,
+	0x00, 0xe0, 0x0e, 0x38, 0x00, 0x0e, 0x00, 0x03, 0x80, 0x38, 0xe0, 0x0e, 0x00, 0xe0, 0x00, 0x07,
+	0x03, 0x8e, 0x00, 0xe0, 0x00, 0x38, 0x03, 0x8e, 0x07, 0xe3, 0x80, 0x38, 0xe0, 0x00, 0x38, 0x03,
+	0x8e, 0x00, 0xe3, 0x80, 0x38, 0xe0, 0x0e, 0x38, 0x00, 0x0e, 0x00, 0x03, 0x80, 0x38, 0xe0, 0x0e,
+	0x00, 0xe0, 0x0e, 0x07, 0x03, 0x81, 0xc0, 0xe0, 0x00, 0x38, 0x03, 0x8e, 0x07, 0xe3, 0x80, 0x38,
+	0xe0, 0x00, 0x38, 0x03, 0x8e, 0x00, 0xe3, 0x80, 0x38, 0xe0, 0x0e, 0x38, 0x00, 0x0e, 0x00, 0x03,
+	0x80, 0x38, 0xe0, 0x0e, 0x00, 0xe0, 0x0e, 0x07, 0x03, 0x81, 0xc0, 0xe0, 0x00, 0x38, 0x03, 0x8e,
+	0x07, 0xe3, 0x80, 0x38, 0xe0, 0x00, 0x38, 0x03, 0x8e, 0x00, 0xe3, 0x80, 0x38, 0xe0, 0x0e, 0x38,
+	0x00, 0x0e, 0x00, 0x03, 0x80, 0x38, 0xe0, 0x0e, 0x00, 0xe0, 0x0e, 0x07, 0x03, 0x81, 0xc0, 0xe0,
+	0x00, 0x38, 0x03, 0x8e, 0x07, 0xe3, 0x80, 0x38, 0x1f, 0xfe, 0x38, 0x03, 0x8f, 0xff, 0x00, 0x7f,
+	0xc0, 0xff, 0xf0, 0x3f, 0xff, 0x8e, 0x00, 0x00, 0x7f, 0xc0, 0xe0, 0x0e, 0x07, 0xfc, 0x01, 0xf8,
+	0x03, 0x80, 0x38, 0xff, 0xfe, 0x38, 0x03, 0x8e, 0x00, 0xe0, 0x7f, 0xc0, 0x1f, 0xfe, 0x38, 0x03,
+	0x8f, 0xff, 0x00, 0x7f, 0xc0, 0xff, 0xf0, 0x3f, 0xff, 0x8e, 0x00, 0x00, 0x7f, 0xc0, 0xe0, 0x0e,
+	0x07, 0xfc, 0x01, 0xf8, 0x03, 0x80, 0x38, 0xff, 0xfe, 0x38, 0x03, 0x8e, 0x00, 0xe0, 0x7f, 0xc0,
+	0x1f, 0xfe, 0x38, 0x03, 0x8f, 0xff, 0x00, 0x7f, 0xc0, 0xff, 0xf0, 0x3f, 0xff, 0x8e, 0x00, 0x00,
+	0x7f, 0xc0, 0xe0, 0x0e, 0x07, 0xfc, 0x01, 0xf8, 0x03, 0x80, 0x38, 0xff, 0xfe, 0x38, 0x03, 0x8e,
+	0x00, 0xe0, 0x7f, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0xff, 0xf0, 0x07, 0xfc, 0x0f, 0xff, 0x00, 0x7f, 0xf8, 0xff, 0xfe, 0x38, 0x03, 0x8e, 0x00, 0xe3,
+	0x8e, 0x38, 0xe0, 0x0e, 0x38, 0x03, 0x8f, 0xff, 0xe0, 0x7f, 0xc0, 0xe0, 0x00, 0x07, 0xfc, 0x00,
+	0x38, 0x00, 0x00, 0x00, 0xff, 0xf0, 0x07, 0xfc, 0x0f, 0xff, 0x00, 0x7f, 0xf8, 0xff, 0xfe, 0x38,
+	0x03, 0x8e, 0x00, 0xe3, 0x8e, 0x38, 0xe0, 0x0e, 0x38, 0x03, 0x8f, 0xff, 0xe0, 0x7f, 0xc0, 0xe0,
+	0x00, 0x07, 0xfc, 0x00, 0x38, 0x00, 0x00, 0x00, 0xff, 0xf0, 0x07, 0xfc, 0x0f, 0xff, 0x00, 0x7f,
+	0xf8, 0xff, 0xfe, 0x38, 0x03, 0x8e, 0x00, 0xe3, 0x8e, 0x38, 0xe0, 0x0e, 0x38, 0x03, 0x8f, 0xff,
+	0xe0, 0x7f, 0xc0, 0xe0, 0x00, 0x07, 0xfc, 0x00, 0x38, 0x00, 0x00, 0x00, 0xe0, 0x0e, 0x38, 0x03,
+	0x8e, 0x00, 0xe3, 0x80, 0x00, 0x03, 0x80, 0x38, 0x03, 0x8e, 0x00, 0xe3, 0x8e, 0x38, 0xe0, 0x0e,
+	0x38, 0x03, 0x80, 0x00, 0xe0, 0x70, 0x00, 0xe0, 0x00, 0x00, 0x1c, 0x01, 0xc7, 0x00, 0x00, 0x00,
+	0xe0, 0x0e, 0x38, 0x03, 0x8e, 0x00, 0xe3, 0x80, 0x00, 0x03, 0x80, 0x38, 0x03, 0x8e, 0x00, 0xe3,
+	0x8e, 0x38, 0xe0, 0x0e, 0x38, 0x03, 0x80, 0x00, 0xe0, 0x70, 0x00, 0xe0, 0x00, 0x00, 0x1c, 0x01,
+	0xc7, 0x00, 0x00, 0x00, 0xe0, 0x0e, 0x38, 0x03, 0x8e, 0x00, 0xe3, 0x80, 0x00, 0x03, 0x80, 0x38,
+	0x03, 0x8e, 0x00, 0xe3, 0x8e, 0x38, 0xe0, 0x0e, 0x38, 0x03, 0x80, 0x00, 0xe0, 0x70, 0x00, 0xe0,
+	0x00, 0x00, 0x1c, 0x01, 0xc7, 0x00, 0x00, 0x00, 0xe0, 0x0e, 0x38, 0x03, 0x8e, 0x00, 0xe3, 0x80,
+	0x00, 0x03, 0x80, 0x38, 0x03, 0x8e, 0x00, 0xe3, 0x8e, 0x38, 0x1c, 0x70, 0x07, 0x1c, 0x00, 0x07,
+	0x00, 0x70, 0x00, 0x1c, 0x00, 0x00, 0x1c, 0x0e, 0x00, 0xe0, 0x00, 0x00, 0xe0, 0x0e, 0x38, 0x03,
+	0x8e, 0x00, 0xe3, 0x80, 0x00, 0x03, 0x80, 0x38, 0x03, 0x8e, 0x00, 0xe3, 0x8e, 0x38, 0x1c, 0x70,
+	0x07, 0x1c, 0x00, 0x07, 0x00, 0x70, 0x00, 0x1c, 0x00, 0x00, 0x1c, 0x0e, 0x00, 0xe0, 0x00, 0x00,
+	0xe0, 0x0e, 0x38, 0x03, 0x8e, 0x00, 0xe3, 0x80, 0x00, 0x03, 0x80, 0x38, 0x03, 0x8e, 0x00, 0xe3,
+	0x8e, 0x38, 0x1c, 0x70, 0x07, 0x1c, 0x00, 0x07, 0x00, 0x70, 0x00, 0x1c, 0x00, 0x00, 0x1c, 0x0e,
+	0x00, 0xe0, 0x00, 0x00, 0xff, 0xf0, 0x38, 0xe3, 0x8f, 0xff, 0x00, 0x7f, 0xc0, 0x03, 0x80, 0x38,
+	0x03, 0x8e, 0x00, 0xe3, 0x8e, 0x38, 0x03, 0x80, 0x00, 0xe0, 0x00, 0x38, 0x00, 0x70, 0x00, 0x03,
+	0x80, 0x00, 0x1c, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xf0, 0x38, 0xe3, 0x8f, 0xff, 0x00, 0x7f,
+	0xc0, 0x03, 0x80, 0x38, 0x03, 0x8e, 0x00, 0xe3, 0x8e, 0x38, 0x03, 0x80, 0x00, 0xe0, 0x00, 0x38,
+	0x00, 0x70, 0x00, 0x03, 0x80, 0x00, 0x1c, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xf0, 0x38, 0xe3,
+	0x8f, 0xff, 0x00, 0x7f, 0xc0, 0x03, 0x80, 0x38, 0x03, 0x8e, 0x00, 0xe3, 0x8e, 0x38, 0x03, 0x80,
+	0x00, 0xe0, 0x00, 0x38, 0x00, 0x70, 0x00, 0x03, 0x80, 0x00, 0x1c, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0xe0, 0x00, 0x38, 0xe3, 0x8e, 0x00, 0xe0, 0x00, 0x38, 0x03, 0x80, 0x38, 0x03, 0x8e, 0x00, 0xe3,
+	0x8e, 0x38, 0x1c, 0x70, 0x00, 0xe0, 0x01, 0xc0, 0x00, 0x70, 0x00, 0x00, 0x70, 0x00, 0x1c, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0xe0, 0x00, 0x38, 0xe3, 0x8e, 0x00, 0xe0, 0x00, 0x38, 0x03, 0x80, 0x38,
+	0x03, 0x8e, 0x00, 0xe3, 0x8e, 0x38, 0x1c, 0x70, 0x00, 0xe0, 0x01, 0xc0, 0x00, 0x70, 0x00, 0x00,
+	0x70, 0x00, 0x1c, 0x00, 0x00, 0x00, 0x00, 0x00, 0xe0, 0x00, 0x38, 0xe3, 0x8e, 0x00, 0xe0, 0x00,
+	0x38, 0x03, 0x80, 0x38, 0x03, 0x8e, 0x00, 0xe3, 0x8e, 0x38, 0x1c, 0x70, 0x00, 0xe0, 0x01, 0xc0,
+	0x00, 0x70, 0x00, 0x00, 0x70, 0x00, 0x1c, 0x00, 0x00, 0x00, 0x00, 0x00, 0xe0, 0x00, 0x38, 0xe3,
+	0x8e, 0x00, 0xe0, 0x00, 0x38, 0x03, 0x80, 0x38, 0x03, 0x81, 0xc7, 0x03, 0x8e, 0x38, 0xe0, 0x0e,
+	0x00, 0xe0, 0x0e, 0x00, 0x00, 0x70, 0x00, 0x00, 0x0e, 0x00, 0x1c, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0xe0, 0x00, 0x38, 0xe3, 0x8e, 0x00, 0xe0, 0x00, 0x38, 0x03, 0x80, 0x38, 0x03, 0x81, 0xc7, 0x03,
+	0x8e, 0x38, 0xe0, 0x0e, 0x00, 0xe0, 0x0e, 0x00, 0x00, 0x70, 0x00, 0x00, 0x0e, 0x00, 0x1c, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0xe0, 0x00, 0x38, 0xe3, 0x8e, 0x00, 0xe0, 0x00, 0x38, 0x03, 0x80, 0x38,
+	0x03, 0x81, 0xc7, 0x03, 0x8e, 0x38, 0xe0, 0x0e, 0x00, 0xe0, 0x0e, 0x00, 0x00, 0x70, 0x00, 0x00,
+	0x0e, 0x00, 0x1c, 0x00, 0x00, 0x00, 0x00, 0x00, 0xe0, 0x00, 0x07, 0xfc, 0x0e, 0x00, 0xe3, 0xff,
+	0xc0, 0x03, 0x80, 0x07, 0xfc, 0x00, 0x38, 0x00, 0x71, 0xc0, 0xe0, 0x0e, 0x00, 0xe0, 0x0f, 0xff,
+	0xe0, 0x7f, 0xc0, 0x00, 0x0e, 0x07, 0xfc, 0x00, 0x00, 0x03, 0xff, 0xf8, 0xe0, 0x00, 0x07, 0xfc,
+	0x0e, 0x00, 0xe3, 0xff, 0xc0, 0x03, 0x80, 0x07, 0xfc, 0x00, 0x38, 0x00, 0x71, 0xc0, 0xe0, 0x0e,
+	0x00, 0xe0, 0x0f, 0xff, 0xe0, 0x7f, 0xc0, 0x00, 0x0e, 0x07, 0xfc, 0x00, 0x00, 0x03, 0xff, 0xf8,
+	0xe0, 0x00, 0x07, 0xfc, 0x0e, 0x00, 0xe3, 0xff, 0xc0, 0x03, 0x80, 0x07, 0xfc, 0x00, 0x38, 0x00,
+	0x71, 0xc0, 0xe0, 0x0e, 0x00, 0xe0, 0x0f, 0xff, 0xe0, 0x7f, 0xc0, 0x00, 0x0e, 0x07, 0xfc, 0x00,
+	0x00, 0x03, 0xff, 0xf8, 0x00, 0x00, 0x00, 0xe0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xe0, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xe0,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0xe0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xe0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xe0, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x1c, 0x00, 0x00, 0x00, 0x0e, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0e, 0x00, 0x00, 0x00, 0x3f, 0x00,
+	0x00, 0x00, 0xe0, 0x00, 0x00, 0xe0, 0x00, 0x07, 0x03, 0x80, 0x00, 0x1f, 0x80, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x1c, 0x00, 0x00, 0x00, 0x0e, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0e, 0x00,
+	0x00, 0x00, 0x3f, 0x00, 0x00, 0x00, 0xe0, 0x00, 0x00, 0xe0, 0x00, 0x07, 0x03, 0x80, 0x00, 0x1f,
+	0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1c, 0x00, 0x00, 0x00, 0x0e, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x0e, 0x00, 0x00, 0x00, 0x3f, 0x00, 0x00, 0x00, 0xe0, 0x00, 0x00, 0xe0, 0x00, 0x07,
+	0x03, 0x80, 0x00, 0x1f, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x80, 0x00, 0x00,
+	0x0e, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0e, 0x00, 0x00, 0x01, 0xc0, 0xe0, 0x00, 0x00, 0xe0, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x03, 0x80, 0x00, 0x03, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x03, 0x80, 0x00, 0x00, 0x0e, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0e, 0x00, 0x00, 0x01, 0xc0, 0xe0,
+	0x00, 0x00, 0xe0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x80, 0x00, 0x03, 0x80, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x03, 0x80, 0x00, 0x00, 0x0e, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0e, 0x00,
+	0x00, 0x01, 0xc0, 0xe0, 0x00, 0x00, 0xe0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x80, 0x00, 0x03,
+	0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x70, 0x07, 0xfc, 0x0f, 0xff, 0x00, 0x7f,
+	0xc0, 0x1f, 0xfe, 0x07, 0xfc, 0x01, 0xc0, 0x00, 0x7f, 0xf8, 0xff, 0xf0, 0x07, 0xe0, 0x00, 0x3f,
+	0x03, 0x80, 0x38, 0x03, 0x80, 0x3f, 0xfc, 0x0f, 0xff, 0x00, 0x7f, 0xc0, 0x00, 0x70, 0x07, 0xfc,
+	0x0f, 0xff, 0x00, 0x7f, 0xc0, 0x1f, 0xfe, 0x07, 0xfc, 0x01, 0xc0, 0x00, 0x7f, 0xf8, 0xff, 0xf0,
+	0x07, 0xe0, 0x00, 0x3f, 0x03, 0x80, 0x38, 0x03, 0x80, 0x3f, 0xfc, 0x0f, 0xff, 0x00, 0x7f, 0xc0,
+	0x00, 0x70, 0x07, 0xfc, 0x0f, 0xff, 0x00, 0x7f, 0xc0, 0x1f, 0xfe, 0x07, 0xfc, 0x01, 0xc0, 0x00,
+	0x7f, 0xf8, 0xff, 0xf0, 0x07, 0xe0, 0x00, 0x3f, 0x03, 0x80, 0x38, 0x03, 0x80, 0x3f, 0xfc, 0x0f,
+	0xff, 0x00, 0x7f, 0xc0, 0x00, 0x00, 0x00, 0x03, 0x8e, 0x00, 0xe3, 0x80, 0x38, 0xe0, 0x0e, 0x38,
+	0x03, 0x8f, 0xff, 0x03, 0x80, 0x38, 0xe0, 0x0e, 0x00, 0xe0, 0x00, 0x07, 0x03, 0x81, 0xc0, 0x03,
+	0x80, 0x38, 0xe3, 0x8e, 0x00, 0xe3, 0x80, 0x38, 0x00, 0x00, 0x00, 0x03, 0x8e, 0x00, 0xe3, 0x80,
+	0x38, 0xe0, 0x0e, 0x38, 0x03, 0x8f, 0xff, 0x03, 0x80, 0x38, 0xe0, 0x0e, 0x00, 0xe0, 0x00, 0x07,
+	0x03, 0x81, 0xc0, 0x03, 0x80, 0x38, 0xe3, 0x8e, 0x00, 0xe3, 0x80, 0x38, 0x00, 0x00, 0x00, 0x03,
+	0x8e, 0x00, 0xe3, 0x80, 0x38, 0xe0, 0x0e, 0x38, 0x03, 0x8f, 0xff, 0x03, 0x80, 0x38, 0xe0, 0x0e,
+	0x00, 0xe0, 0x00, 0x07, 0x03, 0x81, 0xc0, 0x03, 0x80, 0x38, 0xe3, 0x8e, 0x00, 0xe3, 0x80, 0x38,
+	0x00, 0x00, 0x07, 0xff, 0x8e, 0x00, 0xe3, 0x80, 0x00, 0xe0, 0x0e, 0x3f, 0xff, 0x81, 0xc0, 0x03,
+	0x80, 0x38, 0xe0, 0x0e, 0x00, 0xe0, 0x00, 0x07, 0x03, 0xfe, 0x00, 0x03, 0x80, 0x38, 0xe3, 0x8e,
+	0x00, 0xe3, 0x80, 0x38, 0x00, 0x00, 0x07, 0xff, 0x8e, 0x00, 0xe3, 0x80, 0x00, 0xe0, 0x0e, 0x3f,
+	0xff, 0x81, 0xc0, 0x03, 0x80, 0x38, 0xe0, 0x0e, 0x00, 0xe0, 0x00, 0x07, 0x03, 0xfe, 0x00, 0x03,
+	0x80, 0x38, 0xe3, 0x8e, 0x00, 0xe3, 0x80, 0x38, 0x00, 0x00, 0x07, 0xff, 0x8e, 0x00, 0xe3, 0x80,
+	0x00, 0xe0, 0x0e, 0x3f, 0xff, 0x81, 0xc0, 0x03, 0x80, 0x38, 0xe0, 0x0e, 0x00, 0xe0, 0x00, 0x07,
+	0x03, 0xfe, 0x00, 0x03, 0x80, 0x38, 0xe3, 0x8e, 0x00, 0xe3, 0x80, 0x38, 0x00, 0x00, 0x38, 0x03,
+	0x8e, 0x00, 0xe3, 0x80, 0x38, 0xe0, 0x0e, 0x38, 0x00, 0x01, 0xc0, 0x03, 0x80, 0x38, 0xe0, 0x0e,
+	0x00, 0xe0, 0x00, 0x07, 0x03, 0x81, 0xc0, 0x03, 0x80, 0x38, 0xe3, 0x8e, 0x00, 0xe3, 0x80, 0x38,
+	0x00, 0x00, 0x38, 0x03, 0x8e, 0x00, 0xe3, 0x80, 0x38, 0xe0, 0x0e, 0x38, 0x00, 0x01, 0xc0, 0x03,
+	0x80, 0x38, 0xe0, 0x0e, 0x00, 0xe0, 0x00, 0x07, 0x03, 0x81, 0xc0, 0x03, 0x80, 0x38, 0xe3, 0x8e,
+	0x00, 0xe3, 0x80, 0x38, 0x00, 0x00, 0x38, 0x03, 0x8e, 0x00, 0xe3, 0x80, 0x38, 0xe0, 0x0e, 0x38,
+	0x00, 0x01, 0xc0, 0x03, 0x80, 0x38, 0xe0, 0x0e, 0x00, 0xe0, 0x00, 0x07, 0x03, 0x81, 0xc0, 0x03,
+	0x80, 0x38, 0xe3, 0x8e, 0x00, 0xe3, 0x80, 0x38, 0x00, 0x00, 0x07, 0xff, 0x8f, 0xff, 0x00, 0x7f,
+	0xc0, 0x1f, 0xfe, 0x07, 0xfc, 0x01, 0xc0, 0x00, 0x7f, 0xf8, 0xe0, 0x0e, 0x07, 0xfc, 0x00, 0x07,
+	0x03, 0x80, 0x38, 0x1f, 0xf0, 0x38, 0xe3, 0x8e, 0x00, 0xe0, 0x7f, 0xc0, 0x00, 0x00, 0x07, 0xff,
+	0x8f, 0xff, 0x00, 0x7f, 0xc0, 0x1f, 0xfe, 0x07, 0xfc, 0x01, 0xc0, 0x00, 0x7f, 0xf8, 0xe0, 0x0e,
+	0x07, 0xfc, 0x00, 0x07, 0x03, 0x80, 0x38, 0x1f, 0xf0, 0x38, 0xe3, 0x8e, 0x00, 0xe0, 0x7f, 0xc0,
+	0x00, 0x00, 0x07, 0xff, 0x8f, 0xff, 0x00, 0x7f, 0xc0, 0x1f, 0xfe, 0x07, 0xfc, 0x01, 0xc0, 0x00,
+	0x7f, 0xf8, 0xe0, 0x0e, 0x07, 0xfc, 0x00, 0x07, 0x03, 0x80, 0x38, 0x1f, 0xf0, 0x38, 0xe3, 0x8e,
+	0x00, 0xe0, 0x7f, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x38, 0x00, 0x00, 0x00, 0x00, 0x0e, 0x07, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x38, 0x00, 0x00, 0x00, 0x00, 0x0e, 0x07,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x38, 0x00, 0x00,
+	0x00, 0x00, 0x0e, 0x07, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x7f, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x01, 0xf8, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x7f, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x01, 0xf8, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x7f, 0xc0, 0x00, 0x00, 0x00, 0x00, 0x01, 0xf8,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0xf8, 0x03, 0x80, 0x3f, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1c, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01, 0xf8, 0x03,
+	0x80, 0x3f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x1c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x01, 0xf8, 0x03, 0x80, 0x3f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x1c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x0e, 0x00, 0x03, 0x80, 0x00, 0xe0, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1c, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0e, 0x00, 0x03, 0x80, 0x00, 0xe0, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x1c, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x0e, 0x00, 0x03,
+	0x80, 0x00, 0xe0, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xf0, 0x07, 0xff, 0x8f, 0xff, 0x00, 0x7f,
+	0xf8, 0xff, 0xf0, 0x38, 0x03, 0x8e, 0x00, 0xe3, 0x8e, 0x38, 0xe0, 0x0e, 0x38, 0x03, 0x8f, 0xff,
+	0xe0, 0x0e, 0x00, 0x03, 0x80, 0x00, 0xe0, 0x01, 0xf8, 0xe0, 0x00, 0x00, 0xff, 0xf0, 0x07, 0xff,
+	0x8f, 0xff, 0x00, 0x7f, 0xf8, 0xff, 0xf0, 0x38, 0x03, 0x8e, 0x00, 0xe3, 0x8e, 0x38, 0xe0, 0x0e,
+	0x38, 0x03, 0x8f, 0xff, 0xe0, 0x0e, 0x00, 0x03, 0x80, 0x00, 0xe0, 0x01, 0xf8, 0xe0, 0x00, 0x00,
+	0xff, 0xf0, 0x07, 0xff, 0x8f, 0xff, 0x00, 0x7f, 0xf8, 0xff, 0xf0, 0x38, 0x03, 0x8e, 0x00, 0xe3,
+	0x8e, 0x38, 0xe0, 0x0e, 0x38, 0x03, 0x8f, 0xff, 0xe0, 0x0e, 0x00, 0x03, 0x80, 0x00, 0xe0, 0x01,
+	0xf8, 0xe0, 0x00, 0x00, 0xe0, 0x0e, 0x38, 0x03, 0x8e, 0x00, 0xe3, 0x80, 0x00, 0x1c, 0x00, 0x38,
+	0x03, 0x8e, 0x00, 0xe3, 0x8e, 0x38, 0x1c, 0x70, 0x38, 0x03, 0x80, 0x07, 0x00, 0x70, 0x00, 0x03,
+	0x80, 0x00, 0x1c, 0x0e, 0x07, 0x00, 0x00, 0x00, 0xe0, 0x0e, 0x38, 0x03, 0x8e, 0x00, 0xe3, 0x80,
+	0x00, 0x1c, 0x00, 0x38, 0x03, 0x8e, 0x00, 0xe3, 0x8e, 0x38, 0x1c, 0x70, 0x38, 0x03, 0x80, 0x07,
+	0x00, 0x70, 0x00, 0x03, 0x80, 0x00, 0x1c, 0x0e, 0x07, 0x00, 0x00, 0x00, 0xe0, 0x0e, 0x38, 0x03,
+	0x8e, 0x00, 0xe3, 0x80, 0x00, 0x1c, 0x00, 0x38, 0x03, 0x8e, 0x00, 0xe3, 0x8e, 0x38, 0x1c, 0x70,
+	0x38, 0x03, 0x80, 0x07, 0x00, 0x70, 0x00, 0x03, 0x80, 0x00, 0x1c, 0x0e, 0x07, 0x00, 0x00, 0x00,
+	0xe0, 0x0e, 0x38, 0x03, 0x8e, 0x00, 0x00, 0x7f, 0xc0, 0x1c, 0x00, 0x38, 0x03, 0x8e, 0x00, 0xe3,
+	0x8e, 0x38, 0x03, 0x80, 0x38, 0x03, 0x80, 0x38, 0x00, 0x0e, 0x00, 0x03, 0x80, 0x00, 0xe0, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0xe0, 0x0e, 0x38, 0x03, 0x8e, 0x00, 0x00, 0x7f, 0xc0, 0x1c, 0x00, 0x38,
+	0x03, 0x8e, 0x00, 0xe3, 0x8e, 0x38, 0x03, 0x80, 0x38, 0x03, 0x80, 0x38, 0x00, 0x0e, 0x00, 0x03,
+	0x80, 0x00, 0xe0, 0x00, 0x00, 0x00, 0x00, 0x00, 0xe0, 0x0e, 0x38, 0x03, 0x8e, 0x00, 0x00, 0x7f,
+	0xc0, 0x1c, 0x00, 0x38, 0x03, 0x8e, 0x00, 0xe3, 0x8e, 0x38, 0x03, 0x80, 0x38, 0x03, 0x80, 0x38,
+	0x00, 0x0e, 0x00, 0x03, 0x80, 0x00, 0xe0, 0x00, 0x00, 0x00, 0x00, 0x00, 0xe0, 0x0e, 0x38, 0x03,
+	0x8e, 0x00, 0x00, 0x00, 0x38, 0x1c, 0x0e, 0x38, 0x03, 0x81, 0xc7, 0x03, 0x8e, 0x38, 0x1c, 0x70,
+	0x38, 0x03, 0x81, 0xc0, 0x00, 0x0e, 0x00, 0x03, 0x80, 0x00, 0xe0, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0xe0, 0x0e, 0x38, 0x03, 0x8e, 0x00, 0x00, 0x00, 0x38, 0x1c, 0x0e, 0x38, 0x03, 0x81, 0xc7, 0x03,
+	0x8e, 0x38, 0x1c, 0x70, 0x38, 0x03, 0x81, 0xc0, 0x00, 0x0e, 0x00, 0x03, 0x80, 0x00, 0xe0, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0xe0, 0x0e, 0x38, 0x03, 0x8e, 0x00, 0x00, 0x00, 0x38, 0x1c, 0x0e, 0x38,
+	0x03, 0x81, 0xc7, 0x03, 0x8e, 0x38, 0x1c, 0x70, 0x38, 0x03, 0x81, 0xc0, 0x00, 0x0e, 0x00, 0x03,
+	0x80, 0x00, 0xe0, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xf0, 0x07, 0xff, 0x8e, 0x00, 0x03, 0xff,
+	0xc0, 0x03, 0xf0, 0x07, 0xff, 0x80, 0x38, 0x00, 0x71, 0xc0, 0xe0, 0x0e, 0x07, 0xff, 0x8f, 0xff,
+	0xe0, 0x01, 0xf8, 0x03, 0x80, 0x3f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xff, 0xf0, 0x07, 0xff,
+	0x8e, 0x00, 0x03, 0xff, 0xc0, 0x03, 0xf0, 0x07, 0xff, 0x80, 0x38, 0x00, 0x71, 0xc0, 0xe0, 0x0e,
+	0x07, 0xff, 0x8f, 0xff, 0xe0, 0x01, 0xf8, 0x03, 0x80, 0x3f, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0xff, 0xf0, 0x07, 0xff, 0x8e, 0x00, 0x03, 0xff, 0xc0, 0x03, 0xf0, 0x07, 0xff, 0x80, 0x38, 0x00,
+	0x71, 0xc0, 0xe0, 0x0e, 0x07, 0xff, 0x8f, 0xff, 0xe0, 0x01, 0xf8, 0x03, 0x80, 0x3f, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0xe0, 0x00, 0x00, 0x03, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xe0, 0x00, 0x00, 0x03, 0x80, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x03, 0x80, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xe0, 0x00, 0x00, 0x03,
+	0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x03, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0xe0, 0x00, 0x00, 0x03, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x07, 0xfc, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0xe0, 0x00, 0x00, 0x03, 0x80, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x07, 0xfc, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0xe0, 0x00, 0x00, 0x03, 0x80, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x07, 0xfc, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+	0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00,
+};
+
+#endif // BAKED_FONT_H_INCLUDED
@@ -0,0 +1,605 @@
+#include "Broadcast.h"
+#include "Debugger.h"
+#include <stdio.h>
+#include <string.h>
+
+#ifdef __linux__
+#include <errno.h>
+#include <netinet/in.h>
+#include <netinet/tcp.h>
+#include <sys/epoll.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif // __linux__
+
+static const unsigned int s_kMaxEventsPerPoll = 256;
+
+//Helper functions
+//================================================================================
+
+static void WriteU8(std::vector<uint8_t>& out, unsigned int value)
+{
+	out.push_back((uint8_t)value);
+}
+
+static void WriteU16(std::vector<uint8_t>& out, unsigned int value)
+{
+	out.push_back((uint8_t)value);
+	out.push_back((uint8_t)(value >> 8));
+}
+
+static void WriteU32(std::vector<uint8_t>& out, uint32_t value)
+{
+	out.push_back((uint8_t)value);
+	out.push_back((uint8_t)(value >> 8));
+	out.push_back((uint8_t)(value >> 16));
+	out.push_back((uint8_t)(value >> 24));
+}
+
+static void PatchU32(uint8_t* data, uint32_t value)
+{
+	data[0] = (uint8_t)value;
+	data[1] = (uint8_t)(value >> 8);
+	data[2] = (uint8_t)(value >> 16);
+	data[3] = (uint8_t)(value >> 24);
+}
+
+static uint8_t GetGameState(const Game& game)
+{
+	if (game.IsPlaying())
+		return 1;
+	return game.IsGameOver() ? 2 : 0;
+}
+
+//================================================================================
+
+GameStateEncoder::GameStateEncoder(uint16_t gameIndex)
+	: m_gameIndex(gameIndex)
+	, m_fieldEncoder(Game::kFieldWidth, Game::kFieldHeight, 0)
+	, m_score(0)
+	, m_numLinesCleared(0)
+	, m_state(0)
+{
+	memset(&m_piece, 0, sizeof(m_piece));
+}
+
+unsigned int GameStateEncoder::EncodeDelta(const Game& game, std::vector<uint8_t>& out)
+{
+	unsigned int numRecords = 0;
+
+	const uint8_t state = GetGameState(game);
+	if (state != m_state)
+	{
+		m_state = state;
+		WriteState(out);
+		++numRecords;
+	}
+
+	// the server sends its own keyframes, so the field encoder only sends deltas
+	// after the first packet
+	const size_t recordBegin = out.size();
+	WriteRecordHeader(kBroadcastRecord_Field, out);
+	if (m_fieldEncoder.Encode(game.GetField(), out))
+		++numRecords;
+	else
+		out.resize(recordBegin);
+
+	const TetrominoInstance& piece = game.GetActiveTetromino();
+	if (piece.m_tetrominoType != m_piece.m_tetrominoType || piece.m_pos.x != m_piece.m_pos.x
+		|| piece.m_pos.y != m_piece.m_pos.y || piece.m_rot != m_piece.m_rot)
+	{
+		m_piece = piece;
+		WritePiece(out);
+		++numRecords;
+	}
+
+	if (game.GetScore() != m_score || game.GetNumLinesCleared() != m_numLinesCleared)
+	{
+		m_score = game.GetScore();
+		m_numLinesCleared = game.GetNumLinesCleared();
+		WriteScore(out);
+		++numRecords;
+	}
+
+	return numRecords;
+}
+
+void GameStateEncoder::EncodeKeyframe(std::vector<uint8_t>& out) const
+{
+	WriteState(out);
+	WriteRecordHeader(kBroadcastRecord_Field, out);
+	m_fieldEncoder.EncodeKeyframe(out);
+	WritePiece(out);
+	WriteScore(out);
+}
+
+void GameStateEncoder::WriteRecordHeader(BroadcastRecord record, std::vector<uint8_t>& out) const
+{
+	WriteU8(out, record);
+	WriteU16(out, m_gameIndex);
+}
+
+void GameStateEncoder::WritePiece(std::vector<uint8_t>& out) const
+{
+	WriteRecordHeader(kBroadcastRecord_Piece, out);
+	WriteU8(out, m_piece.m_tetrominoType);
+	WriteU8(out, (uint8_t)(int8_t)m_piece.m_pos.x);
+	WriteU8(out, (uint8_t)(int8_t)m_piece.m_pos.y);
+	WriteU8(out, m_piece.m_rot);
+}
+
+void GameStateEncoder::WriteScore(std::vector<uint8_t>& out) const
+{
+	WriteRecordHeader(kBroadcastRecord_Score, out);
+	WriteU32(out, m_score);
+	WriteU32(out, m_numLinesCleared);
+}
+
+void GameStateEncoder::WriteState(std::vector<uint8_t>& out) const
+{
+	WriteRecordHeader(kBroadcastRecord_State, out);
+	WriteU8(out, m_state);
+}
+
+//================================================================================
+
+BroadcastServer::BroadcastServer()
+	: m_listenSocket(-1)
+	, m_epoll(-1)
+	, m_port(0)
+	, m_tick(0)
+	, m_keyframe(0)
+{
+	memset(&m_stats, 0, sizeof(m_stats));
+}
+
+BroadcastServer::~BroadcastServer()
+{
+	Close();
+	for (size_t i = 0; i < m_freeMessages.size(); ++i)
+	{
+		delete m_freeMessages[i];
+	}
+}
+
+void BroadcastServer::AddGame(const Game* game)
+{
+	HP_ASSERT(m_games.size() < 0xffff);
+	m_encoders.push_back(GameStateEncoder((uint16_t)m_games.size()));
+	m_games.push_back(game);
+}
+
+size_t BroadcastServer::GetBytesPerClient()
+{
+	return sizeof(Client) + sizeof(Client*);
+}
+
+void BroadcastServer::PrintStats() const
+{
+	printf("Broadcast stats:\n");
+	printf("  %-22s %14u\n", "Clients now", GetNumClients());
+	printf("  %-22s %14u\n", "Clients accepted", m_stats.clientsAccepted);
+	printf("  %-22s %14u\n", "Clients disconnected", m_stats.clientsDisconnected);
+	printf("  %-22s %14u\n", "Delta messages", m_stats.deltaMessages);
+	printf("  %-22s %14u\n", "Keyframes sent", m_stats.keyframeMessages);
+	printf("  %-22s %14u\n", "Resyncs", m_stats.resyncs);
+	printf("  %-22s %14llu\n", "Bytes queued", (unsigned long long)m_stats.bytesQueued);
+	printf("  %-22s %14llu\n", "Bytes sent", (unsigned long long)m_stats.bytesSent);
+	printf("  %-22s %14u\n", "Send calls", m_stats.sendCalls);
+	printf("  %-22s %14zu\n", "Bytes per client", GetBytesPerClient());
+}
+
+BroadcastServer::Message* BroadcastServer::AllocateMessage(BroadcastMessageKind kind)
+{
+	Message* message;
+	if (!m_freeMessages.empty())
+	{
+		message = m_freeMessages.back();
+		m_freeMessages.pop_back();
+		message->bytes.clear();
+	}
+	else
+	{
+		message = new Message();
+	}
+	message->refCount = 1;
+
+	WriteU32(message->bytes, 0); // patched by FinishMessage
+	WriteU32(message->bytes, m_tick);
+	WriteU8(message->bytes, kind);
+	return message;
+}
+
+void BroadcastServer::FinishMessage(Message* message)
+{
+	PatchU32(message->bytes.data(), (uint32_t)(message->bytes.size() - 4));
+}
+
+void BroadcastServer::ReleaseMessage(Message* message)
+{
+	HP_ASSERT(message->refCount > 0);
+	if (--message->refCount == 0)
+	{
+		m_freeMessages.push_back(message);
+	}
+}
+
+BroadcastServer::Message* BroadcastServer::GetKeyframe()
+{
+	if (!m_keyframe)
+	{
+		m_keyframe = AllocateMessage(kBroadcastMessageKind_Keyframe);
+		for (size_t i = 0; i < m_encoders.size(); ++i)
+		{
+			m_encoders[i].EncodeKeyframe(m_keyframe->bytes);
+		}
+		FinishMessage(m_keyframe);
+	}
+	return m_keyframe;
+}
+
+void BroadcastServer::Enqueue(Client& client, Message* message)
+{
+	// deltas are no use until the client has a keyframe to apply them to
+	if (client.needsKeyframe)
+		return;
+
+	if (client.numQueued == kMaxQueuedMessages)
+	{
+		// Too far behind. Drop the backlog, apart from a message that is half
+		// sent, and send a keyframe once the socket drains.
+		const unsigned int numKept = client.sentBytes > 0 ? 1 : 0;
+		for (unsigned int i = numKept; i < client.numQueued; ++i)
+		{
+			ReleaseMessage(client.queue[(client.firstQueued + i) % kMaxQueuedMessages]);
+		}
+		client.numQueued = numKept;
+		client.needsKeyframe = true;
+		++m_stats.resyncs;
+		return;
+	}
+
+	++message->refCount;
+	client.queue[(client.firstQueued + client.numQueued) % kMaxQueuedMessages] = message;
+	++client.numQueued;
+	m_stats.bytesQueued += message->bytes.size();
+}
+
+#ifdef __linux__
+
+bool BroadcastServer::Open(uint16_t port)
+{
+	HP_ASSERT(m_listenSocket < 0);
+
+	m_listenSocket = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
+	if (m_listenSocket < 0)
+	{
+		fprintf(stderr, "ERROR - Failed to create broadcast socket\n");
+		return false;
+	}
+
+	const int reuse = 1;
+	setsockopt(m_listenSocket, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof(reuse));
+
+	sockaddr_in address;
+	memset(&address, 0, sizeof(address));
+	address.sin_family = AF_INET;
+	address.sin_addr.s_addr = htonl(INADDR_ANY);
+	address.sin_port = htons(port);
+	if (bind(m_listenSocket, (const sockaddr*)&address, sizeof(address)) != 0 || listen(m_listenSocket, SOMAXCONN) != 0)
+	{
+		fprintf(stderr, "ERROR - Failed to listen for broadcast viewers on port %u\n", port);
+		Close();
+		return false;
+	}
+
+	socklen_t addressSize = sizeof(address);
+	getsockname(m_listenSocket, (sockaddr*)&address, &addressSize);
+	m_port = ntohs(address.sin_port);
+
+	m_epoll = epoll_create1(0);
+	epoll_event event;
+	memset(&event, 0, sizeof(event));
+	event.events = EPOLLIN;
+	event.data.ptr = nullptr;
+	if (m_epoll < 0 || epoll_ctl(m_epoll, EPOLL_CTL_ADD, m_listenSocket, &event) != 0)
+	{
+		fprintf(stderr, "ERROR - Failed to create epoll instance\n");
+		Close();
+		return false;
+	}
+
+	printf("Broadcasting %zu games on port %u\n", m_games.size(), m_port);
+	return true;
+}
+
+void BroadcastServer::Close()
+{
+	while (!m_clients.empty())
+	{
+		Disconnect(m_clients.back());
+	}
+	FreeDisconnectedClients();
+	if (m_keyframe)
+	{
+		ReleaseMessage(m_keyframe);
+		m_keyframe = 0;
+	}
+	if (m_epoll >= 0)
+	{
+		close(m_epoll);
+		m_epoll = -1;
+	}
+	if (m_listenSocket >= 0)
+	{
+		close(m_listenSocket);
+		m_listenSocket = -1;
+	}
+	m_port = 0;
+}
+
+void BroadcastServer::Tick()
+{
+	HP_PROFILE_SCOPE("BroadcastServer::Tick");
+
+	++m_tick;
+
+	Message* delta = AllocateMessage(kBroadcastMessageKind_Delta);
+	unsigned int numRecords = 0;
+	for (size_t i = 0; i < m_games.size(); ++i)
+	{
+		numRecords += m_encoders[i].EncodeDelta(*m_games[i], delta->bytes);
+	}
+
+	// the encoders have moved on, so anyone joining from now needs a new keyframe
+	if (m_keyframe)
+	{
+		ReleaseMessage(m_keyframe);
+		m_keyframe = 0;
+	}
+
+	if (numRecords > 0)
+	{
+		FinishMessage(delta);
+		++m_stats.deltaMessages;
+		for (size_t i = 0; i < m_clients.size(); ++i)
+		{
+			Enqueue(*m_clients[i], delta);
+		}
+
+		// backwards, as a failed flush removes the client
+		for (size_t i = m_clients.size(); i > 0; --i)
+		{
+			Flush(*m_clients[i - 1]);
+		}
+	}
+	ReleaseMessage(delta);
+	FreeDisconnectedClients();
+}
+
+void BroadcastServer::Poll(int timeoutMs)
+{
+	HP_PROFILE_SCOPE("BroadcastServer::Poll");
+
+	if (m_epoll < 0)
+		return;
+
+	epoll_event events[s_kMaxEventsPerPoll];
+	const int numEvents = epoll_wait(m_epoll, events, s_kMaxEventsPerPoll, timeoutMs);
+
+	for (int i = 0; i < numEvents; ++i)
+	{
+		const epoll_event& event = events[i];
+		if (!event.data.ptr)
+		{
+			AcceptClients();
+			continue;
+		}
+
+		Client* client = (Client*)event.data.ptr;
+		if (client->socket < 0)
+			continue;
+
+		if (event.events & (EPOLLERR | EPOLLHUP | EPOLLRDHUP))
+		{
+			Disconnect(client);
+			continue;
+		}
+
+		if (event.events & EPOLLIN)
+		{
+			ReadAndDiscard(*client);
+		}
+		if (client->socket >= 0 && (event.events & EPOLLOUT))
+		{
+			client->writable = true;
+			Flush(*client);
+		}
+	}
+
+	// only now, as later events in the batch may still point at them
+	FreeDisconnectedClients();
+}
+
+void BroadcastServer::AcceptClients()
+{
+	for (;;)
+	{
+		const int socket = accept4(m_listenSocket, nullptr, nullptr, SOCK_NONBLOCK);
+		if (socket < 0)
+		{
+			if (errno != EAGAIN && errno != EWOULDBLOCK && errno != EINTR)
+			{
+				fprintf(stderr, "Broadcast accept failed: %s\n", strerror(errno));
+			}
+			return;
+		}
+
+		// deltas are small and latency matters more than packet count
+		const int noDelay = 1;
+		setsockopt(socket, IPPROTO_TCP, TCP_NODELAY, &noDelay, sizeof(noDelay));
+
+		Client* client = new Client();
+		client->socket = socket;
+		client->index = (unsigned int)m_clients.size();
+		client->needsKeyframe = true;
+		client->writable = true;
+		client->firstQueued = 0;
+		client->numQueued = 0;
+		client->sentBytes = 0;
+
+		epoll_event event;
+		memset(&event, 0, sizeof(event));
+		event.events = EPOLLIN | EPOLLOUT | EPOLLRDHUP | EPOLLET;
+		event.data.ptr = client;
+		if (epoll_ctl(m_epoll, EPOLL_CTL_ADD, socket, &event) != 0)
+		{
+			close(socket);
+			delete client;
+			continue;
+		}
+
+		m_clients.push_back(client);
+		++m_stats.clientsAccepted;
+		Flush(*client);
+	}
+}
+
+void BroadcastServer::Disconnect(Client* client)
+{
+	HP_ASSERT(client->socket >= 0);
+
+	close(client->socket);
+	client->socket = -1;
+
+	for (unsigned int i = 0; i < client->numQueued; ++i)
+	{
+		ReleaseMessage(client->queue[(client->firstQueued + i) % kMaxQueuedMessages]);
+	}
+	client->numQueued = 0;
+
+	m_clients[client->index] = m_clients.back();
+	m_clients[client->index]->index = client->index;
+	m_clients.pop_back();
+	m_disconnectedClients.push_back(client);
+	++m_stats.clientsDisconnected;
+}
+
+void BroadcastServer::FreeDisconnectedClients()
+{
+	for (size_t i = 0; i < m_disconnectedClients.size(); ++i)
+	{
+		delete m_disconnectedClients[i];
+	}
+	m_disconnectedClients.clear();
+}
+
+bool BroadcastServer::Flush(Client& client)
+{
+	for (;;)
+	{
+		// only once the socket has drained, or a stalled client would keep taking keyframes
+		if (client.numQueued == 0 && client.needsKeyframe && client.writable)
+		{
+			client.needsKeyframe = false;
+			Enqueue(client, GetKeyframe());
+			++m_stats.keyframeMessages;
+		}
+		if (client.numQueued == 0 || !client.writable)
+			return true;
+
+		// everything queued in one call, each iovec pointing at a shared message
+		iovec iovecs[kMaxQueuedMessages];
+		for (unsigned int i = 0; i < client.numQueued; ++i)
+		{
+			const Message* message = client.queue[(client.firstQueued + i) % kMaxQueuedMessages];
+			const unsigned int offset = i == 0 ? client.sentBytes : 0;
+			iovecs[i].iov_base = (void*)(message->bytes.data() + offset);
+			iovecs[i].iov_len = message->bytes.size() - offset;
+		}
+
+		msghdr header;
+		memset(&header, 0, sizeof(header));
+		header.msg_iov = iovecs;
+		header.msg_iovlen = client.numQueued;
+		const ssize_t numSent = sendmsg(client.socket, &header, MSG_NOSIGNAL | MSG_DONTWAIT);
+		++m_stats.sendCalls;
+		if (numSent < 0)
+		{
+			if (errno == EAGAIN || errno == EWOULDBLOCK)
+			{
+				// edge triggered, EPOLLOUT says when there is room again
+				client.writable = false;
+				return true;
+			}
+			if (errno == EINTR)
+				continue;
+
+			Disconnect(&client);
+			return false;
+		}
+
+		m_stats.bytesSent += (uint64_t)numSent;
+		size_t remaining = (size_t)numSent;
+		while (remaining > 0)
+		{
+			Message* message = client.queue[client.firstQueued];
+			const size_t messageRemaining = message->bytes.size() - client.sentBytes;
+			if (remaining < messageRemaining)
+			{
+				client.sentBytes += (unsigned int)remaining;
+				break;
+			}
+
+			remaining -= messageRemaining;
+			ReleaseMessage(message);
+			client.firstQueued = (client.firstQueued + 1) % kMaxQueuedMessages;
+			--client.numQueued;
+			client.sentBytes = 0;
+		}
+	}
+}
+
+void BroadcastServer::ReadAndDiscard(Client& client)
+{
+	// viewers have nothing to say, this is only here to notice them leaving
+	uint8_t buffer[256];
+	for (;;)
+	{
+		const ssize_t numRead = read(client.socket, buffer, sizeof(buffer));
+		if (numRead > 0)
+			continue;
+		if (numRead < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+			return;
+		if (numRead < 0 && errno == EINTR)
+			continue;
+
+		Disconnect(&client);
+		return;
+	}
+}
+
+#else // __linux__
+
+bool BroadcastServer::Open(uint16_t port)
+{
+	HP_UNUSED(port);
+	fprintf(stderr, "ERROR - Broadcasting needs epoll, which is Linux only\n");
+	return false;
+}
+
+void BroadcastServer::Close()
+{
+}
+
+void BroadcastServer::Tick()
+{
+}
+
+void BroadcastServer::Poll(int timeoutMs)
+{
+	HP_UNUSED(timeoutMs);
+}
+
+#endif // __linux__
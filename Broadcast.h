@@ -0,0 +1,168 @@
+#pragma once
+#ifndef BROADCAST_H_INCLUDED
+#define BROADCAST_H_INCLUDED
+
+#include "FieldCodec.h"
+#include "Game.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+// Wire format, all little endian. Each message is
+//   u32 bodyBytes, u32 tick, u8 BroadcastMessageKind, records...
+// and each record is
+//   u8 BroadcastRecord, u16 game, payload
+// A viewer starts from a keyframe, which has every record for every game, and
+// applies the deltas that follow it in order.
+enum BroadcastMessageKind
+{
+	kBroadcastMessageKind_Delta = 0,
+	kBroadcastMessageKind_Keyframe,
+	kNumBroadcastMessageKinds
+};
+
+enum BroadcastRecord
+{
+	// u8 TetrominoType, i8 x, i8 y, u8 rot
+	kBroadcastRecord_Piece = 0,
+	// one FieldCodec packet, a keyframe in keyframe messages and usually a
+	// delta otherwise
+	kBroadcastRecord_Field,
+	// u32 score, u32 lines cleared
+	kBroadcastRecord_Score,
+	// u8 0 title screen, 1 playing, 2 game over
+	kBroadcastRecord_State,
+	kNumBroadcastRecords
+};
+
+static const unsigned int kBroadcastMessageHeaderBytes = 9;
+
+// Remembers what was last sent for one game and writes records for whatever
+// has changed since.
+class GameStateEncoder
+{
+public:
+	explicit GameStateEncoder(uint16_t gameIndex);
+
+	// appends records for changes since the last call, returns how many
+	unsigned int EncodeDelta(const Game& game, std::vector<uint8_t>& out);
+	// appends the full state without changing what counts as sent
+	void EncodeKeyframe(std::vector<uint8_t>& out) const;
+
+private:
+	void WritePiece(std::vector<uint8_t>& out) const;
+	void WriteScore(std::vector<uint8_t>& out) const;
+	void WriteState(std::vector<uint8_t>& out) const;
+	void WriteRecordHeader(BroadcastRecord record, std::vector<uint8_t>& out) const;
+
+	uint16_t m_gameIndex;
+	FieldEncoder m_fieldEncoder;
+	TetrominoInstance m_piece;
+	unsigned int m_score;
+	unsigned int m_numLinesCleared;
+	uint8_t m_state;
+};
+
+struct BroadcastStats
+{
+	unsigned int clientsAccepted;
+	unsigned int clientsDisconnected;
+	unsigned int deltaMessages;
+	unsigned int keyframeMessages;
+	// clients whose queue filled up, so their deltas were dropped and a keyframe sent instead
+	unsigned int resyncs;
+	// bytes handed to clients, counting a shared message once per client
+	uint64_t bytesQueued;
+	uint64_t bytesSent;
+	unsigned int sendCalls;
+};
+
+// Streams the state of running games to any number of TCP viewers. Each tick
+// the changes to every game are encoded once into a single reference counted
+// message, and every client's queue points at that same buffer, so fan-out
+// costs a pointer per client and one writev when the socket has room. A
+// client that falls a whole queue behind loses its backlog and is sent a
+// fresh keyframe once its socket drains, so slow viewers cost a bounded
+// amount of memory and never hold up the others.
+//
+// Uses epoll, so it only runs on Linux. Elsewhere Open fails.
+class BroadcastServer
+{
+public:
+	BroadcastServer();
+	~BroadcastServer();
+
+	bool Open(uint16_t port);
+	void Close();
+	uint16_t GetPort() const { return m_port; }
+
+	// the game must outlive the server
+	void AddGame(const Game* game);
+
+	// encodes what changed since the last tick and queues it for every client
+	void Tick();
+	// waits up to timeoutMs for socket events and services them, 0 doesn't wait
+	void Poll(int timeoutMs);
+
+	unsigned int GetNumClients() const { return (unsigned int)m_clients.size(); }
+	const BroadcastStats& GetStats() const { return m_stats; }
+	// server side memory held for each connection, not counting kernel socket buffers
+	static size_t GetBytesPerClient();
+	void PrintStats() const;
+
+private:
+	static const unsigned int kMaxQueuedMessages = 32;
+
+	struct Message
+	{
+		unsigned int refCount;
+		std::vector<uint8_t> bytes;
+	};
+
+	struct Client
+	{
+		int socket;
+		unsigned int index;
+		bool needsKeyframe;
+		bool writable;
+		unsigned int firstQueued;
+		unsigned int numQueued;
+		// bytes of the first queued message already sent
+		unsigned int sentBytes;
+		Message* queue[kMaxQueuedMessages];
+	};
+
+	BroadcastServer(const BroadcastServer&);
+	BroadcastServer& operator=(const BroadcastServer&);
+
+	Message* AllocateMessage(BroadcastMessageKind kind);
+	void FinishMessage(Message* message);
+	void ReleaseMessage(Message* message);
+	Message* GetKeyframe();
+
+	void AcceptClients();
+	// closes the socket now, the client is freed by FreeDisconnectedClients
+	void Disconnect(Client* client);
+	void FreeDisconnectedClients();
+	void Enqueue(Client& client, Message* message);
+	// returns false if the client was disconnected
+	bool Flush(Client& client);
+	void ReadAndDiscard(Client& client);
+
+	int m_listenSocket;
+	int m_epoll;
+	uint16_t m_port;
+	uint32_t m_tick;
+
+	std::vector<const Game*> m_games;
+	std::vector<GameStateEncoder> m_encoders;
+	std::vector<Client*> m_clients;
+	std::vector<Client*> m_disconnectedClients;
+	std::vector<Message*> m_freeMessages;
+	// keyframe of the state after the latest tick, shared by everyone joining before the next
+	Message* m_keyframe;
+
+	BroadcastStats m_stats;
+};
+
+#endif // BROADCAST_H_INCLUDED
@@ -32,4 +32,20 @@
 	fprintf( stderr, "FATAL ERROR: %s\nFile:\t%s\nLine:\t%d\n\n", #message, __FILE__, __LINE__ ); \
 	HP_BREAK
 
+// Scoped profile zones. Compiled out entirely with HP_PROFILE_ENABLED=0, and
+// otherwise a single relaxed load until Profiler::SetEnabled(true) is called.
+#ifndef HP_PROFILE_ENABLED
+#define HP_PROFILE_ENABLED 1
+#endif
+
+#if HP_PROFILE_ENABLED
+#include "Profiler.h"
+#define HP_PROFILE_CONCAT_INNER(A, B)	A##B
+#define HP_PROFILE_CONCAT(A, B)	HP_PROFILE_CONCAT_INNER(A, B)
+#define HP_PROFILE_SCOPE( name ) \
+	ProfileScope HP_PROFILE_CONCAT(hpProfileScope, __LINE__)( name )
+#else
+#define HP_PROFILE_SCOPE( name )
+#endif
+
 #endif // DEBUG_H
\ No newline at end of file
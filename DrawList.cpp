@@ -0,0 +1,495 @@
+#include "DrawList.h"
+#include "Debugger.h"
+#include <stdio.h>
+#include <string.h>
+
+// Each command is a one byte DrawCommand followed by its payload, plus the
+// characters or colours for the variable length ones. Payloads are unaligned
+// in the buffer so they are always copied in and out with memcpy.
+
+struct DrawRectPayload
+{
+	int32_t x;
+	int32_t y;
+	int32_t w;
+	int32_t h;
+	uint32_t rgba;
+};
+
+struct DrawTextPayload
+{
+	int32_t x;
+	int32_t y;
+	uint32_t rgba;
+	uint32_t length;
+};
+
+struct BatchSpritePayload
+{
+	TextureHandle atlas;
+	uint32_t spriteIndex;
+	int32_t x;
+	int32_t y;
+};
+
+struct CacheTextPayload
+{
+	TextHandle handle;
+	uint32_t rgba;
+	uint32_t length;
+};
+
+struct DrawCachedTextPayload
+{
+	TextHandle handle;
+	int32_t x;
+	int32_t y;
+};
+
+struct CreateRenderTargetPayload
+{
+	TextureHandle handle;
+	uint32_t width;
+	uint32_t height;
+};
+
+struct DrawTexturePayload
+{
+	TextureHandle handle;
+	int32_t x;
+	int32_t y;
+};
+
+struct CreateBlockAtlasPayload
+{
+	TextureHandle handle;
+	uint32_t numSprites;
+	uint32_t spriteSizePixels;
+};
+
+//Helper functions
+static uint64_t HashBytes(const uint8_t* data, size_t numBytes)
+{
+	// FNV-1a
+	uint64_t hash = 14695981039346656037ull;
+	for (size_t i = 0; i < numBytes; ++i)
+	{
+		hash ^= data[i];
+		hash *= 1099511628211ull;
+	}
+	return hash;
+}
+
+class DrawListReader
+{
+public:
+	DrawListReader(const std::vector<uint8_t>& commands)
+		: m_cursor(commands.data())
+		, m_end(commands.data() + commands.size())
+	{
+	}
+
+	bool IsDone() const { return m_cursor >= m_end; }
+
+	DrawCommand ReadCommand()
+	{
+		return (DrawCommand)*m_cursor++;
+	}
+
+	template <typename T>
+	void Read(T& payload)
+	{
+		Read(&payload, sizeof(payload));
+	}
+
+	void Read(void* data, size_t numBytes)
+	{
+		HP_ASSERT(m_cursor + numBytes <= m_end);
+		memcpy(data, m_cursor, numBytes);
+		m_cursor += numBytes;
+	}
+
+	// returns the next numBytes in place, valid as long as the list is
+	const uint8_t* Skip(size_t numBytes)
+	{
+		HP_ASSERT(m_cursor + numBytes <= m_end);
+		const uint8_t* data = m_cursor;
+		m_cursor += numBytes;
+		return data;
+	}
+
+private:
+	const uint8_t* m_cursor;
+	const uint8_t* m_end;
+};
+
+//================================================================================
+
+DrawList::DrawList(unsigned int Width, unsigned int Height, bool supportsRenderTargets)
+	: Renderer(Width, Height)
+	, m_NumBatched(0)
+	, m_Hash(0)
+	, m_SupportsRenderTargets(supportsRenderTargets)
+{
+	m_Commands.reserve(16 * 1024);
+}
+
+DrawList::~DrawList()
+{
+}
+
+void DrawList::Reset()
+{
+	m_Commands.clear();
+	m_NumBatched = 0;
+}
+
+void DrawList::Write(DrawCommand command, const void* payload, size_t payloadBytes)
+{
+	m_Commands.push_back((uint8_t)command);
+	WriteBytes(payload, payloadBytes);
+}
+
+void DrawList::WriteBytes(const void* data, size_t numBytes)
+{
+	const uint8_t* bytes = (const uint8_t*)data;
+	m_Commands.insert(m_Commands.end(), bytes, bytes + numBytes);
+}
+
+void DrawList::Clear()
+{
+	m_Commands.push_back((uint8_t)kDrawCommand_Clear);
+}
+
+void DrawList::Present()
+{
+	FlushBatch();
+	m_Hash = HashBytes(m_Commands.data(), m_Commands.size());
+	EndFrame();
+}
+
+void DrawList::DrawRect(int x, int y, int w, int h, uint32_t rgba)
+{
+	FlushBatch();
+	DrawRectPayload payload = { x, y, w, h, rgba };
+	Write(kDrawCommand_DrawRect, &payload, sizeof(payload));
+}
+
+void DrawList::DrawSolidRect(int x, int y, int w, int h, uint32_t rgba)
+{
+	FlushBatch();
+	DrawRectPayload payload = { x, y, w, h, rgba };
+	Write(kDrawCommand_DrawSolidRect, &payload, sizeof(payload));
+}
+
+void DrawList::DrawText(const char* text, int x, int y, uint32_t rgba)
+{
+	HP_ASSERT(text);
+
+	FlushBatch();
+	DrawTextPayload payload = { x, y, rgba, (uint32_t)strlen(text) };
+	Write(kDrawCommand_DrawText, &payload, sizeof(payload));
+	WriteBytes(text, payload.length);
+}
+
+bool DrawList::ReadPixels(uint32_t* pixels)
+{
+	HP_UNUSED(pixels);
+	return false;
+}
+
+void DrawList::BatchRect(int x, int y, int w, int h, uint32_t rgba)
+{
+	DrawRectPayload payload = { x, y, w, h, rgba };
+	Write(kDrawCommand_BatchRect, &payload, sizeof(payload));
+	++m_NumBatched;
+}
+
+void DrawList::BatchSolidRect(int x, int y, int w, int h, uint32_t rgba)
+{
+	DrawRectPayload payload = { x, y, w, h, rgba };
+	Write(kDrawCommand_BatchSolidRect, &payload, sizeof(payload));
+	++m_NumBatched;
+}
+
+void DrawList::BatchSprite(TextureHandle atlas, unsigned int spriteIndex, int x, int y)
+{
+	BatchSpritePayload payload = { atlas, spriteIndex, x, y };
+	Write(kDrawCommand_BatchSprite, &payload, sizeof(payload));
+	++m_NumBatched;
+}
+
+// only recorded when something is batched, so redundant flushes cost nothing
+void DrawList::FlushBatch()
+{
+	if (m_NumBatched == 0)
+		return;
+
+	m_Commands.push_back((uint8_t)kDrawCommand_FlushBatch);
+	m_NumBatched = 0;
+}
+
+TextHandle DrawList::CacheText(const char* text, uint32_t rgba)
+{
+	HP_ASSERT(text);
+
+	unsigned int slot;
+	CacheTextPayload payload = { AllocateCachedText(slot), rgba, (uint32_t)strlen(text) };
+	Write(kDrawCommand_CacheText, &payload, sizeof(payload));
+	WriteBytes(text, payload.length);
+	return payload.handle;
+}
+
+bool DrawList::DrawCachedText(TextHandle handle, int x, int y)
+{
+	unsigned int slot;
+	if (!FindCachedText(handle, slot))
+		return false;
+
+	FlushBatch();
+	DrawCachedTextPayload payload = { handle, x, y };
+	Write(kDrawCommand_DrawCachedText, &payload, sizeof(payload));
+	return true;
+}
+
+TextureHandle DrawList::AllocateTexture()
+{
+	// reuse a released slot before growing the table
+	for (size_t i = 0; i < m_LiveTextures.size(); ++i)
+	{
+		if (!m_LiveTextures[i])
+		{
+			m_LiveTextures[i] = true;
+			return (TextureHandle)i + 1;
+		}
+	}
+
+	m_LiveTextures.push_back(true);
+	return (TextureHandle)m_LiveTextures.size();
+}
+
+TextureHandle DrawList::CreateRenderTarget(unsigned int width, unsigned int height)
+{
+	if (!m_SupportsRenderTargets)
+		return 0;
+
+	CreateRenderTargetPayload payload = { AllocateTexture(), width, height };
+	Write(kDrawCommand_CreateRenderTarget, &payload, sizeof(payload));
+	return payload.handle;
+}
+
+void DrawList::DestroyTexture(TextureHandle handle)
+{
+	if (handle == 0 || handle > m_LiveTextures.size() || !m_LiveTextures[handle - 1])
+		return;
+
+	FlushBatch();
+	m_LiveTextures[handle - 1] = false;
+	Write(kDrawCommand_DestroyTexture, &handle, sizeof(handle));
+}
+
+void DrawList::SetRenderTarget(TextureHandle handle)
+{
+	FlushBatch();
+	Write(kDrawCommand_SetRenderTarget, &handle, sizeof(handle));
+}
+
+void DrawList::DrawTexture(TextureHandle handle, int x, int y)
+{
+	FlushBatch();
+	DrawTexturePayload payload = { handle, x, y };
+	Write(kDrawCommand_DrawTexture, &payload, sizeof(payload));
+}
+
+TextureHandle DrawList::CreateBlockAtlas(const uint32_t* rgbas, unsigned int numSprites, unsigned int spriteSizePixels)
+{
+	HP_ASSERT(rgbas && numSprites > 0 && spriteSizePixels > 0);
+
+	CreateBlockAtlasPayload payload = { AllocateTexture(), numSprites, spriteSizePixels };
+	Write(kDrawCommand_CreateBlockAtlas, &payload, sizeof(payload));
+	WriteBytes(rgbas, numSprites * sizeof(uint32_t));
+	return payload.handle;
+}
+
+void DrawList::SubmitRects(const RenderRect* rects, unsigned int numRects, uint32_t rgba, bool solid)
+{
+	HP_UNUSED(rects);
+	HP_UNUSED(numRects);
+	HP_UNUSED(rgba);
+	HP_UNUSED(solid);
+	HP_FATAL_ERROR("DrawList batches are never flushed locally");
+}
+
+void DrawList::SubmitSprites(TextureHandle atlas, const SpriteInstance* sprites, unsigned int numSprites)
+{
+	HP_UNUSED(atlas);
+	HP_UNUSED(sprites);
+	HP_UNUSED(numSprites);
+	HP_FATAL_ERROR("DrawList batches are never flushed locally");
+}
+
+//================================================================================
+
+DrawListPlayer::DrawListPlayer(Renderer& backend)
+	: m_Backend(backend)
+	, m_LastHash(0)
+	, m_HasLastHash(false)
+	, m_FramesSkipped(0)
+{
+	CachedText empty = { 0, 0, 0, std::string() };
+	m_CachedTexts.resize(DrawList::kNumCachedTexts, empty);
+}
+
+DrawListPlayer::~DrawListPlayer()
+{
+	for (size_t i = 0; i < m_Textures.size(); ++i)
+	{
+		m_Backend.DestroyTexture(m_Textures[i]);
+	}
+}
+
+TextureHandle DrawListPlayer::FindTexture(TextureHandle listHandle) const
+{
+	if (listHandle == 0 || listHandle > m_Textures.size())
+		return 0;
+	return m_Textures[listHandle - 1];
+}
+
+bool DrawListPlayer::Submit(const DrawList& list, bool allowSkip)
+{
+	HP_PROFILE_SCOPE("DrawListPlayer::Submit");
+
+	if (allowSkip && m_HasLastHash && list.m_Hash == m_LastHash && m_Backend.IsFrameRetainedAfterPresent())
+	{
+		++m_FramesSkipped;
+		return false;
+	}
+	m_LastHash = list.m_Hash;
+	m_HasLastHash = true;
+
+	DrawListReader reader(list.m_Commands);
+	while (!reader.IsDone())
+	{
+		const DrawCommand command = reader.ReadCommand();
+		switch (command)
+		{
+		case kDrawCommand_Clear:
+			m_Backend.Clear();
+			break;
+		case kDrawCommand_DrawRect:
+		case kDrawCommand_DrawSolidRect:
+		case kDrawCommand_BatchRect:
+		case kDrawCommand_BatchSolidRect:
+		{
+			DrawRectPayload payload;
+			reader.Read(payload);
+			if (command == kDrawCommand_DrawRect)
+				m_Backend.DrawRect(payload.x, payload.y, payload.w, payload.h, payload.rgba);
+			else if (command == kDrawCommand_DrawSolidRect)
+				m_Backend.DrawSolidRect(payload.x, payload.y, payload.w, payload.h, payload.rgba);
+			else if (command == kDrawCommand_BatchRect)
+				m_Backend.BatchRect(payload.x, payload.y, payload.w, payload.h, payload.rgba);
+			else
+				m_Backend.BatchSolidRect(payload.x, payload.y, payload.w, payload.h, payload.rgba);
+			break;
+		}
+		case kDrawCommand_DrawText:
+		{
+			DrawTextPayload payload;
+			reader.Read(payload);
+			m_Text.assign((const char*)reader.Skip(payload.length), payload.length);
+			m_Backend.DrawText(m_Text.c_str(), payload.x, payload.y, payload.rgba);
+			break;
+		}
+		case kDrawCommand_BatchSprite:
+		{
+			BatchSpritePayload payload;
+			reader.Read(payload);
+			m_Backend.BatchSprite(FindTexture(payload.atlas), payload.spriteIndex, payload.x, payload.y);
+			break;
+		}
+		case kDrawCommand_FlushBatch:
+			m_Backend.FlushBatch();
+			break;
+		case kDrawCommand_CacheText:
+		{
+			CacheTextPayload payload;
+			reader.Read(payload);
+			const unsigned int slot = (payload.handle & 0xff) - 1;
+			HP_ASSERT(slot < m_CachedTexts.size());
+			CachedText& cachedText = m_CachedTexts[slot];
+			cachedText.listHandle = payload.handle;
+			cachedText.rgba = payload.rgba;
+			cachedText.text.assign((const char*)reader.Skip(payload.length), payload.length);
+			cachedText.backendHandle = m_Backend.CacheText(cachedText.text.c_str(), cachedText.rgba);
+			break;
+		}
+		case kDrawCommand_DrawCachedText:
+		{
+			DrawCachedTextPayload payload;
+			reader.Read(payload);
+			const unsigned int slot = (payload.handle & 0xff) - 1;
+			HP_ASSERT(slot < m_CachedTexts.size());
+			CachedText& cachedText = m_CachedTexts[slot];
+			if (cachedText.listHandle != payload.handle)
+				break;
+
+			// the backend keeps its own LRU, which may have evicted this string
+			if (!m_Backend.DrawCachedText(cachedText.backendHandle, payload.x, payload.y))
+			{
+				cachedText.backendHandle = m_Backend.CacheText(cachedText.text.c_str(), cachedText.rgba);
+				m_Backend.DrawCachedText(cachedText.backendHandle, payload.x, payload.y);
+			}
+			break;
+		}
+		case kDrawCommand_CreateRenderTarget:
+		{
+			CreateRenderTargetPayload payload;
+			reader.Read(payload);
+			if (payload.handle > m_Textures.size())
+				m_Textures.resize(payload.handle, 0);
+			m_Textures[payload.handle - 1] = m_Backend.CreateRenderTarget(payload.width, payload.height);
+			break;
+		}
+		case kDrawCommand_DestroyTexture:
+		{
+			TextureHandle handle;
+			reader.Read(handle);
+			m_Backend.DestroyTexture(FindTexture(handle));
+			if (handle > 0 && handle <= m_Textures.size())
+				m_Textures[handle - 1] = 0;
+			break;
+		}
+		case kDrawCommand_SetRenderTarget:
+		{
+			TextureHandle handle;
+			reader.Read(handle);
+			m_Backend.SetRenderTarget(FindTexture(handle));
+			break;
+		}
+		case kDrawCommand_DrawTexture:
+		{
+			DrawTexturePayload payload;
+			reader.Read(payload);
+			m_Backend.DrawTexture(FindTexture(payload.handle), payload.x, payload.y);
+			break;
+		}
+		case kDrawCommand_CreateBlockAtlas:
+		{
+			CreateBlockAtlasPayload payload;
+			reader.Read(payload);
+			std::vector<uint32_t> rgbas(payload.numSprites);
+			reader.Read(rgbas.data(), payload.numSprites * sizeof(uint32_t));
+			if (payload.handle > m_Textures.size())
+				m_Textures.resize(payload.handle, 0);
+			m_Textures[payload.handle - 1] = m_Backend.CreateBlockAtlas(rgbas.data(), payload.numSprites, payload.spriteSizePixels);
+			break;
+		}
+		default:
+			HP_FATAL_ERROR("Unhandled case");
+			return true;
+		}
+	}
+
+	return true;
+}
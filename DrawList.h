@@ -0,0 +1,139 @@
+#pragma once
+#ifndef DRAW_LIST_H_INCLUDED
+#define DRAW_LIST_H_INCLUDED
+
+#include "Render.h"
+#include <string>
+
+enum DrawCommand
+{
+	kDrawCommand_Clear = 0,
+	kDrawCommand_DrawRect,
+	kDrawCommand_DrawSolidRect,
+	kDrawCommand_DrawText,
+	kDrawCommand_BatchRect,
+	kDrawCommand_BatchSolidRect,
+	kDrawCommand_BatchSprite,
+	kDrawCommand_FlushBatch,
+	kDrawCommand_CacheText,
+	kDrawCommand_DrawCachedText,
+	kDrawCommand_CreateRenderTarget,
+	kDrawCommand_DestroyTexture,
+	kDrawCommand_SetRenderTarget,
+	kDrawCommand_DrawTexture,
+	kDrawCommand_CreateBlockAtlas,
+	kNumDrawCommands
+};
+
+// Records a frame of Renderer calls into one byte buffer instead of drawing
+// them, to be submitted to a real backend later by a DrawListPlayer. Batched
+// primitives are stored in call order, sorting by colour and texture happens
+// when the list is submitted. The list owns copies of everything it records,
+// so a finished list can be handed to another thread or kept and replayed.
+//
+// Text and texture handles returned by a DrawList belong to the list and are
+// mapped to backend handles by the player. Textures and cached text are only
+// created in the frame that first asks for them, so a kept list can't be
+// replayed on its own: it needs a player that has already submitted every
+// list since the one that created them, such as the player that drew it.
+//
+// The list hands out render targets only if the backend it will be submitted
+// to supports them, so callers fall back to drawing directly as they would
+// on the backend itself.
+class DrawList : public Renderer
+{
+public:
+	DrawList(unsigned int Width, unsigned int Height, bool supportsRenderTargets);
+	virtual ~DrawList();
+
+	// starts recording a new frame, keeping the buffer's memory
+	void Reset();
+	bool IsEmpty() const { return m_Commands.empty(); }
+	size_t GetSizeBytes() const { return m_Commands.size(); }
+	// hash of the commands recorded by the last Present
+	uint64_t GetHash() const { return m_Hash; }
+
+	virtual void Clear();
+	// ends the recorded frame, nothing is shown until the list is submitted
+	virtual void Present();
+
+	virtual void DrawRect(int x, int y, int w, int h, uint32_t rgba = 0xffffffff);
+	virtual void DrawSolidRect(int x, int y, int w, int h, uint32_t rgba = 0xffffffff);
+	virtual void DrawText(const char* text, int x, int y, uint32_t rgba = 0xffffffff);
+	// read back from the backend after submitting instead
+	virtual bool ReadPixels(uint32_t* pixels);
+
+	virtual void BatchRect(int x, int y, int w, int h, uint32_t rgba = 0xffffffff);
+	virtual void BatchSolidRect(int x, int y, int w, int h, uint32_t rgba = 0xffffffff);
+	virtual void BatchSprite(TextureHandle atlas, unsigned int spriteIndex, int x, int y);
+	virtual void FlushBatch();
+
+	virtual TextHandle CacheText(const char* text, uint32_t rgba = 0xffffffff);
+	virtual bool DrawCachedText(TextHandle handle, int x, int y);
+
+	virtual bool SupportsRenderTargets() const { return m_SupportsRenderTargets; }
+	virtual TextureHandle CreateRenderTarget(unsigned int width, unsigned int height);
+	virtual void DestroyTexture(TextureHandle handle);
+	virtual void SetRenderTarget(TextureHandle handle);
+	virtual void DrawTexture(TextureHandle handle, int x, int y);
+
+	virtual TextureHandle CreateBlockAtlas(const uint32_t* rgbas, unsigned int numSprites, unsigned int spriteSizePixels);
+
+protected:
+	// batches are recorded unsorted, so nothing is ever submitted from here
+	virtual void SubmitRects(const RenderRect* rects, unsigned int numRects, uint32_t rgba, bool solid);
+	virtual void SubmitSprites(TextureHandle atlas, const SpriteInstance* sprites, unsigned int numSprites);
+
+private:
+	friend class DrawListPlayer;
+
+	void Write(DrawCommand command, const void* payload, size_t payloadBytes);
+	void WriteBytes(const void* data, size_t numBytes);
+	TextureHandle AllocateTexture();
+
+	std::vector<uint8_t> m_Commands;
+	std::vector<bool> m_LiveTextures;
+	unsigned int m_NumBatched;
+	uint64_t m_Hash;
+	bool m_SupportsRenderTargets;
+};
+
+// Submits draw lists to a backend, creating backend resources as the list
+// asks for them. Cached text is re-rasterized if the backend evicted it.
+class DrawListPlayer
+{
+public:
+	explicit DrawListPlayer(Renderer& backend);
+	~DrawListPlayer();
+
+	// Replays the list onto the backend, the caller still presents. A list whose
+	// hash matches the previous one is skipped when allowSkip is set and the
+	// backend still holds that frame. Returns false if the list was skipped.
+	bool Submit(const DrawList& list, bool allowSkip = true);
+
+	unsigned int GetFramesSkipped() const { return m_FramesSkipped; }
+
+private:
+	DrawListPlayer(const DrawListPlayer&);
+	DrawListPlayer& operator=(const DrawListPlayer&);
+
+	struct CachedText
+	{
+		TextHandle listHandle;
+		TextHandle backendHandle;
+		uint32_t rgba;
+		std::string text;
+	};
+
+	TextureHandle FindTexture(TextureHandle listHandle) const;
+
+	Renderer& m_Backend;
+	std::vector<TextureHandle> m_Textures;
+	std::vector<CachedText> m_CachedTexts;
+	std::string m_Text;
+	uint64_t m_LastHash;
+	bool m_HasLastHash;
+	unsigned int m_FramesSkipped;
+};
+
+#endif // DRAW_LIST_H_INCLUDED
@@ -0,0 +1,551 @@
+#include "FieldCodec.h"
+#include "Debugger.h"
+#include <stdio.h>
+#include <string.h>
+
+static const unsigned int s_kCodeBits = 4;
+static const unsigned int s_kNumCodes = 1 << s_kCodeBits;
+static const unsigned int s_kSetCellsCountBits = 4;
+static const unsigned int s_kMaxCellsPerSet = 1 << s_kSetCellsCountBits;
+static const unsigned int s_kRemoveRowsCountBits = 2;
+static const unsigned int s_kMaxRemovedRows = 1 << s_kRemoveRowsCountBits;
+static const unsigned int s_kOpBits = 2;
+static const uint8_t s_kGarbageCode = GetFieldCellCode(kBlockSprite_Garbage);
+
+//Helper functions
+//================================================================================
+
+class BitWriter
+{
+public:
+	explicit BitWriter(std::vector<uint8_t>& out) : m_out(out), m_bits(0), m_numBits(0) {}
+
+	void Write(uint32_t value, unsigned int numBits)
+	{
+		m_bits |= (uint64_t)value << m_numBits;
+		m_numBits += numBits;
+		while (m_numBits >= 8)
+		{
+			m_out.push_back((uint8_t)m_bits);
+			m_bits >>= 8;
+			m_numBits -= 8;
+		}
+	}
+
+	// pads the packet to a whole byte
+	void Finish()
+	{
+		if (m_numBits > 0)
+			m_out.push_back((uint8_t)m_bits);
+		m_bits = 0;
+		m_numBits = 0;
+	}
+
+private:
+	std::vector<uint8_t>& m_out;
+	uint64_t m_bits;
+	unsigned int m_numBits;
+};
+
+class BitReader
+{
+public:
+	BitReader(const uint8_t* data, size_t size) : m_data(data), m_sizeBits(size * 8), m_bitPos(0), m_overrun(false) {}
+
+	// reads past the end give zeros and set the overrun flag
+	uint32_t Read(unsigned int numBits)
+	{
+		if (m_bitPos + numBits > m_sizeBits)
+		{
+			m_overrun = true;
+			m_bitPos = m_sizeBits;
+			return 0;
+		}
+		uint32_t value = 0;
+		unsigned int numRead = 0;
+		while (numRead < numBits)
+		{
+			const unsigned int bitInByte = (unsigned int)(m_bitPos & 7);
+			unsigned int take = 8 - bitInByte;
+			if (take > numBits - numRead)
+				take = numBits - numRead;
+			const uint32_t bits = (m_data[m_bitPos >> 3] >> bitInByte) & ((1u << take) - 1);
+			value |= bits << numRead;
+			numRead += take;
+			m_bitPos += take;
+		}
+		return value;
+	}
+
+	bool HasOverrun() const { return m_overrun; }
+	size_t GetBytesRead() const { return (m_bitPos + 7) / 8; }
+
+private:
+	const uint8_t* m_data;
+	size_t m_sizeBits;
+	size_t m_bitPos;
+	bool m_overrun;
+};
+
+// bits needed to store any of 0 to numValues - 1
+static unsigned int GetBitsFor(unsigned int numValues)
+{
+	unsigned int numBits = 1;
+	while ((1u << numBits) < numValues)
+	{
+		++numBits;
+	}
+	return numBits;
+}
+
+static void ReadFieldCells(const Field& field, unsigned int numCells, uint8_t* cells)
+{
+	if (!field.staticBlocks)
+	{
+		memset(cells, 0, numCells);
+		return;
+	}
+	for (unsigned int i = 0; i < numCells; ++i)
+	{
+		cells[i] = GetFieldCellCode(field.staticBlocks[i]);
+	}
+}
+
+// rows must be increasing, works in place because rows only ever move down
+static void ApplyRemoveRows(uint8_t* cells, unsigned int width, unsigned int height, const unsigned int* rows, unsigned int numRows)
+{
+	int destRow = (int)height - 1;
+	int nextRemoved = (int)numRows - 1;
+	for (int row = (int)height - 1; row >= 0; --row)
+	{
+		if (nextRemoved >= 0 && (int)rows[nextRemoved] == row)
+		{
+			--nextRemoved;
+			continue;
+		}
+		if (destRow != row)
+			memcpy(cells + destRow * width, cells + row * width, width);
+		--destRow;
+	}
+	memset(cells, 0, (destRow + 1) * width);
+}
+
+static void ApplyInsertGarbage(uint8_t* cells, unsigned int width, unsigned int height, unsigned int numRows, unsigned int holeX)
+{
+	memmove(cells, cells + numRows * width, (height - numRows) * width);
+	uint8_t* garbage = cells + (height - numRows) * width;
+	memset(garbage, s_kGarbageCode, numRows * width);
+	for (unsigned int row = 0; row < numRows; ++row)
+	{
+		garbage[row * width + holeX] = 0;
+	}
+}
+
+// what kFieldOp_SetCells ops turning from into to cost
+static unsigned int GetSetCellsBits(const uint8_t* from, const uint8_t* to, unsigned int numCells, unsigned int cellBits)
+{
+	unsigned int numCellsForCode[s_kNumCodes] = {};
+	for (unsigned int i = 0; i < numCells; ++i)
+	{
+		if (from[i] != to[i])
+			++numCellsForCode[to[i]];
+	}
+
+	unsigned int numBits = 0;
+	for (unsigned int code = 0; code < s_kNumCodes; ++code)
+	{
+		const unsigned int numOps = (numCellsForCode[code] + s_kMaxCellsPerSet - 1) / s_kMaxCellsPerSet;
+		numBits += numOps * (s_kOpBits + s_kCodeBits + s_kSetCellsCountBits) + numCellsForCode[code] * cellBits;
+	}
+	return numBits;
+}
+
+// indices is scratch space for one entry per cell
+static unsigned int WriteSetCells(BitWriter& writer, const uint8_t* from, const uint8_t* to, unsigned int numCells, unsigned int cellBits, unsigned int* indices)
+{
+	// bucket the changed cells by their new code, keeping them in order
+	unsigned int numCellsForCode[s_kNumCodes] = {};
+	for (unsigned int i = 0; i < numCells; ++i)
+	{
+		if (from[i] != to[i])
+			++numCellsForCode[to[i]];
+	}
+	unsigned int firstForCode[s_kNumCodes];
+	unsigned int numChanged = 0;
+	for (unsigned int code = 0; code < s_kNumCodes; ++code)
+	{
+		firstForCode[code] = numChanged;
+		numChanged += numCellsForCode[code];
+	}
+	unsigned int nextForCode[s_kNumCodes];
+	memcpy(nextForCode, firstForCode, sizeof(nextForCode));
+	for (unsigned int i = 0; i < numCells; ++i)
+	{
+		if (from[i] != to[i])
+			indices[nextForCode[to[i]]++] = i;
+	}
+
+	unsigned int numOps = 0;
+	for (unsigned int code = 0; code < s_kNumCodes; ++code)
+	{
+		for (unsigned int first = 0; first < numCellsForCode[code]; first += s_kMaxCellsPerSet)
+		{
+			unsigned int count = numCellsForCode[code] - first;
+			if (count > s_kMaxCellsPerSet)
+				count = s_kMaxCellsPerSet;
+			writer.Write(kFieldOp_SetCells, s_kOpBits);
+			writer.Write(code, s_kCodeBits);
+			writer.Write(count - 1, s_kSetCellsCountBits);
+			for (unsigned int i = 0; i < count; ++i)
+			{
+				writer.Write(indices[firstForCode[code] + first + i], cellBits);
+			}
+			++numOps;
+		}
+	}
+	return numOps;
+}
+
+static unsigned int GetNumEmptyCells(const uint8_t* row, unsigned int width)
+{
+	unsigned int numEmpty = 0;
+	for (unsigned int x = 0; x < width; ++x)
+	{
+		numEmpty += row[x] == 0;
+	}
+	return numEmpty;
+}
+
+// the column of the hole if the row is garbage, otherwise -1
+static int GetGarbageHole(const uint8_t* row, unsigned int width)
+{
+	int holeX = -1;
+	for (unsigned int x = 0; x < width; ++x)
+	{
+		if (row[x] == 0 && holeX < 0)
+			holeX = (int)x;
+		else if (row[x] != s_kGarbageCode)
+			return -1;
+	}
+	return holeX;
+}
+
+//================================================================================
+
+FieldEncoder::FieldEncoder(unsigned int width, unsigned int height, unsigned int keyframeInterval)
+	: m_width(width)
+	, m_height(height)
+	, m_keyframeInterval(keyframeInterval)
+	, m_packetsSinceKeyframe(0)
+	, m_hasSent(false)
+	, m_cells(width * height, 0)
+	, m_numEmptyInRow(height, (uint8_t)width)
+	, m_numBlocks(0)
+	, m_newCells(width * height, 0)
+	, m_newNumEmptyInRow(height, 0)
+	, m_candidateCells(width * height, 0)
+	, m_bestCells(width * height, 0)
+	, m_changedCells(width * height, 0)
+{
+	memset(&m_stats, 0, sizeof(m_stats));
+}
+
+bool FieldEncoder::Encode(const Field& field, std::vector<uint8_t>& out)
+{
+	HP_PROFILE_SCOPE("FieldEncoder::Encode");
+
+	const unsigned int numCells = m_width * m_height;
+	HP_ASSERT(!field.staticBlocks || (field.width == m_width && field.height == m_height));
+	ReadFieldCells(field, numCells, m_newCells.data());
+	if (m_hasSent && memcmp(m_newCells.data(), m_cells.data(), numCells) == 0)
+		return false;
+
+	const size_t firstByte = out.size();
+	unsigned int keyframeBits = 1 + m_height;
+	unsigned int numBlocksAfter = 0;
+	for (unsigned int row = 0; row < m_height; ++row)
+	{
+		const unsigned int numEmpty = GetNumEmptyCells(&m_newCells[row * m_width], m_width);
+		m_newNumEmptyInRow[row] = (uint8_t)numEmpty;
+		numBlocksAfter += m_width - numEmpty;
+		if (numEmpty != m_width)
+			keyframeBits += m_width * s_kCodeBits;
+	}
+
+	bool keyframe = !m_hasSent || (m_keyframeInterval > 0 && m_packetsSinceKeyframe + 1 >= m_keyframeInterval);
+	if (!keyframe)
+	{
+		const unsigned int cellBits = GetBitsFor(numCells);
+		const unsigned int rowBits = GetBitsFor(m_height);
+		const unsigned int columnBits = GetBitsFor(m_width);
+
+		// cell sets alone
+		unsigned int bestBits = 1 + s_kOpBits + GetSetCellsBits(m_cells.data(), m_newCells.data(), numCells, cellBits);
+		unsigned int bestRemovedRows[s_kMaxRemovedRows];
+		unsigned int bestNumRemovedRows = 0;
+		unsigned int bestNumGarbageRows = 0;
+		unsigned int bestHoleX = 0;
+
+		// A lock adds one piece's blocks, then takes away whole cleared rows or
+		// adds garbage rows with one hole each, so the change in the number of
+		// blocks says how many rows to look for.
+		const int numBlocksGone = (int)m_numBlocks + (int)Tetromino::kNumBlocks - (int)numBlocksAfter;
+		unsigned int numClearedRows = 0;
+		if (numBlocksGone > 0 && numBlocksGone % m_width == 0 && numBlocksGone / m_width <= s_kMaxRemovedRows)
+			numClearedRows = numBlocksGone / m_width;
+		unsigned int numInsertedRows = 0;
+		if (numBlocksGone < 0 && -numBlocksGone % (m_width - 1) == 0)
+			numInsertedRows = -numBlocksGone / (m_width - 1);
+
+		// A cleared row was full once the piece locked, so it was missing at
+		// most one piece's worth of blocks, and all the rows one piece clears
+		// lie within as many rows as it has blocks.
+		for (unsigned int first = 0; first < m_height && numClearedRows > 0; ++first)
+		{
+			// the lowest numbered row removed, and the other rows that could go with it
+			unsigned int spanRows[s_kMaxRemovedRows];
+			unsigned int numEmptyInRow[s_kMaxRemovedRows];
+			unsigned int numInSpan = 0;
+			for (unsigned int row = first; row < m_height && row - first < Tetromino::kNumBlocks; ++row)
+			{
+				const unsigned int numEmpty = m_numEmptyInRow[row];
+				if (numEmpty <= Tetromino::kNumBlocks && numEmpty < m_width)
+				{
+					spanRows[numInSpan] = row;
+					numEmptyInRow[numInSpan] = numEmpty;
+					++numInSpan;
+				}
+				else if (row == first)
+				{
+					break;
+				}
+			}
+			if (numInSpan == 0)
+				continue;
+
+			for (unsigned int subset = 0; subset < (1u << (numInSpan - 1)); ++subset)
+			{
+				unsigned int rows[s_kMaxRemovedRows];
+				unsigned int numRows = 0;
+				unsigned int numEmpty = 0;
+				for (unsigned int i = 0; i < numInSpan; ++i)
+				{
+					if (i == 0 || (subset & (1u << (i - 1))))
+					{
+						rows[numRows++] = spanRows[i];
+						numEmpty += numEmptyInRow[i];
+					}
+				}
+				if (numRows != numClearedRows || numEmpty > Tetromino::kNumBlocks)
+					continue;
+
+				m_candidateCells = m_cells;
+				ApplyRemoveRows(m_candidateCells.data(), m_width, m_height, rows, numRows);
+				const unsigned int bits = 1 + s_kOpBits * 2 + s_kRemoveRowsCountBits + numRows * rowBits
+					+ GetSetCellsBits(m_candidateCells.data(), m_newCells.data(), numCells, cellBits);
+				if (bits < bestBits)
+				{
+					bestBits = bits;
+					memcpy(bestRemovedRows, rows, sizeof(rows));
+					bestNumRemovedRows = numRows;
+					bestNumGarbageRows = 0;
+					m_bestCells.swap(m_candidateCells);
+				}
+			}
+		}
+
+		// garbage rows all have their hole in the same column
+		unsigned int numGarbageRows = 0;
+		const int holeX = GetGarbageHole(&m_newCells[(m_height - 1) * m_width], m_width);
+		while (holeX >= 0 && numGarbageRows < m_height
+			&& GetGarbageHole(&m_newCells[(m_height - 1 - numGarbageRows) * m_width], m_width) == holeX)
+		{
+			++numGarbageRows;
+		}
+		if (numInsertedRows > 0 && numInsertedRows <= numGarbageRows)
+		{
+			const unsigned int numRows = numInsertedRows;
+			m_candidateCells = m_cells;
+			ApplyInsertGarbage(m_candidateCells.data(), m_width, m_height, numRows, (unsigned int)holeX);
+			const unsigned int bits = 1 + s_kOpBits * 2 + rowBits + columnBits
+				+ GetSetCellsBits(m_candidateCells.data(), m_newCells.data(), numCells, cellBits);
+			if (bits < bestBits)
+			{
+				bestBits = bits;
+				bestNumRemovedRows = 0;
+				bestNumGarbageRows = numRows;
+				bestHoleX = (unsigned int)holeX;
+				m_bestCells.swap(m_candidateCells);
+			}
+		}
+
+		if (bestBits < keyframeBits)
+		{
+			// the rows move first, then the cells left over are set
+			BitWriter writer(out);
+			writer.Write(0, 1);
+			const uint8_t* fromCells = m_cells.data();
+			if (bestNumRemovedRows > 0)
+			{
+				writer.Write(kFieldOp_RemoveRows, s_kOpBits);
+				writer.Write(bestNumRemovedRows - 1, s_kRemoveRowsCountBits);
+				for (unsigned int i = 0; i < bestNumRemovedRows; ++i)
+				{
+					writer.Write(bestRemovedRows[i], rowBits);
+				}
+				++m_stats.numOps[kFieldOp_RemoveRows];
+				fromCells = m_bestCells.data();
+			}
+			else if (bestNumGarbageRows > 0)
+			{
+				writer.Write(kFieldOp_InsertGarbage, s_kOpBits);
+				writer.Write(bestNumGarbageRows - 1, rowBits);
+				writer.Write(bestHoleX, columnBits);
+				++m_stats.numOps[kFieldOp_InsertGarbage];
+				fromCells = m_bestCells.data();
+			}
+			m_stats.numOps[kFieldOp_SetCells] += WriteSetCells(writer, fromCells, m_newCells.data(), numCells, cellBits, m_changedCells.data());
+			writer.Write(kFieldOp_End, s_kOpBits);
+			writer.Finish();
+			++m_stats.numDeltas;
+			++m_packetsSinceKeyframe;
+		}
+		else
+		{
+			keyframe = true;
+		}
+	}
+
+	if (keyframe)
+	{
+		WriteKeyframe(m_newCells.data(), out);
+		++m_stats.numKeyframes;
+		m_packetsSinceKeyframe = 0;
+	}
+
+	m_cells.swap(m_newCells);
+	m_numEmptyInRow.swap(m_newNumEmptyInRow);
+	m_numBlocks = numBlocksAfter;
+	m_hasSent = true;
+	m_stats.bytes += out.size() - firstByte;
+	return true;
+}
+
+void FieldEncoder::EncodeKeyframe(std::vector<uint8_t>& out) const
+{
+	WriteKeyframe(m_cells.data(), out);
+}
+
+void FieldEncoder::WriteKeyframe(const uint8_t* cells, std::vector<uint8_t>& out) const
+{
+	BitWriter writer(out);
+	writer.Write(1, 1);
+	for (unsigned int row = 0; row < m_height; ++row)
+	{
+		const uint8_t* rowCells = cells + row * m_width;
+		const bool hasBlocks = GetNumEmptyCells(rowCells, m_width) != m_width;
+		writer.Write(hasBlocks, 1);
+		if (!hasBlocks)
+			continue;
+		for (unsigned int x = 0; x < m_width; ++x)
+		{
+			writer.Write(rowCells[x], s_kCodeBits);
+		}
+	}
+	writer.Finish();
+}
+
+//================================================================================
+
+FieldDecoder::FieldDecoder(unsigned int width, unsigned int height)
+	: m_width(width)
+	, m_height(height)
+	, m_hasKeyframe(false)
+	, m_cells(width * height, 0)
+	, m_scratchCells(width * height, 0)
+{
+}
+
+size_t FieldDecoder::Decode(const uint8_t* data, size_t size)
+{
+	const unsigned int numCells = m_width * m_height;
+	BitReader reader(data, size);
+	if (reader.Read(1))
+	{
+		for (unsigned int row = 0; row < m_height; ++row)
+		{
+			uint8_t* rowCells = &m_scratchCells[row * m_width];
+			const bool hasBlocks = reader.Read(1) != 0;
+			for (unsigned int x = 0; x < m_width; ++x)
+			{
+				rowCells[x] = hasBlocks ? (uint8_t)reader.Read(s_kCodeBits) : 0;
+			}
+		}
+	}
+	else
+	{
+		if (!m_hasKeyframe)
+			return 0;
+
+		const unsigned int cellBits = GetBitsFor(numCells);
+		const unsigned int rowBits = GetBitsFor(m_height);
+		const unsigned int columnBits = GetBitsFor(m_width);
+		m_scratchCells = m_cells;
+		for (;;)
+		{
+			const unsigned int op = reader.Read(s_kOpBits);
+			if (reader.HasOverrun())
+				return 0;
+			if (op == kFieldOp_End)
+				break;
+
+			if (op == kFieldOp_SetCells)
+			{
+				const uint8_t code = (uint8_t)reader.Read(s_kCodeBits);
+				const unsigned int count = reader.Read(s_kSetCellsCountBits) + 1;
+				for (unsigned int i = 0; i < count; ++i)
+				{
+					const unsigned int cell = reader.Read(cellBits);
+					if (cell >= numCells)
+						return 0;
+					m_scratchCells[cell] = code;
+				}
+			}
+			else if (op == kFieldOp_RemoveRows)
+			{
+				unsigned int rows[s_kMaxRemovedRows];
+				const unsigned int numRows = reader.Read(s_kRemoveRowsCountBits) + 1;
+				for (unsigned int i = 0; i < numRows; ++i)
+				{
+					rows[i] = reader.Read(rowBits);
+					if (rows[i] >= m_height || (i > 0 && rows[i] <= rows[i - 1]))
+						return 0;
+				}
+				ApplyRemoveRows(m_scratchCells.data(), m_width, m_height, rows, numRows);
+			}
+			else
+			{
+				const unsigned int numRows = reader.Read(rowBits) + 1;
+				const unsigned int holeX = reader.Read(columnBits);
+				if (numRows > m_height || holeX >= m_width)
+					return 0;
+				ApplyInsertGarbage(m_scratchCells.data(), m_width, m_height, numRows, holeX);
+			}
+		}
+	}
+
+	if (reader.HasOverrun())
+		return 0;
+	m_cells.swap(m_scratchCells);
+	m_hasKeyframe = true;
+	return reader.GetBytesRead();
+}
+
+void FieldDecoder::CopyToField(Field& field) const
+{
+	HP_ASSERT(field.width == m_width && field.height == m_height);
+	for (unsigned int i = 0; i < m_width * m_height; ++i)
+	{
+		field.staticBlocks[i] = (int)m_cells[i] - 1;
+	}
+}
@@ -0,0 +1,106 @@
+#pragma once
+#ifndef FIELD_CODEC_H_INCLUDED
+#define FIELD_CODEC_H_INCLUDED
+
+#include "Game.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+// Bit packed description of how a Field changed, for sending or storing fields
+// without the 4 byte int per cell. Cells are 4 bit codes, 0 is empty and
+// anything else is the BlockSprite plus one.
+//
+// A packet is byte aligned and starts with one bit, 1 for a keyframe and 0 for
+// a delta. A keyframe is, for each row from the top, a bit that is 1 if the row
+// has blocks followed by its cells. A delta is a list of operations, each a
+// 2 bit FieldOp and its arguments, ending with kFieldOp_End. Row and cell
+// arguments use just enough bits for the field size.
+enum FieldOp
+{
+	kFieldOp_End = 0,
+	// 4 bit code, 4 bit count - 1, then count cell indices, all set to code
+	kFieldOp_SetCells,
+	// 2 bit count - 1, then count rows in increasing order, which are removed
+	// with the rows above moving down and empty rows coming in at the top
+	kFieldOp_RemoveRows,
+	// row count - 1 and a hole column, the field moves up that many rows and
+	// garbage rows with a hole in that column come in at the bottom
+	kFieldOp_InsertGarbage,
+	kNumFieldOps
+};
+
+struct FieldCodecStats
+{
+	unsigned int numKeyframes;
+	unsigned int numDeltas;
+	unsigned int numOps[kNumFieldOps];
+	uint64_t bytes;
+};
+
+// Remembers the field a decoder has and writes the cheapest packet that gets
+// it to the new one. A lock is explained as cell sets, then tried as removal
+// of nearly full rows and as garbage coming in at the bottom, whatever is left
+// over becomes more cell sets, so decoding is always exact. A keyframe is sent
+// instead when that is smaller, and every keyframeInterval packets.
+class FieldEncoder
+{
+public:
+	// keyframeInterval 0 only sends keyframes first and when they are smaller
+	FieldEncoder(unsigned int width, unsigned int height, unsigned int keyframeInterval);
+
+	// appends a packet if the field changed since the last call, returns whether it did
+	bool Encode(const Field& field, std::vector<uint8_t>& out);
+	// appends a keyframe of the last encoded field without counting it as sent
+	void EncodeKeyframe(std::vector<uint8_t>& out) const;
+
+	const FieldCodecStats& GetStats() const { return m_stats; }
+
+private:
+	void WriteKeyframe(const uint8_t* cells, std::vector<uint8_t>& out) const;
+
+	unsigned int m_width;
+	unsigned int m_height;
+	unsigned int m_keyframeInterval;
+	unsigned int m_packetsSinceKeyframe;
+	bool m_hasSent;
+	std::vector<uint8_t> m_cells;
+	std::vector<uint8_t> m_numEmptyInRow;
+	unsigned int m_numBlocks;
+
+	// scratch space for the field being encoded and the candidates tried
+	std::vector<uint8_t> m_newCells;
+	std::vector<uint8_t> m_newNumEmptyInRow;
+	std::vector<uint8_t> m_candidateCells;
+	std::vector<uint8_t> m_bestCells;
+	std::vector<unsigned int> m_changedCells;
+
+	FieldCodecStats m_stats;
+};
+
+class FieldDecoder
+{
+public:
+	FieldDecoder(unsigned int width, unsigned int height);
+
+	// applies one packet, returns its size in bytes, or 0 if it is malformed
+	// or a delta arrived before any keyframe, in which case nothing changes
+	size_t Decode(const uint8_t* data, size_t size);
+
+	bool HasKeyframe() const { return m_hasKeyframe; }
+	const uint8_t* GetCells() const { return m_cells.data(); }
+	// the field must be the decoder's size
+	void CopyToField(Field& field) const;
+
+private:
+	unsigned int m_width;
+	unsigned int m_height;
+	bool m_hasKeyframe;
+	std::vector<uint8_t> m_cells;
+	std::vector<uint8_t> m_scratchCells;
+};
+
+// the 4 bit code for a Field's staticBlocks value
+inline uint8_t GetFieldCellCode(int block) { return (uint8_t)(block + 1); }
+
+#endif // FIELD_CODEC_H_INCLUDED
@@ -0,0 +1,266 @@
+#include "FieldKernels.h"
+#include <stdio.h>
+#include "Debugger.h"
+#include <atomic>
+#include <string.h>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define HP_FIELD_KERNELS_X86 1
+#include <immintrin.h>
+#if defined(_MSC_VER) && !defined(__clang__)
+#include <intrin.h>
+// MSVC lets any function use any instruction set
+#define HP_TARGET_SSE2
+#define HP_TARGET_AVX2
+#else
+// so the file builds without -mavx2 and only runs AVX2 code on CPUs that have it
+#define HP_TARGET_SSE2 __attribute__((target("sse2")))
+#define HP_TARGET_AVX2 __attribute__((target("avx2")))
+#endif
+#else
+#define HP_FIELD_KERNELS_X86 0
+#endif
+
+struct FieldKernels
+{
+	bool (*isRowFull)(const int* row, unsigned int width);
+	bool (*isRowEmpty)(const int* row, unsigned int width);
+};
+
+//Helper functions
+//================================================================================
+
+static bool IsRowFullScalar(const int* row, unsigned int width)
+{
+	for (unsigned int x = 0; x < width; ++x)
+	{
+		if (row[x] == -1)
+			return false;
+	}
+	return true;
+}
+
+static bool IsRowEmptyScalar(const int* row, unsigned int width)
+{
+	for (unsigned int x = 0; x < width; ++x)
+	{
+		if (row[x] != -1)
+			return false;
+	}
+	return true;
+}
+
+#if HP_FIELD_KERNELS_X86
+
+// Rows that aren't a whole number of vectors finish with a vector that
+// overlaps the one before, rather than a scalar loop.
+
+HP_TARGET_SSE2 static bool IsRowFullSse2(const int* row, unsigned int width)
+{
+	if (width < 4)
+		return IsRowFullScalar(row, width);
+
+	const __m128i empty = _mm_set1_epi32(-1);
+	unsigned int x = 0;
+	for (; x + 4 <= width; x += 4)
+	{
+		if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(row + x)), empty)) != 0)
+			return false;
+	}
+	return x == width || _mm_movemask_epi8(_mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(row + width - 4)), empty)) == 0;
+}
+
+HP_TARGET_SSE2 static bool IsRowEmptySse2(const int* row, unsigned int width)
+{
+	if (width < 4)
+		return IsRowEmptyScalar(row, width);
+
+	const __m128i empty = _mm_set1_epi32(-1);
+	unsigned int x = 0;
+	for (; x + 4 <= width; x += 4)
+	{
+		if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(row + x)), empty)) != 0xffff)
+			return false;
+	}
+	return x == width || _mm_movemask_epi8(_mm_cmpeq_epi32(_mm_loadu_si128((const __m128i*)(row + width - 4)), empty)) == 0xffff;
+}
+
+HP_TARGET_AVX2 static bool IsRowFullAvx2(const int* row, unsigned int width)
+{
+	if (width < 8)
+		return IsRowFullSse2(row, width);
+
+	const __m256i empty = _mm256_set1_epi32(-1);
+	unsigned int x = 0;
+	for (; x + 8 <= width; x += 8)
+	{
+		if (!_mm256_testz_si256(_mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i*)(row + x)), empty), empty))
+			return false;
+	}
+	return x == width || _mm256_testz_si256(_mm256_cmpeq_epi32(_mm256_loadu_si256((const __m256i*)(row + width - 8)), empty), empty);
+}
+
+HP_TARGET_AVX2 static bool IsRowEmptyAvx2(const int* row, unsigned int width)
+{
+	if (width < 8)
+		return IsRowEmptySse2(row, width);
+
+	// every cell is -1 when the row ANDed together is still all ones
+	const __m256i empty = _mm256_set1_epi32(-1);
+	unsigned int x = 0;
+	for (; x + 8 <= width; x += 8)
+	{
+		if (!_mm256_testc_si256(_mm256_loadu_si256((const __m256i*)(row + x)), empty))
+			return false;
+	}
+	return x == width || _mm256_testc_si256(_mm256_loadu_si256((const __m256i*)(row + width - 8)), empty);
+}
+
+static bool CpuHasSse2()
+{
+#if defined(__x86_64__) || defined(_M_X64)
+	return true;
+#elif defined(_MSC_VER) && !defined(__clang__)
+	int info[4];
+	__cpuid(info, 1);
+	return (info[3] & (1 << 26)) != 0;
+#else
+	return __builtin_cpu_supports("sse2");
+#endif
+}
+
+static bool CpuHasAvx2()
+{
+#if defined(_MSC_VER) && !defined(__clang__)
+	int info[4];
+	__cpuid(info, 0);
+	if (info[0] < 7)
+		return false;
+	// the OS has to save the upper halves of the registers too
+	__cpuid(info, 1);
+	const bool osSavesYmm = (info[2] & (1 << 27)) != 0 && (_xgetbv(0) & 6) == 6;
+	__cpuidex(info, 7, 0);
+	return osSavesYmm && (info[1] & (1 << 5)) != 0;
+#else
+	// also checks the OS saves the upper halves of the registers
+	return __builtin_cpu_supports("avx2");
+#endif
+}
+
+#endif // HP_FIELD_KERNELS_X86
+
+static const FieldKernels s_kKernels[kNumFieldKernelSets] =
+{
+	{ IsRowFullScalar, IsRowEmptyScalar },
+#if HP_FIELD_KERNELS_X86
+	{ IsRowFullSse2, IsRowEmptySse2 },
+	{ IsRowFullAvx2, IsRowEmptyAvx2 },
+#else
+	{ IsRowFullScalar, IsRowEmptyScalar },
+	{ IsRowFullScalar, IsRowEmptyScalar },
+#endif
+};
+
+static const char* const s_kKernelSetNames[kNumFieldKernelSets] = { "scalar", "SSE2", "AVX2" };
+
+// chosen on first use, games on any thread can get here first
+static std::atomic<int> s_kernelSet(-1);
+
+static FieldKernelSet GetBestFieldKernelSet()
+{
+	for (int set = kNumFieldKernelSets - 1; set > kFieldKernelSet_Scalar; --set)
+	{
+		if (IsFieldKernelSetSupported((FieldKernelSet)set))
+			return (FieldKernelSet)set;
+	}
+	return kFieldKernelSet_Scalar;
+}
+
+static const FieldKernels& GetKernels()
+{
+	int set = s_kernelSet.load(std::memory_order_relaxed);
+	if (set < 0)
+	{
+		set = GetBestFieldKernelSet();
+		s_kernelSet.store(set, std::memory_order_relaxed);
+	}
+	return s_kKernels[set];
+}
+
+//================================================================================
+
+bool IsFieldKernelSetSupported(FieldKernelSet set)
+{
+	switch (set)
+	{
+	case kFieldKernelSet_Scalar:
+		return true;
+#if HP_FIELD_KERNELS_X86
+	case kFieldKernelSet_Sse2:
+		return CpuHasSse2();
+	case kFieldKernelSet_Avx2:
+		return CpuHasSse2() && CpuHasAvx2();
+#endif
+	default:
+		return false;
+	}
+}
+
+const char* GetFieldKernelSetName(FieldKernelSet set)
+{
+	HP_ASSERT(set < kNumFieldKernelSets);
+	return s_kKernelSetNames[set];
+}
+
+FieldKernelSet GetFieldKernelSet()
+{
+	GetKernels();
+	return (FieldKernelSet)s_kernelSet.load(std::memory_order_relaxed);
+}
+
+void SetFieldKernelSet(FieldKernelSet set)
+{
+	HP_ASSERT(IsFieldKernelSetSupported(set));
+	s_kernelSet.store(set, std::memory_order_relaxed);
+}
+
+bool IsFieldRowFull(const int* row, unsigned int width)
+{
+	return GetKernels().isRowFull(row, width);
+}
+
+bool IsFieldRowEmpty(const int* row, unsigned int width)
+{
+	return GetKernels().isRowEmpty(row, width);
+}
+
+unsigned int RemoveFullFieldRows(int* blocks, unsigned int width, unsigned int height, unsigned int rowBegin, unsigned int rowEnd)
+{
+	HP_ASSERT(rowBegin <= rowEnd && rowEnd <= height);
+	HP_UNUSED(height);
+	const FieldKernels& kernels = GetKernels();
+
+	// Going up from the bottom, each run of rows between full ones moves down
+	// by however many full rows were below it, as one memmove.
+	unsigned int numRemoved = 0;
+	unsigned int runEnd = rowEnd;
+	for (unsigned int y = rowEnd; y-- > rowBegin;)
+	{
+		if (!kernels.isRowFull(blocks + y * width, width))
+			continue;
+
+		if (numRemoved > 0)
+			memmove(blocks + (y + 1 + numRemoved) * width, blocks + (y + 1) * width, (runEnd - y - 1) * width * sizeof(int));
+		++numRemoved;
+		runEnd = y;
+	}
+
+	if (numRemoved > 0)
+	{
+		// everything above the checked rows moves down too
+		memmove(blocks + numRemoved * width, blocks, runEnd * width * sizeof(int));
+		// -1 is every bit set
+		memset(blocks, 0xff, numRemoved * width * sizeof(int));
+	}
+	return numRemoved;
+}
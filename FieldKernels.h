@@ -0,0 +1,32 @@
+#pragma once
+#ifndef FIELD_KERNELS_H_INCLUDED
+#define FIELD_KERNELS_H_INCLUDED
+
+// Row scans over Field::staticBlocks style cells, an int per cell and -1 for
+// empty, so locking a piece costs about the same on a 64 column field as on
+// a 10 column one. There are scalar, SSE2 and AVX2 versions, the best one the
+// CPU supports is picked the first time any of them is used.
+enum FieldKernelSet
+{
+	kFieldKernelSet_Scalar = 0,
+	kFieldKernelSet_Sse2,
+	kFieldKernelSet_Avx2,
+	kNumFieldKernelSets
+};
+
+bool IsFieldKernelSetSupported(FieldKernelSet set);
+const char* GetFieldKernelSetName(FieldKernelSet set);
+FieldKernelSet GetFieldKernelSet();
+// for comparing them, the set must be supported
+void SetFieldKernelSet(FieldKernelSet set);
+
+// no empty cells
+bool IsFieldRowFull(const int* row, unsigned int width);
+// only empty cells
+bool IsFieldRowEmpty(const int* row, unsigned int width);
+// Removes the full rows among [rowBegin, rowEnd), which are the only rows
+// checked. Rows above a removed row move down and empty rows come in at the
+// top. Returns how many were removed.
+unsigned int RemoveFullFieldRows(int* blocks, unsigned int width, unsigned int height, unsigned int rowBegin, unsigned int rowEnd);
+
+#endif // FIELD_KERNELS_H_INCLUDED
@@ -0,0 +1,69 @@
+#include "Font.h"
+#include "Debugger.h"
+#include "Framebuffer.h"
+#include <stdio.h>
+#include <string.h>
+
+void InitGlyphAtlas(GlyphAtlas& atlas, unsigned int width, unsigned int height, int lineHeight)
+{
+	atlas.width = width;
+	atlas.height = height;
+	atlas.lineHeight = lineHeight;
+	atlas.alpha.assign(width * height, 0);
+	memset(atlas.glyphs, 0, sizeof(atlas.glyphs));
+}
+
+bool IsGlyphAtlasValid(const GlyphAtlas& atlas)
+{
+	return atlas.width > 0 && atlas.height > 0 && atlas.alpha.size() == atlas.width * atlas.height;
+}
+
+const GlyphAtlas::Glyph* FindGlyph(const GlyphAtlas& atlas, char c)
+{
+	if (c < GlyphAtlas::kFirstGlyph || c > GlyphAtlas::kLastGlyph)
+		return nullptr;
+	return &atlas.glyphs[c - GlyphAtlas::kFirstGlyph];
+}
+
+int MeasureText(const GlyphAtlas& atlas, const char* text)
+{
+	int width = 0;
+	int penX = 0;
+	for (const char* c = text; *c; ++c)
+	{
+		const GlyphAtlas::Glyph* glyph = FindGlyph(atlas, *c);
+		if (!glyph)
+			continue;
+
+		if (penX + glyph->width > width)
+			width = penX + glyph->width;
+		penX += glyph->advance;
+	}
+	return width;
+}
+
+void ComposeText(const GlyphAtlas& atlas, const char* text, uint32_t rgba, Framebuffer& image)
+{
+	HP_ASSERT(text);
+
+	const int width = MeasureText(atlas, text);
+	image.Resize(width > 0 ? width : 1, atlas.lineHeight > 0 ? atlas.lineHeight : 1);
+
+	// blending onto the text colour with zero alpha leaves the colour untouched
+	// and the alpha equal to the glyph coverage
+	image.Clear(rgba & 0xffffff00);
+	if (!IsGlyphAtlasValid(atlas))
+		return;
+
+	int penX = 0;
+	for (const char* c = text; *c; ++c)
+	{
+		const GlyphAtlas::Glyph* glyph = FindGlyph(atlas, *c);
+		if (!glyph)
+			continue;
+
+		const uint8_t* mask = &atlas.alpha[glyph->y * atlas.width + glyph->x];
+		image.BlendAlphaMask(mask, atlas.width, penX, 0, glyph->width, glyph->height, rgba);
+		penX += glyph->advance;
+	}
+}
@@ -0,0 +1,51 @@
+#pragma once
+#ifndef FONT_H_INCLUDED
+#define FONT_H_INCLUDED
+
+#include <stdint.h>
+#include <vector>
+
+class Framebuffer;
+
+// Coverage masks for printable ASCII packed into one 8 bit alpha image. Built
+// once at startup and shared by every renderer backend.
+struct GlyphAtlas
+{
+	static const char kFirstGlyph = ' ';
+	static const char kLastGlyph = '~';
+	static const unsigned int kNumGlyphs = kLastGlyph - kFirstGlyph + 1;
+
+	struct Glyph
+	{
+		int x;
+		int y;
+		int width;
+		int height;
+		int advance;
+	};
+
+	unsigned int width;
+	unsigned int height;
+	int lineHeight;
+	std::vector<uint8_t> alpha;
+	Glyph glyphs[kNumGlyphs];
+};
+
+void InitGlyphAtlas(GlyphAtlas& atlas, unsigned int width, unsigned int height, int lineHeight);
+bool IsGlyphAtlasValid(const GlyphAtlas& atlas);
+
+// nullptr for characters outside the atlas
+const GlyphAtlas::Glyph* FindGlyph(const GlyphAtlas& atlas, char c);
+
+int MeasureText(const GlyphAtlas& atlas, const char* text);
+
+// resizes image to fit the text and writes it with straight alpha
+void ComposeText(const GlyphAtlas& atlas, const char* text, uint32_t rgba, Framebuffer& image);
+
+// Fills the atlas from the glyphs compiled into BakedFont.h, so text needs no
+// font file or rasterizer at run time. Regenerate that header with the
+// bake_font build target, or tools/BakeFont.cpp by hand, when the font or its
+// size changes.
+void LoadGlyphAtlasBaked(GlyphAtlas& atlas);
+
+#endif // FONT_H_INCLUDED
@@ -0,0 +1,33 @@
+#include "Font.h"
+#include "BakedFont.h"
+#include "Debugger.h"
+#include <stdio.h>
+
+static_assert(s_kBakedFontBitsPerPixel == 1 || s_kBakedFontBitsPerPixel == 8, "Unsupported baked font format");
+
+void LoadGlyphAtlasBaked(GlyphAtlas& atlas)
+{
+	HP_PROFILE_SCOPE("LoadGlyphAtlasBaked");
+
+	InitGlyphAtlas(atlas, s_kBakedFontWidth, s_kBakedFontHeight, s_kBakedFontLineHeight);
+	for (unsigned int i = 0; i < GlyphAtlas::kNumGlyphs; ++i)
+	{
+		atlas.glyphs[i] = s_kBakedFontGlyphs[i];
+	}
+
+	const unsigned int rowBytes = (s_kBakedFontWidth * s_kBakedFontBitsPerPixel + 7) / 8;
+	for (unsigned int y = 0; y < s_kBakedFontHeight; ++y)
+	{
+		const uint8_t* row = &s_kBakedFontPixels[y * rowBytes];
+		uint8_t* alpha = &atlas.alpha[y * s_kBakedFontWidth];
+		for (unsigned int x = 0; x < s_kBakedFontWidth; ++x)
+		{
+			if (s_kBakedFontBitsPerPixel == 8)
+				alpha[x] = row[x];
+			else
+				alpha[x] = (row[x / 8] & (0x80 >> (x % 8))) ? 255 : 0;
+		}
+	}
+
+	printf("Glyph atlas = (%u, %u) baked at %d points\n", atlas.width, atlas.height, s_kBakedFontPointSize);
+}
@@ -0,0 +1,198 @@
+#include "FrameRecorder.h"
+#include "Debugger.h"
+#include "Profiler.h"
+#include <chrono>
+#include <inttypes.h>
+#include <string.h>
+
+// stdio buffer for headers and plane writes, whole raw frames bypass it
+static const size_t s_kWriteBufferBytes = 1 << 20;
+
+//Helper functions
+static bool HasExtension(const char* path, const char* extension)
+{
+	const size_t pathLength = strlen(path);
+	const size_t extensionLength = strlen(extension);
+	return pathLength >= extensionLength && strcmp(path + pathLength - extensionLength, extension) == 0;
+}
+
+// BT.601 studio range, integer approximation
+static void RgbaToYuv(uint32_t rgba, uint8_t& y, uint8_t& u, uint8_t& v)
+{
+	const int r = (int)((rgba >> 24) & 0xff);
+	const int g = (int)((rgba >> 16) & 0xff);
+	const int b = (int)((rgba >> 8) & 0xff);
+	y = (uint8_t)(((66 * r + 129 * g + 25 * b + 128) >> 8) + 16);
+	u = (uint8_t)(((-38 * r - 74 * g + 112 * b + 128) >> 8) + 128);
+	v = (uint8_t)(((112 * r - 94 * g - 18 * b + 128) >> 8) + 128);
+}
+
+//================================================================================
+
+FrameRecorder::FrameRecorder()
+	: m_file(nullptr)
+	, m_format(kFrameFormat_Raw)
+	, m_width(0)
+	, m_height(0)
+	, m_acquiredBuffer(-1)
+	, m_stopping(false)
+	, m_writeFailed(false)
+	, m_framesWritten(0)
+	, m_framesDropped(0)
+{
+}
+
+FrameRecorder::~FrameRecorder()
+{
+	Close();
+}
+
+bool FrameRecorder::Open(const char* path, unsigned int width, unsigned int height, unsigned int framesPerSecond)
+{
+	HP_ASSERT(path && width > 0 && height > 0 && framesPerSecond > 0);
+	HP_ASSERT(!IsOpen());
+
+	m_file = fopen(path, "wb");
+	if (!m_file)
+	{
+		fprintf(stderr, "Failed to open %s for recording\n", path);
+		return false;
+	}
+	setvbuf(m_file, nullptr, _IOFBF, s_kWriteBufferBytes);
+
+	m_format = HasExtension(path, ".y4m") ? kFrameFormat_Y4m : kFrameFormat_Raw;
+	m_width = width;
+	m_height = height;
+	if (m_format == kFrameFormat_Y4m)
+	{
+		fprintf(m_file, "YUV4MPEG2 W%u H%u F%u:1 Ip A1:1 C444\n", width, height, framesPerSecond);
+		m_planes.resize(3 * width * height);
+	}
+
+	m_pixels.resize((size_t)kNumBuffers * width * height);
+
+	// the writer thread isn't running yet, so filling its side of the queue here is safe
+	for (unsigned int i = 0; i < kNumBuffers; ++i)
+	{
+		m_freeBuffers.Push(i);
+	}
+	m_acquiredBuffer = -1;
+	m_stopping.store(false, std::memory_order_relaxed);
+	m_writeFailed.store(false, std::memory_order_relaxed);
+	m_framesWritten.store(0, std::memory_order_relaxed);
+	m_framesDropped = 0;
+
+	m_writerThread = std::thread(&FrameRecorder::WriterThread, this);
+
+	printf("Recording %ux%u %s frames to %s\n", width, height, m_format == kFrameFormat_Y4m ? "Y4M" : "raw RGBA", path);
+	return true;
+}
+
+void FrameRecorder::Close()
+{
+	if (!IsOpen())
+		return;
+
+	m_stopping.store(true, std::memory_order_release);
+	m_writerThread.join();
+
+	printf("Recorded %" PRIu64 " frames, dropped %" PRIu64 "\n", GetFramesWritten(), m_framesDropped);
+	if (m_writeFailed.load(std::memory_order_relaxed))
+	{
+		fprintf(stderr, "Recording stopped early, a frame write failed\n");
+	}
+
+	fclose(m_file);
+	m_file = nullptr;
+
+	// drain the pool so a later Open starts from a full free queue
+	unsigned int index;
+	while (m_freeBuffers.Pop(index))
+	{
+	}
+	m_pixels.clear();
+	m_planes.clear();
+}
+
+uint32_t* FrameRecorder::AcquireFrame()
+{
+	HP_ASSERT(IsOpen());
+
+	if (m_acquiredBuffer < 0)
+	{
+		unsigned int index;
+		if (m_writeFailed.load(std::memory_order_relaxed) || !m_freeBuffers.Pop(index))
+		{
+			++m_framesDropped;
+			return nullptr;
+		}
+		m_acquiredBuffer = (int)index;
+	}
+
+	return &m_pixels[(size_t)m_acquiredBuffer * m_width * m_height];
+}
+
+void FrameRecorder::SubmitFrame(uint32_t* pixels)
+{
+	HP_ASSERT(m_acquiredBuffer >= 0);
+	HP_ASSERT(pixels == &m_pixels[(size_t)m_acquiredBuffer * m_width * m_height]);
+	HP_UNUSED(pixels);
+
+	// can't fail, there are only kNumBuffers indices in flight
+	m_queuedBuffers.Push((unsigned int)m_acquiredBuffer);
+	m_acquiredBuffer = -1;
+}
+
+void FrameRecorder::WriterThread()
+{
+	Profiler::SetThreadName("FrameRecorder");
+
+	for (;;)
+	{
+		unsigned int index;
+		if (!m_queuedBuffers.Pop(index))
+		{
+			// check stopping before the final empty test so nothing submitted before Close is lost
+			if (m_stopping.load(std::memory_order_acquire) && m_queuedBuffers.IsEmpty())
+				break;
+
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			continue;
+		}
+
+		if (!m_writeFailed.load(std::memory_order_relaxed))
+		{
+			if (WriteFrame(&m_pixels[(size_t)index * m_width * m_height]))
+				m_framesWritten.fetch_add(1, std::memory_order_relaxed);
+			else
+				m_writeFailed.store(true, std::memory_order_relaxed);
+		}
+
+		m_freeBuffers.Push(index);
+	}
+
+	fflush(m_file);
+}
+
+bool FrameRecorder::WriteFrame(const uint32_t* pixels)
+{
+	HP_PROFILE_SCOPE("FrameRecorder::WriteFrame");
+
+	const size_t numPixels = (size_t)m_width * m_height;
+	if (m_format == kFrameFormat_Raw)
+	{
+		return fwrite(pixels, sizeof(uint32_t), numPixels, m_file) == numPixels;
+	}
+
+	uint8_t* yPlane = &m_planes[0];
+	uint8_t* uPlane = yPlane + numPixels;
+	uint8_t* vPlane = uPlane + numPixels;
+	for (size_t i = 0; i < numPixels; ++i)
+	{
+		RgbaToYuv(pixels[i], yPlane[i], uPlane[i], vPlane[i]);
+	}
+
+	if (fputs("FRAME\n", m_file) == EOF)
+		return false;
+	return fwrite(yPlane, 1, m_planes.size(), m_file) == m_planes.size();
+}
@@ -0,0 +1,76 @@
+#pragma once
+#ifndef FRAME_RECORDER_H_INCLUDED
+#define FRAME_RECORDER_H_INCLUDED
+
+#include "SpscQueue.h"
+#include <atomic>
+#include <stdint.h>
+#include <stdio.h>
+#include <thread>
+#include <vector>
+
+enum FrameFormat
+{
+	kFrameFormat_Raw = 0,	// native endian RGBA8888 words, ffmpeg -f rawvideo -pix_fmt abgr on little endian
+	kFrameFormat_Y4m,		// YUV4MPEG2 with full resolution 4:4:4 BT.601 planes
+	kNumFrameFormats
+};
+
+// Streams frames to disk on a writer thread. Frame buffers come from a fixed
+// pool allocated by Open and travel between the threads as indices through two
+// lock free queues, so recording never allocates or copies on the game thread.
+// When every buffer is still queued for writing the frame is dropped instead of
+// stalling the game.
+class FrameRecorder
+{
+public:
+	static const unsigned int kNumBuffers = 8;
+
+	FrameRecorder();
+	~FrameRecorder();
+
+	// the format is Y4M if the path ends in .y4m, raw otherwise
+	bool Open(const char* path, unsigned int width, unsigned int height, unsigned int framesPerSecond);
+	// waits for queued frames to be written
+	void Close();
+	bool IsOpen() const { return m_file != nullptr; }
+
+	// Game thread. Returns a width * height pixel buffer to fill, or nullptr when
+	// the writer has fallen behind and this frame must be dropped. A buffer that
+	// isn't submitted is handed out again by the next call.
+	uint32_t* AcquireFrame();
+	void SubmitFrame(uint32_t* pixels);
+	// Game thread. Counts an acquired frame that couldn't be filled as dropped,
+	// its buffer is handed out again.
+	void DropFrame() { ++m_framesDropped; }
+
+	uint64_t GetFramesWritten() const { return m_framesWritten.load(std::memory_order_relaxed); }
+	uint64_t GetFramesDropped() const { return m_framesDropped; }
+
+private:
+	FrameRecorder(const FrameRecorder&);
+	FrameRecorder& operator=(const FrameRecorder&);
+
+	void WriterThread();
+	bool WriteFrame(const uint32_t* pixels);
+
+	FILE* m_file;
+	FrameFormat m_format;
+	unsigned int m_width;
+	unsigned int m_height;
+
+	std::vector<uint32_t> m_pixels;		// every pool buffer in one allocation
+	std::vector<uint8_t> m_planes;		// Y4M conversion, writer thread only
+
+	SpscQueue<unsigned int, kNumBuffers> m_freeBuffers;		// writer to game thread
+	SpscQueue<unsigned int, kNumBuffers> m_queuedBuffers;	// game to writer thread
+	int m_acquiredBuffer;
+
+	std::thread m_writerThread;
+	std::atomic<bool> m_stopping;
+	std::atomic<bool> m_writeFailed;
+	std::atomic<uint64_t> m_framesWritten;
+	uint64_t m_framesDropped;
+};
+
+#endif // FRAME_RECORDER_H_INCLUDED
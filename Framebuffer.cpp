@@ -0,0 +1,300 @@
+#include "Framebuffer.h"
+#include "Debugger.h"
+#include <stdio.h>
+#include <string.h>
+
+#if !defined(HP_FRAMEBUFFER_NO_SIMD) && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+#define HP_FRAMEBUFFER_SSE2 1
+#include <emmintrin.h>
+#else
+#define HP_FRAMEBUFFER_SSE2 0
+#endif
+
+// All blends lerp every channel towards the source colour with its alpha byte
+// treated as 255, so the destination alpha becomes a + d * (1 - a) as well.
+
+//Helper functions
+static inline uint32_t Div255(uint32_t x)
+{
+	x += 128;
+	return (x + (x >> 8)) >> 8;
+}
+
+static inline uint32_t BlendPixel(uint32_t dst, uint32_t src, uint32_t alpha)
+{
+	const uint32_t invAlpha = 255 - alpha;
+	uint32_t out = Div255(255 * alpha + (dst & 0xff) * invAlpha);
+	for (int shift = 8; shift < 32; shift += 8)
+	{
+		const uint32_t s = (src >> shift) & 0xff;
+		const uint32_t d = (dst >> shift) & 0xff;
+		out |= Div255(s * alpha + d * invAlpha) << shift;
+	}
+	return out;
+}
+
+#if HP_FRAMEBUFFER_SSE2
+
+static inline __m128i Div255Epi16(__m128i x)
+{
+	x = _mm_add_epi16(x, _mm_set1_epi16(128));
+	return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+}
+
+// s, d and a hold two pixels as 16 bit channels, every product fits in 16 bits
+static inline __m128i LerpEpi16(__m128i s, __m128i d, __m128i a)
+{
+	const __m128i invA = _mm_sub_epi16(_mm_set1_epi16(255), a);
+	return Div255Epi16(_mm_add_epi16(_mm_mullo_epi16(s, a), _mm_mullo_epi16(d, invA)));
+}
+
+#endif // HP_FRAMEBUFFER_SSE2
+
+//================================================================================
+// span kernels
+
+static void FillSpan(uint32_t* dst, int n, uint32_t rgba)
+{
+	int i = 0;
+#if HP_FRAMEBUFFER_SSE2
+	const __m128i color = _mm_set1_epi32((int)rgba);
+	for (; i + 4 <= n; i += 4)
+	{
+		_mm_storeu_si128((__m128i*)(dst + i), color);
+	}
+#endif
+	for (; i < n; ++i)
+	{
+		dst[i] = rgba;
+	}
+}
+
+static void BlendSpanConstant(uint32_t* dst, int n, uint32_t rgba, uint32_t alpha)
+{
+	int i = 0;
+#if HP_FRAMEBUFFER_SSE2
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i src = _mm_unpacklo_epi8(_mm_set1_epi32((int)(rgba | 0xff)), zero);
+	const __m128i a = _mm_set1_epi16((short)alpha);
+	for (; i + 4 <= n; i += 4)
+	{
+		const __m128i d = _mm_loadu_si128((const __m128i*)(dst + i));
+		const __m128i lo = LerpEpi16(src, _mm_unpacklo_epi8(d, zero), a);
+		const __m128i hi = LerpEpi16(src, _mm_unpackhi_epi8(d, zero), a);
+		_mm_storeu_si128((__m128i*)(dst + i), _mm_packus_epi16(lo, hi));
+	}
+#endif
+	for (; i < n; ++i)
+	{
+		dst[i] = BlendPixel(dst[i], rgba, alpha);
+	}
+}
+
+static void BlendSpanMask(uint32_t* dst, const uint8_t* mask, int n, uint32_t rgba)
+{
+	const uint32_t colorAlpha = rgba & 0xff;
+	int i = 0;
+#if HP_FRAMEBUFFER_SSE2
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i src = _mm_unpacklo_epi8(_mm_set1_epi32((int)(rgba | 0xff)), zero);
+	const __m128i colorA = _mm_set1_epi16((short)colorAlpha);
+	for (; i + 4 <= n; i += 4)
+	{
+		uint32_t mask4;
+		memcpy(&mask4, mask + i, sizeof(mask4));
+		if (mask4 == 0)
+			continue;
+
+		// per pixel coverage, broadcast to the four channels of each pixel
+		__m128i a = Div255Epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128((int)mask4), zero), colorA));
+		a = _mm_unpacklo_epi16(a, a);
+		const __m128i aLo = _mm_unpacklo_epi32(a, a);
+		const __m128i aHi = _mm_unpackhi_epi32(a, a);
+
+		const __m128i d = _mm_loadu_si128((const __m128i*)(dst + i));
+		const __m128i lo = LerpEpi16(src, _mm_unpacklo_epi8(d, zero), aLo);
+		const __m128i hi = LerpEpi16(src, _mm_unpackhi_epi8(d, zero), aHi);
+		_mm_storeu_si128((__m128i*)(dst + i), _mm_packus_epi16(lo, hi));
+	}
+#endif
+	for (; i < n; ++i)
+	{
+		if (mask[i] != 0)
+		{
+			dst[i] = BlendPixel(dst[i], rgba, Div255(mask[i] * colorAlpha));
+		}
+	}
+}
+
+static void BlendSpanImage(uint32_t* dst, const uint32_t* src, int n)
+{
+	int i = 0;
+#if HP_FRAMEBUFFER_SSE2
+	const __m128i zero = _mm_setzero_si128();
+	const __m128i alphaMask = _mm_set1_epi32(0xff);
+	for (; i + 4 <= n; i += 4)
+	{
+		const __m128i s = _mm_loadu_si128((const __m128i*)(src + i));
+		const __m128i alpha = _mm_and_si128(s, alphaMask);
+		const int opaque = _mm_movemask_epi8(_mm_cmpeq_epi32(alpha, alphaMask));
+		if (opaque == 0xffff)
+		{
+			_mm_storeu_si128((__m128i*)(dst + i), s);
+			continue;
+		}
+		if (_mm_movemask_epi8(_mm_cmpeq_epi32(alpha, zero)) == 0xffff)
+			continue;
+
+		// the alpha byte is the lowest channel of each pixel
+		const __m128i sLo = _mm_unpacklo_epi8(s, zero);
+		const __m128i sHi = _mm_unpackhi_epi8(s, zero);
+		const __m128i aLo = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sLo, 0), 0);
+		const __m128i aHi = _mm_shufflehi_epi16(_mm_shufflelo_epi16(sHi, 0), 0);
+		const __m128i solidLo = _mm_or_si128(sLo, _mm_set_epi16(0, 0, 0, 255, 0, 0, 0, 255));
+		const __m128i solidHi = _mm_or_si128(sHi, _mm_set_epi16(0, 0, 0, 255, 0, 0, 0, 255));
+
+		const __m128i d = _mm_loadu_si128((const __m128i*)(dst + i));
+		const __m128i lo = LerpEpi16(solidLo, _mm_unpacklo_epi8(d, zero), aLo);
+		const __m128i hi = LerpEpi16(solidHi, _mm_unpackhi_epi8(d, zero), aHi);
+		_mm_storeu_si128((__m128i*)(dst + i), _mm_packus_epi16(lo, hi));
+	}
+#endif
+	for (; i < n; ++i)
+	{
+		const uint32_t alpha = src[i] & 0xff;
+		if (alpha == 255)
+			dst[i] = src[i];
+		else if (alpha != 0)
+			dst[i] = BlendPixel(dst[i], src[i], alpha);
+	}
+}
+
+//================================================================================
+
+Framebuffer::Framebuffer()
+	: m_width(0)
+	, m_height(0)
+{
+}
+
+void Framebuffer::Resize(unsigned int width, unsigned int height)
+{
+	m_width = width;
+	m_height = height;
+	m_pixels.resize(width * height);
+}
+
+void Framebuffer::Clear(uint32_t rgba)
+{
+	FillSpan(m_pixels.data(), (int)m_pixels.size(), rgba);
+}
+
+bool Framebuffer::Clip(int& srcX, int& srcY, int& w, int& h, int& dstX, int& dstY) const
+{
+	if (dstX < 0)
+	{
+		w += dstX;
+		srcX -= dstX;
+		dstX = 0;
+	}
+	if (dstY < 0)
+	{
+		h += dstY;
+		srcY -= dstY;
+		dstY = 0;
+	}
+	if (dstX + w > (int)m_width)
+		w = (int)m_width - dstX;
+	if (dstY + h > (int)m_height)
+		h = (int)m_height - dstY;
+	return w > 0 && h > 0;
+}
+
+void Framebuffer::FillRect(int x, int y, int w, int h, uint32_t rgba)
+{
+	int srcX = 0;
+	int srcY = 0;
+	if (!Clip(srcX, srcY, w, h, x, y))
+		return;
+
+	const uint32_t alpha = rgba & 0xff;
+	if (alpha == 0)
+		return;
+
+	for (int row = 0; row < h; ++row)
+	{
+		uint32_t* dst = &m_pixels[(y + row) * m_width + x];
+		if (alpha == 255)
+			FillSpan(dst, w, rgba);
+		else
+			BlendSpanConstant(dst, w, rgba, alpha);
+	}
+}
+
+void Framebuffer::DrawRect(int x, int y, int w, int h, uint32_t rgba)
+{
+	if (w <= 0 || h <= 0)
+		return;
+
+	FillRect(x, y, w, 1, rgba);
+	if (h > 1)
+		FillRect(x, y + h - 1, w, 1, rgba);
+	if (h > 2)
+	{
+		FillRect(x, y + 1, 1, h - 2, rgba);
+		if (w > 1)
+			FillRect(x + w - 1, y + 1, 1, h - 2, rgba);
+	}
+}
+
+void Framebuffer::BlendAlphaMask(const uint8_t* mask, unsigned int maskPitch, int dstX, int dstY, int w, int h, uint32_t rgba)
+{
+	HP_ASSERT(mask);
+
+	int srcX = 0;
+	int srcY = 0;
+	if ((rgba & 0xff) == 0 || !Clip(srcX, srcY, w, h, dstX, dstY))
+		return;
+
+	for (int row = 0; row < h; ++row)
+	{
+		BlendSpanMask(&m_pixels[(dstY + row) * m_width + dstX], mask + (srcY + row) * maskPitch + srcX, w, rgba);
+	}
+}
+
+void Framebuffer::Blit(const Framebuffer& src, int srcX, int srcY, int w, int h, int dstX, int dstY)
+{
+	// clip against the source as well as the destination
+	if (srcX < 0)
+	{
+		w += srcX;
+		dstX -= srcX;
+		srcX = 0;
+	}
+	if (srcY < 0)
+	{
+		h += srcY;
+		dstY -= srcY;
+		srcY = 0;
+	}
+	if (srcX + w > (int)src.m_width)
+		w = (int)src.m_width - srcX;
+	if (srcY + h > (int)src.m_height)
+		h = (int)src.m_height - srcY;
+	if (!Clip(srcX, srcY, w, h, dstX, dstY))
+		return;
+
+	for (int row = 0; row < h; ++row)
+	{
+		BlendSpanImage(&m_pixels[(dstY + row) * m_width + dstX], &src.m_pixels[(srcY + row) * src.m_width + srcX], w);
+	}
+}
+
+const char* Framebuffer::GetKernelName()
+{
+#if HP_FRAMEBUFFER_SSE2
+	return "SSE2";
+#else
+	return "scalar";
+#endif
+}
@@ -0,0 +1,49 @@
+#pragma once
+#ifndef FRAMEBUFFER_H_INCLUDED
+#define FRAMEBUFFER_H_INCLUDED
+
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+// An in-memory RGBA8888 image (0xRRGGBBAA per pixel, rows packed with no
+// padding). Fills and alpha blends run through SSE2 kernels where available
+// and a scalar fallback otherwise, both producing identical results. Every
+// operation clips against the image bounds.
+class Framebuffer
+{
+public:
+	Framebuffer();
+
+	void Resize(unsigned int width, unsigned int height);
+
+	unsigned int GetWidth() const { return m_width; }
+	unsigned int GetHeight() const { return m_height; }
+	uint32_t* GetPixels() { return m_pixels.data(); }
+	const uint32_t* GetPixels() const { return m_pixels.data(); }
+	size_t GetSizeBytes() const { return m_pixels.size() * sizeof(uint32_t); }
+
+	void Clear(uint32_t rgba);
+
+	// opaque colours are written directly, anything else is blended
+	void FillRect(int x, int y, int w, int h, uint32_t rgba);
+	void DrawRect(int x, int y, int w, int h, uint32_t rgba);
+
+	// blends rgba using mask * alpha(rgba) as coverage
+	void BlendAlphaMask(const uint8_t* mask, unsigned int maskPitch, int dstX, int dstY, int w, int h, uint32_t rgba);
+
+	// alpha blends a region of src, opaque source pixels are copied
+	void Blit(const Framebuffer& src, int srcX, int srcY, int w, int h, int dstX, int dstY);
+
+	// name of the kernel set compiled in, for logging
+	static const char* GetKernelName();
+
+private:
+	bool Clip(int& srcX, int& srcY, int& w, int& h, int& dstX, int& dstY) const;
+
+	unsigned int m_width;
+	unsigned int m_height;
+	std::vector<uint32_t> m_pixels;
+};
+
+#endif // FRAMEBUFFER_H_INCLUDED
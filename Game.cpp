@@ -1,15 +1,25 @@
 #include "Game.h"
 #include "Debugger.h"
+#include "FieldKernels.h"
 #include "Render.h"
+#include <atomic>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 #include <time.h>
 
 //vars
-static const unsigned int s_kFieldWidth = 10;
-static const unsigned int s_kFieldHeight = 20;
 static const unsigned int s_initialFramesPerStep = 48;
 static const int s_deltaFramesPerStepPerLevel = 2;
+// soft drop falls this many times faster, and at least a cell a frame
+static const uint32_t s_kSoftDropGravityFactor = 20;
+static const float s_fpsSamplePeriodSeconds = 0.25f;
+static const unsigned int s_kBlockSizePixels = 32;
+static const unsigned int s_kEmptyBlockRgba = 0x202020ff;
+static const unsigned int s_kBlockOutlineRgba = 0x404040ff;
+static const unsigned int s_kGarbageBlockRgba = 0x808080ff;
+// garbage sent for clearing 0, 1, 2, 3 and 4 lines at once
+static const unsigned int s_kGarbageLinesForClear[] = { 0, 0, 1, 2, 4 };
 
 //-----------------------------------------------------------------------------------
 
@@ -94,6 +104,192 @@ static bool isOverLap(const TetrominoInstance& instance, const Field& field)
 	return false;
 }
 
+//---------------------------------------------------------------------------------------
+
+static const char* const s_kRotationSystemNames[kNumRotationSystems] = { "srs", "classic" };
+
+// SRS written as per rotation offsets, x right and y up as the guideline has
+// them. The kicks from one rotation to another are the from offsets minus the
+// to offsets, less the first of those, since the shape tables already turn
+// each piece about its own centre.
+static constexpr int s_kSrsOffsetsJlstz[Tetromino::kNumRots][RotationKicks::kMaxTests][2] =
+{
+	{ { 0, 0 }, { 0, 0 }, { 0, 0 }, { 0, 0 }, { 0, 0 } },
+	{ { 0, 0 }, { 1, 0 }, { 1, -1 }, { 0, 2 }, { 1, 2 } },
+	{ { 0, 0 }, { 0, 0 }, { 0, 0 }, { 0, 0 }, { 0, 0 } },
+	{ { 0, 0 }, { -1, 0 }, { -1, -1 }, { 0, 2 }, { -1, 2 } },
+};
+static constexpr int s_kSrsOffsetsI[Tetromino::kNumRots][RotationKicks::kMaxTests][2] =
+{
+	{ { 0, 0 }, { -1, 0 }, { 2, 0 }, { -1, 0 }, { 2, 0 } },
+	{ { -1, 0 }, { 0, 0 }, { 0, 0 }, { 0, 1 }, { 0, -2 } },
+	{ { -1, 1 }, { 1, 1 }, { -2, 1 }, { 1, 0 }, { -2, 0 } },
+	{ { 0, 1 }, { 0, 1 }, { 0, 1 }, { 0, -1 }, { 0, 2 } },
+};
+
+struct RotationKickTable
+{
+	RotationKicks kicks[kNumRotationSystems][kNumTetrominoTypes][Tetromino::kNumRots][Tetromino::kNumRots];
+};
+
+static constexpr RotationKickTable BuildRotationKickTable()
+{
+	RotationKickTable table = {};
+	for (unsigned int system = 0; system < kNumRotationSystems; ++system)
+	{
+		for (unsigned int type = 0; type < kNumTetrominoTypes; ++type)
+		{
+			for (unsigned int from = 0; from < Tetromino::kNumRots; ++from)
+			{
+				for (unsigned int to = 0; to < Tetromino::kNumRots; ++to)
+				{
+					RotationKicks& kicks = table.kicks[system][type][from][to];
+					if ((from + 1) % Tetromino::kNumRots != to && (to + 1) % Tetromino::kNumRots != from)
+						continue;
+
+					kicks.numTests = 1;
+					if (system == kRotationSystem_Classic || type == kTetrominoType_O)
+						continue;
+
+					const int (*offsets)[RotationKicks::kMaxTests][2] = type == kTetrominoType_I ? s_kSrsOffsetsI : s_kSrsOffsetsJlstz;
+					for (unsigned int i = 0; i < RotationKicks::kMaxTests; ++i)
+					{
+						kicks.offsets[i].x = (offsets[from][i][0] - offsets[to][i][0]) - (offsets[from][0][0] - offsets[to][0][0]);
+						kicks.offsets[i].y = -((offsets[from][i][1] - offsets[to][i][1]) - (offsets[from][0][1] - offsets[to][0][1]));
+					}
+					kicks.numTests = RotationKicks::kMaxTests;
+				}
+			}
+		}
+	}
+	return table;
+}
+
+static constexpr RotationKickTable s_kRotationKicks = BuildRotationKickTable();
+
+// spot checks against the guideline's kick tables, with y flipped
+static_assert(s_kRotationKicks.kicks[kRotationSystem_Srs][kTetrominoType_T][0][1].offsets[2].x == -1
+	&& s_kRotationKicks.kicks[kRotationSystem_Srs][kTetrominoType_T][0][1].offsets[2].y == -1, "SRS T 0->R");
+static_assert(s_kRotationKicks.kicks[kRotationSystem_Srs][kTetrominoType_I][0][1].offsets[1].x == -2
+	&& s_kRotationKicks.kicks[kRotationSystem_Srs][kTetrominoType_I][0][1].offsets[4].y == -2, "SRS I 0->R");
+static_assert(s_kRotationKicks.kicks[kRotationSystem_Srs][kTetrominoType_I][3][0].offsets[3].x == 1
+	&& s_kRotationKicks.kicks[kRotationSystem_Srs][kTetrominoType_I][3][0].offsets[3].y == 2, "SRS I L->0");
+static_assert(s_kRotationKicks.kicks[kRotationSystem_Srs][kTetrominoType_O][0][1].numTests == 1, "O doesn't kick");
+static_assert(s_kRotationKicks.kicks[kRotationSystem_Srs][kTetrominoType_T][0][2].numTests == 0, "quarter turns only");
+
+const Tetromino& GetTetromino(TetrominoType type)
+{
+	HP_ASSERT(type < kNumTetrominoTypes);
+	return s_tetrominos[type];
+}
+
+static uint32_t GetBlockRgba(unsigned int blockSprite)
+{
+	if (blockSprite < kNumTetrominoTypes)
+		return s_tetrominos[blockSprite].rgba;
+	return blockSprite == kBlockSprite_Garbage ? s_kGarbageBlockRgba : s_kEmptyBlockRgba;
+}
+
+void GetBlockRgbas(uint32_t* rgbas)
+{
+	for (unsigned int i = 0; i < kNumBlockSprites; ++i)
+	{
+		rgbas[i] = GetBlockRgba(i);
+	}
+}
+
+bool DoesTetrominoOverlap(const TetrominoInstance& instance, const Field& field)
+{
+	return isOverLap(instance, field);
+}
+
+unsigned int GetTetrominoDropDistance(const TetrominoInstance& instance, const Field& field)
+{
+	HP_ASSERT(!isOverLap(instance, field));
+	const Tetromino::BlockCoords& blockCoords = s_tetrominos[instance.m_tetrominoType].blockCoord[instance.m_rot];
+
+	// only the lowest block in each column can land on anything
+	unsigned int dropDistance = field.height;
+	for (unsigned int i = 0; i < Tetromino::kNumBlocks; ++i)
+	{
+		bool lowestInColumn = true;
+		for (unsigned int j = 0; j < Tetromino::kNumBlocks; ++j)
+		{
+			lowestInColumn &= blockCoords[j].x != blockCoords[i].x || blockCoords[j].y <= blockCoords[i].y;
+		}
+		if (!lowestInColumn)
+			continue;
+
+		const unsigned int x = (unsigned int)(instance.m_pos.x + (int)blockCoords[i].x);
+		const unsigned int y = (unsigned int)(instance.m_pos.y + (int)blockCoords[i].y);
+		unsigned int below = y + 1;
+		while (below < field.height && below - y - 1 < dropDistance && field.staticBlocks[below * field.width + x] == -1)
+		{
+			++below;
+		}
+		if (below - y - 1 < dropDistance)
+			dropDistance = below - y - 1;
+	}
+	return dropDistance;
+}
+
+// The old frames per cell, 48 at level 0 and 2 fewer a level, until a cell a
+// frame at level 24, after which gravity doubles a level up to 20G.
+static uint32_t GetLevelGravity(unsigned int level)
+{
+	const unsigned int numLevelsToOneCell = (s_initialFramesPerStep - 1) / s_deltaFramesPerStepPerLevel + 1;
+	if (level < numLevelsToOneCell)
+	{
+		const uint32_t framesPerStep = s_initialFramesPerStep - s_deltaFramesPerStepPerLevel * level;
+		// rounded up so a piece still falls on the last frame of its step
+		return (Game::kGravityOneCell + framesPerStep - 1) / framesPerStep;
+	}
+	const unsigned int numDoublings = level - numLevelsToOneCell;
+	return numDoublings >= 5 ? Game::kGravity20G : Game::kGravityOneCell << numDoublings;
+}
+
+const char* GetRotationSystemName(RotationSystem system)
+{
+	HP_ASSERT(system < kNumRotationSystems);
+	return s_kRotationSystemNames[system];
+}
+
+RotationSystem FindRotationSystem(const char* name)
+{
+	for (unsigned int i = 0; i < kNumRotationSystems; ++i)
+	{
+		if (strcmp(s_kRotationSystemNames[i], name) == 0)
+			return (RotationSystem)i;
+	}
+	return kNumRotationSystems;
+}
+
+const RotationKicks& GetRotationKicks(RotationSystem system, TetrominoType type, unsigned int fromRot, unsigned int toRot)
+{
+	HP_ASSERT(system < kNumRotationSystems && type < kNumTetrominoTypes);
+	HP_ASSERT(fromRot < Tetromino::kNumRots && toRot < Tetromino::kNumRots);
+	return s_kRotationKicks.kicks[system][type][fromRot][toRot];
+}
+
+bool RotateTetromino(TetrominoInstance& instance, bool clockwise, RotationSystem system, const Field& field)
+{
+	const unsigned int toRot = (instance.m_rot + (clockwise ? 1 : Tetromino::kNumRots - 1)) % Tetromino::kNumRots;
+	const RotationKicks& kicks = GetRotationKicks(system, instance.m_tetrominoType, instance.m_rot, toRot);
+	TetrominoInstance testInstance = instance;
+	testInstance.m_rot = toRot;
+	for (unsigned int i = 0; i < kicks.numTests; ++i)
+	{
+		testInstance.m_pos.x = instance.m_pos.x + kicks.offsets[i].x;
+		testInstance.m_pos.y = instance.m_pos.y + kicks.offsets[i].y;
+		if (!isOverLap(testInstance, field))
+		{
+			instance = testInstance;
+			return true;
+		}
+	}
+	return false;
+}
+
 static void SetBlock(Field & field, unsigned int ix, unsigned int iy, unsigned int val)
 {
 	HP_ASSERT(ix < field.width);
@@ -105,16 +301,50 @@ static void SetBlock(Field & field, unsigned int ix, unsigned int iy, unsigned i
 
 Game::Game()
 	: m_deltaTimeSeconds(0.0f)
-	, m_framesUntilFall(s_initialFramesPerStep)
-	, m_framesPerFallStep(s_initialFramesPerStep)
+	, m_rotationSystem(kRotationSystem_Srs)
+	, m_renderResourcesCreated(false)
+	, m_blockAtlas(0)
+	, m_fieldTarget(0)
+	, m_fieldTargetGeneration(0)
+	, m_fieldDirtyRowBegin(0)
+	, m_fieldDirtyRowEnd(0)
+	, m_stateVersion(0)
+	, m_rngState(0)
+	, m_pendingGarbageLines(0)
+	, m_garbageLinesSent(0)
+	, m_fallProgress(0)
+	, m_fixedGravity(0)
 	, m_numUserDropsForTetromino(0)
 	, m_numLinesCleared(0)
 	, m_Level(0)
 	, m_score(0)
 	, m_hiScore(0)
 	, m_gameState(kGameState_TitleScreen)
+	, m_fpsSampleSeconds(0.0f)
+	, m_fpsSampleFrames(0)
+	, m_fpsText("FPS: %.1f", 0x8080ffff)
+	, m_titleText("Press Space To Start", 0xffffffff)
+	, m_gameOverText("GAME OVER", 0xffffffff)
+	, m_linesText("Lines: %u", 0xffffffff)
+	, m_levelText("Level: %u", 0xffffffff)
+	, m_scoreText("Score: %u", 0xffffffff)
+	, m_hiScoreText("High score: %u", 0xffffffff)
+#ifdef _DEBUG
+	, m_gravityText("Gravity: %.3f", 0X404040ff)
+#endif
 {
+	m_field.width = 0;
+	m_field.height = 0;
 	m_field.staticBlocks = nullptr;
+	m_activeTetromino.m_tetrominoType = kTetrominoType_I;
+	m_activeTetromino.m_pos.x = 0;
+	m_activeTetromino.m_pos.y = 0;
+	m_activeTetromino.m_rot = 0;
+	m_fpsText.SetValue(0.0f);
+
+	// games created in the same second still get different pieces, on any thread
+	static std::atomic<uint32_t> s_numGamesCreated(0);
+	SetSeed((uint32_t)time(NULL) ^ ((s_numGamesCreated.fetch_add(1, std::memory_order_relaxed) + 1) * 0x9e3779b9u));
 }
 
 Game::~Game()
@@ -134,11 +364,124 @@ void Game::Shutdown()
 
 void Game::Reset()
 {
+	// whatever state the game was in, the next start begins a new one
+	m_gameState = kGameState_TitleScreen;
+	++m_stateVersion;
+}
+
+void Game::SetSeed(uint32_t seed)
+{
+	// xorshift gets stuck on zero
+	m_rngState = seed != 0 ? seed : 0x6d2b79f5u;
+}
+
+uint32_t Game::NextRandom()
+{
+	// xorshift32, the same on every platform unlike rand()
+	uint32_t x = m_rngState;
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	m_rngState = x;
+	return x;
+}
+
+void Game::SaveSnapshot(Snapshot& snapshot) const
+{
+	snapshot.hasField = m_field.staticBlocks != nullptr;
+	if (snapshot.hasField)
+	{
+		memcpy(snapshot.staticBlocks, m_field.staticBlocks, sizeof(snapshot.staticBlocks));
+	}
+	snapshot.activeTetromino = m_activeTetromino;
+	snapshot.fallProgress = m_fallProgress;
+	snapshot.numUserDropsForTetromino = m_numUserDropsForTetromino;
+	snapshot.numLinesCleared = m_numLinesCleared;
+	snapshot.level = m_Level;
+	snapshot.score = m_score;
+	snapshot.hiScore = m_hiScore;
+	snapshot.gameState = (unsigned int)m_gameState;
+	snapshot.rngState = m_rngState;
+	snapshot.pendingGarbageLines = m_pendingGarbageLines;
+	snapshot.garbageLinesSent = m_garbageLinesSent;
+}
+
+void Game::LoadSnapshot(const Snapshot& snapshot)
+{
+	if (snapshot.hasField)
+	{
+		if (!m_field.staticBlocks)
+		{
+			m_field.width = kFieldWidth;
+			m_field.height = kFieldHeight;
+			m_field.staticBlocks = new int[m_field.width * m_field.height];
+		}
+		memcpy(m_field.staticBlocks, snapshot.staticBlocks, sizeof(snapshot.staticBlocks));
+		MarkFieldRowsDirty(0, m_field.height);
+	}
+	else
+	{
+		delete[] m_field.staticBlocks;
+		m_field.staticBlocks = nullptr;
+	}
+	m_activeTetromino = snapshot.activeTetromino;
+	m_fallProgress = snapshot.fallProgress;
+	m_numUserDropsForTetromino = snapshot.numUserDropsForTetromino;
+	m_numLinesCleared = snapshot.numLinesCleared;
+	m_Level = snapshot.level;
+	m_score = snapshot.score;
+	m_hiScore = snapshot.hiScore;
+	m_gameState = (GameState)snapshot.gameState;
+	m_rngState = snapshot.rngState;
+	m_pendingGarbageLines = snapshot.pendingGarbageLines;
+	m_garbageLinesSent = snapshot.garbageLinesSent;
+	++m_stateVersion;
+}
+
+uint32_t Game::GetGravity() const
+{
+	return m_fixedGravity != 0 ? m_fixedGravity : GetLevelGravity(m_Level);
+}
+
+void Game::AddGarbageLines(unsigned int numLines)
+{
+	m_pendingGarbageLines += numLines;
+}
+
+void Game::InsertGarbageRows(unsigned int numRows)
+{
+	const unsigned int width = m_field.width;
+	const unsigned int height = m_field.height;
+	if (numRows > height)
+		numRows = height;
+
+	// anything pushed off the top ends the game
+	for (unsigned int y = 0; y < numRows; ++y)
+	{
+		if (!IsFieldRowEmpty(m_field.staticBlocks + y * width, width))
+		{
+			m_gameState = kGameState_GameOver;
+			break;
+		}
+	}
+
+	memmove(m_field.staticBlocks, m_field.staticBlocks + numRows * width, (height - numRows) * width * sizeof(int));
+
+	// one hole per batch, in the same column, so it can be dug out
+	const unsigned int holeX = NextRandom() % width;
+	for (unsigned int iy = height - numRows; iy < height; ++iy)
+	{
+		for (unsigned int ix = 0; ix < width; ++ix)
+		{
+			m_field.staticBlocks[iy * width + ix] = ix == holeX ? -1 : (int)kBlockSprite_Garbage;
+		}
+	}
+	MarkFieldRowsDirty(0, height);
 }
 
 bool Game::SpawnTetromino()
 {
-	m_activeTetromino.m_tetrominoType = (TetrominoType)(rand() % kNumTetrominoTypes);
+	m_activeTetromino.m_tetrominoType = (TetrominoType)(NextRandom() % kNumTetrominoTypes);
 	m_activeTetromino.m_rot = 0;
 	m_activeTetromino.m_pos.x = (m_field.width - 4) / 2;
 	m_activeTetromino.m_pos.y = 0;
@@ -148,15 +491,20 @@ bool Game::SpawnTetromino()
 		return false;
 	}
 
-	m_framesUntilFall = s_initialFramesPerStep;
+	m_fallProgress = 0;
 	m_numUserDropsForTetromino = 0;
 	return true;
 }
 
 void Game::Update(const GameInput & input, float deltaTimeSeconds)
 {
+	HP_PROFILE_SCOPE("Game::Update");
+
 	m_deltaTimeSeconds = deltaTimeSeconds;
 
+	const GameState previousGameState = m_gameState;
+	const TetrominoInstance previousTetromino = m_activeTetromino;
+
 	switch (m_gameState)
 	{
 	case kGameState_TitleScreen:
@@ -179,14 +527,25 @@ void Game::Update(const GameInput & input, float deltaTimeSeconds)
 	default:
 		HP_FATAL_ERROR("Unhandled case");
 	}
+
+	// field changes bump the version where they happen
+	if (m_gameState != previousGameState
+		|| m_activeTetromino.m_tetrominoType != previousTetromino.m_tetrominoType
+		|| m_activeTetromino.m_pos.x != previousTetromino.m_pos.x
+		|| m_activeTetromino.m_pos.y != previousTetromino.m_pos.y
+		|| m_activeTetromino.m_rot != previousTetromino.m_rot)
+	{
+		++m_stateVersion;
+	}
 }
 
 void Game::InitPlaying()
 {
-	m_field.width = s_kFieldWidth;
-	m_field.height = s_kFieldHeight;
-	delete[] m_field.staticBlocks;
-	m_field.staticBlocks = new int[m_field.width * m_field.height];
+	m_field.width = kFieldWidth;
+	m_field.height = kFieldHeight;
+	// the size never changes, so a new game reuses the last one's field
+	if (!m_field.staticBlocks)
+		m_field.staticBlocks = new int[m_field.width * m_field.height];
 
 	for (unsigned int iy = 0; iy < m_field.height; ++iy)
 	{
@@ -195,14 +554,15 @@ void Game::InitPlaying()
 			m_field.staticBlocks[iy * m_field.width + ix] = -1;
 		}
 	}
-
-	srand((unsigned int)time(NULL));
+	MarkFieldRowsDirty(0, m_field.height);
+	++m_stateVersion;
 
 	SpawnTetromino();
 
+	m_pendingGarbageLines = 0;
+	m_garbageLinesSent = 0;
 	m_numLinesCleared = 0;
 	m_Level = 0;
-	m_framesPerFallStep = s_initialFramesPerStep;
 	m_score = 0;
 }
 
@@ -252,73 +612,51 @@ void Game::UpdatePlaying(const GameInput & input)
 	//rotate
 	if (input.rotClockwise)
 	{
-		TetrominoInstance testInstace = m_activeTetromino;
-		if (testInstace.m_rot == 0)
-		{
-			testInstace.m_rot = 3;
-		}
-		else
-		{
-			--testInstace.m_rot;
-		}
-
-		if (isOverLap(testInstace, m_field))
-		{
-			testInstace.m_pos.x = m_activeTetromino.m_pos.x - 1;
-			if (!isOverLap(testInstace, m_field))
-			{
-				m_activeTetromino = testInstace;
-			}
-			else
-			{
-				testInstace.m_pos.x = m_activeTetromino.m_pos.x + 1;
-				if (!isOverLap(testInstace, m_field))
-				{
-					m_activeTetromino = testInstace;
-				}
-			}
-		}
-		else
-		{
-			m_activeTetromino = testInstace;
-		}
+		RotateTetromino(m_activeTetromino, true, m_rotationSystem, m_field);
 	}
 
 	if (input.rotAnticlockwise)
 	{
-		m_activeTetromino.m_rot = (m_activeTetromino.m_rot + 1) % Tetromino::kNumRots;
+		RotateTetromino(m_activeTetromino, false, m_rotationSystem, m_field);
 	}
 
-	m_framesUntilFall -= 1;
-	if (m_framesUntilFall <= 0)
+	// all the cells due this frame fall at once, as far as the piece can go,
+	// and a piece that is due to fall but already landed locks
+	uint32_t gravity = GetGravity();
+	if (input.softDrop)
 	{
-		m_framesUntilFall = m_framesPerFallStep;
-
-		TetrominoInstance testInstance = m_activeTetromino;
-		testInstance.m_pos.y += 1;
-		if (isOverLap(testInstance, m_field))
+		gravity *= s_kSoftDropGravityFactor;
+		gravity = gravity > kGravityOneCell ? gravity : kGravityOneCell;
+	}
+	m_fallProgress += gravity;
+	const unsigned int numCellsDue = m_fallProgress >> kGravityFractionBits;
+	m_fallProgress &= kGravityOneCell - 1;
+	if (numCellsDue > 0)
+	{
+		const unsigned int dropDistance = GetTetrominoDropDistance(m_activeTetromino, m_field);
+		if (dropDistance == 0)
 		{
 			AddTetronimoToField(m_field, m_activeTetromino);
-				if (!SpawnTetromino())
-					m_gameState = kGameState_GameOver;
+			if (!SpawnTetromino())
+				m_gameState = kGameState_GameOver;
 		}
 		else
 		{
-			m_activeTetromino.m_pos.y = testInstance.m_pos.y;
+			const unsigned int numCells = numCellsDue < dropDistance ? numCellsDue : dropDistance;
+			m_activeTetromino.m_pos.y += (int)numCells;
+			if (input.softDrop)
+				m_numUserDropsForTetromino += numCells;
 		}
 	}
 
-	if (input.hardDrop)
+	// gravity may have just topped out
+	if (input.hardDrop && m_gameState == kGameState_Playing)
 	{
-		TetrominoInstance testInstace = m_activeTetromino;
-		while (!isOverLap(testInstace, m_field))
-		{
-			++testInstace.m_pos.y;
-			++m_numUserDropsForTetromino;
-		}
-		--testInstace.m_pos.y;
-		--m_numUserDropsForTetromino;
-		AddTetronimoToField(m_field, testInstace);
+		TetrominoInstance droppedInstance = m_activeTetromino;
+		const unsigned int dropDistance = GetTetrominoDropDistance(droppedInstance, m_field);
+		droppedInstance.m_pos.y += (int)dropDistance;
+		m_numUserDropsForTetromino += dropDistance;
+		AddTetronimoToField(m_field, droppedInstance);
 		if (!SpawnTetromino())
 			m_gameState = kGameState_GameOver;
 	}
@@ -326,8 +664,14 @@ void Game::UpdatePlaying(const GameInput & input)
 
 void Game::AddTetronimoToField(const Field & field, const TetrominoInstance & instance)
 {
+	HP_PROFILE_SCOPE("Game::AddTetronimoToField");
+
+	++m_stateVersion;
+
 	const Tetromino& tetromino = s_tetrominos[instance.m_tetrominoType];
 	const Tetromino::BlockCoords& blockCoords = tetromino.blockCoord[instance.m_rot];
+	unsigned int pieceRowBegin = field.height;
+	unsigned int pieceRowEnd = 0;
 	for (unsigned int i = 0; i < Tetromino::kNumBlocks; ++i)
 	{
 		const int x = instance.m_pos.x + blockCoords[i].x;
@@ -335,46 +679,30 @@ void Game::AddTetronimoToField(const Field & field, const TetrominoInstance & in
 
 		HP_ASSERT((x >= 0) && (x < (int)field.width && (y >= 0) && (y < (int)field.height)))
 			field.staticBlocks[x + y * field.width] = (unsigned int)instance.m_tetrominoType;
+		MarkFieldRowsDirty(y, y + 1);
+		pieceRowBegin = (unsigned int)y < pieceRowBegin ? (unsigned int)y : pieceRowBegin;
+		pieceRowEnd = (unsigned int)y + 1 > pieceRowEnd ? (unsigned int)y + 1 : pieceRowEnd;
 	}
 
-	unsigned int numLinesCleared = 0;
-	for (unsigned int y = 0; y < field.height; ++y)
-	{
-		bool RowFull = true;
-		for (unsigned int x = 0; x < field.width; ++x)
-		{
-			if (field.staticBlocks[x + y * field.width] == -1)
-			{
-				RowFull = false;
-				break;
-			}
-		}
-
-		if (RowFull)
-		{
-			++numLinesCleared;
-
-			for (unsigned int yy = y; yy > 0; --yy)
-			{
-				for (unsigned int x = 0; x < field.width; ++x)
-				{
-					field.staticBlocks[x + yy * field.width] = field.staticBlocks[x + (yy - 1) * field.width];
-				}
-			}
-		}
-	}
+	// only rows the piece landed in can have filled up
+	const unsigned int numLinesCleared = RemoveFullFieldRows(field.staticBlocks, field.width, field.height, pieceRowBegin, pieceRowEnd);
+	if (numLinesCleared > 0)
+		MarkFieldRowsDirty(0, pieceRowEnd);
 
 	unsigned int previousLevel = m_numLinesCleared / 10;
 	m_numLinesCleared += numLinesCleared;
 	m_Level = m_numLinesCleared / 10;
 
-	if (m_Level != previousLevel)
+	// clears cancel queued garbage before sending any
+	unsigned int garbageLines = s_kGarbageLinesForClear[numLinesCleared];
+	const unsigned int cancelledLines = garbageLines < m_pendingGarbageLines ? garbageLines : m_pendingGarbageLines;
+	m_pendingGarbageLines -= cancelledLines;
+	garbageLines -= cancelledLines;
+	m_garbageLinesSent += garbageLines;
+	if (numLinesCleared == 0 && m_pendingGarbageLines > 0)
 	{
-		m_framesPerFallStep -= s_deltaFramesPerStepPerLevel;
-		if (m_framesPerFallStep < 1)
-		{
-			m_framesPerFallStep = 1;
-		}
+		InsertGarbageRows(m_pendingGarbageLines);
+		m_pendingGarbageLines = 0;
 	}
 
 	if (numLinesCleared > 0)
@@ -408,28 +736,36 @@ void Game::Draw(Renderer & renderer)
 	switch (m_gameState)
 	{
 	case kGameState_TitleScreen:
-		renderer.DrawText("Press Space To Start", renderer.GetWidth() / 2 - 100, renderer.GetHeight() / 2);
+		m_titleText.Draw(renderer, renderer.GetWidth() / 2 - 100, renderer.GetHeight() / 2);
 		break;
 	case kGameState_Playing:
 		DrawPlaying(renderer);
 		break;
 	case kGameState_GameOver:
 		DrawPlaying(renderer);
-		renderer.DrawText("GAME OVER", renderer.GetWidth() / 2 - 100, renderer.GetHeight() / 2, 0xffffffff);
+		m_gameOverText.Draw(renderer, renderer.GetWidth() / 2 - 100, renderer.GetHeight() / 2);
 		break;
 	default:
 		HP_FATAL_ERROR("Unhandled Case");
 	}
 
-	float fps = 1.0f / m_deltaTimeSeconds;
-	char text[128];
-	snprintf(text, sizeof(text), "FPS: %.1f", fps);
-	renderer.DrawText(text, 0, 0, 0x8080ffff);
+	// averaged over a short period so the text isn't rasterized every frame
+	m_fpsSampleSeconds += m_deltaTimeSeconds;
+	++m_fpsSampleFrames;
+	if (m_fpsSampleSeconds >= s_fpsSamplePeriodSeconds)
+	{
+		m_fpsText.SetValue((float)m_fpsSampleFrames / m_fpsSampleSeconds);
+		m_fpsSampleSeconds = 0.0f;
+		m_fpsSampleFrames = 0;
+	}
+	m_fpsText.Draw(renderer, 0, 0);
 }
 
 void Game::DrawPlaying(Renderer& renderer)
 {
-	static unsigned int blockSizePixels = 32;
+	HP_PROFILE_SCOPE("Game::DrawPlaying");
+
+	const unsigned int blockSizePixels = s_kBlockSizePixels;
 
 	unsigned int fieldWidthPixels = m_field.width * blockSizePixels;
 	unsigned int fieldHeightPixels = m_field.height * blockSizePixels;
@@ -446,49 +782,170 @@ void Game::DrawPlaying(Renderer& renderer)
 		fieldOffsetPixelsY = (renderer.GetHeight() - fieldHeightPixels) / 2;
 	}
 
-	for (unsigned int iy = 0; iy < m_field.height; ++iy)
+	if (!m_renderResourcesCreated)
 	{
-		const unsigned int y = fieldOffsetPixelsY + iy * blockSizePixels;
+		CreateRenderResources(renderer);
+	}
+	else if (m_fieldTargetGeneration != renderer.GetRenderTargetGeneration())
+	{
+		m_fieldTargetGeneration = renderer.GetRenderTargetGeneration();
+		MarkFieldRowsDirty(0, m_field.height);
+	}
 
-		for (unsigned int ix = 0; ix < m_field.width; ++ix)
+	if (m_fieldTarget != 0)
+	{
+		if (m_fieldDirtyRowBegin < m_fieldDirtyRowEnd)
 		{
-			const unsigned int x = fieldOffsetPixelsX + ix * blockSizePixels;
-
-			const int blockState = m_field.staticBlocks[iy * m_field.width + ix];
-			unsigned int blockRgba = 0x202020ff;
-			if (blockState != -1)
-			{
-				HP_ASSERT(blockState < kNumTetrominoTypes);
-				blockRgba = s_tetrominos[blockState].rgba;
-			}
-
-			renderer.DrawSolidRect(x, y, blockSizePixels, blockSizePixels, blockRgba);
-			renderer.DrawRect(x, y, blockSizePixels, blockSizePixels, 0X404040ff);
+			renderer.SetRenderTarget(m_fieldTarget);
+			DrawFieldRows(renderer, m_fieldDirtyRowBegin, m_fieldDirtyRowEnd, 0, 0);
+			renderer.SetRenderTarget(0);
+			m_fieldDirtyRowBegin = 0;
+			m_fieldDirtyRowEnd = 0;
 		}
+		renderer.DrawTexture(m_fieldTarget, fieldOffsetPixelsX, fieldOffsetPixelsY);
+	}
+	else
+	{
+		// no render target support, draw the whole field every frame
+		DrawFieldRows(renderer, 0, m_field.height, fieldOffsetPixelsX, fieldOffsetPixelsY);
 	}
 
 	for (unsigned int i = 0; i < 4; ++i)
 	{
 		const Tetromino& tetromino = s_tetrominos[m_activeTetromino.m_tetrominoType];
 		const Tetromino::BlockCoords& blockCoords = tetromino.blockCoord[m_activeTetromino.m_rot];
-		unsigned int tetrominoRgba = tetromino.rgba;
 		const unsigned int x = fieldOffsetPixelsX + (m_activeTetromino.m_pos.x + blockCoords[i].x) * blockSizePixels;
 		const unsigned int y = fieldOffsetPixelsY + (m_activeTetromino.m_pos.y + blockCoords[i].y) * blockSizePixels;
-		renderer.DrawSolidRect(x, y, blockSizePixels, blockSizePixels, tetrominoRgba);
+		DrawBlock(renderer, m_activeTetromino.m_tetrominoType, x, y);
 	}
+	renderer.FlushBatch();
 
-	char text[128];
-	snprintf(text, sizeof(text), "Lines: %u", m_numLinesCleared);
-	renderer.DrawText(text, 0, 100, 0xffffffff);
-	snprintf(text, sizeof(text), "Level: %u", m_Level);
-	renderer.DrawText(text, 0, 140, 0xffffffff);
-	snprintf(text, sizeof(text), "Score: %u", m_score);
-	renderer.DrawText(text, 0, 180, 0xffffffff);
-	snprintf(text, sizeof(text), "High score: %u", m_hiScore);
-	renderer.DrawText(text, 0, 220, 0xffffffff);
+	m_linesText.SetValue(m_numLinesCleared);
+	m_linesText.Draw(renderer, 0, 100);
+	m_levelText.SetValue(m_Level);
+	m_levelText.Draw(renderer, 0, 140);
+	m_scoreText.SetValue(m_score);
+	m_scoreText.Draw(renderer, 0, 180);
+	m_hiScoreText.SetValue(m_hiScore);
+	m_hiScoreText.Draw(renderer, 0, 220);
 
 #ifdef _DEBUG
-	snprintf(text, sizeof(text), "Frames per fall: %u", m_framesPerFallStep);
-	renderer.DrawText(text, 0, 400, 0X404040ff);
+	m_gravityText.SetValue((float)GetGravity() / kGravityOneCell);
+	m_gravityText.Draw(renderer, 0, 400);
 #endif
-}
\ No newline at end of file
+}
+
+void Game::CreateRenderResources(Renderer& renderer)
+{
+	uint32_t blockRgbas[kNumBlockSprites];
+	GetBlockRgbas(blockRgbas);
+	m_blockAtlas = renderer.CreateBlockAtlas(blockRgbas, kNumBlockSprites, s_kBlockSizePixels);
+
+	m_fieldTarget = renderer.CreateRenderTarget(m_field.width * s_kBlockSizePixels, m_field.height * s_kBlockSizePixels);
+	m_fieldTargetGeneration = renderer.GetRenderTargetGeneration();
+	MarkFieldRowsDirty(0, m_field.height);
+
+	m_renderResourcesCreated = true;
+}
+
+void Game::DrawFieldRows(Renderer& renderer, unsigned int rowBegin, unsigned int rowEnd, int offsetPixelsX, int offsetPixelsY)
+{
+	const unsigned int blockSizePixels = s_kBlockSizePixels;
+
+	for (unsigned int iy = rowBegin; iy < rowEnd; ++iy)
+	{
+		const unsigned int y = offsetPixelsY + iy * blockSizePixels;
+
+		for (unsigned int ix = 0; ix < m_field.width; ++ix)
+		{
+			const unsigned int x = offsetPixelsX + ix * blockSizePixels;
+
+			const int blockState = m_field.staticBlocks[iy * m_field.width + ix];
+			unsigned int blockIndex = kBlockSprite_Empty;
+			if (blockState != -1)
+			{
+				HP_ASSERT(blockState < kBlockSprite_Empty);
+				blockIndex = (unsigned int)blockState;
+			}
+
+			DrawBlock(renderer, blockIndex, x, y);
+		}
+	}
+
+	// submit now so the active piece is drawn over the field
+	renderer.FlushBatch();
+}
+
+void Game::DrawBlock(Renderer& renderer, unsigned int blockIndex, int x, int y)
+{
+	if (m_blockAtlas != 0)
+	{
+		renderer.BatchSprite(m_blockAtlas, blockIndex, x, y);
+		return;
+	}
+
+	// no atlas, fall back to fill plus outline
+	const unsigned int blockRgba = GetBlockRgba(blockIndex);
+	renderer.BatchSolidRect(x, y, s_kBlockSizePixels, s_kBlockSizePixels, blockRgba);
+	renderer.BatchRect(x, y, s_kBlockSizePixels, s_kBlockSizePixels, s_kBlockOutlineRgba);
+}
+
+void Game::DrawBoard(Renderer& renderer, int x, int y, unsigned int blockSizePixels, unsigned int blockAtlas) const
+{
+	if (!m_field.staticBlocks)
+		return;
+
+	const int blockSize = (int)blockSizePixels;
+	if (blockAtlas == 0)
+	{
+		// one background fill, then only the occupied cells
+		renderer.BatchSolidRect(x, y, m_field.width * blockSize, m_field.height * blockSize, s_kEmptyBlockRgba);
+	}
+
+	for (unsigned int iy = 0; iy < m_field.height; ++iy)
+	{
+		for (unsigned int ix = 0; ix < m_field.width; ++ix)
+		{
+			const int blockState = m_field.staticBlocks[iy * m_field.width + ix];
+			const int blockX = x + ix * blockSize;
+			const int blockY = y + iy * blockSize;
+			if (blockAtlas != 0)
+				renderer.BatchSprite(blockAtlas, blockState != -1 ? (unsigned int)blockState : (unsigned int)kBlockSprite_Empty, blockX, blockY);
+			else if (blockState != -1)
+				renderer.BatchSolidRect(blockX, blockY, blockSize, blockSize, GetBlockRgba(blockState));
+		}
+	}
+	renderer.FlushBatch();
+
+	if (m_gameState != kGameState_Playing)
+		return;
+
+	const Tetromino& tetromino = s_tetrominos[m_activeTetromino.m_tetrominoType];
+	const Tetromino::BlockCoords& blockCoords = tetromino.blockCoord[m_activeTetromino.m_rot];
+	for (unsigned int i = 0; i < Tetromino::kNumBlocks; ++i)
+	{
+		const int blockX = x + (m_activeTetromino.m_pos.x + blockCoords[i].x) * blockSize;
+		const int blockY = y + (m_activeTetromino.m_pos.y + blockCoords[i].y) * blockSize;
+		if (blockAtlas != 0)
+			renderer.BatchSprite(blockAtlas, m_activeTetromino.m_tetrominoType, blockX, blockY);
+		else
+			renderer.BatchSolidRect(blockX, blockY, blockSize, blockSize, tetromino.rgba);
+	}
+	renderer.FlushBatch();
+}
+
+void Game::MarkFieldRowsDirty(unsigned int rowBegin, unsigned int rowEnd)
+{
+	if (m_fieldDirtyRowBegin >= m_fieldDirtyRowEnd)
+	{
+		m_fieldDirtyRowBegin = rowBegin;
+		m_fieldDirtyRowEnd = rowEnd;
+	}
+	else
+	{
+		if (rowBegin < m_fieldDirtyRowBegin)
+			m_fieldDirtyRowBegin = rowBegin;
+		if (rowEnd > m_fieldDirtyRowEnd)
+			m_fieldDirtyRowEnd = rowEnd;
+	}
+}
@@ -2,6 +2,8 @@
 #ifndef GAME_H_INCLUDED
 #define GAME_H_INCLUDED
 
+#include "Hud.h"
+
 class Renderer;
 
 struct uint2
@@ -45,6 +47,15 @@ enum TetrominoType
 	kNumTetrominoTypes
 };
 
+// what a field cell or block atlas sprite shows, tetromino colours come first
+// and are indexed by TetrominoType
+enum BlockSprite
+{
+	kBlockSprite_Garbage = kNumTetrominoTypes,
+	kBlockSprite_Empty,
+	kNumBlockSprites
+};
+
 struct TetrominoInstance
 {
 	TetrominoType m_tetrominoType;
@@ -52,6 +63,26 @@ struct TetrominoInstance
 	unsigned int m_rot;
 };
 
+// Rotations go 0 (spawn), 1, 2, 3 clockwise, as in the shape tables.
+enum RotationSystem
+{
+	// the guideline Super Rotation System, up to five kicks a turn
+	kRotationSystem_Srs = 0,
+	// turns in place or not at all
+	kRotationSystem_Classic,
+	kNumRotationSystems
+};
+
+// The positions to try a turn at, in order, as offsets from where the piece
+// is with y down. The first is always 0, 0.
+struct RotationKicks
+{
+	static const unsigned int kMaxTests = 5;
+
+	unsigned int numTests;
+	int2 offsets[kMaxTests];
+};
+
 struct GameInput
 {
 	bool start;
@@ -73,33 +104,150 @@ struct GameInput
 #endif
 };
 
+// the tetromino shapes and colours, shared with anything that plays or draws boards
+const Tetromino& GetTetromino(TetrominoType type);
+// fills kNumBlockSprites colours, indexed by BlockSprite
+void GetBlockRgbas(uint32_t* rgbas);
+// true if any block is outside the field or on a locked block
+bool DoesTetrominoOverlap(const TetrominoInstance& instance, const Field& field);
+// how many rows the piece can fall before it lands, it must not overlap to begin with
+unsigned int GetTetrominoDropDistance(const TetrominoInstance& instance, const Field& field);
+
+const char* GetRotationSystemName(RotationSystem system);
+// kNumRotationSystems if name isn't one
+RotationSystem FindRotationSystem(const char* name);
+// the kicks for turning from fromRot to toRot, no tests unless it is a quarter turn
+const RotationKicks& GetRotationKicks(RotationSystem system, TetrominoType type, unsigned int fromRot, unsigned int toRot);
+// Turns the piece a quarter turn to the first kick that doesn't overlap.
+// Returns false and leaves it alone if none fit.
+bool RotateTetromino(TetrominoInstance& instance, bool clockwise, RotationSystem system, const Field& field);
+
 //-----------------------------------------Game Class-----------------------------------
 
 class Game
 {
 public:
+	static const unsigned int kFieldWidth = 10;
+	static const unsigned int kFieldHeight = 20;
+
+	// Gravity is cells a frame in 16.16 fixed point, so it can be a fraction
+	// of a cell or many cells, and plays out the same on every machine.
+	static const unsigned int kGravityFractionBits = 16;
+	static const uint32_t kGravityOneCell = 1u << kGravityFractionBits;
+	// to the floor the first frame a piece falls
+	static const uint32_t kGravity20G = 20 * kGravityOneCell;
+
+	// Everything Update reads or writes, so a game can be rewound to an earlier
+	// frame and replayed. Restoring one also invalidates anything drawn from it.
+	struct Snapshot
+	{
+		int staticBlocks[kFieldWidth * kFieldHeight];
+		bool hasField;
+		TetrominoInstance activeTetromino;
+		uint32_t fallProgress;
+		unsigned int numUserDropsForTetromino;
+		unsigned int numLinesCleared;
+		unsigned int level;
+		unsigned int score;
+		unsigned int hiScore;
+		unsigned int gameState;
+		uint32_t rngState;
+		unsigned int pendingGarbageLines;
+		unsigned int garbageLinesSent;
+	};
+
 	Game();
 	~Game();
 
 	bool Init();
 	void Shutdown();
+	// back to the title screen
 	void Reset();
 	void Update(const GameInput& input, float deltaTimeSeconds);
 	void Draw(Renderer& renderer);
+
+	// The piece sequence and garbage holes come from this seed, so games given
+	// the same seed and the same inputs play out identically. Takes effect from
+	// the next piece, games are seeded from the clock otherwise.
+	void SetSeed(uint32_t seed);
+
+	void SaveSnapshot(Snapshot& snapshot) const;
+	void LoadSnapshot(const Snapshot& snapshot);
+
+	// Garbage is queued and pushed up from the bottom when the next piece
+	// locks without clearing a line, line clears cancel queued garbage first.
+	void AddGarbageLines(unsigned int numLines);
+	unsigned int GetPendingGarbageLines() const { return m_pendingGarbageLines; }
+	// running total of garbage this game has sent, for the opponent to receive
+	unsigned int GetGarbageLinesSent() const { return m_garbageLinesSent; }
+
+	// Draws just the field and active piece with the top left at (x, y). Blocks
+	// are sprites from blockAtlas if it is non zero, otherwise flat colours.
+	void DrawBoard(Renderer& renderer, int x, int y, unsigned int blockSizePixels, unsigned int blockAtlas) const;
+
+	bool IsPlaying() const { return m_gameState == kGameState_Playing; }
+	bool IsGameOver() const { return m_gameState == kGameState_GameOver; }
+	const Field& GetField() const { return m_field; }
+	const TetrominoInstance& GetActiveTetromino() const { return m_activeTetromino; }
+	unsigned int GetScore() const { return m_score; }
+	unsigned int GetNumLinesCleared() const { return m_numLinesCleared; }
+	unsigned int GetHiScore() const { return m_hiScore; }
+	// for a high score kept from earlier runs
+	void SetHiScore(unsigned int hiScore) { m_hiScore = hiScore; }
+	// Gravity for the current level unless set to something other than 0,
+	// which is then used at every level. Both sides of a versus match need the
+	// same one.
+	uint32_t GetGravity() const;
+	uint32_t GetFixedGravity() const { return m_fixedGravity; }
+	void SetGravity(uint32_t gravity) { m_fixedGravity = gravity; }
+	// SRS unless set, both sides of a versus match need the same one
+	RotationSystem GetRotationSystem() const { return m_rotationSystem; }
+	void SetRotationSystem(RotationSystem system) { m_rotationSystem = system; }
+	// changes whenever anything DrawBoard shows changes
+	unsigned int GetStateVersion() const { return m_stateVersion; }
+
 private:
+	// tools/TetrisBench.cpp times the lock and spawn steps on their own
+	friend struct GameBench;
+
 	void InitPlaying();
 	void UpdatePlaying(const GameInput& input);
 	void DrawPlaying(Renderer& renderer);
+	void CreateRenderResources(Renderer& renderer);
+	void DrawFieldRows(Renderer& renderer, unsigned int rowBegin, unsigned int rowEnd, int offsetPixelsX, int offsetPixelsY);
+	void DrawBlock(Renderer& renderer, unsigned int blockIndex, int x, int y);
+	void MarkFieldRowsDirty(unsigned int rowBegin, unsigned int rowEnd);
 
 	bool SpawnTetromino();
 	void AddTetronimoToField(const Field& field, const TetrominoInstance& instance);
+	void InsertGarbageRows(unsigned int numRows);
+	uint32_t NextRandom();
 
 	float m_deltaTimeSeconds;
 	Field m_field;
 	TetrominoInstance m_activeTetromino;
+	RotationSystem m_rotationSystem;
+
+	// block sprites, indexed by TetrominoType with the empty cell last
+	bool m_renderResourcesCreated;
+	unsigned int m_blockAtlas;
+
+	// the locked blocks are cached in a render target and only rows in
+	// [m_fieldDirtyRowBegin, m_fieldDirtyRowEnd) are redrawn into it
+	unsigned int m_fieldTarget;
+	unsigned int m_fieldTargetGeneration;
+	unsigned int m_fieldDirtyRowBegin;
+	unsigned int m_fieldDirtyRowEnd;
+
+	unsigned int m_stateVersion;
 
-	int m_framesUntilFall;
-	int m_framesPerFallStep;
+	uint32_t m_rngState;
+	unsigned int m_pendingGarbageLines;
+	unsigned int m_garbageLinesSent;
+
+	// fraction of a cell fallen since the piece last moved down
+	uint32_t m_fallProgress;
+	uint32_t m_fixedGravity;
 
 	unsigned int m_numUserDropsForTetromino;
 
@@ -118,6 +266,20 @@ private:
 	};
 
 	GameState m_gameState;
+
+	//hud
+	float m_fpsSampleSeconds;
+	unsigned int m_fpsSampleFrames;
+	HudText m_fpsText;
+	HudText m_titleText;
+	HudText m_gameOverText;
+	HudText m_linesText;
+	HudText m_levelText;
+	HudText m_scoreText;
+	HudText m_hiScoreText;
+#ifdef _DEBUG
+	HudText m_gravityText;
+#endif
 };
 
 #endif // GAME_H_INCLUDED
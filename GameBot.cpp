@@ -0,0 +1,218 @@
+#include "GameBot.h"
+#include "Debugger.h"
+#include "FieldKernels.h"
+#include <stdio.h>
+#include <string.h>
+
+// The first has the feature weights from a well known genetic search for this
+// heuristic, the others change one thing about it.
+static const GameBotStyle s_kStyles[] =
+{
+	{ "genetic", -0.510066f, 0.760666f, -0.35663f, -0.184483f, 1 },
+	// builds up and holds lines back hoping to clear several at once
+	{ "stacker", -0.2f, -1.0f, -0.35663f, -0.184483f, 1 },
+	{ "flat", -0.510066f, 0.760666f, -0.35663f, -0.6f, 1 },
+	{ "holey", -0.510066f, 0.760666f, -0.05f, -0.184483f, 1 },
+	{ "slow", -0.510066f, 0.760666f, -0.35663f, -0.184483f, 3 },
+};
+static const unsigned int s_kNumStyles = sizeof(s_kStyles) / sizeof(s_kStyles[0]);
+
+// give up steering and drop where we are, in case the path is blocked
+static const unsigned int s_kMaxActionsPerPiece = 16;
+
+//================================================================================
+
+unsigned int GetNumGameBotStyles()
+{
+	return s_kNumStyles;
+}
+
+const GameBotStyle& GetGameBotStyle(unsigned int index)
+{
+	HP_ASSERT(index < s_kNumStyles);
+	return s_kStyles[index];
+}
+
+int FindGameBotStyle(const char* name)
+{
+	for (unsigned int i = 0; i < s_kNumStyles; ++i)
+	{
+		if (strcmp(s_kStyles[i].name, name) == 0)
+			return (int)i;
+	}
+	return -1;
+}
+
+//================================================================================
+
+GameBot::GameBot(unsigned int framesPerAction)
+	: m_style(s_kStyles[0])
+	, m_framesPerAction(framesPerAction > 0 ? framesPerAction : 1)
+	, m_framesUntilAction(0)
+	, m_hasPlan(false)
+	, m_plannedType(kTetrominoType_I)
+	, m_lastY(0)
+	, m_targetRot(0)
+	, m_targetX(0)
+	, m_actionsForPiece(0)
+{
+}
+
+GameBot::GameBot(const GameBotStyle& style)
+	: m_style(style)
+	, m_framesPerAction(style.framesPerAction > 0 ? style.framesPerAction : 1)
+	, m_framesUntilAction(0)
+	, m_hasPlan(false)
+	, m_plannedType(kTetrominoType_I)
+	, m_lastY(0)
+	, m_targetRot(0)
+	, m_targetX(0)
+	, m_actionsForPiece(0)
+{
+}
+
+GameInput GameBot::Think(const Game& game)
+{
+	GameInput input;
+	memset(&input, 0, sizeof(input));
+
+	if (m_framesUntilAction > 0)
+	{
+		--m_framesUntilAction;
+		return input;
+	}
+	m_framesUntilAction = m_framesPerAction - 1;
+
+	if (!game.IsPlaying())
+	{
+		// from game over this goes back to the title screen, and from there starts again
+		input.start = true;
+		m_hasPlan = false;
+		return input;
+	}
+
+	// a new piece has spawned if the type changed or it moved back up the field
+	const TetrominoInstance& active = game.GetActiveTetromino();
+	if (!m_hasPlan || active.m_tetrominoType != m_plannedType || active.m_pos.y < m_lastY)
+	{
+		Plan(game);
+	}
+	m_lastY = active.m_pos.y;
+
+	if (++m_actionsForPiece > s_kMaxActionsPerPiece)
+	{
+		input.hardDrop = true;
+	}
+	else if (active.m_rot != m_targetRot)
+	{
+		input.rotClockwise = true;
+	}
+	else if (active.m_pos.x < m_targetX)
+	{
+		input.moveRight = true;
+	}
+	else if (active.m_pos.x > m_targetX)
+	{
+		input.moveLeft = true;
+	}
+	else
+	{
+		input.hardDrop = true;
+	}
+
+	if (input.hardDrop)
+	{
+		m_hasPlan = false;
+	}
+	return input;
+}
+
+void GameBot::Plan(const Game& game)
+{
+	HP_PROFILE_SCOPE("GameBot::Plan");
+
+	const Field& field = game.GetField();
+	const TetrominoInstance& active = game.GetActiveTetromino();
+
+	float bestScore = -1e30f;
+	m_targetRot = active.m_rot;
+	m_targetX = active.m_pos.x;
+	for (unsigned int rot = 0; rot < Tetromino::kNumRots; ++rot)
+	{
+		// shapes sit in a 4x4 box, so the box can hang up to 3 columns off the left
+		for (int x = -3; x < (int)field.width; ++x)
+		{
+			TetrominoInstance instance = active;
+			instance.m_rot = rot;
+			instance.m_pos.x = x;
+			if (DoesTetrominoOverlap(instance, field))
+				continue;
+
+			// drop to where it would land
+			instance.m_pos.y += (int)GetTetrominoDropDistance(instance, field);
+
+			const float score = Evaluate(field, instance);
+			if (score > bestScore)
+			{
+				bestScore = score;
+				m_targetRot = rot;
+				m_targetX = x;
+			}
+		}
+	}
+
+	m_hasPlan = true;
+	m_plannedType = active.m_tetrominoType;
+	m_actionsForPiece = 0;
+}
+
+float GameBot::Evaluate(const Field& field, const TetrominoInstance& instance)
+{
+	const unsigned int width = field.width;
+	const unsigned int height = field.height;
+	m_scratchBlocks.assign(field.staticBlocks, field.staticBlocks + width * height);
+
+	const Tetromino::BlockCoords& blockCoords = GetTetromino(instance.m_tetrominoType).blockCoord[instance.m_rot];
+	unsigned int pieceRowBegin = height;
+	unsigned int pieceRowEnd = 0;
+	for (unsigned int i = 0; i < Tetromino::kNumBlocks; ++i)
+	{
+		const int x = instance.m_pos.x + blockCoords[i].x;
+		const int y = instance.m_pos.y + blockCoords[i].y;
+		m_scratchBlocks[y * width + x] = instance.m_tetrominoType;
+		pieceRowBegin = (unsigned int)y < pieceRowBegin ? (unsigned int)y : pieceRowBegin;
+		pieceRowEnd = (unsigned int)y + 1 > pieceRowEnd ? (unsigned int)y + 1 : pieceRowEnd;
+	}
+
+	// clear full rows by compacting the rest downwards
+	const unsigned int numLinesCleared = RemoveFullFieldRows(m_scratchBlocks.data(), width, height, pieceRowBegin, pieceRowEnd);
+
+	unsigned int aggregateHeight = 0;
+	unsigned int holes = 0;
+	unsigned int bumpiness = 0;
+	int previousHeight = -1;
+	for (unsigned int x = 0; x < width; ++x)
+	{
+		int columnHeight = 0;
+		for (unsigned int y = 0; y < height; ++y)
+		{
+			if (m_scratchBlocks[y * width + x] != -1)
+			{
+				if (columnHeight == 0)
+					columnHeight = (int)(height - y);
+			}
+			else if (columnHeight != 0)
+			{
+				++holes;
+			}
+		}
+
+		aggregateHeight += columnHeight;
+		if (previousHeight >= 0)
+			bumpiness += (unsigned int)(columnHeight > previousHeight ? columnHeight - previousHeight : previousHeight - columnHeight);
+		previousHeight = columnHeight;
+	}
+
+	return m_style.heightWeight * aggregateHeight + m_style.linesWeight * numLinesCleared
+		+ m_style.holesWeight * holes + m_style.bumpinessWeight * bumpiness;
+}
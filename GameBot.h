@@ -0,0 +1,57 @@
+#pragma once
+#ifndef GAME_BOT_H_INCLUDED
+#define GAME_BOT_H_INCLUDED
+
+#include "Game.h"
+#include <vector>
+
+// How a bot weighs the features of a placement, and how fast it plays.
+struct GameBotStyle
+{
+	const char* name;
+	float heightWeight;
+	float linesWeight;
+	float holesWeight;
+	float bumpinessWeight;
+	// one input every framesPerAction frames
+	unsigned int framesPerAction;
+};
+
+// the built in styles, the first is the default
+unsigned int GetNumGameBotStyles();
+const GameBotStyle& GetGameBotStyle(unsigned int index);
+// the index of the style with that name, or -1
+int FindGameBotStyle(const char* name);
+
+// Plays a Game through GameInput the way a player would. When a piece spawns
+// it scores every reachable rotation and column on aggregate height, holes,
+// bumpiness and cleared lines, then steers the piece there and hard drops.
+class GameBot
+{
+public:
+	// the default style, one input every framesPerAction frames so games can be watched
+	explicit GameBot(unsigned int framesPerAction = 1);
+	explicit GameBot(const GameBotStyle& style);
+
+	// the input to give the game this frame, also restarts finished games
+	GameInput Think(const Game& game);
+
+private:
+	void Plan(const Game& game);
+	float Evaluate(const Field& field, const TetrominoInstance& instance);
+
+	GameBotStyle m_style;
+	unsigned int m_framesPerAction;
+	unsigned int m_framesUntilAction;
+
+	bool m_hasPlan;
+	TetrominoType m_plannedType;
+	int m_lastY;
+	unsigned int m_targetRot;
+	int m_targetX;
+	unsigned int m_actionsForPiece;
+
+	std::vector<int> m_scratchBlocks;
+};
+
+#endif // GAME_BOT_H_INCLUDED
@@ -0,0 +1,52 @@
+#include "Hud.h"
+#include "Debugger.h"
+#include "Render.h"
+#include <stdio.h>
+
+HudText::HudText(const char* format, uint32_t rgba)
+	: m_format(format)
+	, m_rgba(rgba)
+	, m_valueType(kValueType_None)
+	, m_unsignedValue(0)
+	, m_floatValue(0.0f)
+	, m_textHandle(0)
+{
+	snprintf(m_text, sizeof(m_text), "%s", format);
+}
+
+void HudText::SetValue(unsigned int value)
+{
+	if (m_valueType == kValueType_Unsigned && m_unsignedValue == value)
+		return;
+
+	m_valueType = kValueType_Unsigned;
+	m_unsignedValue = value;
+	snprintf(m_text, sizeof(m_text), m_format, value);
+	Invalidate();
+}
+
+void HudText::SetValue(float value)
+{
+	if (m_valueType == kValueType_Float && m_floatValue == value)
+		return;
+
+	m_valueType = kValueType_Float;
+	m_floatValue = value;
+	snprintf(m_text, sizeof(m_text), m_format, value);
+	Invalidate();
+}
+
+void HudText::Draw(Renderer& renderer, int x, int y)
+{
+	if (m_textHandle == 0 || !renderer.DrawCachedText(m_textHandle, x, y))
+	{
+		m_textHandle = renderer.CacheText(m_text, m_rgba);
+		renderer.DrawCachedText(m_textHandle, x, y);
+	}
+}
+
+void HudText::Invalidate()
+{
+	// the old texture is left for the renderer's LRU to reclaim
+	m_textHandle = 0;
+}
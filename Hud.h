@@ -0,0 +1,44 @@
+#pragma once
+#ifndef HUD_H_INCLUDED
+#define HUD_H_INCLUDED
+
+#include "Render.h"
+#include <stdint.h>
+
+// A retained line of HUD text bound to a single value. The text is only
+// formatted and rasterized again when the value changes, otherwise drawing it
+// is one texture copy.
+class HudText
+{
+public:
+	// format takes one %u (or a float conversion when SetValue(float) is used),
+	// or no conversion at all for a static label
+	HudText(const char* format, uint32_t rgba);
+
+	void SetValue(unsigned int value);
+	void SetValue(float value);
+
+	void Draw(Renderer& renderer, int x, int y);
+
+private:
+	void Invalidate();
+
+	const char* m_format;
+	uint32_t m_rgba;
+
+	enum ValueType
+	{
+		kValueType_None = 0,
+		kValueType_Unsigned,
+		kValueType_Float
+	};
+
+	ValueType m_valueType;
+	unsigned int m_unsignedValue;
+	float m_floatValue;
+
+	char m_text[64];
+	TextHandle m_textHandle;
+};
+
+#endif // HUD_H_INCLUDED
@@ -0,0 +1,118 @@
+#include "InputRecording.h"
+#include "Debugger.h"
+#include "Versus.h"
+#include <errno.h>
+#include <stdio.h>
+#include <string.h>
+
+static const uint8_t s_kMagic[8] = { 'H', 'P', 'I', 'N', 'P', 'U', 'T', '1' };
+static const unsigned int s_kHeaderBytes = 24;
+
+//Helper functions
+//================================================================================
+
+static void WriteU32(uint8_t* data, uint32_t value)
+{
+	data[0] = (uint8_t)value;
+	data[1] = (uint8_t)(value >> 8);
+	data[2] = (uint8_t)(value >> 16);
+	data[3] = (uint8_t)(value >> 24);
+}
+
+static uint32_t ReadU32(const uint8_t* data)
+{
+	return (uint32_t)data[0] | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24);
+}
+
+//================================================================================
+
+InputRecording::InputRecording()
+	: m_seed(0)
+	, m_rotationSystem(kRotationSystem_Srs)
+	, m_fixedGravity(0)
+{
+}
+
+void InputRecording::Begin(Game& game, uint32_t seed)
+{
+	m_seed = seed;
+	m_rotationSystem = game.GetRotationSystem();
+	m_fixedGravity = game.GetFixedGravity();
+	m_inputs.clear();
+	game.SetSeed(seed);
+}
+
+void InputRecording::AddFrame(const GameInput& input)
+{
+	m_inputs.push_back(PackGameInput(input));
+}
+
+bool InputRecording::Save(const char* path) const
+{
+	FILE* file = fopen(path, "wb");
+	if (!file)
+	{
+		fprintf(stderr, "Failed to open %s: %s\n", path, strerror(errno));
+		return false;
+	}
+
+	uint8_t header[s_kHeaderBytes];
+	memcpy(header, s_kMagic, sizeof(s_kMagic));
+	WriteU32(header + 8, m_seed);
+	WriteU32(header + 12, (uint32_t)m_rotationSystem);
+	WriteU32(header + 16, m_fixedGravity);
+	WriteU32(header + 20, (uint32_t)m_inputs.size());
+	bool written = fwrite(header, sizeof(header), 1, file) == 1;
+	if (written && !m_inputs.empty())
+		written = fwrite(m_inputs.data(), m_inputs.size(), 1, file) == 1;
+	written = fclose(file) == 0 && written;
+	if (!written)
+		fprintf(stderr, "Failed to write %s: %s\n", path, strerror(errno));
+	return written;
+}
+
+bool InputRecording::Load(const char* path)
+{
+	FILE* file = fopen(path, "rb");
+	if (!file)
+	{
+		fprintf(stderr, "Failed to open %s: %s\n", path, strerror(errno));
+		return false;
+	}
+
+	uint8_t header[s_kHeaderBytes];
+	if (fread(header, sizeof(header), 1, file) != 1 || memcmp(header, s_kMagic, sizeof(s_kMagic)) != 0
+		|| ReadU32(header + 12) >= kNumRotationSystems)
+	{
+		fprintf(stderr, "%s is not an input recording\n", path);
+		fclose(file);
+		return false;
+	}
+
+	m_seed = ReadU32(header + 8);
+	m_rotationSystem = (RotationSystem)ReadU32(header + 12);
+	m_fixedGravity = ReadU32(header + 16);
+	m_inputs.resize(ReadU32(header + 20));
+	const bool read = m_inputs.empty() || fread(m_inputs.data(), m_inputs.size(), 1, file) == 1;
+	fclose(file);
+	if (!read)
+	{
+		fprintf(stderr, "%s is cut short\n", path);
+		m_inputs.clear();
+		return false;
+	}
+	return true;
+}
+
+void InputRecording::ApplySettings(Game& game) const
+{
+	game.SetRotationSystem(m_rotationSystem);
+	game.SetGravity(m_fixedGravity);
+	game.SetSeed(m_seed);
+}
+
+GameInput InputRecording::GetInput(unsigned int frame) const
+{
+	HP_ASSERT(frame < m_inputs.size());
+	return UnpackGameInput(m_inputs[frame]);
+}
@@ -0,0 +1,39 @@
+#pragma once
+#ifndef INPUT_RECORDING_H_INCLUDED
+#define INPUT_RECORDING_H_INCLUDED
+
+#include "Game.h"
+#include <stdint.h>
+#include <vector>
+
+// A single player game's inputs, a packed byte a frame, with the seed and
+// settings it started from. Game only depends on those, so replaying the
+// inputs plays the game out exactly as it went. The file is
+//   8 byte magic, u32 seed, u32 RotationSystem, u32 fixed gravity, u32 frames
+// then a byte a frame from PackGameInput, all little endian.
+class InputRecording
+{
+public:
+	InputRecording();
+
+	// takes the seed and settings from game, which should be on its title screen
+	void Begin(Game& game, uint32_t seed);
+	void AddFrame(const GameInput& input);
+
+	bool Save(const char* path) const;
+	bool Load(const char* path);
+
+	// sets up game to replay from the first frame
+	void ApplySettings(Game& game) const;
+	unsigned int GetNumFrames() const { return (unsigned int)m_inputs.size(); }
+	GameInput GetInput(unsigned int frame) const;
+	uint32_t GetSeed() const { return m_seed; }
+
+private:
+	uint32_t m_seed;
+	RotationSystem m_rotationSystem;
+	uint32_t m_fixedGravity;
+	std::vector<uint8_t> m_inputs;
+};
+
+#endif // INPUT_RECORDING_H_INCLUDED
@@ -0,0 +1,890 @@
+#include "Leaderboard.h"
+#include "Debugger.h"
+#include "Profiler.h"
+#include <chrono>
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+#include <time.h>
+
+#ifdef _WIN32
+#define WIN32_LEAN_AND_MEAN
+#define NOMINMAX
+#include <windows.h>
+#else
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif // _WIN32
+
+// Everything on disk is little endian. The log is a header then fixed size
+// records:
+//   header  u8 magic[8], u32 record bytes, u32 unused
+//   record  u32 magic, u32 score, u32 lines, u32 crc, u64 time, u64 session
+// where the crc covers the record with its crc field zeroed. The index is
+//   header  u8 magic[8], u32 entries, u32 crc of the entries, u64 log bytes covered
+//   entry   u32 score, u32 lines, u64 time, u64 session, best first
+static const uint8_t s_kLogMagic[8] = { 'H', 'P', 'S', 'C', 'O', 'R', 'E', '1' };
+static const uint8_t s_kIndexMagic[8] = { 'H', 'P', 'T', 'O', 'P', 'K', '0', '1' };
+static const uint32_t s_kRecordMagic = 0x52435348;
+static const unsigned int s_kLogHeaderBytes = 16;
+static const unsigned int s_kRecordBytes = 32;
+static const unsigned int s_kIndexHeaderBytes = 24;
+static const unsigned int s_kIndexEntryBytes = 24;
+static const unsigned int s_kReadChunkRecords = 4096;
+// how often an idle writer looks for scores other processes appended
+static const unsigned int s_kTailLogIntervalMs = 1000;
+
+//Helper functions
+//================================================================================
+
+static void WriteU32(uint8_t* data, uint32_t value)
+{
+	data[0] = (uint8_t)value;
+	data[1] = (uint8_t)(value >> 8);
+	data[2] = (uint8_t)(value >> 16);
+	data[3] = (uint8_t)(value >> 24);
+}
+
+static void WriteU64(uint8_t* data, uint64_t value)
+{
+	WriteU32(data, (uint32_t)value);
+	WriteU32(data + 4, (uint32_t)(value >> 32));
+}
+
+static uint32_t ReadU32(const uint8_t* data)
+{
+	return (uint32_t)data[0] | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24);
+}
+
+static uint64_t ReadU64(const uint8_t* data)
+{
+	return (uint64_t)ReadU32(data) | ((uint64_t)ReadU32(data + 4) << 32);
+}
+
+struct Crc32Table
+{
+	Crc32Table()
+	{
+		for (uint32_t i = 0; i < 256; ++i)
+		{
+			uint32_t crc = i;
+			for (unsigned int bit = 0; bit < 8; ++bit)
+			{
+				crc = (crc & 1) ? (crc >> 1) ^ 0xedb88320 : crc >> 1;
+			}
+			entries[i] = crc;
+		}
+	}
+
+	uint32_t entries[256];
+};
+
+// CRC-32 with the zlib polynomial
+static uint32_t Crc32(const uint8_t* data, size_t size)
+{
+	// built on first use, which is thread safe for a function local static
+	static const Crc32Table s_table;
+
+	uint32_t crc = 0xffffffff;
+	for (size_t i = 0; i < size; ++i)
+	{
+		crc = s_table.entries[(crc ^ data[i]) & 0xff] ^ (crc >> 8);
+	}
+	return crc ^ 0xffffffff;
+}
+
+static void WriteRecord(const ScoreEntry& entry, uint8_t* record)
+{
+	WriteU32(record, s_kRecordMagic);
+	WriteU32(record + 4, entry.score);
+	WriteU32(record + 8, entry.numLinesCleared);
+	WriteU32(record + 12, 0);
+	WriteU64(record + 16, entry.timeSeconds);
+	WriteU64(record + 24, entry.sessionId);
+	WriteU32(record + 12, Crc32(record, s_kRecordBytes));
+}
+
+static bool ReadRecord(const uint8_t* record, ScoreEntry& entry)
+{
+	uint8_t check[s_kRecordBytes];
+	memcpy(check, record, s_kRecordBytes);
+	WriteU32(check + 12, 0);
+	if (ReadU32(record) != s_kRecordMagic || ReadU32(record + 12) != Crc32(check, s_kRecordBytes))
+		return false;
+
+	entry.score = ReadU32(record + 4);
+	entry.numLinesCleared = ReadU32(record + 8);
+	entry.timeSeconds = ReadU64(record + 16);
+	entry.sessionId = ReadU64(record + 24);
+	return true;
+}
+
+static void WriteIndexEntry(const ScoreEntry& entry, uint8_t* data)
+{
+	WriteU32(data, entry.score);
+	WriteU32(data + 4, entry.numLinesCleared);
+	WriteU64(data + 8, entry.timeSeconds);
+	WriteU64(data + 16, entry.sessionId);
+}
+
+static void ReadIndexEntry(const uint8_t* data, ScoreEntry& entry)
+{
+	entry.score = ReadU32(data);
+	entry.numLinesCleared = ReadU32(data + 4);
+	entry.timeSeconds = ReadU64(data + 8);
+	entry.sessionId = ReadU64(data + 16);
+}
+
+// higher scores first, earlier games first among equal scores
+static bool IsBetterScore(const ScoreEntry& a, const ScoreEntry& b)
+{
+	if (a.score != b.score)
+		return a.score > b.score;
+	return a.timeSeconds < b.timeSeconds;
+}
+
+// The few file operations the log and index need. Files are an fd, or a
+// HANDLE on Windows, either way -1 when there isn't one. Reads take an offset
+// and appends always go to the end, so nothing depends on a file position.
+static const intptr_t s_kNoFile = -1;
+
+// the last file error as text, for the thread that hit it
+static const char* GetFileError()
+{
+#ifdef _WIN32
+	static thread_local char s_message[256];
+	const DWORD error = GetLastError();
+	if (FormatMessageA(FORMAT_MESSAGE_FROM_SYSTEM | FORMAT_MESSAGE_IGNORE_INSERTS, nullptr, error, 0, s_message, sizeof(s_message), nullptr) == 0)
+		snprintf(s_message, sizeof(s_message), "error %lu", (unsigned long)error);
+	return s_message;
+#else
+	return strerror(errno);
+#endif
+}
+
+static uint64_t GetProcessNumber()
+{
+#ifdef _WIN32
+	return GetCurrentProcessId();
+#else
+	return (uint64_t)getpid();
+#endif
+}
+
+// opens or creates a file for reading and appending, shared with other processes
+static intptr_t OpenLogFile(const char* path)
+{
+#ifdef _WIN32
+	const HANDLE file = CreateFileA(path, GENERIC_READ | GENERIC_WRITE, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE,
+		nullptr, OPEN_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+	return file == INVALID_HANDLE_VALUE ? s_kNoFile : (intptr_t)file;
+#else
+	return open(path, O_RDWR | O_CREAT | O_APPEND, 0644);
+#endif
+}
+
+static void CloseFile(intptr_t file)
+{
+#ifdef _WIN32
+	CloseHandle((HANDLE)file);
+#else
+	close((int)file);
+#endif
+}
+
+static bool GetFileBytes(intptr_t file, uint64_t& numBytes)
+{
+#ifdef _WIN32
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx((HANDLE)file, &size))
+		return false;
+	numBytes = (uint64_t)size.QuadPart;
+#else
+	struct stat status;
+	if (fstat((int)file, &status) != 0)
+		return false;
+	numBytes = (uint64_t)status.st_size;
+#endif
+	return true;
+}
+
+// reads up to numBytes from offset, fewer only at the end of the file
+static bool ReadAt(intptr_t file, uint8_t* data, size_t numBytes, uint64_t offset, size_t& numRead)
+{
+#ifdef _WIN32
+	OVERLAPPED overlapped;
+	memset(&overlapped, 0, sizeof(overlapped));
+	overlapped.Offset = (DWORD)offset;
+	overlapped.OffsetHigh = (DWORD)(offset >> 32);
+	DWORD read = 0;
+	if (!ReadFile((HANDLE)file, data, (DWORD)numBytes, &read, &overlapped) && GetLastError() != ERROR_HANDLE_EOF)
+		return false;
+	numRead = read;
+	return true;
+#else
+	for (;;)
+	{
+		const ssize_t read = pread((int)file, data, numBytes, (off_t)offset);
+		if (read >= 0)
+		{
+			numRead = (size_t)read;
+			return true;
+		}
+		if (errno != EINTR)
+			return false;
+	}
+#endif
+}
+
+// Writes everything at the end of the file, or from the start of one just
+// created. Appends from one call land in one piece unless the disk fills.
+static bool WriteAll(intptr_t file, const uint8_t* data, size_t size)
+{
+	while (size > 0)
+	{
+#ifdef _WIN32
+		// an offset of all ones appends, like O_APPEND
+		OVERLAPPED overlapped;
+		memset(&overlapped, 0, sizeof(overlapped));
+		overlapped.Offset = 0xffffffff;
+		overlapped.OffsetHigh = 0xffffffff;
+		const DWORD chunk = size > 0x40000000 ? 0x40000000 : (DWORD)size;
+		DWORD written = 0;
+		if (!WriteFile((HANDLE)file, data, chunk, &written, &overlapped))
+			return false;
+#else
+		const ssize_t written = write((int)file, data, size);
+		if (written < 0)
+		{
+			if (errno == EINTR)
+				continue;
+			return false;
+		}
+#endif
+		data += written;
+		size -= (size_t)written;
+	}
+	return true;
+}
+
+static bool SyncFile(intptr_t file)
+{
+#ifdef _WIN32
+	return FlushFileBuffers((HANDLE)file) != 0;
+#elif defined(__linux__)
+	return fdatasync((int)file) == 0;
+#else
+	return fsync((int)file) == 0;
+#endif
+}
+
+static bool TruncateFile(intptr_t file, uint64_t numBytes)
+{
+#ifdef _WIN32
+	LARGE_INTEGER position;
+	position.QuadPart = (LONGLONG)numBytes;
+	return SetFilePointerEx((HANDLE)file, position, nullptr, FILE_BEGIN) && SetEndOfFile((HANDLE)file);
+#else
+	return ftruncate((int)file, (off_t)numBytes) == 0;
+#endif
+}
+
+// creates or empties path and writes data to it, on the disk when this returns
+static bool WriteFileSynced(const char* path, const uint8_t* data, size_t size)
+{
+#ifdef _WIN32
+	const HANDLE handle = CreateFileA(path, GENERIC_WRITE, 0, nullptr, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, nullptr);
+	const intptr_t file = handle == INVALID_HANDLE_VALUE ? s_kNoFile : (intptr_t)handle;
+#else
+	const intptr_t file = open(path, O_WRONLY | O_CREAT | O_TRUNC, 0644);
+#endif
+	if (file == s_kNoFile)
+		return false;
+	const bool written = WriteAll(file, data, size) && SyncFile(file);
+	CloseFile(file);
+	return written;
+}
+
+// replaces to with from in one step, anything reading to sees one or the other
+static bool MoveFileOver(const char* from, const char* to)
+{
+#ifdef _WIN32
+	return MoveFileExA(from, to, MOVEFILE_REPLACE_EXISTING | MOVEFILE_WRITE_THROUGH) != 0;
+#else
+	return rename(from, to) == 0;
+#endif
+}
+
+// maps a whole file read only, nullptr if it is missing or under minBytes
+static const uint8_t* MapFile(const char* path, size_t minBytes, size_t& numBytes)
+{
+	const uint8_t* view = nullptr;
+#ifdef _WIN32
+	// shared for delete too, so the file can be replaced while it is mapped
+	const HANDLE file = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ | FILE_SHARE_WRITE | FILE_SHARE_DELETE, nullptr,
+		OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE)
+		return nullptr;
+
+	LARGE_INTEGER size;
+	if (GetFileSizeEx(file, &size) && (uint64_t)size.QuadPart >= minBytes && size.QuadPart > 0)
+	{
+		// the view keeps the mapping and the file open after their handles close
+		const HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+		if (mapping)
+		{
+			view = (const uint8_t*)MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0);
+			CloseHandle(mapping);
+		}
+		if (view)
+			numBytes = (size_t)size.QuadPart;
+	}
+	CloseHandle(file);
+#else
+	const int file = open(path, O_RDONLY);
+	if (file < 0)
+		return nullptr;
+
+	struct stat status;
+	if (fstat(file, &status) == 0 && status.st_size >= (off_t)minBytes && status.st_size > 0)
+	{
+		void* mapping = mmap(nullptr, (size_t)status.st_size, PROT_READ, MAP_SHARED, file, 0);
+		if (mapping != MAP_FAILED)
+		{
+			view = (const uint8_t*)mapping;
+			numBytes = (size_t)status.st_size;
+		}
+	}
+	close(file);
+#endif
+	return view;
+}
+
+static void UnmapFile(const uint8_t* view, size_t numBytes)
+{
+#ifdef _WIN32
+	HP_UNUSED(numBytes);
+	UnmapViewOfFile(view);
+#else
+	munmap((void*)view, numBytes);
+#endif
+}
+
+//================================================================================
+
+ScoreRankTree::ScoreRankTree()
+	: m_root(kNoNode)
+	, m_rngState(0x9e3779b9)
+{
+}
+
+void ScoreRankTree::Clear()
+{
+	m_nodes.clear();
+	m_root = kNoNode;
+}
+
+void ScoreRankTree::Insert(uint32_t score)
+{
+	m_root = InsertBelow(m_root, score);
+}
+
+uint64_t ScoreRankTree::CountAbove(uint32_t score) const
+{
+	uint64_t count = 0;
+	uint32_t node = m_root;
+	while (node != kNoNode)
+	{
+		const Node& current = m_nodes[node];
+		if (score < current.score)
+		{
+			count += current.count + GetSubtreeCount(current.right);
+			node = current.left;
+		}
+		else if (score > current.score)
+		{
+			node = current.right;
+		}
+		else
+		{
+			count += GetSubtreeCount(current.right);
+			break;
+		}
+	}
+	return count;
+}
+
+uint64_t ScoreRankTree::GetNumEntries() const
+{
+	return GetSubtreeCount(m_root);
+}
+
+// returns what is now the root of the subtree, which rotations may change
+uint32_t ScoreRankTree::InsertBelow(uint32_t node, uint32_t score)
+{
+	if (node == kNoNode)
+	{
+		// xorshift32 priorities keep the tree balanced on average whatever order scores arrive in
+		m_rngState ^= m_rngState << 13;
+		m_rngState ^= m_rngState >> 17;
+		m_rngState ^= m_rngState << 5;
+
+		Node newNode;
+		newNode.score = score;
+		newNode.priority = m_rngState;
+		newNode.left = kNoNode;
+		newNode.right = kNoNode;
+		newNode.count = 1;
+		newNode.subtreeCount = 1;
+		m_nodes.push_back(newNode);
+		return (uint32_t)(m_nodes.size() - 1);
+	}
+
+	// indices rather than references, the insert below can grow m_nodes
+	if (score == m_nodes[node].score)
+	{
+		++m_nodes[node].count;
+		++m_nodes[node].subtreeCount;
+		return node;
+	}
+
+	if (score < m_nodes[node].score)
+	{
+		const uint32_t left = InsertBelow(m_nodes[node].left, score);
+		m_nodes[node].left = left;
+		UpdateSubtreeCount(node);
+		if (m_nodes[left].priority > m_nodes[node].priority)
+			return RotateRight(node);
+	}
+	else
+	{
+		const uint32_t right = InsertBelow(m_nodes[node].right, score);
+		m_nodes[node].right = right;
+		UpdateSubtreeCount(node);
+		if (m_nodes[right].priority > m_nodes[node].priority)
+			return RotateLeft(node);
+	}
+	return node;
+}
+
+uint32_t ScoreRankTree::RotateLeft(uint32_t node)
+{
+	const uint32_t right = m_nodes[node].right;
+	m_nodes[node].right = m_nodes[right].left;
+	m_nodes[right].left = node;
+	UpdateSubtreeCount(node);
+	UpdateSubtreeCount(right);
+	return right;
+}
+
+uint32_t ScoreRankTree::RotateRight(uint32_t node)
+{
+	const uint32_t left = m_nodes[node].left;
+	m_nodes[node].left = m_nodes[left].right;
+	m_nodes[left].right = node;
+	UpdateSubtreeCount(node);
+	UpdateSubtreeCount(left);
+	return left;
+}
+
+void ScoreRankTree::UpdateSubtreeCount(uint32_t node)
+{
+	Node& current = m_nodes[node];
+	current.subtreeCount = current.count + GetSubtreeCount(current.left) + GetSubtreeCount(current.right);
+}
+
+//================================================================================
+
+Leaderboard::Leaderboard()
+	: m_logFile(s_kNoFile)
+	, m_sessionId(0)
+	, m_numSubmitted(0)
+	, m_numWritten(0)
+	, m_highScore(0)
+	, m_loaded(false)
+	, m_stopping(false)
+	, m_readOffset(0)
+	, m_topScoresChanged(false)
+	, m_index(nullptr)
+	, m_indexBytes(0)
+{
+	memset(&m_stats, 0, sizeof(m_stats));
+}
+
+Leaderboard::~Leaderboard()
+{
+	Close();
+}
+
+bool Leaderboard::Open(const char* path)
+{
+	HP_ASSERT(path && !IsOpen());
+
+	m_logFile = OpenLogFile(path);
+	if (m_logFile == s_kNoFile)
+	{
+		fprintf(stderr, "Failed to open score log %s: %s\n", path, GetFileError());
+		return false;
+	}
+
+	uint8_t header[s_kLogHeaderBytes];
+	uint64_t logBytes = 0;
+	size_t numRead = 0;
+	if (!GetFileBytes(m_logFile, logBytes))
+		logBytes = 1;
+	if (logBytes == 0)
+	{
+		memset(header, 0, sizeof(header));
+		memcpy(header, s_kLogMagic, sizeof(s_kLogMagic));
+		WriteU32(header + 8, s_kRecordBytes);
+		if (!WriteAll(m_logFile, header, sizeof(header)) || !SyncFile(m_logFile))
+		{
+			fprintf(stderr, "Failed to write score log %s: %s\n", path, GetFileError());
+			Close();
+			return false;
+		}
+	}
+	else if (!ReadAt(m_logFile, header, sizeof(header), 0, numRead) || numRead != sizeof(header)
+		|| memcmp(header, s_kLogMagic, sizeof(s_kLogMagic)) != 0 || ReadU32(header + 8) != s_kRecordBytes)
+	{
+		fprintf(stderr, "%s is not a score log\n", path);
+		Close();
+		return false;
+	}
+
+	m_indexPath = path;
+	m_indexPath += ".top";
+	m_sessionId = ((uint64_t)time(nullptr) << 32) ^ (GetProcessNumber() << 16) ^ (uint64_t)Profiler::GetTimeNs();
+	m_readOffset = s_kLogHeaderBytes;
+	m_tree.Clear();
+	m_topScores.clear();
+	m_topScoresChanged = false;
+	m_numSubmitted.store(0, std::memory_order_relaxed);
+	m_numWritten.store(0, std::memory_order_relaxed);
+	m_highScore.store(0, std::memory_order_relaxed);
+	m_loaded.store(false, std::memory_order_relaxed);
+	m_stopping.store(false, std::memory_order_relaxed);
+	memset(&m_stats, 0, sizeof(m_stats));
+
+	// the best scores are there straight away, the log is read on the writer thread
+	MapIndex();
+	unsigned int numTopScores = 0;
+	ScoreEntry best;
+	if (GetTopScores(&best, 1, numTopScores) && numTopScores > 0)
+		m_highScore.store(best.score, std::memory_order_relaxed);
+
+	m_writerThread = std::thread(&Leaderboard::WriterThread, this);
+	return true;
+}
+
+void Leaderboard::Close()
+{
+	if (!IsOpen())
+		return;
+
+	if (m_writerThread.joinable())
+	{
+		m_stopping.store(true, std::memory_order_release);
+		m_writerThread.join();
+	}
+
+	UnmapIndex();
+	CloseFile(m_logFile);
+	m_logFile = s_kNoFile;
+
+	ScoreSubmitResult result;
+	while (m_results.Pop(result))
+	{
+	}
+}
+
+bool Leaderboard::Submit(uint32_t score, uint32_t numLinesCleared)
+{
+	HP_ASSERT(IsOpen());
+
+	ScoreEntry entry;
+	entry.score = score;
+	entry.numLinesCleared = numLinesCleared;
+	entry.timeSeconds = (uint64_t)time(nullptr);
+	entry.sessionId = m_sessionId;
+	if (!m_pendingScores.Push(entry))
+		return false;
+	m_numSubmitted.fetch_add(1, std::memory_order_release);
+	return true;
+}
+
+bool Leaderboard::PopResult(ScoreSubmitResult& result)
+{
+	return m_results.Pop(result);
+}
+
+bool Leaderboard::GetTopScores(ScoreEntry* entries, unsigned int maxEntries, unsigned int& numEntries)
+{
+	numEntries = 0;
+	if (!m_indexMutex.try_lock())
+		return false;
+
+	if (m_index)
+	{
+		const unsigned int numInIndex = ReadU32(m_index + 8);
+		while (numEntries < numInIndex && numEntries < maxEntries)
+		{
+			ReadIndexEntry(m_index + s_kIndexHeaderBytes + numEntries * s_kIndexEntryBytes, entries[numEntries]);
+			++numEntries;
+		}
+	}
+	m_indexMutex.unlock();
+	return true;
+}
+
+void Leaderboard::Flush()
+{
+	const uint64_t numSubmitted = m_numSubmitted.load(std::memory_order_acquire);
+	while (m_numWritten.load(std::memory_order_acquire) < numSubmitted || !IsLoaded())
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+}
+
+uint64_t Leaderboard::GetRank(uint32_t score)
+{
+	std::lock_guard<std::mutex> lock(m_treeMutex);
+	return 1 + m_tree.CountAbove(score);
+}
+
+uint64_t Leaderboard::GetNumEntries()
+{
+	std::lock_guard<std::mutex> lock(m_treeMutex);
+	return m_tree.GetNumEntries();
+}
+
+void Leaderboard::WriterThread()
+{
+	Profiler::SetThreadName("Leaderboard");
+
+	const uint64_t replayBeginNs = Profiler::GetTimeNs();
+	ReadLog(true);
+	m_stats.replaySeconds = (Profiler::GetTimeNs() - replayBeginNs) * 1e-9;
+
+	// rewrite an index that is missing or older than the log
+	const bool indexCurrent = m_index && ReadU64(m_index + 16) == m_readOffset;
+	if (!indexCurrent)
+		m_topScoresChanged = true;
+	m_loaded.store(true, std::memory_order_release);
+
+	std::vector<ScoreEntry> batch;
+	std::vector<uint8_t> records;
+	uint64_t lastTailNs = Profiler::GetTimeNs();
+	for (;;)
+	{
+		ScoreEntry entry;
+		batch.clear();
+		while (m_pendingScores.Pop(entry))
+		{
+			batch.push_back(entry);
+		}
+
+		if (batch.empty())
+		{
+			// the index is rewritten once a burst of scores is in, not for each one
+			if (m_topScoresChanged)
+			{
+				WriteIndex();
+				m_topScoresChanged = false;
+			}
+
+			// check stopping before the final empty test so nothing submitted before Close is lost
+			if (m_stopping.load(std::memory_order_acquire) && m_pendingScores.IsEmpty())
+				break;
+
+			const uint64_t nowNs = Profiler::GetTimeNs();
+			if (nowNs - lastTailNs >= s_kTailLogIntervalMs * 1000000ull)
+			{
+				ReadLog(false);
+				lastTailNs = nowNs;
+			}
+
+			std::this_thread::sleep_for(std::chrono::milliseconds(1));
+			continue;
+		}
+
+		HP_PROFILE_SCOPE("Leaderboard::WriteScores");
+
+		records.resize(batch.size() * s_kRecordBytes);
+		for (size_t i = 0; i < batch.size(); ++i)
+		{
+			WriteRecord(batch[i], &records[i * s_kRecordBytes]);
+		}
+		// one append, so the batch lands whole and after anything other processes wrote
+		if (!WriteAll(m_logFile, records.data(), records.size()) || !SyncFile(m_logFile))
+			fprintf(stderr, "Failed to write scores: %s\n", GetFileError());
+		++m_stats.numSyncs;
+
+		// reading back picks up the batch and anything else appended since
+		ReadLog(false);
+		for (size_t i = 0; i < batch.size(); ++i)
+		{
+			ScoreSubmitResult result;
+			result.score = batch[i].score;
+			{
+				std::lock_guard<std::mutex> lock(m_treeMutex);
+				result.rank = 1 + m_tree.CountAbove(batch[i].score);
+				result.numEntries = m_tree.GetNumEntries();
+			}
+			// the game not collecting results mustn't hold up writing
+			m_results.Push(result);
+		}
+		m_numWritten.fetch_add(batch.size(), std::memory_order_release);
+	}
+}
+
+bool Leaderboard::ReadLog(bool truncateTornRecord)
+{
+	HP_PROFILE_SCOPE("Leaderboard::ReadLog");
+
+	std::vector<uint8_t> chunk(s_kReadChunkRecords * s_kRecordBytes);
+	for (;;)
+	{
+		size_t numRead = 0;
+		if (!ReadAt(m_logFile, chunk.data(), chunk.size(), m_readOffset, numRead))
+		{
+			fprintf(stderr, "Failed to read scores: %s\n", GetFileError());
+			return false;
+		}
+
+		const size_t numRecords = numRead / s_kRecordBytes;
+		{
+			std::lock_guard<std::mutex> lock(m_treeMutex);
+			for (size_t i = 0; i < numRecords; ++i)
+			{
+				ScoreEntry entry;
+				if (ReadRecord(&chunk[i * s_kRecordBytes], entry))
+					AddEntry(entry);
+				else
+					++m_stats.numCorruptRecords;
+			}
+		}
+		m_readOffset += numRecords * s_kRecordBytes;
+
+		if (numRecords < s_kReadChunkRecords)
+		{
+			// A partial record at the end is a write a crash cut short. It is
+			// only cut off on open, another process could be appending later.
+			const size_t tornBytes = numRead - numRecords * s_kRecordBytes;
+			if (tornBytes > 0 && truncateTornRecord)
+			{
+				if (TruncateFile(m_logFile, m_readOffset))
+					m_stats.numTruncatedBytes += (unsigned int)tornBytes;
+				else
+					fprintf(stderr, "Failed to drop a torn score record: %s\n", GetFileError());
+			}
+			break;
+		}
+	}
+	return true;
+}
+
+bool Leaderboard::WriteIndex()
+{
+	HP_PROFILE_SCOPE("Leaderboard::WriteIndex");
+
+	std::vector<uint8_t> data(s_kIndexHeaderBytes + m_topScores.size() * s_kIndexEntryBytes);
+	for (size_t i = 0; i < m_topScores.size(); ++i)
+	{
+		WriteIndexEntry(m_topScores[i], &data[s_kIndexHeaderBytes + i * s_kIndexEntryBytes]);
+	}
+	memcpy(data.data(), s_kIndexMagic, sizeof(s_kIndexMagic));
+	WriteU32(&data[8], (uint32_t)m_topScores.size());
+	WriteU32(&data[12], Crc32(&data[s_kIndexHeaderBytes], data.size() - s_kIndexHeaderBytes));
+	WriteU64(&data[16], m_readOffset);
+
+	// written in full beside the old one, then renamed over it in one step
+	const std::string tempPath = m_indexPath + ".tmp";
+	if (!WriteFileSynced(tempPath.c_str(), data.data(), data.size()))
+	{
+		fprintf(stderr, "Failed to write %s: %s\n", tempPath.c_str(), GetFileError());
+		remove(tempPath.c_str());
+		return false;
+	}
+
+	// unmapped first, Windows won't replace a file this process has mapped
+	std::lock_guard<std::mutex> lock(m_indexMutex);
+	UnmapIndex();
+	const bool replaced = MoveFileOver(tempPath.c_str(), m_indexPath.c_str());
+	if (replaced)
+		++m_stats.numIndexWrites;
+	else
+	{
+		fprintf(stderr, "Failed to write %s: %s\n", m_indexPath.c_str(), GetFileError());
+		remove(tempPath.c_str());
+	}
+	MapIndex();
+	return replaced;
+}
+
+// caller holds m_indexMutex or is the only thread running
+void Leaderboard::MapIndex()
+{
+	HP_ASSERT(!m_index);
+
+	m_index = MapFile(m_indexPath.c_str(), s_kIndexHeaderBytes, m_indexBytes);
+
+	// an index that doesn't check out is ignored and rewritten once the log is read
+	if (m_index)
+	{
+		const uint32_t numEntries = ReadU32(m_index + 8);
+		const size_t expectedBytes = s_kIndexHeaderBytes + (size_t)numEntries * s_kIndexEntryBytes;
+		if (memcmp(m_index, s_kIndexMagic, sizeof(s_kIndexMagic)) != 0 || numEntries > kNumTopScores
+			|| m_indexBytes != expectedBytes
+			|| ReadU32(m_index + 12) != Crc32(m_index + s_kIndexHeaderBytes, expectedBytes - s_kIndexHeaderBytes))
+		{
+			UnmapIndex();
+		}
+	}
+}
+
+void Leaderboard::UnmapIndex()
+{
+	if (m_index)
+		UnmapFile(m_index, m_indexBytes);
+	m_index = nullptr;
+	m_indexBytes = 0;
+}
+
+
+// writer thread with m_treeMutex held
+void Leaderboard::AddEntry(const ScoreEntry& entry)
+{
+	m_tree.Insert(entry.score);
+	++m_stats.numReplayed;
+
+	if (m_topScores.size() == kNumTopScores && !IsBetterScore(entry, m_topScores.back()))
+		return;
+
+	std::vector<ScoreEntry>::iterator position = m_topScores.begin();
+	while (position != m_topScores.end() && !IsBetterScore(entry, *position))
+	{
+		++position;
+	}
+	m_topScores.insert(position, entry);
+	if (m_topScores.size() > kNumTopScores)
+		m_topScores.pop_back();
+	m_topScoresChanged = true;
+
+	if (entry.score > m_highScore.load(std::memory_order_relaxed))
+		m_highScore.store(entry.score, std::memory_order_release);
+}
+
+void Leaderboard::PrintStats() const
+{
+	printf("Leaderboard\n");
+	printf("  %-24s %12" PRIu64 "\n", "Scores read", m_stats.numReplayed);
+	printf("  %-24s %12.3f\n", "Log read seconds", m_stats.replaySeconds);
+	printf("  %-24s %12u\n", "Corrupt records", m_stats.numCorruptRecords);
+	printf("  %-24s %12u\n", "Torn bytes dropped", m_stats.numTruncatedBytes);
+	printf("  %-24s %12u\n", "Syncs", m_stats.numSyncs);
+	printf("  %-24s %12u\n", "Index writes", m_stats.numIndexWrites);
+}
@@ -0,0 +1,170 @@
+#pragma once
+#ifndef LEADERBOARD_H_INCLUDED
+#define LEADERBOARD_H_INCLUDED
+
+#include "SpscQueue.h"
+#include <atomic>
+#include <mutex>
+#include <stdint.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct ScoreEntry
+{
+	uint32_t score;
+	uint32_t numLinesCleared;
+	// unix time the game ended
+	uint64_t timeSeconds;
+	// random for each Open, so logs merged from many machines and runs stay apart
+	uint64_t sessionId;
+};
+
+struct ScoreSubmitResult
+{
+	uint32_t score;
+	// 1 is the best, equal scores share a rank
+	uint64_t rank;
+	uint64_t numEntries;
+};
+
+struct LeaderboardStats
+{
+	uint64_t numReplayed;
+	unsigned int numCorruptRecords;
+	unsigned int numTruncatedBytes;
+	double replaySeconds;
+	unsigned int numSyncs;
+	unsigned int numIndexWrites;
+};
+
+// Order statistic treap over scores with one node per distinct score, so
+// inserting and ranking are O(log n) in the number of distinct scores.
+class ScoreRankTree
+{
+public:
+	ScoreRankTree();
+
+	void Insert(uint32_t score);
+	// how many entries scored strictly more
+	uint64_t CountAbove(uint32_t score) const;
+	uint64_t GetNumEntries() const;
+	size_t GetNumNodes() const { return m_nodes.size(); }
+	void Clear();
+
+private:
+	static const uint32_t kNoNode = 0xffffffff;
+
+	struct Node
+	{
+		uint32_t score;
+		uint32_t priority;
+		uint32_t left;
+		uint32_t right;
+		uint32_t count;
+		// entries in this node and everything below it
+		uint32_t subtreeCount;
+	};
+
+	uint32_t InsertBelow(uint32_t node, uint32_t score);
+	uint32_t RotateLeft(uint32_t node);
+	uint32_t RotateRight(uint32_t node);
+	uint32_t GetSubtreeCount(uint32_t node) const { return node == kNoNode ? 0 : m_nodes[node].subtreeCount; }
+	void UpdateSubtreeCount(uint32_t node);
+
+	std::vector<Node> m_nodes;
+	uint32_t m_root;
+	uint32_t m_rngState;
+};
+
+// Scores kept across runs in an append-only log, with the best kNumTopScores
+// also kept sorted in a small index file next to it. Each log record has a
+// checksum, so a record torn by a crash is dropped when the log is next opened
+// and a damaged one is skipped. The index is replaced by renaming a fully
+// written file over it, and is memory mapped, so the best scores are there as
+// soon as Open returns without reading the whole log.
+//
+// The game thread only ever touches lock free queues and atomics. A writer
+// thread appends and syncs submitted scores, reads the log back from where it
+// last got to, which also picks up scores other processes appended, and keeps
+// the rank tree and the index up to date. POSIX files and mmap, or on Windows
+// FlushFileBuffers, MoveFileEx and a mapped view.
+class Leaderboard
+{
+public:
+	static const unsigned int kNumTopScores = 100;
+	static const unsigned int kMaxPendingScores = 256;
+
+	Leaderboard();
+	~Leaderboard();
+
+	// opens or creates the log at path, the index is path with ".top" appended
+	bool Open(const char* path);
+	// waits for submitted scores to reach the disk
+	void Close();
+	bool IsOpen() const { return m_logFile != -1; }
+
+	// Game thread, never blocks. Fails only if kMaxPendingScores are waiting.
+	bool Submit(uint32_t score, uint32_t numLinesCleared);
+	// Game thread. The rank of each submitted score once it is on disk.
+	bool PopResult(ScoreSubmitResult& result);
+	// the best score known, from the index until the log has been read
+	uint32_t GetHighScore() const { return m_highScore.load(std::memory_order_acquire); }
+	// true once the whole log has been read and ranks cover every score
+	bool IsLoaded() const { return m_loaded.load(std::memory_order_acquire); }
+	// Game thread, never blocks. Copies the best scores, highest first, and
+	// returns false without copying if the index is being replaced right now.
+	bool GetTopScores(ScoreEntry* entries, unsigned int maxEntries, unsigned int& numEntries);
+
+	// These block, so they are for tools rather than the game thread.
+	// Waits until every submitted score is on disk and ranked.
+	void Flush();
+	// 1 plus how many entries scored more
+	uint64_t GetRank(uint32_t score);
+	uint64_t GetNumEntries();
+
+	const LeaderboardStats& GetStats() const { return m_stats; }
+	void PrintStats() const;
+
+private:
+	Leaderboard(const Leaderboard&);
+	Leaderboard& operator=(const Leaderboard&);
+
+	void WriterThread();
+	// ranks everything in the log past m_readOffset, returns false on a read error
+	bool ReadLog(bool truncateTornRecord);
+	void AddEntry(const ScoreEntry& entry);
+	bool WriteIndex();
+	void MapIndex();
+	void UnmapIndex();
+
+	// an fd, or a HANDLE on Windows
+	intptr_t m_logFile;
+	std::string m_indexPath;
+	uint64_t m_sessionId;
+
+	SpscQueue<ScoreEntry, kMaxPendingScores> m_pendingScores;		// game to writer thread
+	SpscQueue<ScoreSubmitResult, kMaxPendingScores> m_results;	// writer to game thread
+	std::atomic<uint64_t> m_numSubmitted;
+	std::atomic<uint64_t> m_numWritten;
+	std::atomic<uint32_t> m_highScore;
+	std::atomic<bool> m_loaded;
+	std::atomic<bool> m_stopping;
+	std::thread m_writerThread;
+
+	// writer thread, and tools through the mutex
+	std::mutex m_treeMutex;
+	ScoreRankTree m_tree;
+	uint64_t m_readOffset;
+	std::vector<ScoreEntry> m_topScores;
+	bool m_topScoresChanged;
+
+	// the mapped index, swapped by the writer thread under the mutex
+	std::mutex m_indexMutex;
+	const uint8_t* m_index;
+	size_t m_indexBytes;
+
+	LeaderboardStats m_stats;
+};
+
+#endif // LEADERBOARD_H_INCLUDED
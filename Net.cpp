@@ -0,0 +1,197 @@
+#include "Net.h"
+#include "Debugger.h"
+#include <stdio.h>
+#include <string.h>
+
+#ifdef _WIN32
+#include <winsock2.h>
+#pragma comment(lib, "ws2_32.lib")
+typedef int socklen_t;
+#else
+#include <arpa/inet.h>
+#include <errno.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+#endif
+
+static const intptr_t s_kInvalidSocket = -1;
+
+//Helper functions
+//================================================================================
+
+static bool InitSockets()
+{
+#ifdef _WIN32
+	static bool s_initialised = false;
+	if (!s_initialised)
+	{
+		WSADATA wsaData;
+		if (WSAStartup(MAKEWORD(2, 2), &wsaData) != 0)
+		{
+			fprintf(stderr, "WSAStartup failed\n");
+			return false;
+		}
+		s_initialised = true;
+	}
+#endif
+	return true;
+}
+
+static void CloseSocket(intptr_t socketHandle)
+{
+#ifdef _WIN32
+	closesocket((SOCKET)socketHandle);
+#else
+	close((int)socketHandle);
+#endif
+}
+
+static bool WouldBlock()
+{
+#ifdef _WIN32
+	const int error = WSAGetLastError();
+	// a previous send to a closed port is reported on the next receive, ignore it
+	return error == WSAEWOULDBLOCK || error == WSAECONNRESET;
+#else
+	return errno == EAGAIN || errno == EWOULDBLOCK || errno == ECONNREFUSED;
+#endif
+}
+
+static void ToSockAddr(const NetAddress& address, sockaddr_in& sockAddr)
+{
+	memset(&sockAddr, 0, sizeof(sockAddr));
+	sockAddr.sin_family = AF_INET;
+	sockAddr.sin_addr.s_addr = htonl(address.host);
+	sockAddr.sin_port = htons(address.port);
+}
+
+//================================================================================
+
+bool ParseNetAddress(const char* text, NetAddress& address)
+{
+	unsigned int a = 0, b = 0, c = 0, d = 0, port = 0;
+	if (strncmp(text, "localhost:", 10) == 0 && sscanf(text + 10, "%u", &port) == 1)
+	{
+		a = 127;
+		d = 1;
+	}
+	else if (sscanf(text, "%u.%u.%u.%u:%u", &a, &b, &c, &d, &port) != 5)
+	{
+		fprintf(stderr, "ERROR - Expected an address like 127.0.0.1:7000, got %s\n", text);
+		return false;
+	}
+
+	if (a > 255 || b > 255 || c > 255 || d > 255 || port == 0 || port > 65535)
+	{
+		fprintf(stderr, "ERROR - Address out of range: %s\n", text);
+		return false;
+	}
+
+	address.host = (a << 24) | (b << 16) | (c << 8) | d;
+	address.port = (uint16_t)port;
+	return true;
+}
+
+UdpSocket::UdpSocket()
+	: m_socket(s_kInvalidSocket)
+	, m_port(0)
+{
+}
+
+UdpSocket::~UdpSocket()
+{
+	Close();
+}
+
+bool UdpSocket::Open(uint16_t port)
+{
+	HP_ASSERT(!IsOpen());
+
+	if (!InitSockets())
+		return false;
+
+#ifdef _WIN32
+	const SOCKET socketHandle = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	if (socketHandle == INVALID_SOCKET)
+#else
+	const int socketHandle = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	if (socketHandle < 0)
+#endif
+	{
+		fprintf(stderr, "ERROR - Failed to create UDP socket\n");
+		return false;
+	}
+	m_socket = (intptr_t)socketHandle;
+
+	NetAddress anyAddress = { INADDR_ANY, port };
+	sockaddr_in sockAddr;
+	ToSockAddr(anyAddress, sockAddr);
+	if (bind(socketHandle, (const sockaddr*)&sockAddr, sizeof(sockAddr)) != 0)
+	{
+		fprintf(stderr, "ERROR - Failed to bind UDP port %u\n", port);
+		Close();
+		return false;
+	}
+
+#ifdef _WIN32
+	u_long nonBlocking = 1;
+	const bool nonBlockingSet = ioctlsocket(socketHandle, FIONBIO, &nonBlocking) == 0;
+#else
+	const bool nonBlockingSet = fcntl(socketHandle, F_SETFL, fcntl(socketHandle, F_GETFL, 0) | O_NONBLOCK) == 0;
+#endif
+	if (!nonBlockingSet)
+	{
+		fprintf(stderr, "ERROR - Failed to make UDP socket non-blocking\n");
+		Close();
+		return false;
+	}
+
+	socklen_t sockAddrSize = sizeof(sockAddr);
+	getsockname(socketHandle, (sockaddr*)&sockAddr, &sockAddrSize);
+	m_port = ntohs(sockAddr.sin_port);
+	return true;
+}
+
+void UdpSocket::Close()
+{
+	if (IsOpen())
+	{
+		CloseSocket(m_socket);
+		m_socket = s_kInvalidSocket;
+		m_port = 0;
+	}
+}
+
+bool UdpSocket::IsOpen() const
+{
+	return m_socket != s_kInvalidSocket;
+}
+
+bool UdpSocket::Send(const NetAddress& to, const void* data, size_t numBytes)
+{
+	HP_ASSERT(IsOpen());
+
+	sockaddr_in sockAddr;
+	ToSockAddr(to, sockAddr);
+	const int numSent = (int)sendto(m_socket, (const char*)data, (int)numBytes, 0, (const sockaddr*)&sockAddr, sizeof(sockAddr));
+	return numSent == (int)numBytes;
+}
+
+int UdpSocket::Receive(void* data, size_t maxBytes, NetAddress& from)
+{
+	HP_ASSERT(IsOpen());
+
+	sockaddr_in sockAddr;
+	socklen_t sockAddrSize = sizeof(sockAddr);
+	const int numReceived = (int)recvfrom(m_socket, (char*)data, (int)maxBytes, 0, (sockaddr*)&sockAddr, &sockAddrSize);
+	if (numReceived < 0)
+	{
+		return WouldBlock() ? 0 : -1;
+	}
+
+	from.host = ntohl(sockAddr.sin_addr.s_addr);
+	from.port = ntohs(sockAddr.sin_port);
+	return numReceived;
+}
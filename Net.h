@@ -0,0 +1,47 @@
+#pragma once
+#ifndef NET_H_INCLUDED
+#define NET_H_INCLUDED
+
+#include <stddef.h>
+#include <stdint.h>
+
+// An IPv4 address and port, both in host byte order.
+struct NetAddress
+{
+	uint32_t host;
+	uint16_t port;
+
+	bool operator==(const NetAddress& other) const { return host == other.host && port == other.port; }
+	bool operator!=(const NetAddress& other) const { return !(*this == other); }
+};
+
+// Parses "a.b.c.d:port" or "localhost:port".
+bool ParseNetAddress(const char* text, NetAddress& address);
+
+// A non-blocking UDP socket.
+class UdpSocket
+{
+public:
+	UdpSocket();
+	~UdpSocket();
+
+	// binds to port on all interfaces, 0 picks a free port
+	bool Open(uint16_t port);
+	void Close();
+	bool IsOpen() const;
+	uint16_t GetPort() const { return m_port; }
+
+	bool Send(const NetAddress& to, const void* data, size_t numBytes);
+	// Returns the size of the next waiting datagram, 0 if there is none or -1
+	// on error. Datagrams bigger than maxBytes are truncated.
+	int Receive(void* data, size_t maxBytes, NetAddress& from);
+
+private:
+	UdpSocket(const UdpSocket&);
+	UdpSocket& operator=(const UdpSocket&);
+
+	intptr_t m_socket;
+	uint16_t m_port;
+};
+
+#endif // NET_H_INCLUDED
@@ -0,0 +1,123 @@
+#include "NetRelay.h"
+#include "Debugger.h"
+#include "Profiler.h"
+#include <stdio.h>
+#include <string.h>
+#include <chrono>
+#include <thread>
+
+NetRelay::NetRelay()
+	: m_rngState(0x2545f491u)
+	, m_packetsForwarded(0)
+	, m_packetsDropped(0)
+{
+	memset(&m_conditions, 0, sizeof(m_conditions));
+	for (unsigned int i = 0; i < 2; ++i)
+	{
+		m_sides[i].hasPeer = false;
+	}
+}
+
+bool NetRelay::Open(uint16_t portA, uint16_t portB, const NetConditions& conditions)
+{
+	m_conditions = conditions;
+	if (!m_sides[0].socket.Open(portA) || !m_sides[1].socket.Open(portB))
+	{
+		Close();
+		return false;
+	}
+
+	printf("Relaying ports %u <-> %u, latency %u ms, jitter %u ms, loss %u%%\n",
+		m_sides[0].socket.GetPort(), m_sides[1].socket.GetPort(), conditions.latencyMs, conditions.jitterMs, conditions.lossPercent);
+	return true;
+}
+
+void NetRelay::Close()
+{
+	for (unsigned int i = 0; i < 2; ++i)
+	{
+		m_sides[i].socket.Close();
+		m_sides[i].hasPeer = false;
+	}
+	m_delayedPackets.clear();
+}
+
+uint32_t NetRelay::NextRandom()
+{
+	uint32_t x = m_rngState;
+	x ^= x << 13;
+	x ^= x >> 17;
+	x ^= x << 5;
+	m_rngState = x;
+	return x;
+}
+
+void NetRelay::Update()
+{
+	const uint64_t nowNs = Profiler::GetTimeNs();
+
+	for (unsigned int side = 0; side < 2; ++side)
+	{
+		Side& from = m_sides[side];
+		DelayedPacket packet;
+		NetAddress fromAddress;
+		int numBytes;
+		while ((numBytes = from.socket.Receive(packet.data, sizeof(packet.data), fromAddress)) > 0)
+		{
+			from.peer = fromAddress;
+			from.hasPeer = true;
+
+			if (NextRandom() % 100 < m_conditions.lossPercent)
+			{
+				++m_packetsDropped;
+				continue;
+			}
+
+			int delayMs = (int)m_conditions.latencyMs;
+			if (m_conditions.jitterMs > 0)
+			{
+				delayMs += (int)(NextRandom() % (2 * m_conditions.jitterMs + 1)) - (int)m_conditions.jitterMs;
+			}
+			if (delayMs < 0)
+				delayMs = 0;
+
+			packet.sendTimeNs = nowNs + (uint64_t)delayMs * 1000000;
+			packet.toSide = side ^ 1;
+			packet.numBytes = (uint16_t)numBytes;
+			m_delayedPackets.push_back(packet);
+		}
+	}
+
+	for (size_t i = 0; i < m_delayedPackets.size();)
+	{
+		const DelayedPacket& packet = m_delayedPackets[i];
+		if (packet.sendTimeNs > nowNs)
+		{
+			++i;
+			continue;
+		}
+
+		Side& to = m_sides[packet.toSide];
+		if (to.hasPeer)
+		{
+			to.socket.Send(to.peer, packet.data, packet.numBytes);
+			++m_packetsForwarded;
+		}
+		else
+		{
+			++m_packetsDropped;
+		}
+
+		m_delayedPackets[i] = m_delayedPackets.back();
+		m_delayedPackets.pop_back();
+	}
+}
+
+void NetRelay::Run(const volatile bool& stop)
+{
+	while (!stop)
+	{
+		Update();
+		std::this_thread::sleep_for(std::chrono::milliseconds(1));
+	}
+}
@@ -0,0 +1,64 @@
+#pragma once
+#ifndef NET_RELAY_H_INCLUDED
+#define NET_RELAY_H_INCLUDED
+
+#include "Net.h"
+#include <vector>
+
+struct NetConditions
+{
+	unsigned int latencyMs;
+	// each packet's delay varies by up to this either way, so packets can arrive out of order
+	unsigned int jitterMs;
+	unsigned int lossPercent;
+};
+
+// Forwards UDP between two peers on one machine with simulated latency,
+// jitter and loss, for testing versus mode without a real network. Each peer
+// talks to its own relay port, the relay learns the peer's address from the
+// first packet it sends and forwards everything to the other side.
+class NetRelay
+{
+public:
+	NetRelay();
+
+	bool Open(uint16_t portA, uint16_t portB, const NetConditions& conditions);
+	void Close();
+
+	// forwards what has arrived and sends what is due
+	void Update();
+	// updates until stop is set
+	void Run(const volatile bool& stop);
+
+	unsigned int GetPacketsForwarded() const { return m_packetsForwarded; }
+	unsigned int GetPacketsDropped() const { return m_packetsDropped; }
+
+private:
+	static const unsigned int kMaxPacketBytes = 1024;
+
+	struct DelayedPacket
+	{
+		uint64_t sendTimeNs;
+		unsigned int toSide;
+		uint16_t numBytes;
+		uint8_t data[kMaxPacketBytes];
+	};
+
+	struct Side
+	{
+		UdpSocket socket;
+		NetAddress peer;
+		bool hasPeer;
+	};
+
+	uint32_t NextRandom();
+
+	Side m_sides[2];
+	NetConditions m_conditions;
+	std::vector<DelayedPacket> m_delayedPackets;
+	uint32_t m_rngState;
+	unsigned int m_packetsForwarded;
+	unsigned int m_packetsDropped;
+};
+
+#endif // NET_RELAY_H_INCLUDED
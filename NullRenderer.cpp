@@ -0,0 +1,272 @@
+#include "NullRenderer.h"
+#include "Debugger.h"
+#include <inttypes.h>
+#include <stdio.h>
+#include <string.h>
+
+static const char* s_kRenderCallNames[] =
+{
+	"Clear",
+	"Present",
+	"DrawRect",
+	"DrawSolidRect",
+	"DrawText",
+	"ReadPixels",
+	"CacheText",
+	"DrawCachedText",
+	"CreateRenderTarget",
+	"DestroyTexture",
+	"SetRenderTarget",
+	"DrawTexture",
+	"CreateBlockAtlas",
+	"SubmitRects",
+	"SubmitSprites",
+};
+static_assert(sizeof(s_kRenderCallNames) / sizeof(s_kRenderCallNames[0]) == kNumRenderCalls, "Render call names out of date");
+
+const char* GetRenderCallName(RenderCall call)
+{
+	HP_ASSERT(call < kNumRenderCalls);
+	return s_kRenderCallNames[call];
+}
+
+//================================================================================
+
+NullRenderer::NullRenderer(unsigned int Width, unsigned int Height)
+	: Renderer(Width, Height)
+{
+	memset(&m_Stats, 0, sizeof(m_Stats));
+	printf("Null renderer = (%u, %u)\n", Width, Height);
+}
+
+NullRenderer::~NullRenderer()
+{
+}
+
+void NullRenderer::ResetStats()
+{
+	// allocations outlive a reset, only the per call counters start again
+	const uint64_t textureBytes = m_Stats.textureBytes;
+	memset(&m_Stats, 0, sizeof(m_Stats));
+	m_Stats.textureBytes = textureBytes;
+}
+
+void NullRenderer::PrintStats() const
+{
+	const double frames = m_Stats.frames ? (double)m_Stats.frames : 1.0;
+	printf("Null renderer stats over %" PRIu64 " frames\n", m_Stats.frames);
+	for (int i = 0; i < kNumRenderCalls; ++i)
+	{
+		if (m_Stats.calls[i] == 0)
+			continue;
+		printf("  %-20s %12" PRIu64 " (%.1f per frame)\n", GetRenderCallName((RenderCall)i), m_Stats.calls[i], m_Stats.calls[i] / frames);
+	}
+	printf("  %-20s %12" PRIu64 " (%.1f per frame)\n", "primitives", m_Stats.primitives, m_Stats.primitives / frames);
+	printf("  %-20s %12" PRIu64 " (%.1f per frame)\n", "command bytes", m_Stats.commandBytes, m_Stats.commandBytes / frames);
+	printf("  %-20s %12" PRIu64 " (%.1f per frame)\n", "pixel bytes", m_Stats.pixelBytes, m_Stats.pixelBytes / frames);
+	printf("  %-20s %12" PRIu64 "\n", "texture bytes", m_Stats.textureBytes);
+}
+
+void NullRenderer::Clear()
+{
+	++m_Stats.calls[kRenderCall_Clear];
+	m_Stats.pixelBytes += (uint64_t)m_Width * m_Height * 4;
+}
+
+void NullRenderer::Present()
+{
+	FlushBatch();
+	++m_Stats.calls[kRenderCall_Present];
+	++m_Stats.frames;
+	EndFrame();
+}
+
+void NullRenderer::DrawRect(int x, int y, int w, int h, uint32_t rgba)
+{
+	HP_UNUSED(x);
+	HP_UNUSED(y);
+	HP_UNUSED(rgba);
+
+	FlushBatch();
+	++m_Stats.calls[kRenderCall_DrawRect];
+	++m_Stats.primitives;
+	m_Stats.commandBytes += sizeof(RenderRect) + sizeof(uint32_t);
+	m_Stats.pixelBytes += (uint64_t)(2 * (w + h)) * 4;
+}
+
+void NullRenderer::DrawSolidRect(int x, int y, int w, int h, uint32_t rgba)
+{
+	HP_UNUSED(x);
+	HP_UNUSED(y);
+	HP_UNUSED(rgba);
+
+	FlushBatch();
+	++m_Stats.calls[kRenderCall_DrawSolidRect];
+	++m_Stats.primitives;
+	m_Stats.commandBytes += sizeof(RenderRect) + sizeof(uint32_t);
+	m_Stats.pixelBytes += (uint64_t)w * h * 4;
+}
+
+void NullRenderer::DrawText(const char* text, int x, int y, uint32_t rgba)
+{
+	HP_ASSERT(text);
+	HP_UNUSED(x);
+	HP_UNUSED(y);
+	HP_UNUSED(rgba);
+
+	FlushBatch();
+	const size_t length = strlen(text);
+	++m_Stats.calls[kRenderCall_DrawText];
+	m_Stats.primitives += length;
+	m_Stats.commandBytes += length + sizeof(uint32_t);
+}
+
+// counted but never succeeds, there is no frame to read
+bool NullRenderer::ReadPixels(uint32_t* pixels)
+{
+	HP_ASSERT(pixels);
+
+	FlushBatch();
+	++m_Stats.calls[kRenderCall_ReadPixels];
+	return false;
+}
+
+TextHandle NullRenderer::CacheText(const char* text, uint32_t rgba)
+{
+	HP_ASSERT(text);
+	HP_UNUSED(rgba);
+
+	++m_Stats.calls[kRenderCall_CacheText];
+	m_Stats.commandBytes += strlen(text) + sizeof(uint32_t);
+
+	unsigned int slot;
+	return AllocateCachedText(slot);
+}
+
+bool NullRenderer::DrawCachedText(TextHandle handle, int x, int y)
+{
+	HP_UNUSED(x);
+	HP_UNUSED(y);
+
+	unsigned int slot;
+	if (!FindCachedText(handle, slot))
+		return false;
+
+	FlushBatch();
+	++m_Stats.calls[kRenderCall_DrawCachedText];
+	++m_Stats.primitives;
+	m_Stats.commandBytes += sizeof(TextHandle);
+	return true;
+}
+
+NullRenderer::TextureEntry* NullRenderer::GetTexture(TextureHandle handle)
+{
+	if (handle == 0 || handle > m_Textures.size() || m_Textures[handle - 1].width == 0)
+		return nullptr;
+	return &m_Textures[handle - 1];
+}
+
+TextureHandle NullRenderer::AddTexture(unsigned int width, unsigned int height, unsigned int spriteSize)
+{
+	HP_ASSERT(width > 0 && height > 0);
+
+	TextureEntry entry = { width, height, spriteSize };
+	m_Stats.textureBytes += (uint64_t)width * height * 4;
+
+	// reuse a released slot before growing the table
+	for (size_t i = 0; i < m_Textures.size(); ++i)
+	{
+		if (m_Textures[i].width == 0)
+		{
+			m_Textures[i] = entry;
+			return (TextureHandle)i + 1;
+		}
+	}
+
+	m_Textures.push_back(entry);
+	return (TextureHandle)m_Textures.size();
+}
+
+TextureHandle NullRenderer::CreateRenderTarget(unsigned int width, unsigned int height)
+{
+	++m_Stats.calls[kRenderCall_CreateRenderTarget];
+	return AddTexture(width, height, 0);
+}
+
+TextureHandle NullRenderer::CreateBlockAtlas(const uint32_t* rgbas, unsigned int numSprites, unsigned int spriteSizePixels)
+{
+	HP_ASSERT(rgbas && numSprites > 0 && spriteSizePixels > 0);
+
+	++m_Stats.calls[kRenderCall_CreateBlockAtlas];
+	m_Stats.commandBytes += numSprites * sizeof(uint32_t);
+	return AddTexture(numSprites * spriteSizePixels, spriteSizePixels, spriteSizePixels);
+}
+
+void NullRenderer::DestroyTexture(TextureHandle handle)
+{
+	TextureEntry* entry = GetTexture(handle);
+	if (!entry)
+		return;
+
+	FlushBatch();
+	++m_Stats.calls[kRenderCall_DestroyTexture];
+	m_Stats.textureBytes -= (uint64_t)entry->width * entry->height * 4;
+	entry->width = 0;
+	entry->height = 0;
+}
+
+void NullRenderer::SetRenderTarget(TextureHandle handle)
+{
+	HP_UNUSED(handle);
+
+	FlushBatch();
+	++m_Stats.calls[kRenderCall_SetRenderTarget];
+	m_Stats.commandBytes += sizeof(TextureHandle);
+}
+
+void NullRenderer::DrawTexture(TextureHandle handle, int x, int y)
+{
+	HP_UNUSED(x);
+	HP_UNUSED(y);
+
+	TextureEntry* entry = GetTexture(handle);
+	if (!entry)
+		return;
+
+	FlushBatch();
+	++m_Stats.calls[kRenderCall_DrawTexture];
+	++m_Stats.primitives;
+	m_Stats.commandBytes += sizeof(TextureHandle) + 2 * sizeof(int);
+	m_Stats.pixelBytes += (uint64_t)entry->width * entry->height * 4;
+}
+
+void NullRenderer::SubmitRects(const RenderRect* rects, unsigned int numRects, uint32_t rgba, bool solid)
+{
+	HP_UNUSED(rgba);
+
+	++m_Stats.calls[kRenderCall_SubmitRects];
+	m_Stats.primitives += numRects;
+	m_Stats.commandBytes += numRects * sizeof(RenderRect) + sizeof(uint32_t);
+	for (unsigned int i = 0; i < numRects; ++i)
+	{
+		const RenderRect& rect = rects[i];
+		if (solid)
+			m_Stats.pixelBytes += (uint64_t)rect.w * rect.h * 4;
+		else
+			m_Stats.pixelBytes += (uint64_t)(2 * (rect.w + rect.h)) * 4;
+	}
+}
+
+void NullRenderer::SubmitSprites(TextureHandle atlas, const SpriteInstance* sprites, unsigned int numSprites)
+{
+	HP_UNUSED(sprites);
+
+	TextureEntry* entry = GetTexture(atlas);
+	if (!entry || entry->spriteSize == 0)
+		return;
+
+	++m_Stats.calls[kRenderCall_SubmitSprites];
+	m_Stats.primitives += numSprites;
+	m_Stats.commandBytes += numSprites * sizeof(SpriteInstance) + sizeof(TextureHandle);
+	m_Stats.pixelBytes += (uint64_t)numSprites * entry->spriteSize * entry->spriteSize * 4;
+}
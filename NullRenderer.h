@@ -0,0 +1,88 @@
+#pragma once
+#ifndef NULL_RENDERER_H_INCLUDED
+#define NULL_RENDERER_H_INCLUDED
+
+#include "Render.h"
+
+enum RenderCall
+{
+	kRenderCall_Clear = 0,
+	kRenderCall_Present,
+	kRenderCall_DrawRect,
+	kRenderCall_DrawSolidRect,
+	kRenderCall_DrawText,
+	kRenderCall_ReadPixels,
+	kRenderCall_CacheText,
+	kRenderCall_DrawCachedText,
+	kRenderCall_CreateRenderTarget,
+	kRenderCall_DestroyTexture,
+	kRenderCall_SetRenderTarget,
+	kRenderCall_DrawTexture,
+	kRenderCall_CreateBlockAtlas,
+	kRenderCall_SubmitRects,
+	kRenderCall_SubmitSprites,
+	kNumRenderCalls
+};
+
+const char* GetRenderCallName(RenderCall call);
+
+struct RenderStats
+{
+	uint64_t frames;
+	uint64_t calls[kNumRenderCalls];
+	uint64_t primitives;	// rects, sprites, glyphs and texture copies
+	uint64_t commandBytes;	// argument data passed across the interface
+	uint64_t pixelBytes;	// RGBA8888 bytes a rasterizer would have written
+	uint64_t textureBytes;	// currently allocated texture memory
+};
+
+// Accepts every call and only counts it, so Game::Draw can run without a
+// window or GPU and its CPU cost can be measured apart from any backend.
+class NullRenderer : public Renderer
+{
+public:
+	NullRenderer(unsigned int Width, unsigned int Height);
+	virtual ~NullRenderer();
+
+	virtual void Clear();
+	virtual void Present();
+
+	virtual void DrawRect(int x, int y, int w, int h, uint32_t rgba = 0xffffffff);
+	virtual void DrawSolidRect(int x, int y, int w, int h, uint32_t rgba = 0xffffffff);
+	virtual void DrawText(const char* text, int x, int y, uint32_t rgba = 0xffffffff);
+	virtual bool ReadPixels(uint32_t* pixels);
+
+	virtual TextHandle CacheText(const char* text, uint32_t rgba = 0xffffffff);
+	virtual bool DrawCachedText(TextHandle handle, int x, int y);
+
+	virtual TextureHandle CreateRenderTarget(unsigned int width, unsigned int height);
+	virtual void DestroyTexture(TextureHandle handle);
+	virtual void SetRenderTarget(TextureHandle handle);
+	virtual void DrawTexture(TextureHandle handle, int x, int y);
+
+	virtual TextureHandle CreateBlockAtlas(const uint32_t* rgbas, unsigned int numSprites, unsigned int spriteSizePixels);
+
+	const RenderStats& GetStats() const { return m_Stats; }
+	void ResetStats();
+	void PrintStats() const;
+
+protected:
+	virtual void SubmitRects(const RenderRect* rects, unsigned int numRects, uint32_t rgba, bool solid);
+	virtual void SubmitSprites(TextureHandle atlas, const SpriteInstance* sprites, unsigned int numSprites);
+
+private:
+	struct TextureEntry
+	{
+		unsigned int width;
+		unsigned int height;
+		unsigned int spriteSize;
+	};
+
+	TextureEntry* GetTexture(TextureHandle handle);
+	TextureHandle AddTexture(unsigned int width, unsigned int height, unsigned int spriteSize);
+
+	std::vector<TextureEntry> m_Textures;
+	RenderStats m_Stats;
+};
+
+#endif // NULL_RENDERER_H_INCLUDED
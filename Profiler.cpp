@@ -0,0 +1,131 @@
+#include "Profiler.h"
+#include <chrono>
+#include <stdio.h>
+#include <string.h>
+
+struct ProfileEvent
+{
+	const char* name;
+	uint64_t beginNs;
+	uint64_t endNs;
+};
+
+// Written only by its owning thread. The write count is published with release
+// ordering so a dumping thread sees complete events up to that count.
+struct ProfileThreadBuffer
+{
+	ProfileEvent events[Profiler::kEventsPerThread];
+	std::atomic<uint64_t> writeCount;
+	unsigned int threadIndex;
+	char threadName[32];
+	ProfileThreadBuffer* next;
+};
+
+std::atomic<bool> Profiler::s_enabled(false);
+
+static std::atomic<ProfileThreadBuffer*> s_threadBuffers(nullptr);
+static std::atomic<unsigned int> s_numThreadBuffers(0);
+static thread_local ProfileThreadBuffer* s_threadBuffer = nullptr;
+static const std::chrono::steady_clock::time_point s_startTime = std::chrono::steady_clock::now();
+
+//================================================================================
+
+static ProfileThreadBuffer* GetThreadBuffer()
+{
+	if (s_threadBuffer)
+		return s_threadBuffer;
+
+	// one allocation per thread for the life of the process, pushed lock free
+	ProfileThreadBuffer* buffer = new ProfileThreadBuffer;
+	buffer->writeCount.store(0, std::memory_order_relaxed);
+	buffer->threadIndex = s_numThreadBuffers.fetch_add(1, std::memory_order_relaxed) + 1;
+	snprintf(buffer->threadName, sizeof(buffer->threadName), "Thread %u", buffer->threadIndex);
+
+	ProfileThreadBuffer* head = s_threadBuffers.load(std::memory_order_relaxed);
+	do
+	{
+		buffer->next = head;
+	} while (!s_threadBuffers.compare_exchange_weak(head, buffer, std::memory_order_release, std::memory_order_relaxed));
+
+	s_threadBuffer = buffer;
+	return buffer;
+}
+
+static void WriteJsonString(FILE* file, const char* text)
+{
+	fputc('"', file);
+	for (const char* c = text; *c; ++c)
+	{
+		if (*c == '"' || *c == '\\')
+			fputc('\\', file);
+		if ((unsigned char)*c >= 0x20)
+			fputc(*c, file);
+	}
+	fputc('"', file);
+}
+
+//================================================================================
+
+uint64_t Profiler::GetTimeNs()
+{
+	auto elapsed = std::chrono::steady_clock::now() - s_startTime;
+	return (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count() + 1;
+}
+
+void Profiler::RecordZone(const char* name, uint64_t beginNs, uint64_t endNs)
+{
+	ProfileThreadBuffer* buffer = GetThreadBuffer();
+	const uint64_t index = buffer->writeCount.load(std::memory_order_relaxed);
+	ProfileEvent& event = buffer->events[index % kEventsPerThread];
+	event.name = name;
+	event.beginNs = beginNs;
+	event.endNs = endNs;
+	buffer->writeCount.store(index + 1, std::memory_order_release);
+}
+
+void Profiler::SetThreadName(const char* name)
+{
+	ProfileThreadBuffer* buffer = GetThreadBuffer();
+	snprintf(buffer->threadName, sizeof(buffer->threadName), "%s", name);
+}
+
+bool Profiler::WriteChromeTrace(const char* path)
+{
+	FILE* file = fopen(path, "wb");
+	if (!file)
+	{
+		fprintf(stderr, "Failed to open profile output file %s\n", path);
+		return false;
+	}
+
+	fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+	bool first = true;
+	uint64_t numEvents = 0;
+	for (ProfileThreadBuffer* buffer = s_threadBuffers.load(std::memory_order_acquire); buffer; buffer = buffer->next)
+	{
+		fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%u,\"args\":{\"name\":", first ? "" : ",\n", buffer->threadIndex);
+		WriteJsonString(file, buffer->threadName);
+		fprintf(file, "}}");
+		first = false;
+
+		const uint64_t writeCount = buffer->writeCount.load(std::memory_order_acquire);
+		const uint64_t begin = writeCount > kEventsPerThread ? writeCount - kEventsPerThread : 0;
+		for (uint64_t i = begin; i < writeCount; ++i)
+		{
+			const ProfileEvent& event = buffer->events[i % kEventsPerThread];
+			fprintf(file, ",\n{\"name\":");
+			WriteJsonString(file, event.name);
+			fprintf(file, ",\"ph\":\"X\",\"pid\":1,\"tid\":%u,\"ts\":%.3f,\"dur\":%.3f}",
+				buffer->threadIndex,
+				0.001 * (double)event.beginNs,
+				0.001 * (double)(event.endNs - event.beginNs));
+			++numEvents;
+		}
+	}
+	fprintf(file, "\n]}\n");
+
+	const bool ok = ferror(file) == 0;
+	fclose(file);
+	printf("Wrote %llu profile zones to %s\n", (unsigned long long)numEvents, path);
+	return ok;
+}
@@ -0,0 +1,58 @@
+#pragma once
+#ifndef PROFILER_H_INCLUDED
+#define PROFILER_H_INCLUDED
+
+#include <atomic>
+#include <stdint.h>
+
+// Records named begin/end zones into per-thread ring buffers and dumps them as
+// Chrome trace JSON (load the file in chrome://tracing or ui.perfetto.dev).
+// Use the HP_PROFILE_SCOPE macro from Debugger.h rather than this directly.
+class Profiler
+{
+public:
+	static const unsigned int kEventsPerThread = 1 << 16;
+
+	static void SetEnabled(bool enabled) { s_enabled.store(enabled, std::memory_order_relaxed); }
+	static bool IsEnabled() { return s_enabled.load(std::memory_order_relaxed); }
+
+	// nanoseconds since the profiler was first used, never returns 0
+	static uint64_t GetTimeNs();
+
+	static void RecordZone(const char* name, uint64_t beginNs, uint64_t endNs);
+	static void SetThreadName(const char* name);
+
+	// safe to call while other threads are recording, although zones recorded
+	// during the dump may be missing or overwritten
+	static bool WriteChromeTrace(const char* path);
+
+private:
+	static std::atomic<bool> s_enabled;
+};
+
+class ProfileScope
+{
+public:
+	explicit ProfileScope(const char* name)
+		: m_name(name)
+		, m_beginNs(Profiler::IsEnabled() ? Profiler::GetTimeNs() : 0)
+	{
+	}
+
+	~ProfileScope()
+	{
+		if (m_beginNs != 0)
+		{
+			Profiler::RecordZone(m_name, m_beginNs, Profiler::GetTimeNs());
+		}
+	}
+
+private:
+	ProfileScope(const ProfileScope&);
+	ProfileScope& operator=(const ProfileScope&);
+
+	const char* m_name;
+	uint64_t m_beginNs;
+};
+
+#endif // PROFILER_H_INCLUDED
@@ -1,139 +1,192 @@
 #include "Render.h"
 #include "Debugger.h"
-#include <SDL.h>
-#include <SDL_ttf.h>
+#include <algorithm>
 #include <stdio.h>
+#include <string.h>
 
-//Helper functions
-static SDL_Color MakeSDL_Color(uint32_t rgba)
+// the outline flag sits above the colour so all fills are submitted first
+static const uint64_t s_kBatchOutlineKey = 1ull << 32;
+
+//================================================================================
+
+Renderer::Renderer(unsigned int width, unsigned int height)
+	: m_Width(width)
+	, m_Height(height)
+	, m_FrameIndex(0)
+	, m_RenderTargetGeneration(0)
 {
-	SDL_Color color;
-	color.r = (unsigned char)((rgba >> 24) & 0xff);
-	color.g = (unsigned char)((rgba >> 16) & 0xff);
-	color.b = (unsigned char)((rgba >> 8) & 0xff);
-	color.a = (unsigned char)((rgba >> 0) & 0xff);
-	return color;
+	memset(m_CachedTextSlots, 0, sizeof(m_CachedTextSlots));
+	m_BatchedRects.reserve(1024);
+	m_BatchedSprites.reserve(1024);
+	m_SubmitRects.reserve(1024);
+	m_SubmitSprites.reserve(1024);
 }
 
-static void PrintRendererInfo(SDL_RendererInfo info)
+Renderer::~Renderer()
 {
-	printf("Renderer : %s software+%d accelerated=%d, presentvsync=%d targettexture=%d\n",
-		info.name,
-		(info.flags & SDL_RENDERER_SOFTWARE) != 0,
-		(info.flags & SDL_RENDERER_ACCELERATED) != 0,
-		(info.flags & SDL_RENDERER_PRESENTVSYNC) != 0,
-		(info.flags & SDL_RENDERER_TARGETTEXTURE) != 0);
 }
 
-//================================================================================
+void Renderer::BatchRect(int x, int y, int w, int h, uint32_t rgba)
+{
+	BatchedRect batchedRect = { s_kBatchOutlineKey | rgba, { x, y, w, h } };
+	m_BatchedRects.push_back(batchedRect);
+}
 
-Renderer::Renderer(SDL_Window & window, unsigned int Width, unsigned int Height)
-	: m_Width(0)
-	, m_Height(0)
-	, m_SdlRenderer(nullptr)
-	, m_Font(nullptr)
+void Renderer::BatchSolidRect(int x, int y, int w, int h, uint32_t rgba)
 {
-	int numDrivers = SDL_GetNumRenderDrivers();
-	printf("%d render drivers: \n", numDrivers);
-	for (int i = 0; i < numDrivers; ++i)
-	{
-		SDL_RendererInfo info;
-		SDL_GetRenderDriverInfo(i, &info);
-		printf("%d", i);
-		PrintRendererInfo(info);
-	}
+	BatchedRect batchedRect = { rgba, { x, y, w, h } };
+	m_BatchedRects.push_back(batchedRect);
+}
 
-	Uint32 rendererFlags = SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC;
-	m_SdlRenderer = SDL_CreateRenderer(&window, -1, rendererFlags);
-	if (!m_SdlRenderer)
-	{
-		printf("SDL_CreateRenderer failed: %s\n", SDL_GetError());
-	}
+void Renderer::BatchSprite(TextureHandle atlas, unsigned int spriteIndex, int x, int y)
+{
+	BatchedSprite batchedSprite = { atlas, { spriteIndex, x, y } };
+	m_BatchedSprites.push_back(batchedSprite);
+}
 
-	SDL_RendererInfo info;
-	if (SDL_GetRendererInfo(m_SdlRenderer, &info) != 0)
-	{
-		printf("SDL_GetRendererInfo failed: %s\n", SDL_GetError());
-	}
-	printf("Created Renderer: \n");
-	PrintRendererInfo(info);
-
-	int displayWidth, displayHeight;
-	SDL_GetWindowSize(&window, &displayWidth, &displayHeight);
-	printf("Display size = (%d, %d)\n", displayWidth, displayHeight);
-	printf("Renderer logical size = (%u, %u)\n", Width, Height);
-	if (displayWidth != (int)Width || displayHeight != (int)Height)
-	{
-		printf("Logical size != display size (%u, %u) vs (%u, %u). Scaling will be applied\n", Width, Height, displayWidth, displayHeight);
-	}
-	const float displayAspect = (float)displayWidth / (float)displayHeight;
-	const float logicalAspect = (float)Width / (float)Height;
-	if (logicalAspect != displayAspect)
+void Renderer::FlushBatch()
+{
+	if (m_BatchedRects.empty() && m_BatchedSprites.empty())
+		return;
+
+	HP_PROFILE_SCOPE("Renderer::FlushBatch");
+
+	std::sort(m_BatchedRects.begin(), m_BatchedRects.end());
+
+	size_t runBegin = 0;
+	while (runBegin < m_BatchedRects.size())
 	{
-		printf("Logical aspect != display aspect. Letterboxing will be applied\n");
+		const uint64_t sortKey = m_BatchedRects[runBegin].sortKey;
+		m_SubmitRects.clear();
+		size_t runEnd = runBegin;
+		while (runEnd < m_BatchedRects.size() && m_BatchedRects[runEnd].sortKey == sortKey)
+		{
+			m_SubmitRects.push_back(m_BatchedRects[runEnd].rect);
+			++runEnd;
+		}
+
+		SubmitRects(m_SubmitRects.data(), (unsigned int)m_SubmitRects.size(), (uint32_t)sortKey, (sortKey & s_kBatchOutlineKey) == 0);
+		runBegin = runEnd;
 	}
 
-	m_Width = Width;
-	m_Height = Height;
-	SDL_RenderSetLogicalSize(m_SdlRenderer, Width, Height);
+	m_BatchedRects.clear();
 
-	SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "linear");
+	// stable so sprites sharing an atlas keep their submission order
+	std::stable_sort(m_BatchedSprites.begin(), m_BatchedSprites.end());
 
-	int defaultFontSize = 48;
-	m_Font = TTF_OpenFont("fonts/Coder's Crux.ttf", defaultFontSize);
-	if (!m_Font)
+	runBegin = 0;
+	while (runBegin < m_BatchedSprites.size())
 	{
-		printf("TTF_OpenFont failed");
+		const TextureHandle atlas = m_BatchedSprites[runBegin].atlas;
+		m_SubmitSprites.clear();
+		size_t runEnd = runBegin;
+		while (runEnd < m_BatchedSprites.size() && m_BatchedSprites[runEnd].atlas == atlas)
+		{
+			m_SubmitSprites.push_back(m_BatchedSprites[runEnd].sprite);
+			++runEnd;
+		}
+
+		SubmitSprites(atlas, m_SubmitSprites.data(), (unsigned int)m_SubmitSprites.size());
+		runBegin = runEnd;
 	}
-}
 
-Renderer::~Renderer()
-{
-	TTF_CloseFont(m_Font);
-	SDL_DestroyRenderer(m_SdlRenderer);
+	m_BatchedSprites.clear();
 }
 
-void Renderer::Clear()
+// handles pack the slot index (plus one, so 0 is never valid) in the low byte
+// and the slot generation above it
+TextHandle Renderer::AllocateCachedText(unsigned int& slot)
 {
-	SDL_SetRenderDrawColor(m_SdlRenderer, 0, 0, 0, 255);
-	SDL_RenderClear(m_SdlRenderer);
+	slot = 0;
+	for (unsigned int i = 1; i < kNumCachedTexts; ++i)
+	{
+		if (m_CachedTextSlots[i].lastDrawnFrame < m_CachedTextSlots[slot].lastDrawnFrame)
+		{
+			slot = i;
+		}
+	}
+
+	// frames are stored plus one so never used slots sort first
+	CachedTextSlot& cachedText = m_CachedTextSlots[slot];
+	cachedText.lastDrawnFrame = m_FrameIndex + 1;
+	++cachedText.generation;
+	return (cachedText.generation << 8) | (slot + 1);
 }
 
-void Renderer::Present()
+bool Renderer::FindCachedText(TextHandle handle, unsigned int& slot)
 {
-	SDL_RenderPresent(m_SdlRenderer);
+	slot = (handle & 0xff) - 1;
+	if (slot >= kNumCachedTexts)
+		return false;
+
+	CachedTextSlot& cachedText = m_CachedTextSlots[slot];
+	if (cachedText.generation != (handle >> 8))
+		return false;
+
+	cachedText.lastDrawnFrame = m_FrameIndex + 1;
+	return true;
 }
 
-void Renderer::DrawRect(int x, int y, int w, int h, uint32_t rgba)
+void Renderer::EvictCachedTexts()
 {
-	SDL_Color color = MakeSDL_Color(rgba);
-	SDL_SetRenderDrawColor(m_SdlRenderer, color.r, color.g, color.b, color.a);
-
-	SDL_Rect rect = { x, y, w, h };
-	SDL_RenderDrawRect(m_SdlRenderer, &rect);
+	for (unsigned int i = 0; i < kNumCachedTexts; ++i)
+	{
+		++m_CachedTextSlots[i].generation;
+		m_CachedTextSlots[i].lastDrawnFrame = 0;
+	}
 }
 
-void Renderer::DrawSolidRect(int x, int y, int w, int h, uint32_t rgba)
+// Each sprite gets a one pixel dark border, a lit top-left bevel, a shaded
+// bottom-right bevel and a slight vertical gradient across the face.
+static uint32_t ShadeBlockPixel(uint32_t rgba, int x, int y, int size)
 {
-	SDL_Color color = MakeSDL_Color(rgba);
-	SDL_SetRenderDrawColor(m_SdlRenderer, color.r, color.g, color.b, color.a);
+	const int kBevelPixels = std::max(1, size / 10);
+	const int last = size - 1;
+
+	int scale = 256 - (y * 48) / std::max(1, last);
+	int lighten = 0;
+	if (x == 0 || y == 0 || x == last || y == last)
+	{
+		return 0x404040ff;
+	}
+	else if (x <= kBevelPixels || y <= kBevelPixels)
+	{
+		if (last - y > x && last - x > y)
+			lighten = 96;
+		else
+			scale = 160;
+	}
+	else if (x >= last - kBevelPixels || y >= last - kBevelPixels)
+	{
+		scale = 144;
+	}
 
-	SDL_Rect rect = { x, y, w, h };
-	SDL_RenderFillRect(m_SdlRenderer, &rect);
+	uint32_t shaded = rgba & 0xff;
+	for (int shift = 8; shift < 32; shift += 8)
+	{
+		int channel = (int)((rgba >> shift) & 0xff);
+		channel = (channel * scale) >> 8;
+		channel += ((255 - channel) * lighten) >> 8;
+		shaded |= (uint32_t)std::min(channel, 255) << shift;
+	}
+	return shaded;
 }
 
-void Renderer::DrawText(const char* text, int x, int y, uint32_t rgba)
+void Renderer::BakeBlockAtlas(const uint32_t* rgbas, unsigned int numSprites, unsigned int spriteSizePixels, std::vector<uint32_t>& pixels)
 {
-	SDL_assert(text);
-
-	SDL_Color color = MakeSDL_Color(rgba);
-
-	SDL_Surface* surface = TTF_RenderText_Blended(m_Font, text, color);
-	SDL_Texture* texture = SDL_CreateTextureFromSurface(m_SdlRenderer, surface);
-	int width, height;
-	SDL_QueryTexture(texture, NULL, NULL, &width, &height);
-	SDL_Rect rect = { x, y, width, height };
-	SDL_RenderCopy(m_SdlRenderer, texture, nullptr, &rect);
-	SDL_DestroyTexture(texture);
-	SDL_FreeSurface(surface);
+	HP_ASSERT(rgbas && numSprites > 0 && spriteSizePixels > 0);
+
+	const int size = (int)spriteSizePixels;
+	const int atlasWidth = size * (int)numSprites;
+	pixels.resize(atlasWidth * size);
+	for (unsigned int i = 0; i < numSprites; ++i)
+	{
+		for (int y = 0; y < size; ++y)
+		{
+			for (int x = 0; x < size; ++x)
+			{
+				pixels[y * atlasWidth + i * size + x] = ShadeBlockPixel(rgbas[i], x, y, size);
+			}
+		}
+	}
 }
@@ -1,37 +1,145 @@
+#pragma once
 #ifndef RENDER_H_INCLUDED
 #define RENDER_H_INCLUDED
 
-#include <SDL.h>
-#include <SDL_ttf.h>
+#include <stdint.h>
+#include <vector>
 
-class Texture;
+// Identifies a string rasterized into its own texture by Renderer::CacheText.
+// 0 is never a valid handle.
+typedef unsigned int TextHandle;
 
-struct SDL_Window;
-struct SDL_Renderer;
+// Identifies a texture owned by the Renderer. 0 is never a valid handle.
+typedef unsigned int TextureHandle;
 
+struct RenderRect
+{
+	int x;
+	int y;
+	int w;
+	int h;
+};
+
+struct SpriteInstance
+{
+	unsigned int spriteIndex;
+	int x;
+	int y;
+};
+
+// Backend independent drawing interface. Batching, the cached text LRU and
+// block sprite baking live here, the backends only submit the results.
 class Renderer
 {
 public:
-	Renderer(SDL_Window& window, unsigned int Width, unsigned int Height);
-	~Renderer();
+	virtual ~Renderer();
 
-	void Clear();
-	void Present();
+	virtual void Clear() = 0;
+	virtual void Present() = 0;
 
 	unsigned int GetWidth() const { return m_Width; }
 	unsigned int GetHeight() const { return m_Height; }
 
-	void DrawRect(int x, int y, int w, int h, uint32_t rgba = 0xfffffffff);
-	void DrawSolidRect(int x, int y, int w, int h, uint32_t rgba = 0xfffffffff);
-	void DrawText(const char* text, int x, int y, uint32_t rgba = 0xfffffffff);
+	virtual void DrawRect(int x, int y, int w, int h, uint32_t rgba = 0xffffffff) = 0;
+	virtual void DrawSolidRect(int x, int y, int w, int h, uint32_t rgba = 0xffffffff) = 0;
+	virtual void DrawText(const char* text, int x, int y, uint32_t rgba = 0xffffffff) = 0;
+
+	// Copies the frame drawn so far as GetWidth() * GetHeight() RGBA8888 pixels
+	// with no row padding. Call after drawing and before Present. Returns false
+	// if the backend can't read the frame back.
+	virtual bool ReadPixels(uint32_t* pixels) = 0;
+
+	// true if the frame is still intact after Present, so presenting again
+	// without drawing shows the same image
+	virtual bool IsFrameRetainedAfterPresent() const { return false; }
+
+	// Batched primitives. Rects and sprites are collected until FlushBatch, then
+	// rects are sorted by colour and submitted with one call per colour, fills
+	// before outlines, followed by sprites grouped by texture. Any immediate draw
+	// or Present flushes first, so ordering against them is kept.
+	virtual void BatchRect(int x, int y, int w, int h, uint32_t rgba = 0xffffffff);
+	virtual void BatchSolidRect(int x, int y, int w, int h, uint32_t rgba = 0xffffffff);
+	virtual void BatchSprite(TextureHandle atlas, unsigned int spriteIndex, int x, int y);
+	virtual void FlushBatch();
+
+	// Retained text. Cached strings are evicted least recently drawn first, after
+	// which DrawCachedText returns false and the caller should cache it again.
+	virtual TextHandle CacheText(const char* text, uint32_t rgba = 0xffffffff) = 0;
+	virtual bool DrawCachedText(TextHandle handle, int x, int y) = 0;
+
+	// Off-screen render targets. CreateRenderTarget returns 0 if the backend has
+	// no render target support. Target contents are lost when the generation
+	// changes, after which they must be redrawn in full.
+	virtual bool SupportsRenderTargets() const { return true; }
+	virtual TextureHandle CreateRenderTarget(unsigned int width, unsigned int height) = 0;
+	virtual void DestroyTexture(TextureHandle handle) = 0;
+	virtual void SetRenderTarget(TextureHandle handle) = 0;
+	virtual void DrawTexture(TextureHandle handle, int x, int y) = 0;
+	void InvalidateRenderTargets() { ++m_RenderTargetGeneration; }
+	unsigned int GetRenderTargetGeneration() const { return m_RenderTargetGeneration; }
+	// Call when the device was lost and every texture on it, then invalidate the
+	// render targets. Textures are recreated under the same handles, targets
+	// empty, and cached text is evicted so it is cached again.
+	virtual void RecreateTextures() {}
+
+	// Bakes one bevelled block sprite per colour into a single atlas texture.
+	// Sprite i is drawn with BatchSprite(atlas, i, x, y).
+	virtual TextureHandle CreateBlockAtlas(const uint32_t* rgbas, unsigned int numSprites, unsigned int spriteSizePixels) = 0;
+
+protected:
+	static const unsigned int kNumCachedTexts = 32;
+
+	Renderer(unsigned int width, unsigned int height);
+
+	virtual void SubmitRects(const RenderRect* rects, unsigned int numRects, uint32_t rgba, bool solid) = 0;
+	virtual void SubmitSprites(TextureHandle atlas, const SpriteInstance* sprites, unsigned int numSprites) = 0;
+
+	// picks the least recently drawn slot and returns a new handle for it
+	TextHandle AllocateCachedText(unsigned int& slot);
+	// validates the handle and marks the slot as drawn this frame
+	bool FindCachedText(TextHandle handle, unsigned int& slot);
+	// makes every handle handed out so far invalid
+	void EvictCachedTexts();
+
+	void EndFrame() { ++m_FrameIndex; }
+
+	// RGBA8888 pixels, sprites laid out left to right in a single row
+	static void BakeBlockAtlas(const uint32_t* rgbas, unsigned int numSprites, unsigned int spriteSizePixels, std::vector<uint32_t>& pixels);
 
-private:
 	unsigned int m_Width;
 	unsigned int m_Height;
+	unsigned int m_FrameIndex;
+	unsigned int m_RenderTargetGeneration;
+
+private:
+	struct BatchedRect
+	{
+		uint64_t sortKey;
+		RenderRect rect;
+
+		bool operator<(const BatchedRect& other) const { return sortKey < other.sortKey; }
+	};
+
+	struct BatchedSprite
+	{
+		TextureHandle atlas;
+		SpriteInstance sprite;
+
+		bool operator<(const BatchedSprite& other) const { return atlas < other.atlas; }
+	};
+
+	struct CachedTextSlot
+	{
+		unsigned int generation;
+		unsigned int lastDrawnFrame;
+	};
 
-	SDL_Renderer* m_SdlRenderer;
+	std::vector<BatchedRect> m_BatchedRects;
+	std::vector<BatchedSprite> m_BatchedSprites;
+	std::vector<RenderRect> m_SubmitRects;
+	std::vector<SpriteInstance> m_SubmitSprites;
 
-	TTF_Font* m_Font;
+	CachedTextSlot m_CachedTextSlots[kNumCachedTexts];
 };
 
 #endif // RENDER_H_INCLUDED
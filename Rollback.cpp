@@ -0,0 +1,363 @@
+#include "Rollback.h"
+#include "Debugger.h"
+#include "Profiler.h"
+#include "Render.h"
+#include <stdio.h>
+#include <string.h>
+
+static const uint32_t s_kPacketMagic = 0x54525442; // "TRTB"
+static const unsigned int s_kPacketHeaderBytes = 25;
+
+static const unsigned int s_kBlockSizePixels = 28;
+static const int s_kBoardY = 100;
+static const int s_kBoardX[VersusMatch::kNumPlayers] = { 240, 760 };
+static const uint32_t s_kGarbageMeterRgba = 0xff4040ff;
+
+//Helper functions
+//================================================================================
+
+static void WriteU32(uint8_t* data, uint32_t value)
+{
+	data[0] = (uint8_t)value;
+	data[1] = (uint8_t)(value >> 8);
+	data[2] = (uint8_t)(value >> 16);
+	data[3] = (uint8_t)(value >> 24);
+}
+
+static uint32_t ReadU32(const uint8_t* data)
+{
+	return (uint32_t)data[0] | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24);
+}
+
+static uint32_t GetTimeMs()
+{
+	return (uint32_t)(Profiler::GetTimeNs() / 1000000);
+}
+
+// Inputs are key presses, not held keys, so a player usually presses nothing
+// on any given frame. Repeating their last input would repeat their moves.
+static uint8_t PredictRemoteInput()
+{
+	return 0;
+}
+
+//================================================================================
+
+RollbackSession::RollbackSession()
+	: m_localPlayer(0)
+	, m_localSeed(0)
+	, m_running(false)
+	, m_frame(0)
+	, m_remoteFrames(0)
+	, m_localFramesAcked(0)
+	, m_rollbackFrame(kNoRollback)
+	, m_pendingLocalInput(0)
+	, m_peerSendTimeMs(0)
+	, m_peerSendTimeReceivedNs(0)
+	, m_blockAtlas(0)
+	, m_waitingText("Waiting for opponent", 0xffffffff)
+	, m_youText("You", 0x8080ffff)
+	, m_titleText("Press Space", 0xffffffff)
+	, m_gameOverText("GAME OVER", 0xffffffff)
+	, m_scoreTexts{ HudText("Score: %u", 0xffffffff), HudText("Score: %u", 0xffffffff) }
+	, m_garbageTexts{ HudText("Garbage: %u", 0xff8080ff), HudText("Garbage: %u", 0xff8080ff) }
+	, m_pingText("Ping: %u ms", 0x8080ffff)
+	, m_rollbackText("Max rollback: %u frames", 0x8080ffff)
+{
+	memset(&m_peer, 0, sizeof(m_peer));
+	memset(m_inputs, 0, sizeof(m_inputs));
+	memset(m_predictedRemoteInputs, 0, sizeof(m_predictedRemoteInputs));
+	memset(&m_stats, 0, sizeof(m_stats));
+}
+
+RollbackSession::~RollbackSession()
+{
+	Close();
+}
+
+bool RollbackSession::Open(unsigned int localPlayer, uint16_t localPort, const NetAddress& peer)
+{
+	HP_ASSERT(localPlayer < VersusMatch::kNumPlayers);
+
+	if (!m_socket.Open(localPort))
+		return false;
+
+	m_localPlayer = localPlayer;
+	m_peer = peer;
+	m_localSeed = (uint32_t)Profiler::GetTimeNs() ^ ((uint32_t)m_socket.GetPort() << 16);
+	printf("Versus: player %u on port %u, waiting for %u.%u.%u.%u:%u\n", localPlayer, m_socket.GetPort(),
+		peer.host >> 24, (peer.host >> 16) & 0xff, (peer.host >> 8) & 0xff, peer.host & 0xff, peer.port);
+	return true;
+}
+
+void RollbackSession::Close()
+{
+	if (m_running)
+	{
+		m_match.Shutdown();
+		m_running = false;
+	}
+	m_socket.Close();
+}
+
+void RollbackSession::Tick(const GameInput& localInput)
+{
+	HP_PROFILE_SCOPE("RollbackSession::Tick");
+
+	const uint64_t tickBeginNs = Profiler::GetTimeNs();
+
+	ReceivePackets();
+	if (!m_running)
+	{
+		// say hello until the peer answers
+		SendInputs();
+		return;
+	}
+
+	++m_stats.ticks;
+	if (m_rollbackFrame != kNoRollback)
+	{
+		RollBack();
+	}
+
+	// presses made while stalled are kept for the next frame that runs
+	m_pendingLocalInput |= PackGameInput(localInput);
+	if (m_frame >= m_remoteFrames + kMaxRollbackFrames)
+	{
+		++m_stats.stalls;
+	}
+	else
+	{
+		m_inputs[m_localPlayer][m_frame % kInputHistoryFrames] = m_pendingLocalInput;
+		m_pendingLocalInput = 0;
+		Simulate(m_frame);
+		++m_frame;
+	}
+
+	SendInputs();
+
+	const uint64_t tickNs = Profiler::GetTimeNs() - tickBeginNs;
+	m_stats.totalTickNs += tickNs;
+	if (tickNs > m_stats.maxTickNs)
+		m_stats.maxTickNs = tickNs;
+}
+
+void RollbackSession::Simulate(unsigned int frame)
+{
+	const unsigned int remotePlayer = m_localPlayer ^ 1;
+	const unsigned int historyIndex = frame % kInputHistoryFrames;
+	if (frame >= m_remoteFrames)
+	{
+		m_predictedRemoteInputs[historyIndex] = PredictRemoteInput();
+		m_inputs[remotePlayer][historyIndex] = m_predictedRemoteInputs[historyIndex];
+	}
+
+	GameInput inputs[VersusMatch::kNumPlayers];
+	for (unsigned int i = 0; i < VersusMatch::kNumPlayers; ++i)
+	{
+		inputs[i] = UnpackGameInput(m_inputs[i][historyIndex]);
+	}
+
+	HP_ASSERT(m_match.GetFrame() == frame);
+	m_match.SaveSnapshot(m_snapshots[frame % kNumSnapshots]);
+	m_match.Step(inputs);
+}
+
+void RollbackSession::RollBack()
+{
+	HP_PROFILE_SCOPE("RollbackSession::RollBack");
+
+	const unsigned int firstFrame = m_rollbackFrame;
+	m_rollbackFrame = kNoRollback;
+	HP_ASSERT(firstFrame < m_frame && m_frame - firstFrame < kNumSnapshots);
+
+	m_match.LoadSnapshot(m_snapshots[firstFrame % kNumSnapshots]);
+	for (unsigned int frame = firstFrame; frame < m_frame; ++frame)
+	{
+		Simulate(frame);
+	}
+
+	const unsigned int numFrames = m_frame - firstFrame;
+	++m_stats.rollbacks;
+	m_stats.framesResimulated += numFrames;
+	if (numFrames > m_stats.maxFramesResimulated)
+		m_stats.maxFramesResimulated = numFrames;
+}
+
+void RollbackSession::ReceivePackets()
+{
+	uint8_t data[s_kPacketHeaderBytes + kMaxInputsPerPacket];
+	NetAddress from;
+	int numBytes;
+	while ((numBytes = m_socket.Receive(data, sizeof(data), from)) > 0)
+	{
+		if (from != m_peer)
+			continue;
+		ReadPacket(data, numBytes);
+	}
+}
+
+void RollbackSession::ReadPacket(const uint8_t* data, int numBytes)
+{
+	if (numBytes < (int)s_kPacketHeaderBytes || ReadU32(data) != s_kPacketMagic)
+		return;
+
+	const uint32_t peerSeed = ReadU32(data + 4);
+	const uint32_t sendTimeMs = ReadU32(data + 8);
+	const uint32_t echoTimeMs = ReadU32(data + 12);
+	const uint32_t framesAcked = ReadU32(data + 16);
+	const uint32_t firstFrame = ReadU32(data + 20);
+	const unsigned int numInputs = data[24];
+	if (numBytes < (int)(s_kPacketHeaderBytes + numInputs))
+		return;
+
+	++m_stats.packetsReceived;
+
+	if (!m_running)
+	{
+		// both games take player 0's seed so they get the same pieces
+		m_match.Init(m_localPlayer == 0 ? m_localSeed : peerSeed);
+		m_running = true;
+		printf("Versus: connected\n");
+	}
+
+	m_peerSendTimeMs = sendTimeMs;
+	m_peerSendTimeReceivedNs = Profiler::GetTimeNs();
+	if (echoTimeMs != 0)
+	{
+		m_stats.roundTripMs = GetTimeMs() - echoTimeMs;
+	}
+
+	if (framesAcked > m_localFramesAcked && framesAcked <= m_frame)
+	{
+		m_localFramesAcked = framesAcked;
+	}
+
+	const unsigned int remotePlayer = m_localPlayer ^ 1;
+	for (unsigned int i = 0; i < numInputs; ++i)
+	{
+		const unsigned int frame = firstFrame + i;
+		if (frame < m_remoteFrames)
+			continue;
+		// a gap, the resend in a later packet fills it
+		if (frame > m_remoteFrames || frame >= m_frame + kInputHistoryFrames / 2)
+			break;
+
+		const uint8_t input = data[s_kPacketHeaderBytes + i];
+		const unsigned int historyIndex = frame % kInputHistoryFrames;
+		if (frame < m_frame && input != m_predictedRemoteInputs[historyIndex] && frame < m_rollbackFrame)
+		{
+			m_rollbackFrame = frame;
+		}
+		m_inputs[remotePlayer][historyIndex] = input;
+		++m_remoteFrames;
+	}
+}
+
+void RollbackSession::SendInputs()
+{
+	unsigned int firstFrame = m_localFramesAcked;
+	if (m_frame - firstFrame > kMaxInputsPerPacket)
+	{
+		firstFrame = m_frame - kMaxInputsPerPacket;
+	}
+	const unsigned int numInputs = m_frame - firstFrame;
+
+	// the peer's send time plus how long we held it, so it can time the round trip
+	uint32_t echoTimeMs = 0;
+	if (m_peerSendTimeReceivedNs != 0)
+	{
+		echoTimeMs = m_peerSendTimeMs + (uint32_t)((Profiler::GetTimeNs() - m_peerSendTimeReceivedNs) / 1000000);
+	}
+
+	uint8_t data[s_kPacketHeaderBytes + kMaxInputsPerPacket];
+	WriteU32(data, s_kPacketMagic);
+	WriteU32(data + 4, m_localSeed);
+	WriteU32(data + 8, GetTimeMs());
+	WriteU32(data + 12, echoTimeMs);
+	WriteU32(data + 16, m_remoteFrames);
+	WriteU32(data + 20, firstFrame);
+	data[24] = (uint8_t)numInputs;
+	for (unsigned int i = 0; i < numInputs; ++i)
+	{
+		data[s_kPacketHeaderBytes + i] = m_inputs[m_localPlayer][(firstFrame + i) % kInputHistoryFrames];
+	}
+
+	if (m_socket.Send(m_peer, data, s_kPacketHeaderBytes + numInputs))
+	{
+		++m_stats.packetsSent;
+	}
+}
+
+void RollbackSession::Draw(Renderer& renderer)
+{
+	HP_PROFILE_SCOPE("RollbackSession::Draw");
+
+	if (!m_running)
+	{
+		m_waitingText.Draw(renderer, renderer.GetWidth() / 2 - 140, renderer.GetHeight() / 2);
+		return;
+	}
+
+	if (m_blockAtlas == 0)
+	{
+		uint32_t blockRgbas[kNumBlockSprites];
+		GetBlockRgbas(blockRgbas);
+		m_blockAtlas = renderer.CreateBlockAtlas(blockRgbas, kNumBlockSprites, s_kBlockSizePixels);
+	}
+
+	const int boardWidth = Game::kFieldWidth * s_kBlockSizePixels;
+	const int boardHeight = Game::kFieldHeight * s_kBlockSizePixels;
+	for (unsigned int i = 0; i < VersusMatch::kNumPlayers; ++i)
+	{
+		const Game& game = m_match.GetGame(i);
+		const int x = s_kBoardX[i];
+		game.DrawBoard(renderer, x, s_kBoardY, s_kBlockSizePixels, m_blockAtlas);
+
+		// queued garbage rises up the side of the board it is about to land on
+		const unsigned int pendingGarbage = game.GetPendingGarbageLines();
+		if (pendingGarbage > 0)
+		{
+			const int meterHeight = (int)(pendingGarbage < Game::kFieldHeight ? pendingGarbage : Game::kFieldHeight) * (int)s_kBlockSizePixels;
+			renderer.DrawSolidRect(x - 12, s_kBoardY + boardHeight - meterHeight, 8, meterHeight, s_kGarbageMeterRgba);
+		}
+
+		if (i == m_localPlayer)
+		{
+			m_youText.Draw(renderer, x, s_kBoardY - 80);
+		}
+		m_scoreTexts[i].SetValue(game.GetScore());
+		m_scoreTexts[i].Draw(renderer, x, s_kBoardY - 40);
+		m_garbageTexts[i].SetValue(pendingGarbage);
+		m_garbageTexts[i].Draw(renderer, x, s_kBoardY + boardHeight + 8);
+
+		if (game.IsGameOver())
+		{
+			m_gameOverText.Draw(renderer, x + boardWidth / 2 - 80, s_kBoardY + boardHeight / 2);
+		}
+		else if (!game.IsPlaying())
+		{
+			m_titleText.Draw(renderer, x + boardWidth / 2 - 90, s_kBoardY + boardHeight / 2);
+		}
+	}
+
+	m_pingText.SetValue(m_stats.roundTripMs);
+	m_pingText.Draw(renderer, 0, 0);
+	m_rollbackText.SetValue(m_stats.maxFramesResimulated);
+	m_rollbackText.Draw(renderer, 0, 30);
+}
+
+void RollbackSession::PrintStats() const
+{
+	printf("Rollback stats:\n");
+	printf("  %-24s %12u\n", "Ticks", m_stats.ticks);
+	printf("  %-24s %12u\n", "Stalls", m_stats.stalls);
+	printf("  %-24s %12u\n", "Rollbacks", m_stats.rollbacks);
+	printf("  %-24s %12u\n", "Frames resimulated", m_stats.framesResimulated);
+	printf("  %-24s %12u\n", "Max frames per rollback", m_stats.maxFramesResimulated);
+	printf("  %-24s %12.3f\n", "Mean tick ms", m_stats.ticks ? m_stats.totalTickNs * 1e-6 / m_stats.ticks : 0.0);
+	printf("  %-24s %12.3f\n", "Max tick ms", m_stats.maxTickNs * 1e-6);
+	printf("  %-24s %12u\n", "Packets sent", m_stats.packetsSent);
+	printf("  %-24s %12u\n", "Packets received", m_stats.packetsReceived);
+	printf("  %-24s %12u\n", "Round trip ms", m_stats.roundTripMs);
+}
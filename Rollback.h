@@ -0,0 +1,102 @@
+#pragma once
+#ifndef ROLLBACK_H_INCLUDED
+#define ROLLBACK_H_INCLUDED
+
+#include "Hud.h"
+#include "Net.h"
+#include "Versus.h"
+
+class Renderer;
+
+struct RollbackStats
+{
+	unsigned int ticks;
+	// ticks spent waiting because the remote input was too far behind
+	unsigned int stalls;
+	unsigned int rollbacks;
+	unsigned int framesResimulated;
+	unsigned int maxFramesResimulated;
+	uint64_t totalTickNs;
+	uint64_t maxTickNs;
+	unsigned int packetsSent;
+	unsigned int packetsReceived;
+	unsigned int roundTripMs;
+};
+
+// A versus match against a peer over UDP. Local input is applied the frame it
+// happens and the remote player is predicted to press nothing. When their real
+// input arrives and differs, the match is restored to the snapshot before that
+// frame and stepped forward again with the corrected inputs, all within the
+// tick. Every packet repeats the inputs the peer hasn't acknowledged yet, so
+// lost packets cost nothing until several in a row go missing.
+class RollbackSession
+{
+public:
+	// how far ahead of the last confirmed remote input the local game may run
+	static const unsigned int kMaxRollbackFrames = 8;
+
+	RollbackSession();
+	~RollbackSession();
+
+	// player 0 is on the left and picks the seed
+	bool Open(unsigned int localPlayer, uint16_t localPort, const NetAddress& peer);
+	void Close();
+
+	// advances one frame, or waits if the peer has fallen too far behind
+	void Tick(const GameInput& localInput);
+	void Draw(Renderer& renderer);
+
+	bool IsRunning() const { return m_running; }
+	const VersusMatch& GetMatch() const { return m_match; }
+	unsigned int GetFrame() const { return m_frame; }
+	const RollbackStats& GetStats() const { return m_stats; }
+	void PrintStats() const;
+
+private:
+	static const unsigned int kInputHistoryFrames = 128;
+	static const unsigned int kNumSnapshots = kMaxRollbackFrames * 2;
+	static const unsigned int kMaxInputsPerPacket = 64;
+	static const unsigned int kNoRollback = 0xffffffff;
+
+	void ReceivePackets();
+	void ReadPacket(const uint8_t* data, int numBytes);
+	void SendInputs();
+	void RollBack();
+	void Simulate(unsigned int frame);
+
+	VersusMatch m_match;
+	UdpSocket m_socket;
+	NetAddress m_peer;
+	unsigned int m_localPlayer;
+	uint32_t m_localSeed;
+	bool m_running;
+
+	// m_frame is the next frame to simulate. Remote inputs are confirmed for
+	// frames before m_remoteFrames, the peer has ours before m_localFramesAcked.
+	unsigned int m_frame;
+	unsigned int m_remoteFrames;
+	unsigned int m_localFramesAcked;
+	unsigned int m_rollbackFrame;
+	uint8_t m_pendingLocalInput;
+	uint8_t m_inputs[VersusMatch::kNumPlayers][kInputHistoryFrames];
+	uint8_t m_predictedRemoteInputs[kInputHistoryFrames];
+	VersusMatch::Snapshot m_snapshots[kNumSnapshots];
+
+	uint32_t m_peerSendTimeMs;
+	uint64_t m_peerSendTimeReceivedNs;
+
+	RollbackStats m_stats;
+
+	//hud
+	TextureHandle m_blockAtlas;
+	HudText m_waitingText;
+	HudText m_youText;
+	HudText m_titleText;
+	HudText m_gameOverText;
+	HudText m_scoreTexts[VersusMatch::kNumPlayers];
+	HudText m_garbageTexts[VersusMatch::kNumPlayers];
+	HudText m_pingText;
+	HudText m_rollbackText;
+};
+
+#endif // ROLLBACK_H_INCLUDED
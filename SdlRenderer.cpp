@@ -0,0 +1,541 @@
+#include "SdlRenderer.h"
+#include "Debugger.h"
+#include "Font.h"
+#include <stdio.h>
+#include <string.h>
+
+//Helper functions
+static SDL_Color MakeSDL_Color(uint32_t rgba)
+{
+	SDL_Color color;
+	color.r = (unsigned char)((rgba >> 24) & 0xff);
+	color.g = (unsigned char)((rgba >> 16) & 0xff);
+	color.b = (unsigned char)((rgba >> 8) & 0xff);
+	color.a = (unsigned char)((rgba >> 0) & 0xff);
+	return color;
+}
+
+static void PrintRendererInfo(SDL_RendererInfo info)
+{
+	printf("Renderer : %s software+%d accelerated=%d, presentvsync=%d targettexture=%d\n",
+		info.name,
+		(info.flags & SDL_RENDERER_SOFTWARE) != 0,
+		(info.flags & SDL_RENDERER_ACCELERATED) != 0,
+		(info.flags & SDL_RENDERER_PRESENTVSYNC) != 0,
+		(info.flags & SDL_RENDERER_TARGETTEXTURE) != 0);
+}
+
+static SDL_Renderer* CreateSdlRenderer(SDL_Window& window, unsigned int Width, unsigned int Height)
+{
+	HP_PROFILE_SCOPE("CreateSdlRenderer");
+
+	const bool verbose = SDL_LogGetPriority(SDL_LOG_CATEGORY_RENDER) <= SDL_LOG_PRIORITY_VERBOSE;
+	const int numDrivers = verbose ? SDL_GetNumRenderDrivers() : 0;
+	if (numDrivers > 0)
+	{
+		printf("%d render drivers: \n", numDrivers);
+	}
+	for (int i = 0; i < numDrivers; ++i)
+	{
+		SDL_RendererInfo info;
+		SDL_GetRenderDriverInfo(i, &info);
+		printf("%d", i);
+		PrintRendererInfo(info);
+	}
+
+	Uint32 rendererFlags = SDL_RENDERER_ACCELERATED | SDL_RENDERER_PRESENTVSYNC;
+	SDL_Renderer* sdlRenderer = SDL_CreateRenderer(&window, -1, rendererFlags);
+	if (!sdlRenderer)
+	{
+		printf("SDL_CreateRenderer failed: %s\n", SDL_GetError());
+	}
+
+	SDL_RendererInfo info;
+	if (SDL_GetRendererInfo(sdlRenderer, &info) != 0)
+	{
+		printf("SDL_GetRendererInfo failed: %s\n", SDL_GetError());
+	}
+	printf("Created Renderer: \n");
+	PrintRendererInfo(info);
+
+	int displayWidth, displayHeight;
+	SDL_GetWindowSize(&window, &displayWidth, &displayHeight);
+	printf("Display size = (%d, %d)\n", displayWidth, displayHeight);
+	printf("Renderer logical size = (%u, %u)\n", Width, Height);
+	if (displayWidth != (int)Width || displayHeight != (int)Height)
+	{
+		printf("Logical size != display size (%u, %u) vs (%u, %u). Scaling will be applied\n", Width, Height, displayWidth, displayHeight);
+	}
+	const float displayAspect = (float)displayWidth / (float)displayHeight;
+	const float logicalAspect = (float)Width / (float)Height;
+	if (logicalAspect != displayAspect)
+	{
+		printf("Logical aspect != display aspect. Letterboxing will be applied\n");
+	}
+
+	SDL_RenderSetLogicalSize(sdlRenderer, Width, Height);
+
+	SDL_SetHint(SDL_HINT_RENDER_SCALE_QUALITY, "linear");
+	return sdlRenderer;
+}
+
+static SDL_Texture* CreateStaticTexture(SDL_Renderer* sdlRenderer, const Framebuffer& image)
+{
+	SDL_Texture* texture = SDL_CreateTexture(sdlRenderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_STATIC, image.GetWidth(), image.GetHeight());
+	if (texture)
+	{
+		SDL_UpdateTexture(texture, nullptr, image.GetPixels(), image.GetWidth() * (int)sizeof(uint32_t));
+		SDL_SetTextureBlendMode(texture, SDL_BLENDMODE_BLEND);
+	}
+	return texture;
+}
+
+//================================================================================
+
+SdlRenderer::SdlRenderer(SDL_Window & window, unsigned int Width, unsigned int Height, const GlyphAtlas& glyphAtlas)
+	: Renderer(Width, Height)
+	, m_SdlRenderer(nullptr)
+	, m_GlyphAtlas(glyphAtlas)
+	, m_GlyphTexture(nullptr)
+{
+	memset(m_CachedTexts, 0, sizeof(m_CachedTexts));
+	m_SubmitRects.reserve(1024);
+
+	m_SdlRenderer = CreateSdlRenderer(window, Width, Height);
+
+	if (!CreateGlyphTexture())
+	{
+		printf("Failed to create glyph texture: %s\n", SDL_GetError());
+	}
+}
+
+SdlRenderer::~SdlRenderer()
+{
+	for (size_t i = 0; i < m_Textures.size(); ++i)
+	{
+		SDL_DestroyTexture(m_Textures[i].texture);
+	}
+	for (unsigned int i = 0; i < kNumCachedTexts; ++i)
+	{
+		SDL_DestroyTexture(m_CachedTexts[i].texture);
+	}
+	SDL_DestroyTexture(m_GlyphTexture);
+	SDL_DestroyRenderer(m_SdlRenderer);
+}
+
+// white glyphs with coverage in alpha, tinted per string with the colour mod
+bool SdlRenderer::CreateGlyphTexture()
+{
+	if (!IsGlyphAtlasValid(m_GlyphAtlas))
+		return false;
+
+	Framebuffer image;
+	image.Resize(m_GlyphAtlas.width, m_GlyphAtlas.height);
+	uint32_t* pixels = image.GetPixels();
+	for (size_t i = 0; i < m_GlyphAtlas.alpha.size(); ++i)
+	{
+		pixels[i] = 0xffffff00 | m_GlyphAtlas.alpha[i];
+	}
+
+	m_GlyphTexture = CreateStaticTexture(m_SdlRenderer, image);
+	return m_GlyphTexture != nullptr;
+}
+
+void SdlRenderer::Clear()
+{
+	SDL_SetRenderDrawColor(m_SdlRenderer, 0, 0, 0, 255);
+	SDL_RenderClear(m_SdlRenderer);
+}
+
+void SdlRenderer::Present()
+{
+	FlushBatch();
+	SDL_RenderPresent(m_SdlRenderer);
+	EndFrame();
+}
+
+void SdlRenderer::DrawRect(int x, int y, int w, int h, uint32_t rgba)
+{
+	FlushBatch();
+
+	SDL_Color color = MakeSDL_Color(rgba);
+	SDL_SetRenderDrawColor(m_SdlRenderer, color.r, color.g, color.b, color.a);
+
+	SDL_Rect rect = { x, y, w, h };
+	SDL_RenderDrawRect(m_SdlRenderer, &rect);
+}
+
+void SdlRenderer::DrawSolidRect(int x, int y, int w, int h, uint32_t rgba)
+{
+	FlushBatch();
+
+	SDL_Color color = MakeSDL_Color(rgba);
+	SDL_SetRenderDrawColor(m_SdlRenderer, color.r, color.g, color.b, color.a);
+
+	SDL_Rect rect = { x, y, w, h };
+	SDL_RenderFillRect(m_SdlRenderer, &rect);
+}
+
+void SdlRenderer::SubmitRects(const RenderRect* rects, unsigned int numRects, uint32_t rgba, bool solid)
+{
+	m_SubmitRects.resize(numRects);
+	for (unsigned int i = 0; i < numRects; ++i)
+	{
+		SDL_Rect rect = { rects[i].x, rects[i].y, rects[i].w, rects[i].h };
+		m_SubmitRects[i] = rect;
+	}
+
+	SDL_Color color = MakeSDL_Color(rgba);
+	SDL_SetRenderDrawColor(m_SdlRenderer, color.r, color.g, color.b, color.a);
+	if (solid)
+	{
+		SDL_RenderFillRects(m_SdlRenderer, m_SubmitRects.data(), (int)numRects);
+	}
+	else
+	{
+		SDL_RenderDrawRects(m_SdlRenderer, m_SubmitRects.data(), (int)numRects);
+	}
+}
+
+// copies from one texture back to back need no texture switches in the backend
+void SdlRenderer::SubmitSprites(TextureHandle atlas, const SpriteInstance* sprites, unsigned int numSprites)
+{
+	const TextureEntry* entry = GetTexture(atlas);
+	if (!entry || entry->spriteSize <= 0)
+		return;
+
+	const int spriteSize = entry->spriteSize;
+	for (unsigned int i = 0; i < numSprites; ++i)
+	{
+		const SpriteInstance& sprite = sprites[i];
+		SDL_Rect srcRect = { (int)sprite.spriteIndex * spriteSize, 0, spriteSize, spriteSize };
+		SDL_Rect dstRect = { sprite.x, sprite.y, spriteSize, spriteSize };
+		SDL_RenderCopy(m_SdlRenderer, entry->texture, &srcRect, &dstRect);
+	}
+}
+
+void SdlRenderer::DrawText(const char* text, int x, int y, uint32_t rgba)
+{
+	HP_PROFILE_SCOPE("Renderer::DrawText");
+	SDL_assert(text);
+
+	FlushBatch();
+	if (!m_GlyphTexture)
+		return;
+
+	// one colour change for the whole string, then consecutive copies from the
+	// same texture which the SDL backends can submit without state changes
+	SDL_Color color = MakeSDL_Color(rgba);
+	SDL_SetTextureColorMod(m_GlyphTexture, color.r, color.g, color.b);
+	SDL_SetTextureAlphaMod(m_GlyphTexture, color.a);
+
+	int penX = x;
+	for (const char* c = text; *c; ++c)
+	{
+		const GlyphAtlas::Glyph* glyph = FindGlyph(m_GlyphAtlas, *c);
+		if (!glyph)
+			continue;
+
+		if (glyph->width > 0)
+		{
+			SDL_Rect srcRect = { glyph->x, glyph->y, glyph->width, glyph->height };
+			SDL_Rect dstRect = { penX, y, glyph->width, glyph->height };
+			SDL_RenderCopy(m_SdlRenderer, m_GlyphTexture, &srcRect, &dstRect);
+		}
+		penX += glyph->advance;
+	}
+}
+
+// Reads the output pixels. When the logical size is scaled to fit the window,
+// as it is fullscreen, the whole output is read and sampled back down to the
+// logical size, nearest pixel.
+bool SdlRenderer::ReadPixels(uint32_t* pixels)
+{
+	HP_PROFILE_SCOPE("Renderer::ReadPixels");
+	HP_ASSERT(pixels);
+
+	FlushBatch();
+
+	int outputWidth, outputHeight;
+	if (SDL_GetRendererOutputSize(m_SdlRenderer, &outputWidth, &outputHeight) != 0)
+		return false;
+	if (outputWidth == (int)m_Width && outputHeight == (int)m_Height)
+	{
+		if (SDL_RenderReadPixels(m_SdlRenderer, nullptr, SDL_PIXELFORMAT_RGBA8888, pixels, m_Width * (int)sizeof(uint32_t)) != 0)
+		{
+			printf("SDL_RenderReadPixels failed: %s\n", SDL_GetError());
+			return false;
+		}
+		return true;
+	}
+
+	// the read is clipped to the letterboxed viewport and lands where it is in the output
+	m_ReadbackPixels.resize((size_t)outputWidth * outputHeight);
+	SDL_Rect outputRect = { 0, 0, outputWidth, outputHeight };
+	if (SDL_RenderReadPixels(m_SdlRenderer, &outputRect, SDL_PIXELFORMAT_RGBA8888, m_ReadbackPixels.data(), outputWidth * (int)sizeof(uint32_t)) != 0)
+	{
+		printf("SDL_RenderReadPixels failed: %s\n", SDL_GetError());
+		return false;
+	}
+
+	// the viewport comes back in logical units
+	SDL_Rect viewport;
+	float scaleX, scaleY;
+	SDL_RenderGetViewport(m_SdlRenderer, &viewport);
+	SDL_RenderGetScale(m_SdlRenderer, &scaleX, &scaleY);
+	const float viewportX = viewport.x * scaleX;
+	const float viewportY = viewport.y * scaleY;
+
+	m_ReadbackColumns.resize(m_Width);
+	for (unsigned int x = 0; x < m_Width; ++x)
+	{
+		const int column = (int)(viewportX + (x + 0.5f) * scaleX);
+		m_ReadbackColumns[x] = column < outputWidth ? column : outputWidth - 1;
+	}
+	for (unsigned int y = 0; y < m_Height; ++y)
+	{
+		int row = (int)(viewportY + (y + 0.5f) * scaleY);
+		row = row < outputHeight ? row : outputHeight - 1;
+		const uint32_t* src = &m_ReadbackPixels[(size_t)row * outputWidth];
+		uint32_t* dst = pixels + (size_t)y * m_Width;
+		for (unsigned int x = 0; x < m_Width; ++x)
+		{
+			dst[x] = src[m_ReadbackColumns[x]];
+		}
+	}
+	return true;
+}
+
+TextHandle SdlRenderer::CacheText(const char* text, uint32_t rgba)
+{
+	HP_PROFILE_SCOPE("Renderer::CacheText");
+	SDL_assert(text);
+
+	unsigned int slot;
+	const TextHandle handle = AllocateCachedText(slot);
+
+	CachedText& cachedText = m_CachedTexts[slot];
+	SDL_DestroyTexture(cachedText.texture);
+
+	ComposeText(m_GlyphAtlas, text, rgba, m_ComposeImage);
+	cachedText.texture = CreateStaticTexture(m_SdlRenderer, m_ComposeImage);
+	cachedText.width = (int)m_ComposeImage.GetWidth();
+	cachedText.height = (int)m_ComposeImage.GetHeight();
+	return handle;
+}
+
+bool SdlRenderer::DrawCachedText(TextHandle handle, int x, int y)
+{
+	unsigned int slot;
+	if (!FindCachedText(handle, slot))
+		return false;
+
+	FlushBatch();
+	const CachedText& cachedText = m_CachedTexts[slot];
+	if (cachedText.texture)
+	{
+		SDL_Rect rect = { x, y, cachedText.width, cachedText.height };
+		SDL_RenderCopy(m_SdlRenderer, cachedText.texture, nullptr, &rect);
+	}
+	return true;
+}
+
+const SdlRenderer::TextureEntry* SdlRenderer::GetTexture(TextureHandle handle) const
+{
+	if (handle == 0 || handle > m_Textures.size() || !m_Textures[handle - 1].texture)
+		return nullptr;
+	return &m_Textures[handle - 1];
+}
+
+TextureHandle SdlRenderer::AddTexture(SDL_Texture* texture, int spriteSize)
+{
+	TextureEntry entry = { texture, 0, 0, spriteSize, std::vector<uint32_t>() };
+	SDL_QueryTexture(texture, nullptr, nullptr, &entry.width, &entry.height);
+
+	// reuse a released slot before growing the table
+	for (size_t i = 0; i < m_Textures.size(); ++i)
+	{
+		if (!m_Textures[i].texture)
+		{
+			m_Textures[i] = entry;
+			return (TextureHandle)i + 1;
+		}
+	}
+
+	m_Textures.push_back(entry);
+	return (TextureHandle)m_Textures.size();
+}
+
+bool SdlRenderer::SupportsRenderTargets() const
+{
+	return SDL_RenderTargetSupported(m_SdlRenderer) == SDL_TRUE;
+}
+
+TextureHandle SdlRenderer::CreateRenderTarget(unsigned int width, unsigned int height)
+{
+	if (!SupportsRenderTargets())
+		return 0;
+
+	SDL_Texture* texture = SDL_CreateTexture(m_SdlRenderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, width, height);
+	if (!texture)
+	{
+		printf("Failed to create render target: %s\n", SDL_GetError());
+		return 0;
+	}
+
+	return AddTexture(texture, 0);
+}
+
+SDL_Texture* SdlRenderer::CreateBlockAtlasTexture(const uint32_t* rgbas, unsigned int numSprites, unsigned int spriteSizePixels)
+{
+	std::vector<uint32_t> pixels;
+	BakeBlockAtlas(rgbas, numSprites, spriteSizePixels, pixels);
+
+	const int atlasWidth = (int)(numSprites * spriteSizePixels);
+	SDL_Texture* texture = SDL_CreateTexture(m_SdlRenderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_STATIC, atlasWidth, spriteSizePixels);
+	if (!texture)
+	{
+		printf("Failed to create block atlas: %s\n", SDL_GetError());
+		return nullptr;
+	}
+	SDL_UpdateTexture(texture, nullptr, pixels.data(), atlasWidth * (int)sizeof(uint32_t));
+	return texture;
+}
+
+TextureHandle SdlRenderer::CreateBlockAtlas(const uint32_t* rgbas, unsigned int numSprites, unsigned int spriteSizePixels)
+{
+	HP_PROFILE_SCOPE("Renderer::CreateBlockAtlas");
+
+	SDL_Texture* texture = CreateBlockAtlasTexture(rgbas, numSprites, spriteSizePixels);
+	if (!texture)
+		return 0;
+
+	const TextureHandle handle = AddTexture(texture, (int)spriteSizePixels);
+	m_Textures[handle - 1].spriteRgbas.assign(rgbas, rgbas + numSprites);
+	return handle;
+}
+
+void SdlRenderer::RecreateTextures()
+{
+	HP_PROFILE_SCOPE("Renderer::RecreateTextures");
+
+	for (size_t i = 0; i < m_Textures.size(); ++i)
+	{
+		TextureEntry& entry = m_Textures[i];
+		if (!entry.texture)
+			continue;
+
+		SDL_DestroyTexture(entry.texture);
+		if (entry.spriteSize > 0)
+			entry.texture = CreateBlockAtlasTexture(entry.spriteRgbas.data(), (unsigned int)entry.spriteRgbas.size(), (unsigned int)entry.spriteSize);
+		else
+			entry.texture = SDL_CreateTexture(m_SdlRenderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_TARGET, entry.width, entry.height);
+		// a texture that can't be recreated leaves its handle drawing nothing
+		if (!entry.texture)
+			printf("Failed to recreate texture %zu: %s\n", i + 1, SDL_GetError());
+	}
+
+	for (unsigned int i = 0; i < kNumCachedTexts; ++i)
+	{
+		SDL_DestroyTexture(m_CachedTexts[i].texture);
+		m_CachedTexts[i].texture = nullptr;
+	}
+	EvictCachedTexts();
+
+	SDL_DestroyTexture(m_GlyphTexture);
+	m_GlyphTexture = nullptr;
+	if (!CreateGlyphTexture())
+	{
+		printf("Failed to create glyph texture: %s\n", SDL_GetError());
+	}
+}
+
+void SdlRenderer::DestroyTexture(TextureHandle handle)
+{
+	if (GetTexture(handle))
+	{
+		FlushBatch();
+		SDL_DestroyTexture(m_Textures[handle - 1].texture);
+		m_Textures[handle - 1].texture = nullptr;
+	}
+}
+
+void SdlRenderer::SetRenderTarget(TextureHandle handle)
+{
+	FlushBatch();
+	const TextureEntry* entry = GetTexture(handle);
+	SDL_SetRenderTarget(m_SdlRenderer, entry ? entry->texture : nullptr);
+}
+
+void SdlRenderer::DrawTexture(TextureHandle handle, int x, int y)
+{
+	const TextureEntry* entry = GetTexture(handle);
+	if (!entry)
+		return;
+
+	FlushBatch();
+	SDL_Rect rect = { x, y, entry->width, entry->height };
+	SDL_RenderCopy(m_SdlRenderer, entry->texture, nullptr, &rect);
+}
+
+//================================================================================
+
+SdlSoftwareRenderer::SdlSoftwareRenderer(SDL_Window& window, unsigned int Width, unsigned int Height, const GlyphAtlas& glyphAtlas)
+	: SoftwareRenderer(Width, Height, glyphAtlas)
+	, m_SdlRenderer(nullptr)
+	, m_StreamingTexture(nullptr)
+{
+	m_SdlRenderer = CreateSdlRenderer(window, Width, Height);
+	m_StreamingTexture = SDL_CreateTexture(m_SdlRenderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_STREAMING, Width, Height);
+	if (!m_StreamingTexture)
+	{
+		printf("Failed to create streaming texture: %s\n", SDL_GetError());
+	}
+}
+
+SdlSoftwareRenderer::~SdlSoftwareRenderer()
+{
+	SDL_DestroyTexture(m_StreamingTexture);
+	SDL_DestroyRenderer(m_SdlRenderer);
+}
+
+void SdlSoftwareRenderer::RecreateTextures()
+{
+	SDL_DestroyTexture(m_StreamingTexture);
+	m_StreamingTexture = SDL_CreateTexture(m_SdlRenderer, SDL_PIXELFORMAT_RGBA8888, SDL_TEXTUREACCESS_STREAMING, m_Width, m_Height);
+	if (!m_StreamingTexture)
+	{
+		printf("Failed to create streaming texture: %s\n", SDL_GetError());
+	}
+}
+
+void SdlSoftwareRenderer::PresentFramebuffer(const Framebuffer& framebuffer)
+{
+	HP_PROFILE_SCOPE("SdlSoftwareRenderer::PresentFramebuffer");
+
+	void* pixels;
+	int pitch;
+	if (m_StreamingTexture && SDL_LockTexture(m_StreamingTexture, nullptr, &pixels, &pitch) == 0)
+	{
+		const size_t rowBytes = framebuffer.GetWidth() * sizeof(uint32_t);
+		if ((size_t)pitch == rowBytes)
+		{
+			memcpy(pixels, framebuffer.GetPixels(), framebuffer.GetSizeBytes());
+		}
+		else
+		{
+			for (unsigned int y = 0; y < framebuffer.GetHeight(); ++y)
+			{
+				memcpy((uint8_t*)pixels + y * pitch, framebuffer.GetPixels() + y * framebuffer.GetWidth(), rowBytes);
+			}
+		}
+		SDL_UnlockTexture(m_StreamingTexture);
+
+		// clears any letterbox borders
+		SDL_SetRenderDrawColor(m_SdlRenderer, 0, 0, 0, 255);
+		SDL_RenderClear(m_SdlRenderer);
+		SDL_RenderCopy(m_SdlRenderer, m_StreamingTexture, nullptr, nullptr);
+	}
+
+	SDL_RenderPresent(m_SdlRenderer);
+}
@@ -0,0 +1,101 @@
+#pragma once
+#ifndef SDL_RENDERER_H_INCLUDED
+#define SDL_RENDERER_H_INCLUDED
+
+#include "Render.h"
+#include "SoftwareRenderer.h"
+#include <SDL.h>
+
+struct GlyphAtlas;
+
+// Draws through an SDL_Renderer, normally GPU accelerated.
+class SdlRenderer : public Renderer
+{
+public:
+	SdlRenderer(SDL_Window& window, unsigned int Width, unsigned int Height, const GlyphAtlas& glyphAtlas);
+	virtual ~SdlRenderer();
+
+	virtual void Clear();
+	virtual void Present();
+
+	virtual void DrawRect(int x, int y, int w, int h, uint32_t rgba = 0xffffffff);
+	virtual void DrawSolidRect(int x, int y, int w, int h, uint32_t rgba = 0xffffffff);
+	virtual void DrawText(const char* text, int x, int y, uint32_t rgba = 0xffffffff);
+	virtual bool ReadPixels(uint32_t* pixels);
+
+	virtual TextHandle CacheText(const char* text, uint32_t rgba = 0xffffffff);
+	virtual bool DrawCachedText(TextHandle handle, int x, int y);
+
+	virtual bool SupportsRenderTargets() const;
+	virtual TextureHandle CreateRenderTarget(unsigned int width, unsigned int height);
+	virtual void DestroyTexture(TextureHandle handle);
+	virtual void SetRenderTarget(TextureHandle handle);
+	virtual void DrawTexture(TextureHandle handle, int x, int y);
+
+	virtual TextureHandle CreateBlockAtlas(const uint32_t* rgbas, unsigned int numSprites, unsigned int spriteSizePixels);
+
+	virtual void RecreateTextures();
+
+protected:
+	virtual void SubmitRects(const RenderRect* rects, unsigned int numRects, uint32_t rgba, bool solid);
+	virtual void SubmitSprites(TextureHandle atlas, const SpriteInstance* sprites, unsigned int numSprites);
+
+private:
+	struct TextureEntry
+	{
+		SDL_Texture* texture;
+		int width;
+		int height;
+		int spriteSize;
+		// block atlases, to bake them again after a device reset
+		std::vector<uint32_t> spriteRgbas;
+	};
+
+	struct CachedText
+	{
+		SDL_Texture* texture;
+		int width;
+		int height;
+	};
+
+	bool CreateGlyphTexture();
+	SDL_Texture* CreateBlockAtlasTexture(const uint32_t* rgbas, unsigned int numSprites, unsigned int spriteSizePixels);
+	const TextureEntry* GetTexture(TextureHandle handle) const;
+	TextureHandle AddTexture(SDL_Texture* texture, int spriteSize);
+
+	SDL_Renderer* m_SdlRenderer;
+
+	const GlyphAtlas& m_GlyphAtlas;
+	SDL_Texture* m_GlyphTexture;
+
+	std::vector<SDL_Rect> m_SubmitRects;
+	std::vector<TextureEntry> m_Textures;
+
+	CachedText m_CachedTexts[kNumCachedTexts];
+	Framebuffer m_ComposeImage;
+
+	// ReadPixels on a scaled output
+	std::vector<uint32_t> m_ReadbackPixels;
+	std::vector<int> m_ReadbackColumns;
+};
+
+// The software renderer presented to a window with one streaming texture
+// upload per frame.
+class SdlSoftwareRenderer : public SoftwareRenderer
+{
+public:
+	SdlSoftwareRenderer(SDL_Window& window, unsigned int Width, unsigned int Height, const GlyphAtlas& glyphAtlas);
+	virtual ~SdlSoftwareRenderer();
+
+	// only the streaming texture lives on the device
+	virtual void RecreateTextures();
+
+protected:
+	virtual void PresentFramebuffer(const Framebuffer& framebuffer);
+
+private:
+	SDL_Renderer* m_SdlRenderer;
+	SDL_Texture* m_StreamingTexture;
+};
+
+#endif // SDL_RENDERER_H_INCLUDED
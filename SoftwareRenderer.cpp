@@ -0,0 +1,208 @@
+#include "SoftwareRenderer.h"
+#include "Debugger.h"
+#include "Font.h"
+#include <algorithm>
+#include <stdio.h>
+
+SoftwareRenderer::SoftwareRenderer(unsigned int Width, unsigned int Height, const GlyphAtlas& glyphAtlas)
+	: Renderer(Width, Height)
+	, m_GlyphAtlas(glyphAtlas)
+	, m_Target(nullptr)
+{
+	m_Framebuffer.Resize(Width, Height);
+	m_Target = &m_Framebuffer;
+	printf("Software renderer = (%u, %u) using %s kernels\n", Width, Height, Framebuffer::GetKernelName());
+}
+
+SoftwareRenderer::~SoftwareRenderer()
+{
+	for (size_t i = 0; i < m_Textures.size(); ++i)
+	{
+		delete m_Textures[i].image;
+	}
+}
+
+void SoftwareRenderer::Clear()
+{
+	m_Target->Clear(0x000000ff);
+}
+
+void SoftwareRenderer::Present()
+{
+	FlushBatch();
+	PresentFramebuffer(m_Framebuffer);
+	EndFrame();
+}
+
+void SoftwareRenderer::PresentFramebuffer(const Framebuffer& framebuffer)
+{
+	HP_UNUSED(framebuffer);
+}
+
+void SoftwareRenderer::DrawRect(int x, int y, int w, int h, uint32_t rgba)
+{
+	FlushBatch();
+	m_Target->DrawRect(x, y, w, h, rgba);
+}
+
+void SoftwareRenderer::DrawSolidRect(int x, int y, int w, int h, uint32_t rgba)
+{
+	FlushBatch();
+	m_Target->FillRect(x, y, w, h, rgba);
+}
+
+void SoftwareRenderer::DrawText(const char* text, int x, int y, uint32_t rgba)
+{
+	HP_PROFILE_SCOPE("Renderer::DrawText");
+	HP_ASSERT(text);
+
+	FlushBatch();
+	if (!IsGlyphAtlasValid(m_GlyphAtlas))
+		return;
+
+	int penX = x;
+	for (const char* c = text; *c; ++c)
+	{
+		const GlyphAtlas::Glyph* glyph = FindGlyph(m_GlyphAtlas, *c);
+		if (!glyph)
+			continue;
+
+		const uint8_t* mask = &m_GlyphAtlas.alpha[glyph->y * m_GlyphAtlas.width + glyph->x];
+		m_Target->BlendAlphaMask(mask, m_GlyphAtlas.width, penX, y, glyph->width, glyph->height, rgba);
+		penX += glyph->advance;
+	}
+}
+
+bool SoftwareRenderer::ReadPixels(uint32_t* pixels)
+{
+	HP_ASSERT(pixels);
+
+	FlushBatch();
+	const uint32_t* source = m_Framebuffer.GetPixels();
+	std::copy(source, source + m_Framebuffer.GetWidth() * m_Framebuffer.GetHeight(), pixels);
+	return true;
+}
+
+TextHandle SoftwareRenderer::CacheText(const char* text, uint32_t rgba)
+{
+	HP_PROFILE_SCOPE("Renderer::CacheText");
+
+	unsigned int slot;
+	const TextHandle handle = AllocateCachedText(slot);
+	ComposeText(m_GlyphAtlas, text, rgba, m_CachedTexts[slot]);
+	return handle;
+}
+
+bool SoftwareRenderer::DrawCachedText(TextHandle handle, int x, int y)
+{
+	unsigned int slot;
+	if (!FindCachedText(handle, slot))
+		return false;
+
+	FlushBatch();
+	const Framebuffer& image = m_CachedTexts[slot];
+	m_Target->Blit(image, 0, 0, image.GetWidth(), image.GetHeight(), x, y);
+	return true;
+}
+
+SoftwareRenderer::TextureEntry* SoftwareRenderer::GetTexture(TextureHandle handle)
+{
+	if (handle == 0 || handle > m_Textures.size() || !m_Textures[handle - 1].image)
+		return nullptr;
+	return &m_Textures[handle - 1];
+}
+
+TextureHandle SoftwareRenderer::AddTexture(Framebuffer* image, int spriteSize)
+{
+	TextureEntry entry = { image, spriteSize };
+
+	// reuse a released slot before growing the table
+	for (size_t i = 0; i < m_Textures.size(); ++i)
+	{
+		if (!m_Textures[i].image)
+		{
+			m_Textures[i] = entry;
+			return (TextureHandle)i + 1;
+		}
+	}
+
+	m_Textures.push_back(entry);
+	return (TextureHandle)m_Textures.size();
+}
+
+TextureHandle SoftwareRenderer::CreateRenderTarget(unsigned int width, unsigned int height)
+{
+	Framebuffer* image = new Framebuffer;
+	image->Resize(width, height);
+	image->Clear(0x000000ff);
+	return AddTexture(image, 0);
+}
+
+TextureHandle SoftwareRenderer::CreateBlockAtlas(const uint32_t* rgbas, unsigned int numSprites, unsigned int spriteSizePixels)
+{
+	HP_PROFILE_SCOPE("Renderer::CreateBlockAtlas");
+
+	std::vector<uint32_t> pixels;
+	BakeBlockAtlas(rgbas, numSprites, spriteSizePixels, pixels);
+
+	Framebuffer* image = new Framebuffer;
+	image->Resize(numSprites * spriteSizePixels, spriteSizePixels);
+	std::copy(pixels.begin(), pixels.end(), image->GetPixels());
+	return AddTexture(image, (int)spriteSizePixels);
+}
+
+void SoftwareRenderer::DestroyTexture(TextureHandle handle)
+{
+	TextureEntry* entry = GetTexture(handle);
+	if (!entry)
+		return;
+
+	FlushBatch();
+	if (m_Target == entry->image)
+		m_Target = &m_Framebuffer;
+	delete entry->image;
+	entry->image = nullptr;
+}
+
+void SoftwareRenderer::SetRenderTarget(TextureHandle handle)
+{
+	FlushBatch();
+	TextureEntry* entry = GetTexture(handle);
+	m_Target = entry ? entry->image : &m_Framebuffer;
+}
+
+void SoftwareRenderer::DrawTexture(TextureHandle handle, int x, int y)
+{
+	TextureEntry* entry = GetTexture(handle);
+	if (!entry)
+		return;
+
+	FlushBatch();
+	m_Target->Blit(*entry->image, 0, 0, entry->image->GetWidth(), entry->image->GetHeight(), x, y);
+}
+
+void SoftwareRenderer::SubmitRects(const RenderRect* rects, unsigned int numRects, uint32_t rgba, bool solid)
+{
+	for (unsigned int i = 0; i < numRects; ++i)
+	{
+		const RenderRect& rect = rects[i];
+		if (solid)
+			m_Target->FillRect(rect.x, rect.y, rect.w, rect.h, rgba);
+		else
+			m_Target->DrawRect(rect.x, rect.y, rect.w, rect.h, rgba);
+	}
+}
+
+void SoftwareRenderer::SubmitSprites(TextureHandle atlas, const SpriteInstance* sprites, unsigned int numSprites)
+{
+	TextureEntry* entry = GetTexture(atlas);
+	if (!entry || entry->spriteSize <= 0)
+		return;
+
+	const int spriteSize = entry->spriteSize;
+	for (unsigned int i = 0; i < numSprites; ++i)
+	{
+		const SpriteInstance& sprite = sprites[i];
+		m_Target->Blit(*entry->image, (int)sprite.spriteIndex * spriteSize, 0, spriteSize, spriteSize, sprite.x, sprite.y);
+	}
+}
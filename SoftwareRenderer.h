@@ -0,0 +1,65 @@
+#pragma once
+#ifndef SOFTWARE_RENDERER_H_INCLUDED
+#define SOFTWARE_RENDERER_H_INCLUDED
+
+#include "Framebuffer.h"
+#include "Render.h"
+
+struct GlyphAtlas;
+
+// Rasterizes everything on the CPU into an RGBA8888 Framebuffer. On its own it
+// is headless, derived classes override PresentFramebuffer to display it.
+class SoftwareRenderer : public Renderer
+{
+public:
+	SoftwareRenderer(unsigned int Width, unsigned int Height, const GlyphAtlas& glyphAtlas);
+	virtual ~SoftwareRenderer();
+
+	virtual void Clear();
+	virtual void Present();
+
+	virtual void DrawRect(int x, int y, int w, int h, uint32_t rgba = 0xffffffff);
+	virtual void DrawSolidRect(int x, int y, int w, int h, uint32_t rgba = 0xffffffff);
+	virtual void DrawText(const char* text, int x, int y, uint32_t rgba = 0xffffffff);
+	virtual bool ReadPixels(uint32_t* pixels);
+	virtual bool IsFrameRetainedAfterPresent() const { return true; }
+
+	virtual TextHandle CacheText(const char* text, uint32_t rgba = 0xffffffff);
+	virtual bool DrawCachedText(TextHandle handle, int x, int y);
+
+	virtual TextureHandle CreateRenderTarget(unsigned int width, unsigned int height);
+	virtual void DestroyTexture(TextureHandle handle);
+	virtual void SetRenderTarget(TextureHandle handle);
+	virtual void DrawTexture(TextureHandle handle, int x, int y);
+
+	virtual TextureHandle CreateBlockAtlas(const uint32_t* rgbas, unsigned int numSprites, unsigned int spriteSizePixels);
+
+	const Framebuffer& GetFramebuffer() const { return m_Framebuffer; }
+
+protected:
+	virtual void SubmitRects(const RenderRect* rects, unsigned int numRects, uint32_t rgba, bool solid);
+	virtual void SubmitSprites(TextureHandle atlas, const SpriteInstance* sprites, unsigned int numSprites);
+
+	// called with the finished frame from Present
+	virtual void PresentFramebuffer(const Framebuffer& framebuffer);
+
+private:
+	struct TextureEntry
+	{
+		Framebuffer* image;
+		int spriteSize;
+	};
+
+	TextureEntry* GetTexture(TextureHandle handle);
+	TextureHandle AddTexture(Framebuffer* image, int spriteSize);
+
+	const GlyphAtlas& m_GlyphAtlas;
+
+	Framebuffer m_Framebuffer;
+	Framebuffer* m_Target;
+
+	std::vector<TextureEntry> m_Textures;
+	Framebuffer m_CachedTexts[kNumCachedTexts];
+};
+
+#endif // SOFTWARE_RENDERER_H_INCLUDED
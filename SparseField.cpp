@@ -0,0 +1,386 @@
+#include "SparseField.h"
+#include "Render.h"
+#include <stdio.h>
+#include "Debugger.h"
+#include <string.h>
+
+// int2 positions have to reach every cell, with room for a piece's 4x4 box
+static const unsigned int s_kMaxSize = 0x7fffff00u;
+
+//================================================================================
+
+SparseField::SparseField()
+	: m_width(0)
+	, m_height(0)
+	, m_numChunkColumns(0)
+	, m_freeChunks(nullptr)
+	, m_numChunks(0)
+	, m_numFreeChunks(0)
+	, m_numAllocatedRows(0)
+	, m_blockRowBound(0)
+	, m_dirtyRowEnd(0)
+{
+}
+
+SparseField::~SparseField()
+{
+	Shutdown();
+}
+
+bool SparseField::Init(unsigned int width, unsigned int height)
+{
+	Shutdown();
+	if (width == 0 || height == 0 || width > s_kMaxSize || height > s_kMaxSize)
+	{
+		fprintf(stderr, "Can't make a %u x %u sparse field\n", width, height);
+		return false;
+	}
+
+	m_width = width;
+	m_height = height;
+	m_numChunkColumns = (width + kChunkWidth - 1) / kChunkWidth;
+	Row emptyRow;
+	emptyRow.chunks = nullptr;
+	emptyRow.numBlocks = 0;
+	m_rows.assign(height, emptyRow);
+	m_rowOrder.resize(height);
+	for (unsigned int y = 0; y < height; ++y)
+	{
+		m_rowOrder[y] = y;
+	}
+	m_blockRowBound = height;
+	// the whole field is new to anything that draws it
+	m_dirtyRowEnd = height;
+	return true;
+}
+
+void SparseField::Shutdown()
+{
+	for (size_t i = 0; i < m_rows.size(); ++i)
+	{
+		delete[] m_rows[i].chunks;
+	}
+	for (size_t i = 0; i < m_chunkBlocks.size(); ++i)
+	{
+		delete[] m_chunkBlocks[i];
+	}
+	m_rows.clear();
+	m_rowOrder.clear();
+	m_chunkBlocks.clear();
+	m_dirtyChunks.clear();
+	m_dirtyChunkPointers.clear();
+	m_freeChunks = nullptr;
+	m_numChunks = 0;
+	m_numFreeChunks = 0;
+	m_numAllocatedRows = 0;
+	m_blockRowBound = 0;
+	m_dirtyRowEnd = 0;
+	m_width = 0;
+	m_height = 0;
+	m_numChunkColumns = 0;
+}
+
+int SparseField::GetCell(unsigned int x, unsigned int y) const
+{
+	HP_ASSERT(x < m_width && y < m_height);
+	const Row& row = GetRow(y);
+	if (row.numBlocks == 0)
+		return -1;
+	const Chunk* chunk = row.chunks[x / kChunkWidth];
+	return chunk ? (int)chunk->cells[x % kChunkWidth] - 1 : -1;
+}
+
+void SparseField::SetCell(unsigned int x, unsigned int y, int block)
+{
+	HP_ASSERT(x < m_width && y < m_height);
+	HP_ASSERT(block >= -1 && block < (int)kBlockSprite_Empty);
+	Row& row = GetRow(y);
+	const unsigned int chunkColumn = x / kChunkWidth;
+	const uint8_t code = (uint8_t)(block + 1);
+
+	if (!row.chunks)
+	{
+		if (code == 0)
+			return;
+		row.chunks = new Chunk*[m_numChunkColumns];
+		memset(row.chunks, 0, m_numChunkColumns * sizeof(Chunk*));
+		++m_numAllocatedRows;
+	}
+
+	Chunk* chunk = row.chunks[chunkColumn];
+	if (!chunk)
+	{
+		if (code == 0)
+			return;
+		chunk = AllocateChunk();
+		row.chunks[chunkColumn] = chunk;
+	}
+
+	uint8_t& cell = chunk->cells[x % kChunkWidth];
+	if (cell == code)
+		return;
+
+	if (cell == 0)
+	{
+		++chunk->numBlocks;
+		++row.numBlocks;
+		if (y < m_blockRowBound)
+			m_blockRowBound = y;
+	}
+	else if (code == 0)
+	{
+		--chunk->numBlocks;
+		--row.numBlocks;
+	}
+	cell = code;
+	MarkChunkDirty(*chunk, y, chunkColumn);
+
+	if (chunk->numBlocks == 0)
+	{
+		FreeChunk(chunk);
+		row.chunks[chunkColumn] = nullptr;
+	}
+}
+
+unsigned int SparseField::GetNumBlocksInRow(unsigned int y) const
+{
+	HP_ASSERT(y < m_height);
+	return GetRow(y).numBlocks;
+}
+
+bool SparseField::Overlaps(const TetrominoInstance& instance) const
+{
+	const Tetromino::BlockCoords& blockCoords = GetTetromino(instance.m_tetrominoType).blockCoord[instance.m_rot];
+	for (unsigned int i = 0; i < Tetromino::kNumBlocks; ++i)
+	{
+		const int x = instance.m_pos.x + (int)blockCoords[i].x;
+		const int y = instance.m_pos.y + (int)blockCoords[i].y;
+		if (x < 0 || x >= (int)m_width || y < 0 || y >= (int)m_height)
+			return true;
+		if (GetCell((unsigned int)x, (unsigned int)y) != -1)
+			return true;
+	}
+	return false;
+}
+
+unsigned int SparseField::GetDropDistance(const TetrominoInstance& instance) const
+{
+	HP_ASSERT(!Overlaps(instance));
+	const Tetromino::BlockCoords& blockCoords = GetTetromino(instance.m_tetrominoType).blockCoord[instance.m_rot];
+
+	// only the lowest block in each column can land on anything, and empty
+	// rows are passed over without looking at their chunks
+	unsigned int dropDistance = m_height;
+	for (unsigned int i = 0; i < Tetromino::kNumBlocks; ++i)
+	{
+		bool lowestInColumn = true;
+		for (unsigned int j = 0; j < Tetromino::kNumBlocks; ++j)
+		{
+			lowestInColumn &= blockCoords[j].x != blockCoords[i].x || blockCoords[j].y <= blockCoords[i].y;
+		}
+		if (!lowestInColumn)
+			continue;
+
+		const unsigned int x = (unsigned int)(instance.m_pos.x + (int)blockCoords[i].x);
+		const unsigned int y = (unsigned int)(instance.m_pos.y + (int)blockCoords[i].y);
+		unsigned int below = y + 1 > m_blockRowBound ? y + 1 : m_blockRowBound;
+		while (below < m_height && below - y - 1 < dropDistance && GetCell(x, below) == -1)
+		{
+			++below;
+		}
+		if (below - y - 1 < dropDistance)
+			dropDistance = below - y - 1;
+	}
+	return dropDistance;
+}
+
+unsigned int SparseField::AddTetromino(const TetrominoInstance& instance)
+{
+	const Tetromino::BlockCoords& blockCoords = GetTetromino(instance.m_tetrominoType).blockCoord[instance.m_rot];
+	unsigned int pieceRowBegin = m_height;
+	unsigned int pieceRowEnd = 0;
+	for (unsigned int i = 0; i < Tetromino::kNumBlocks; ++i)
+	{
+		const int x = instance.m_pos.x + (int)blockCoords[i].x;
+		const int y = instance.m_pos.y + (int)blockCoords[i].y;
+		HP_ASSERT(x >= 0 && x < (int)m_width && y >= 0 && y < (int)m_height);
+		SetCell((unsigned int)x, (unsigned int)y, (int)instance.m_tetrominoType);
+		pieceRowBegin = (unsigned int)y < pieceRowBegin ? (unsigned int)y : pieceRowBegin;
+		pieceRowEnd = (unsigned int)y + 1 > pieceRowEnd ? (unsigned int)y + 1 : pieceRowEnd;
+	}
+
+	// top down, so removing a row doesn't move the ones still to check
+	unsigned int numRemoved = 0;
+	for (unsigned int y = pieceRowBegin; y < pieceRowEnd; ++y)
+	{
+		if (GetRow(y).numBlocks == m_width)
+		{
+			RemoveRow(y);
+			++numRemoved;
+		}
+	}
+	return numRemoved;
+}
+
+void SparseField::Draw(Renderer& renderer, int x, int y, unsigned int blockSizePixels, unsigned int blockAtlas, const RenderRect& view) const
+{
+	const int viewBeginX = view.x > 0 ? view.x : 0;
+	const int viewBeginY = view.y > 0 ? view.y : 0;
+	const int viewEndX = view.x + view.w < (int)m_width ? view.x + view.w : (int)m_width;
+	const int viewEndY = view.y + view.h < (int)m_height ? view.y + view.h : (int)m_height;
+	if (viewBeginX >= viewEndX || viewBeginY >= viewEndY)
+		return;
+
+	uint32_t rgbas[kNumBlockSprites];
+	GetBlockRgbas(rgbas);
+	const int blockSize = (int)blockSizePixels;
+	// one background fill, even with sprites, as the view can be millions of cells
+	renderer.BatchSolidRect(x + (viewBeginX - view.x) * blockSize, y + (viewBeginY - view.y) * blockSize,
+		(viewEndX - viewBeginX) * blockSize, (viewEndY - viewBeginY) * blockSize, rgbas[kBlockSprite_Empty]);
+
+	const unsigned int chunkColumnBegin = (unsigned int)viewBeginX / kChunkWidth;
+	const unsigned int chunkColumnEnd = ((unsigned int)viewEndX + kChunkWidth - 1) / kChunkWidth;
+	for (int iy = viewBeginY; iy < viewEndY; ++iy)
+	{
+		const Row& row = GetRow((unsigned int)iy);
+		if (row.numBlocks == 0)
+			continue;
+
+		const int blockY = y + (iy - view.y) * blockSize;
+		for (unsigned int chunkColumn = chunkColumnBegin; chunkColumn < chunkColumnEnd; ++chunkColumn)
+		{
+			const Chunk* chunk = row.chunks[chunkColumn];
+			if (!chunk)
+				continue;
+
+			const int chunkX = (int)(chunkColumn * kChunkWidth);
+			const int cellBegin = viewBeginX > chunkX ? viewBeginX - chunkX : 0;
+			const int cellEnd = viewEndX - chunkX < (int)kChunkWidth ? viewEndX - chunkX : (int)kChunkWidth;
+			for (int cell = cellBegin; cell < cellEnd; ++cell)
+			{
+				const uint8_t code = chunk->cells[cell];
+				if (code == 0)
+					continue;
+				const int blockX = x + (chunkX + cell - view.x) * blockSize;
+				if (blockAtlas != 0)
+					renderer.BatchSprite(blockAtlas, code - 1u, blockX, blockY);
+				else
+					renderer.BatchSolidRect(blockX, blockY, blockSize, blockSize, rgbas[code - 1]);
+			}
+		}
+	}
+	renderer.FlushBatch();
+}
+
+void SparseField::CopyToField(int x, int y, Field& field) const
+{
+	for (unsigned int i = 0; i < field.width * field.height; ++i)
+	{
+		field.staticBlocks[i] = -1;
+	}
+
+	for (unsigned int fieldY = 0; fieldY < field.height; ++fieldY)
+	{
+		const int iy = y + (int)fieldY;
+		if (iy < 0 || iy >= (int)m_height || GetRow((unsigned int)iy).numBlocks == 0)
+			continue;
+		for (unsigned int fieldX = 0; fieldX < field.width; ++fieldX)
+		{
+			const int ix = x + (int)fieldX;
+			if (ix >= 0 && ix < (int)m_width)
+				field.staticBlocks[fieldY * field.width + fieldX] = GetCell((unsigned int)ix, (unsigned int)iy);
+		}
+	}
+}
+
+void SparseField::ClearDirty()
+{
+	for (size_t i = 0; i < m_dirtyChunkPointers.size(); ++i)
+	{
+		m_dirtyChunkPointers[i]->dirty = false;
+	}
+	m_dirtyChunks.clear();
+	m_dirtyChunkPointers.clear();
+	m_dirtyRowEnd = 0;
+}
+
+SparseFieldStats SparseField::GetStats() const
+{
+	SparseFieldStats stats;
+	stats.numAllocatedRows = m_numAllocatedRows;
+	stats.numChunks = m_numChunks;
+	stats.numFreeChunks = m_numFreeChunks;
+	stats.memoryBytes = m_rows.capacity() * sizeof(Row) + m_rowOrder.capacity() * sizeof(uint32_t)
+		+ (size_t)m_numAllocatedRows * m_numChunkColumns * sizeof(Chunk*)
+		+ m_chunkBlocks.size() * kChunksPerBlock * sizeof(Chunk);
+	return stats;
+}
+
+SparseField::Chunk* SparseField::AllocateChunk()
+{
+	if (!m_freeChunks)
+	{
+		Chunk* block = new Chunk[kChunksPerBlock];
+		m_chunkBlocks.push_back(block);
+		for (unsigned int i = 0; i < kChunksPerBlock; ++i)
+		{
+			block[i].nextFree = m_freeChunks;
+			m_freeChunks = &block[i];
+		}
+		m_numChunks += kChunksPerBlock;
+		m_numFreeChunks += kChunksPerBlock;
+	}
+
+	Chunk* chunk = m_freeChunks;
+	m_freeChunks = chunk->nextFree;
+	--m_numFreeChunks;
+	memset(chunk->cells, 0, sizeof(chunk->cells));
+	chunk->numBlocks = 0;
+	chunk->dirty = false;
+	chunk->nextFree = nullptr;
+	return chunk;
+}
+
+void SparseField::FreeChunk(Chunk* chunk)
+{
+	chunk->nextFree = m_freeChunks;
+	m_freeChunks = chunk;
+	++m_numFreeChunks;
+}
+
+void SparseField::RemoveRow(unsigned int y)
+{
+	// A full row has a chunk in every column. The chunk table goes too, or on
+	// a very wide board every row ever cleared would keep one.
+	const uint32_t removed = m_rowOrder[y];
+	Row& row = m_rows[removed];
+	for (unsigned int chunkColumn = 0; chunkColumn < m_numChunkColumns; ++chunkColumn)
+	{
+		FreeChunk(row.chunks[chunkColumn]);
+	}
+	delete[] row.chunks;
+	row.chunks = nullptr;
+	row.numBlocks = 0;
+	--m_numAllocatedRows;
+
+	// the rows above move down one and the emptied row goes back in at the top
+	memmove(&m_rowOrder[1], &m_rowOrder[0], y * sizeof(uint32_t));
+	m_rowOrder[0] = removed;
+	// the first row with blocks moved down with the rest, if it was above
+	if (m_blockRowBound <= y)
+		++m_blockRowBound;
+	if (y + 1 > m_dirtyRowEnd)
+		m_dirtyRowEnd = y + 1;
+}
+
+void SparseField::MarkChunkDirty(Chunk& chunk, unsigned int y, unsigned int chunkColumn)
+{
+	if (chunk.dirty)
+		return;
+	chunk.dirty = true;
+	SparseFieldChunkCoord coord;
+	coord.row = y;
+	coord.chunkColumn = chunkColumn;
+	m_dirtyChunks.push_back(coord);
+	m_dirtyChunkPointers.push_back(&chunk);
+}
@@ -0,0 +1,138 @@
+#pragma once
+#ifndef SPARSE_FIELD_H_INCLUDED
+#define SPARSE_FIELD_H_INCLUDED
+
+#include "Game.h"
+#include <stddef.h>
+#include <stdint.h>
+#include <vector>
+
+class Renderer;
+
+struct SparseFieldChunkCoord
+{
+	unsigned int row;
+	unsigned int chunkColumn;
+};
+
+struct SparseFieldStats
+{
+	unsigned int numAllocatedRows;
+	unsigned int numChunks;
+	unsigned int numFreeChunks;
+	size_t memoryBytes;
+};
+
+// A field for sandbox boards far too big for Field's int per cell. Each row
+// is split into chunks of kChunkWidth cells, and a row only has a chunk table
+// once it has a block, and a chunk only exists while it has blocks, so memory
+// follows the blocks rather than the board size.
+//
+// Rows are reached through a list of row indices, so clearing a line moves
+// indices rather than cells. Every row and chunk counts its blocks, which is
+// how full rows are found and empty ones skipped, so a lock costs about the
+// same on a 10 wide board as on a 100000 wide one. The chunks written and the
+// rows moved since the last ClearDirty are kept, for anything that caches
+// what it drew.
+class SparseField
+{
+public:
+	static const unsigned int kChunkWidth = 64;
+
+	SparseField();
+	~SparseField();
+
+	// Empty, only the row list is allocated. Returns false if the size is 0 or
+	// too big for the int2 positions pieces use.
+	bool Init(unsigned int width, unsigned int height);
+	void Shutdown();
+
+	unsigned int GetWidth() const { return m_width; }
+	unsigned int GetHeight() const { return m_height; }
+	unsigned int GetNumChunkColumns() const { return m_numChunkColumns; }
+
+	// -1 for empty, or a BlockSprite, like Field::staticBlocks
+	int GetCell(unsigned int x, unsigned int y) const;
+	void SetCell(unsigned int x, unsigned int y, int block);
+	unsigned int GetNumBlocksInRow(unsigned int y) const;
+
+	// true if any block is outside the field or on a block
+	bool Overlaps(const TetrominoInstance& instance) const;
+	// how far the piece can fall, it must not overlap to begin with
+	unsigned int GetDropDistance(const TetrominoInstance& instance) const;
+	// Locks the piece in and removes the rows it filled, with the rows above
+	// moving down. Returns how many rows were removed.
+	unsigned int AddTetromino(const TetrominoInstance& instance);
+
+	// Batches every block in the cell rectangle view, a cell at a time, with
+	// the rectangle's top left at (x, y). Rows and chunks with no blocks are
+	// skipped without looking at their cells. Blocks are sprites from
+	// blockAtlas if it is non zero, otherwise flat colours.
+	void Draw(Renderer& renderer, int x, int y, unsigned int blockSizePixels, unsigned int blockAtlas, const RenderRect& view) const;
+	// Copies the rectangle with its top left at (x, y) into field, cells
+	// outside this field come out empty. For code that works on a Field.
+	void CopyToField(int x, int y, Field& field) const;
+
+	// Chunks written since ClearDirty, by where they were when written, and
+	// the rows [0, GetDirtyRowEnd()) which may all have moved. A chunk may be
+	// listed once after it was emptied and freed.
+	const std::vector<SparseFieldChunkCoord>& GetDirtyChunks() const { return m_dirtyChunks; }
+	unsigned int GetDirtyRowEnd() const { return m_dirtyRowEnd; }
+	void ClearDirty();
+
+	SparseFieldStats GetStats() const;
+
+private:
+	SparseField(const SparseField&);
+	SparseField& operator=(const SparseField&);
+
+	struct Chunk
+	{
+		// 0 for empty, otherwise the BlockSprite plus one
+		uint8_t cells[kChunkWidth];
+		unsigned int numBlocks;
+		// this chunk is already in m_dirtyChunks
+		bool dirty;
+		Chunk* nextFree;
+	};
+
+	struct Row
+	{
+		// numChunkColumns entries once the row has had a block
+		Chunk** chunks;
+		unsigned int numBlocks;
+	};
+
+	Row& GetRow(unsigned int y) { return m_rows[m_rowOrder[y]]; }
+	const Row& GetRow(unsigned int y) const { return m_rows[m_rowOrder[y]]; }
+	Chunk* AllocateChunk();
+	void FreeChunk(Chunk* chunk);
+	void RemoveRow(unsigned int y);
+	void MarkChunkDirty(Chunk& chunk, unsigned int y, unsigned int chunkColumn);
+
+	unsigned int m_width;
+	unsigned int m_height;
+	unsigned int m_numChunkColumns;
+
+	std::vector<Row> m_rows;
+	// the index in m_rows of each row from the top
+	std::vector<uint32_t> m_rowOrder;
+
+	// emptied chunks are kept for reuse rather than freed, chunks are
+	// allocated in blocks of kChunksPerBlock
+	static const unsigned int kChunksPerBlock = 256;
+	std::vector<Chunk*> m_chunkBlocks;
+	Chunk* m_freeChunks;
+	unsigned int m_numChunks;
+	unsigned int m_numFreeChunks;
+	unsigned int m_numAllocatedRows;
+	// no row above this has blocks, so drops can skip straight to it
+	unsigned int m_blockRowBound;
+
+	std::vector<SparseFieldChunkCoord> m_dirtyChunks;
+	// the same chunks, to clear their dirty flags after rows have moved
+	std::vector<Chunk*> m_dirtyChunkPointers;
+	unsigned int m_dirtyRowEnd;
+};
+
+#endif // SPARSE_FIELD_H_INCLUDED
@@ -0,0 +1,227 @@
+#include "Spectator.h"
+#include "Debugger.h"
+#include "Game.h"
+#include "GameBot.h"
+#include "Render.h"
+#include <stdio.h>
+
+static const float s_fpsSamplePeriodSeconds = 0.25f;
+static const unsigned int s_kHudHeightPixels = 32;
+static const unsigned int s_kBoardGapPixels = 2;
+// below this the bevels are lost, so flat rects look the same and cost less
+static const unsigned int s_kMinAtlasBlockSizePixels = 6;
+// bots move at a speed that is still watchable
+static const unsigned int s_kBotFramesPerAction = 4;
+
+//================================================================================
+
+SpectatorGrid::SpectatorGrid()
+	: m_blockSizePixels(0)
+	, m_boardWidthPixels(0)
+	, m_boardHeightPixels(0)
+	, m_renderResourcesCreated(false)
+	, m_blockAtlas(0)
+	, m_renderTargetGeneration(0)
+	, m_fpsSampleSeconds(0.0f)
+	, m_fpsSampleFrames(0)
+	, m_boardsRedrawn(0)
+	, m_fpsText("FPS: %.1f", 0x8080ffff)
+	, m_boardsText("Boards: %u", 0xffffffff)
+	, m_redrawnText("Redrawn per frame: %.1f", 0xffffffff)
+{
+}
+
+SpectatorGrid::~SpectatorGrid()
+{
+	HP_ASSERT(m_boards.empty());
+}
+
+bool SpectatorGrid::Init(unsigned int numBoards, unsigned int width, unsigned int height)
+{
+	if (numBoards == 0 || height <= s_kHudHeightPixels)
+	{
+		fprintf(stderr, "ERROR - Can't fit %u boards in %ux%u\n", numBoards, width, height);
+		return false;
+	}
+
+	// try every column count and keep the one giving the biggest blocks
+	const unsigned int gridHeight = height - s_kHudHeightPixels;
+	unsigned int numColumns = 1;
+	unsigned int blockSizePixels = 0;
+	for (unsigned int columns = 1; columns <= numBoards; ++columns)
+	{
+		const unsigned int rows = (numBoards + columns - 1) / columns;
+		const unsigned int cellWidth = width / columns;
+		const unsigned int cellHeight = gridHeight / rows;
+		if (cellWidth <= s_kBoardGapPixels)
+			break;
+		if (cellHeight <= s_kBoardGapPixels)
+			continue;
+
+		const unsigned int blockWidth = (cellWidth - s_kBoardGapPixels) / Game::kFieldWidth;
+		const unsigned int blockHeight = (cellHeight - s_kBoardGapPixels) / Game::kFieldHeight;
+		const unsigned int blockSize = blockWidth < blockHeight ? blockWidth : blockHeight;
+		if (blockSize > blockSizePixels)
+		{
+			blockSizePixels = blockSize;
+			numColumns = columns;
+		}
+	}
+
+	if (blockSizePixels == 0)
+	{
+		fprintf(stderr, "ERROR - Can't fit %u boards in %ux%u\n", numBoards, width, height);
+		return false;
+	}
+
+	m_blockSizePixels = blockSizePixels;
+	m_boardWidthPixels = Game::kFieldWidth * blockSizePixels;
+	m_boardHeightPixels = Game::kFieldHeight * blockSizePixels;
+
+	const unsigned int numRows = (numBoards + numColumns - 1) / numColumns;
+	const unsigned int cellWidth = m_boardWidthPixels + s_kBoardGapPixels;
+	const unsigned int cellHeight = m_boardHeightPixels + s_kBoardGapPixels;
+	const int gridOffsetX = (int)(width - numColumns * cellWidth) / 2;
+	const int gridOffsetY = (int)(s_kHudHeightPixels + (gridHeight - numRows * cellHeight) / 2);
+
+	m_boards.resize(numBoards);
+	for (unsigned int i = 0; i < numBoards; ++i)
+	{
+		Board& board = m_boards[i];
+		board.game = new Game();
+		board.bot = new GameBot(s_kBotFramesPerAction);
+		board.x = gridOffsetX + (int)((i % numColumns) * cellWidth);
+		board.y = gridOffsetY + (int)((i / numColumns) * cellHeight);
+		board.target = 0;
+		board.drawnStateVersion = 0;
+		board.drawn = false;
+
+		if (!board.game->Init())
+		{
+			fprintf(stderr, "ERROR - Spectator game %u failed to initialise\n", i);
+			return false;
+		}
+	}
+
+	m_boardsText.SetValue(numBoards);
+	printf("Spectating %u boards, %u columns, %u pixel blocks\n", numBoards, numColumns, blockSizePixels);
+	return true;
+}
+
+void SpectatorGrid::Shutdown()
+{
+	for (size_t i = 0; i < m_boards.size(); ++i)
+	{
+		if (m_boards[i].game)
+		{
+			m_boards[i].game->Shutdown();
+		}
+		delete m_boards[i].game;
+		delete m_boards[i].bot;
+	}
+	m_boards.clear();
+}
+
+void SpectatorGrid::Update(float deltaTimeSeconds)
+{
+	HP_PROFILE_SCOPE("SpectatorGrid::Update");
+
+	for (size_t i = 0; i < m_boards.size(); ++i)
+	{
+		Board& board = m_boards[i];
+		const GameInput input = board.bot->Think(*board.game);
+		board.game->Update(input, deltaTimeSeconds);
+	}
+
+	m_fpsSampleSeconds += deltaTimeSeconds;
+}
+
+void SpectatorGrid::Draw(Renderer& renderer)
+{
+	HP_PROFILE_SCOPE("SpectatorGrid::Draw");
+
+	if (!m_renderResourcesCreated)
+	{
+		CreateRenderResources(renderer);
+	}
+	else if (m_renderTargetGeneration != renderer.GetRenderTargetGeneration())
+	{
+		m_renderTargetGeneration = renderer.GetRenderTargetGeneration();
+		for (size_t i = 0; i < m_boards.size(); ++i)
+		{
+			m_boards[i].drawn = false;
+		}
+	}
+
+	// redraw the boards that changed first, so the render target is switched
+	// once per changed board and the composite below is all texture copies
+	for (size_t i = 0; i < m_boards.size(); ++i)
+	{
+		Board& board = m_boards[i];
+		if (board.target == 0)
+			continue;
+
+		const unsigned int stateVersion = board.game->GetStateVersion();
+		if (board.drawn && board.drawnStateVersion == stateVersion)
+			continue;
+
+		renderer.SetRenderTarget(board.target);
+		board.game->DrawBoard(renderer, 0, 0, m_blockSizePixels, m_blockAtlas);
+		renderer.SetRenderTarget(0);
+		board.drawnStateVersion = stateVersion;
+		board.drawn = true;
+		++m_boardsRedrawn;
+	}
+
+	for (size_t i = 0; i < m_boards.size(); ++i)
+	{
+		const Board& board = m_boards[i];
+		if (board.target != 0)
+		{
+			renderer.DrawTexture(board.target, board.x, board.y);
+		}
+		else
+		{
+			// no render target support, draw the board every frame
+			board.game->DrawBoard(renderer, board.x, board.y, m_blockSizePixels, m_blockAtlas);
+			++m_boardsRedrawn;
+		}
+	}
+
+	// averaged over a short period so the text isn't rasterized every frame
+	++m_fpsSampleFrames;
+	if (m_fpsSampleSeconds >= s_fpsSamplePeriodSeconds)
+	{
+		m_fpsText.SetValue((float)m_fpsSampleFrames / m_fpsSampleSeconds);
+		m_redrawnText.SetValue((float)m_boardsRedrawn / (float)m_fpsSampleFrames);
+		m_fpsSampleSeconds = 0.0f;
+		m_fpsSampleFrames = 0;
+		m_boardsRedrawn = 0;
+	}
+	m_fpsText.Draw(renderer, 0, 0);
+	m_boardsText.Draw(renderer, 240, 0);
+	m_redrawnText.Draw(renderer, 480, 0);
+}
+
+void SpectatorGrid::CreateRenderResources(Renderer& renderer)
+{
+	if (m_blockSizePixels >= s_kMinAtlasBlockSizePixels)
+	{
+		uint32_t blockRgbas[kNumBlockSprites];
+		GetBlockRgbas(blockRgbas);
+		m_blockAtlas = renderer.CreateBlockAtlas(blockRgbas, kNumBlockSprites, m_blockSizePixels);
+	}
+
+	unsigned int numUncached = 0;
+	for (size_t i = 0; i < m_boards.size(); ++i)
+	{
+		m_boards[i].target = renderer.CreateRenderTarget(m_boardWidthPixels, m_boardHeightPixels);
+		m_boards[i].drawn = false;
+		numUncached += m_boards[i].target == 0;
+	}
+	if (numUncached > 0)
+		printf("No render targets for %u of %zu boards, they are drawn every frame\n", numUncached, m_boards.size());
+	m_renderTargetGeneration = renderer.GetRenderTargetGeneration();
+
+	m_renderResourcesCreated = true;
+}
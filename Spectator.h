@@ -0,0 +1,62 @@
+#pragma once
+#ifndef SPECTATOR_H_INCLUDED
+#define SPECTATOR_H_INCLUDED
+
+#include "Hud.h"
+#include <vector>
+
+class Game;
+class GameBot;
+class Renderer;
+
+// Watches many bot played games at once, laid out in a grid that fills the
+// screen. Each board lives in its own render target which is only redrawn when
+// that game's state changes, so a frame is mostly one texture copy per board.
+// Boards big enough to show bevels use a block atlas baked at the board's block
+// size, smaller ones are drawn as flat batched rects.
+class SpectatorGrid
+{
+public:
+	SpectatorGrid();
+	~SpectatorGrid();
+
+	bool Init(unsigned int numBoards, unsigned int width, unsigned int height);
+	void Shutdown();
+	void Update(float deltaTimeSeconds);
+	void Draw(Renderer& renderer);
+
+	unsigned int GetNumBoards() const { return (unsigned int)m_boards.size(); }
+	const Game& GetGame(unsigned int board) const { return *m_boards[board].game; }
+
+private:
+	struct Board
+	{
+		Game* game;
+		GameBot* bot;
+		int x;
+		int y;
+		TextureHandle target;
+		unsigned int drawnStateVersion;
+		bool drawn;
+	};
+
+	void CreateRenderResources(Renderer& renderer);
+
+	std::vector<Board> m_boards;
+	unsigned int m_blockSizePixels;
+	unsigned int m_boardWidthPixels;
+	unsigned int m_boardHeightPixels;
+
+	bool m_renderResourcesCreated;
+	TextureHandle m_blockAtlas;
+	unsigned int m_renderTargetGeneration;
+
+	float m_fpsSampleSeconds;
+	unsigned int m_fpsSampleFrames;
+	unsigned int m_boardsRedrawn;
+	HudText m_fpsText;
+	HudText m_boardsText;
+	HudText m_redrawnText;
+};
+
+#endif // SPECTATOR_H_INCLUDED
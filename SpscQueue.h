@@ -0,0 +1,62 @@
+#pragma once
+#ifndef SPSC_QUEUE_H_INCLUDED
+#define SPSC_QUEUE_H_INCLUDED
+
+#include <atomic>
+
+// Bounded lock free queue for exactly one producer thread and one consumer
+// thread. kCapacity must be a power of two. Push fails rather than blocks when
+// the queue is full, Pop fails when it is empty.
+template <typename T, unsigned int kCapacity>
+class SpscQueue
+{
+	static_assert(kCapacity > 0 && (kCapacity & (kCapacity - 1)) == 0, "SpscQueue capacity must be a power of two");
+
+public:
+	SpscQueue()
+		: m_head(0)
+		, m_tail(0)
+	{
+	}
+
+	// producer thread only
+	bool Push(const T& value)
+	{
+		const unsigned int tail = m_tail.load(std::memory_order_relaxed);
+		if (tail - m_head.load(std::memory_order_acquire) == kCapacity)
+			return false;
+
+		m_items[tail & (kCapacity - 1)] = value;
+		m_tail.store(tail + 1, std::memory_order_release);
+		return true;
+	}
+
+	// consumer thread only
+	bool Pop(T& value)
+	{
+		const unsigned int head = m_head.load(std::memory_order_relaxed);
+		if (head == m_tail.load(std::memory_order_acquire))
+			return false;
+
+		value = m_items[head & (kCapacity - 1)];
+		m_head.store(head + 1, std::memory_order_release);
+		return true;
+	}
+
+	// approximate when called while the other thread is active
+	bool IsEmpty() const
+	{
+		return m_head.load(std::memory_order_acquire) == m_tail.load(std::memory_order_acquire);
+	}
+
+private:
+	SpscQueue(const SpscQueue&);
+	SpscQueue& operator=(const SpscQueue&);
+
+	// head and tail on separate cache lines so the two threads don't share one
+	alignas(64) std::atomic<unsigned int> m_head;
+	alignas(64) std::atomic<unsigned int> m_tail;
+	alignas(64) T m_items[kCapacity];
+};
+
+#endif // SPSC_QUEUE_H_INCLUDED
@@ -0,0 +1,222 @@
+#include "TetrisEnv.h"
+#include "Game.h"
+#include <stdio.h>
+#include "Debugger.h"
+#include <string.h>
+
+static_assert(sizeof(TetrisEnvObservation) == 84, "TetrisEnvObservation is part of the ABI");
+static_assert(TETRIS_ENV_FIELD_WIDTH == Game::kFieldWidth && TETRIS_ENV_FIELD_HEIGHT == Game::kFieldHeight, "TetrisEnv field size");
+static_assert(Game::kFieldWidth <= 16, "field rows are packed into 16 bits");
+
+// the same fixed step as versus matches
+static const float s_kStepSeconds = 1.0f / 60.0f;
+
+struct TetrisEnv
+{
+	uint32_t numGames;
+	Game* games;
+	// per game
+	uint32_t* numEpisodes;
+	unsigned int* observedVersions;
+	bool* hasObservation;
+
+	TetrisEnvObservation* observations;
+	float* rewards;
+	uint8_t* dones;
+
+	uint32_t seed;
+	bool hasReset;
+	GameInput actionInputs[kNumTetrisEnvActions];
+	GameInput startInput;
+};
+
+//Helper functions
+//================================================================================
+
+static uint32_t MixSeed(uint32_t seed, uint32_t game, uint32_t episode)
+{
+	uint32_t x = seed ^ (game * 0x9e3779b9u) ^ (episode * 0x85ebca6bu);
+	x ^= x >> 16;
+	x *= 0x7feb352du;
+	x ^= x >> 15;
+	x *= 0x846ca68bu;
+	x ^= x >> 16;
+	return x;
+}
+
+static void StartEpisode(TetrisEnv& env, uint32_t index)
+{
+	Game& game = env.games[index];
+	game.Reset();
+	game.SetSeed(MixSeed(env.seed, index, env.numEpisodes[index]++));
+	game.Update(env.startInput, s_kStepSeconds);
+	HP_ASSERT(game.IsPlaying());
+}
+
+static void WriteObservation(const Game& game, TetrisEnvObservation& observation)
+{
+	const Field& field = game.GetField();
+	const int* blocks = field.staticBlocks;
+	for (unsigned int y = 0; y < Game::kFieldHeight; ++y)
+	{
+		uint16_t row = 0;
+		for (unsigned int x = 0; x < Game::kFieldWidth; ++x)
+		{
+			row |= (uint16_t)((blocks[x] != -1 ? 1 : 0) << x);
+		}
+		observation.blockRows[y] = row;
+		observation.pieceRows[y] = 0;
+		blocks += Game::kFieldWidth;
+	}
+
+	const TetrominoInstance& piece = game.GetActiveTetromino();
+	const Tetromino::BlockCoords& blockCoords = GetTetromino(piece.m_tetrominoType).blockCoord[piece.m_rot];
+	for (unsigned int i = 0; i < Tetromino::kNumBlocks; ++i)
+	{
+		const int x = piece.m_pos.x + (int)blockCoords[i].x;
+		const int y = piece.m_pos.y + (int)blockCoords[i].y;
+		if (x >= 0 && x < (int)Game::kFieldWidth && y >= 0 && y < (int)Game::kFieldHeight)
+			observation.pieceRows[y] |= (uint16_t)(1 << x);
+	}
+	observation.pieceType = (uint8_t)piece.m_tetrominoType;
+	observation.pieceRotation = (uint8_t)piece.m_rot;
+	observation.pieceX = (int8_t)piece.m_pos.x;
+	observation.pieceY = (int8_t)piece.m_pos.y;
+}
+
+// only games that changed since their observation was written are packed again
+static void WriteObservations(TetrisEnv& env)
+{
+	for (uint32_t i = 0; i < env.numGames; ++i)
+	{
+		const unsigned int version = env.games[i].GetStateVersion();
+		if (env.hasObservation[i] && env.observedVersions[i] == version)
+			continue;
+		WriteObservation(env.games[i], env.observations[i]);
+		env.observedVersions[i] = version;
+		env.hasObservation[i] = true;
+	}
+}
+
+//================================================================================
+
+uint32_t TetrisEnv_GetAbiVersion(void)
+{
+	return TETRIS_ENV_ABI_VERSION;
+}
+
+TetrisEnv* TetrisEnv_Create(uint32_t numGames)
+{
+	if (numGames == 0)
+		return nullptr;
+
+	TetrisEnv* env = new TetrisEnv;
+	env->numGames = numGames;
+	env->games = new Game[numGames];
+	env->numEpisodes = new uint32_t[numGames];
+	env->observedVersions = new unsigned int[numGames];
+	env->hasObservation = new bool[numGames];
+	for (uint32_t i = 0; i < numGames; ++i)
+	{
+		env->games[i].Init();
+		env->numEpisodes[i] = 0;
+		env->observedVersions[i] = 0;
+		env->hasObservation[i] = false;
+	}
+	env->observations = nullptr;
+	env->rewards = nullptr;
+	env->dones = nullptr;
+	env->seed = 0;
+	env->hasReset = false;
+
+	memset(env->actionInputs, 0, sizeof(env->actionInputs));
+	env->actionInputs[kTetrisEnvAction_MoveLeft].moveLeft = true;
+	env->actionInputs[kTetrisEnvAction_MoveRight].moveRight = true;
+	env->actionInputs[kTetrisEnvAction_RotClockwise].rotClockwise = true;
+	env->actionInputs[kTetrisEnvAction_RotAnticlockwise].rotAnticlockwise = true;
+	env->actionInputs[kTetrisEnvAction_SoftDrop].softDrop = true;
+	env->actionInputs[kTetrisEnvAction_HardDrop].hardDrop = true;
+	memset(&env->startInput, 0, sizeof(env->startInput));
+	env->startInput.start = true;
+	return env;
+}
+
+void TetrisEnv_Destroy(TetrisEnv* env)
+{
+	if (!env)
+		return;
+
+	for (uint32_t i = 0; i < env->numGames; ++i)
+	{
+		env->games[i].Shutdown();
+	}
+	delete[] env->games;
+	delete[] env->numEpisodes;
+	delete[] env->observedVersions;
+	delete[] env->hasObservation;
+	delete env;
+}
+
+uint32_t TetrisEnv_GetNumGames(const TetrisEnv* env)
+{
+	return env->numGames;
+}
+
+void TetrisEnv_SetBuffers(TetrisEnv* env, TetrisEnvObservation* observations, float* rewards, uint8_t* dones)
+{
+	env->observations = observations;
+	env->rewards = rewards;
+	env->dones = dones;
+
+	// new buffers start out with nothing in them
+	for (uint32_t i = 0; i < env->numGames; ++i)
+	{
+		env->hasObservation[i] = false;
+	}
+	if (observations && env->hasReset)
+		WriteObservations(*env);
+}
+
+void TetrisEnv_Reset(TetrisEnv* env, uint32_t seed)
+{
+	env->seed = seed;
+	for (uint32_t i = 0; i < env->numGames; ++i)
+	{
+		env->numEpisodes[i] = 0;
+		StartEpisode(*env, i);
+		if (env->rewards)
+			env->rewards[i] = 0.0f;
+		if (env->dones)
+			env->dones[i] = 0;
+	}
+	env->hasReset = true;
+	if (env->observations)
+		WriteObservations(*env);
+}
+
+int32_t TetrisEnv_Step(TetrisEnv* env, const uint8_t* actions)
+{
+	if (!env->observations || !env->rewards || !env->dones || !env->hasReset)
+		return -1;
+
+	int32_t numEnded = 0;
+	for (uint32_t i = 0; i < env->numGames; ++i)
+	{
+		Game& game = env->games[i];
+		const unsigned int scoreBefore = game.GetScore();
+		const uint8_t action = actions[i] < kNumTetrisEnvActions ? actions[i] : (uint8_t)kTetrisEnvAction_None;
+		game.Update(env->actionInputs[action], s_kStepSeconds);
+		env->rewards[i] = (float)(game.GetScore() - scoreBefore);
+
+		const bool ended = game.IsGameOver();
+		env->dones[i] = ended ? 1 : 0;
+		if (ended)
+		{
+			StartEpisode(*env, i);
+			++numEnded;
+		}
+	}
+
+	WriteObservations(*env);
+	return numEnded;
+}
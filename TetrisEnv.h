@@ -0,0 +1,97 @@
+#pragma once
+#ifndef TETRIS_ENV_H_INCLUDED
+#define TETRIS_ENV_H_INCLUDED
+
+// A batch of games for reinforcement learning, behind a C ABI so trainers can
+// load it from any language. Every Step advances each game by one frame with
+// the normal Game rules, then writes observations, rewards and done flags
+// straight into buffers the caller gave to TetrisEnv_SetBuffers. Those can be
+// plain arrays or live in shared memory another process reads, nothing is
+// copied or allocated per step.
+//
+// A game that ends is reset within the same Step, so its observation is the
+// first frame of the next episode and its done flag is set. Every episode's
+// pieces come from the seed given to TetrisEnv_Reset, the game's index and
+// how many episodes it has played, so a run can be repeated exactly.
+//
+// A TetrisEnv is used from one thread at a time. Split a large batch across
+// several of them to step it on several threads.
+//
+// Build as a shared library from the repository root:
+//   g++ -O2 -std=c++17 -shared -fPIC -fvisibility=hidden -I. TetrisEnv.cpp FieldKernels.cpp Game.cpp Hud.cpp Render.cpp Profiler.cpp -lpthread -o libtetrisenv.so
+
+#include <stdint.h>
+
+#if defined(_WIN32)
+#define TETRIS_ENV_API __declspec(dllexport)
+#else
+#define TETRIS_ENV_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+// changes whenever a function or struct here changes in an incompatible way
+#define TETRIS_ENV_ABI_VERSION 1
+
+#define TETRIS_ENV_FIELD_WIDTH 10
+#define TETRIS_ENV_FIELD_HEIGHT 20
+
+// one input for one frame
+enum TetrisEnvAction
+{
+	kTetrisEnvAction_None = 0,
+	kTetrisEnvAction_MoveLeft,
+	kTetrisEnvAction_MoveRight,
+	kTetrisEnvAction_RotClockwise,
+	kTetrisEnvAction_RotAnticlockwise,
+	kTetrisEnvAction_SoftDrop,
+	kTetrisEnvAction_HardDrop,
+	kNumTetrisEnvActions
+};
+
+// 84 bytes with no padding. Row 0 is the top of the field and bit x of a row
+// is column x, so each plane is a 20 x 10 bitmap.
+typedef struct TetrisEnvObservation
+{
+	// locked blocks, including garbage
+	uint16_t blockRows[TETRIS_ENV_FIELD_HEIGHT];
+	// the falling piece
+	uint16_t pieceRows[TETRIS_ENV_FIELD_HEIGHT];
+	// TetrominoType, I J L O S T Z
+	uint8_t pieceType;
+	uint8_t pieceRotation;
+	// the top left of the piece's 4 x 4 box
+	int8_t pieceX;
+	int8_t pieceY;
+} TetrisEnvObservation;
+
+typedef struct TetrisEnv TetrisEnv;
+
+TETRIS_ENV_API uint32_t TetrisEnv_GetAbiVersion(void);
+
+// numGames games, all at the title screen until TetrisEnv_Reset. Returns null if numGames is 0.
+TETRIS_ENV_API TetrisEnv* TetrisEnv_Create(uint32_t numGames);
+TETRIS_ENV_API void TetrisEnv_Destroy(TetrisEnv* env);
+TETRIS_ENV_API uint32_t TetrisEnv_GetNumGames(const TetrisEnv* env);
+
+// Each buffer holds one entry per game and must stay valid until the buffers
+// are replaced or the env is destroyed. rewards is the score gained on the
+// last step, dones is 1 where the last step ended an episode. An observation
+// is only written again when its game changed, so the caller reads them but
+// doesn't write to them.
+TETRIS_ENV_API void TetrisEnv_SetBuffers(TetrisEnv* env, TetrisEnvObservation* observations, float* rewards, uint8_t* dones);
+
+// starts a new episode in every game and writes the first observations
+TETRIS_ENV_API void TetrisEnv_Reset(TetrisEnv* env, uint32_t seed);
+
+// One frame of every game, actions holds one TetrisEnvAction per game.
+// Returns how many episodes ended, or -1 if the env has no buffers or hasn't been reset.
+TETRIS_ENV_API int32_t TetrisEnv_Step(TetrisEnv* env, const uint8_t* actions);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // TETRIS_ENV_H_INCLUDED
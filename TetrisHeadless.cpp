@@ -0,0 +1,232 @@
+// The game without SDL, a window or a player: replays recorded inputs, plays
+// bot games and runs bot tournaments, drawing every frame through a DrawList
+// onto the null renderer the way App would. Built from the same sources as
+// the SDL game, it is what profile guided builds train on.
+//
+// tetris_headless [--replay path]... [--repeat n] [--bot-games n] [--frames n]
+//                 [--seed n] [--record-inputs path] [--tournament n] [--threads n]
+#include "DrawList.h"
+#include "InputRecording.h"
+#include "NullRenderer.h"
+#include "Profiler.h"
+#include "Tournament.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <thread>
+#include <vector>
+
+static const float s_kStepSeconds = 1.0f / 60.0f;
+static const unsigned int s_kWidth = 1280;
+static const unsigned int s_kHeight = 720;
+
+// A frame's worth of drawing, as App does it.
+struct HeadlessFrame
+{
+	NullRenderer renderer;
+	DrawList drawList;
+	DrawListPlayer drawListPlayer;
+
+	HeadlessFrame()
+		: renderer(s_kWidth, s_kHeight)
+		, drawList(s_kWidth, s_kHeight, renderer.SupportsRenderTargets())
+		, drawListPlayer(renderer)
+	{
+	}
+
+	void Draw(Game& game)
+	{
+		drawList.Reset();
+		drawList.Clear();
+		game.Draw(drawList);
+		drawList.Present();
+		drawListPlayer.Submit(drawList);
+		renderer.Present();
+	}
+};
+
+struct ReplayResult
+{
+	unsigned int score;
+	unsigned int numLinesCleared;
+	bool gameOver;
+	uint32_t fieldChecksum;
+};
+
+//Helper functions
+//================================================================================
+
+static uint32_t GetFieldChecksum(const Game& game)
+{
+	const Field& field = game.GetField();
+	uint32_t checksum = 0;
+	for (unsigned int i = 0; field.staticBlocks && i < field.width * field.height; ++i)
+	{
+		checksum = checksum * 31 + (uint32_t)field.staticBlocks[i];
+	}
+	return checksum;
+}
+
+static ReplayResult PlayRecording(const InputRecording& recording, HeadlessFrame& frame)
+{
+	Game game;
+	game.Init();
+	recording.ApplySettings(game);
+	for (unsigned int i = 0; i < recording.GetNumFrames(); ++i)
+	{
+		game.Update(recording.GetInput(i), s_kStepSeconds);
+		frame.Draw(game);
+	}
+
+	ReplayResult result;
+	result.score = game.GetScore();
+	result.numLinesCleared = game.GetNumLinesCleared();
+	result.gameOver = game.IsGameOver();
+	result.fieldChecksum = GetFieldChecksum(game);
+	game.Shutdown();
+	return result;
+}
+
+// Plays the recording numRepeats times, every time has to come out the same.
+static bool ReplayRecording(const char* path, unsigned int numRepeats, HeadlessFrame& frame)
+{
+	InputRecording recording;
+	if (!recording.Load(path))
+		return false;
+
+	const uint64_t beginNs = Profiler::GetTimeNs();
+	const ReplayResult first = PlayRecording(recording, frame);
+	unsigned int numMismatches = 0;
+	for (unsigned int i = 1; i < numRepeats; ++i)
+	{
+		const ReplayResult result = PlayRecording(recording, frame);
+		numMismatches += result.score != first.score || result.numLinesCleared != first.numLinesCleared
+			|| result.gameOver != first.gameOver || result.fieldChecksum != first.fieldChecksum;
+	}
+	const double seconds = (Profiler::GetTimeNs() - beginNs) * 1e-9;
+
+	printf("%s: %u frames x %u, score %u, lines %u%s, %.0f frames / s\n", path, recording.GetNumFrames(), numRepeats,
+		first.score, first.numLinesCleared, first.gameOver ? ", game over" : "", recording.GetNumFrames() * numRepeats / seconds);
+	if (numMismatches > 0)
+	{
+		printf("ERROR - %u replays of %s ended differently\n", numMismatches, path);
+		return false;
+	}
+	return true;
+}
+
+// Each style in turn plays single player games from consecutive seeds until
+// they top out or run out of frames. The first game's inputs are saved to
+// recordPath if it isn't null.
+static bool PlayBotGames(unsigned int numGames, unsigned int maxFrames, uint32_t seed, const char* recordPath, HeadlessFrame& frame)
+{
+	const uint64_t beginNs = Profiler::GetTimeNs();
+	uint64_t numFrames = 0;
+	for (unsigned int i = 0; i < numGames; ++i)
+	{
+		const GameBotStyle& style = GetGameBotStyle(i % GetNumGameBotStyles());
+		GameBot bot(style);
+		Game game;
+		game.Init();
+		InputRecording recording;
+		recording.Begin(game, seed + i);
+
+		unsigned int frameIndex = 0;
+		for (; frameIndex < maxFrames && !game.IsGameOver(); ++frameIndex)
+		{
+			const GameInput input = bot.Think(game);
+			game.Update(input, s_kStepSeconds);
+			recording.AddFrame(input);
+			frame.Draw(game);
+		}
+		numFrames += frameIndex;
+		printf("Bot game %u, %s: %u frames, score %u, lines %u%s\n", i, style.name, frameIndex, game.GetScore(),
+			game.GetNumLinesCleared(), game.IsGameOver() ? ", game over" : "");
+
+		if (i == 0 && recordPath)
+		{
+			if (!recording.Save(recordPath))
+				return false;
+			printf("Saved %u frames of input to %s\n", recording.GetNumFrames(), recordPath);
+		}
+		game.Shutdown();
+	}
+
+	const double seconds = (Profiler::GetTimeNs() - beginNs) * 1e-9;
+	printf("%u bot games, %llu frames, %.0f frames / s\n", numGames, (unsigned long long)numFrames, numFrames / seconds);
+	return true;
+}
+
+// every style against every other
+static void RunTournament(unsigned int matchesPerPair, uint32_t seed, unsigned int numThreads)
+{
+	std::vector<unsigned int> entrants;
+	for (unsigned int i = 0; i < GetNumGameBotStyles(); ++i)
+	{
+		entrants.push_back(i);
+	}
+
+	Tournament tournament;
+	if (!tournament.Init(entrants, matchesPerPair, seed))
+		return;
+	tournament.Run(numThreads);
+	tournament.PrintResults();
+}
+
+//================================================================================
+
+int main(int argc, char** argv)
+{
+	std::vector<const char*> replayPaths;
+	unsigned int numRepeats = 1;
+	unsigned int numBotGames = 0;
+	unsigned int maxBotFrames = 60 * 60 * 5;
+	uint32_t seed = 1;
+	const char* recordPath = nullptr;
+	unsigned int tournamentMatchesPerPair = 0;
+	unsigned int numThreads = std::thread::hardware_concurrency();
+	for (int i = 1; i + 1 < argc; i += 2)
+	{
+		if (strcmp(argv[i], "--replay") == 0)
+			replayPaths.push_back(argv[i + 1]);
+		else if (strcmp(argv[i], "--repeat") == 0)
+			numRepeats = (unsigned int)atoi(argv[i + 1]);
+		else if (strcmp(argv[i], "--bot-games") == 0)
+			numBotGames = (unsigned int)atoi(argv[i + 1]);
+		else if (strcmp(argv[i], "--frames") == 0)
+			maxBotFrames = (unsigned int)atoi(argv[i + 1]);
+		else if (strcmp(argv[i], "--seed") == 0)
+			seed = (uint32_t)strtoul(argv[i + 1], nullptr, 10);
+		else if (strcmp(argv[i], "--record-inputs") == 0)
+			recordPath = argv[i + 1];
+		else if (strcmp(argv[i], "--tournament") == 0)
+			tournamentMatchesPerPair = (unsigned int)atoi(argv[i + 1]);
+		else if (strcmp(argv[i], "--threads") == 0)
+			numThreads = (unsigned int)atoi(argv[i + 1]);
+		else
+		{
+			argc = 0;
+			break;
+		}
+	}
+	if (argc < 2 || (replayPaths.empty() && numBotGames == 0 && tournamentMatchesPerPair == 0))
+	{
+		fprintf(stderr, "usage: tetris_headless [--replay path]... [--repeat n] [--bot-games n] [--frames n] [--seed n]\n"
+			"                       [--record-inputs path] [--tournament n] [--threads n]\n");
+		return 1;
+	}
+
+	HeadlessFrame frame;
+	bool succeeded = true;
+	for (size_t i = 0; i < replayPaths.size(); ++i)
+	{
+		succeeded &= ReplayRecording(replayPaths[i], numRepeats > 0 ? numRepeats : 1, frame);
+	}
+	if (numBotGames > 0)
+		succeeded &= PlayBotGames(numBotGames, maxBotFrames, seed, recordPath, frame);
+	if (tournamentMatchesPerPair > 0)
+		RunTournament(tournamentMatchesPerPair, seed, numThreads > 0 ? numThreads : 1);
+
+	frame.renderer.PrintStats();
+	return succeeded ? 0 : 1;
+}
@@ -1,14 +1,100 @@
 #include "App.h"
+#include "NetRelay.h"
+#include "Profiler.h"
+#include "Tournament.h"
 #include <SDL.h>
+#include <signal.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <thread>
+#include <vector>
+
+static volatile bool s_stopRelay = false;
+
+static void StopRelay(int)
+{
+	s_stopRelay = true;
+}
+
+// bots is a comma separated list of GameBotStyle names, match -1 plays them all
+static int RunTournament(const char* bots, unsigned int matchesPerPair, uint32_t seed, unsigned int numThreads, int match, const char* csvPath)
+{
+	std::vector<unsigned int> entrants;
+	const char* name = bots;
+	while (*name)
+	{
+		const char* end = strchr(name, ',');
+		const size_t length = end ? (size_t)(end - name) : strlen(name);
+		char styleName[32];
+		snprintf(styleName, sizeof(styleName), "%.*s", (int)length, name);
+		const int style = FindGameBotStyle(styleName);
+		if (style < 0)
+		{
+			printf("ERROR - No bot called %s, the bots are:", styleName);
+			for (unsigned int i = 0; i < GetNumGameBotStyles(); ++i)
+			{
+				printf(" %s", GetGameBotStyle(i).name);
+			}
+			printf("\n");
+			return 1;
+		}
+		entrants.push_back((unsigned int)style);
+		name = end ? end + 1 : name + length;
+	}
+
+	Tournament tournament;
+	if (!tournament.Init(entrants, matchesPerPair, seed))
+		return 1;
+
+	if (match >= 0)
+	{
+		// one match again, for looking into a result
+		if ((unsigned int)match >= tournament.GetNumMatches())
+		{
+			printf("ERROR - There are only %u matches\n", tournament.GetNumMatches());
+			return 1;
+		}
+		TournamentMatchResult result;
+		tournament.RunMatch((unsigned int)match, result);
+		printf("Match %d, seed %u: %s against %s, %s after %u frames\n", match, result.seed,
+			GetGameBotStyle(entrants[result.entrants[0]]).name, GetGameBotStyle(entrants[result.entrants[1]]).name,
+			result.winner < 0 ? "drawn" : (result.winner == 0 ? "first won" : "second won"), result.numFrames);
+		printf("  lines %u / %u, garbage sent %u / %u, score %u / %u\n", result.numLinesCleared[0], result.numLinesCleared[1],
+			result.garbageLinesSent[0], result.garbageLinesSent[1], result.score[0], result.score[1]);
+		return 0;
+	}
+
+	tournament.Run(numThreads);
+	tournament.PrintResults();
+	if (csvPath && !tournament.WriteCsv(csvPath))
+		return 1;
+	return 0;
+}
 
 int main(int argc, char** argv)
 {
 	bool FullScreen = false;
 	unsigned int displayWidth = 1280;
 	unsigned int displayHeight = 720;
+	const char* profileOutputPath = nullptr;
+	const char* recordOutputPath = nullptr;
+	const char* inputRecordingPath = nullptr;
+	unsigned int numSpectatorBoards = 0;
+	const char* versusPeerAddress = nullptr;
+	unsigned int versusPlayer = 0;
+	unsigned int localPort = 0;
+	unsigned int relayPorts[2] = { 0, 0 };
+	NetConditions netConditions = { 0, 0, 0 };
+	unsigned int broadcastPort = 0;
+	const char* scoresPath = "scores.log";
+	unsigned int tournamentMatchesPerPair = 0;
+	const char* tournamentBots = "genetic,stacker,flat,holey,slow";
+	unsigned int tournamentThreads = std::thread::hardware_concurrency();
+	uint32_t tournamentSeed = 1;
+	int tournamentMatch = -1;
+	const char* tournamentCsvPath = nullptr;
+	RendererBackend rendererBackend = kRendererBackend_Sdl;
 	for (int i = 1; i < argc; ++i)
 	{
 		if (strcmp(argv[i], "--fullscreen") == 0)
@@ -25,18 +111,192 @@ int main(int argc, char** argv)
 			SDL_assert(argc > i); // make sure we have another argument
 			displayHeight = (unsigned int)atoi(argv[++i]);
 		}
+		else if (strcmp(argv[i], "--software") == 0)
+		{
+			rendererBackend = kRendererBackend_Software;
+		}
+		else if (strcmp(argv[i], "--verbose") == 0)
+		{
+			// also lists displays, render drivers and GL strings at startup
+			SDL_LogSetAllPriority(SDL_LOG_PRIORITY_VERBOSE);
+		}
+		else if (strcmp(argv[i], "--headless") == 0)
+		{
+			rendererBackend = kRendererBackend_Null;
+		}
+		else if (strcmp(argv[i], "--record") == 0)
+		{
+			SDL_assert(argc > i + 1); // make sure we have another argument
+			recordOutputPath = argv[++i];
+		}
+		else if (strcmp(argv[i], "--record-inputs") == 0)
+		{
+			SDL_assert(argc > i + 1); // make sure we have another argument
+			inputRecordingPath = argv[++i];
+		}
+		else if (strcmp(argv[i], "--spectate") == 0)
+		{
+			SDL_assert(argc > i + 1); // make sure we have another argument
+			numSpectatorBoards = (unsigned int)atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--versus") == 0)
+		{
+			SDL_assert(argc > i + 1); // make sure we have another argument
+			versusPeerAddress = argv[++i];
+		}
+		else if (strcmp(argv[i], "--player") == 0)
+		{
+			SDL_assert(argc > i + 1); // make sure we have another argument
+			versusPlayer = (unsigned int)atoi(argv[++i]) != 0 ? 1 : 0;
+		}
+		else if (strcmp(argv[i], "--port") == 0)
+		{
+			SDL_assert(argc > i + 1); // make sure we have another argument
+			localPort = (unsigned int)atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--relay") == 0)
+		{
+			SDL_assert(argc > i + 2); // make sure we have two more arguments
+			relayPorts[0] = (unsigned int)atoi(argv[++i]);
+			relayPorts[1] = (unsigned int)atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--latency") == 0)
+		{
+			SDL_assert(argc > i + 1); // make sure we have another argument
+			netConditions.latencyMs = (unsigned int)atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--jitter") == 0)
+		{
+			SDL_assert(argc > i + 1); // make sure we have another argument
+			netConditions.jitterMs = (unsigned int)atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--loss") == 0)
+		{
+			SDL_assert(argc > i + 1); // make sure we have another argument
+			netConditions.lossPercent = (unsigned int)atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--broadcast") == 0)
+		{
+			SDL_assert(argc > i + 1); // make sure we have another argument
+			broadcastPort = (unsigned int)atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--scores") == 0)
+		{
+			SDL_assert(argc > i + 1); // make sure we have another argument
+			scoresPath = argv[++i];
+		}
+		else if (strcmp(argv[i], "--no-scores") == 0)
+		{
+			scoresPath = nullptr;
+		}
+		else if (strcmp(argv[i], "--tournament") == 0)
+		{
+			SDL_assert(argc > i + 1); // make sure we have another argument
+			tournamentMatchesPerPair = (unsigned int)atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--bots") == 0)
+		{
+			SDL_assert(argc > i + 1); // make sure we have another argument
+			tournamentBots = argv[++i];
+		}
+		else if (strcmp(argv[i], "--threads") == 0)
+		{
+			SDL_assert(argc > i + 1); // make sure we have another argument
+			tournamentThreads = (unsigned int)atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--seed") == 0)
+		{
+			SDL_assert(argc > i + 1); // make sure we have another argument
+			tournamentSeed = (uint32_t)strtoul(argv[++i], nullptr, 10);
+		}
+		else if (strcmp(argv[i], "--match") == 0)
+		{
+			SDL_assert(argc > i + 1); // make sure we have another argument
+			tournamentMatch = atoi(argv[++i]);
+		}
+		else if (strcmp(argv[i], "--csv") == 0)
+		{
+			SDL_assert(argc > i + 1); // make sure we have another argument
+			tournamentCsvPath = argv[++i];
+		}
+		else if (strcmp(argv[i], "--profile") == 0)
+		{
+			SDL_assert(argc > i + 1); // make sure we have another argument
+			profileOutputPath = argv[++i];
+		}
+	}
+
+	// the relay is a tool for testing versus mode and runs without the game
+	if (relayPorts[0] != 0 && relayPorts[1] != 0)
+	{
+		NetRelay relay;
+		if (!relay.Open((uint16_t)relayPorts[0], (uint16_t)relayPorts[1], netConditions))
+			return 1;
+
+		signal(SIGINT, StopRelay);
+		relay.Run(s_stopRelay);
+		printf("Forwarded %u packets, dropped %u\n", relay.GetPacketsForwarded(), relay.GetPacketsDropped());
+		relay.Close();
+		return 0;
+	}
+
+	// bot tournaments are headless too
+	if (tournamentMatchesPerPair > 0)
+		return RunTournament(tournamentBots, tournamentMatchesPerPair, tournamentSeed, tournamentThreads, tournamentMatch, tournamentCsvPath);
+
+	if (profileOutputPath)
+	{
+		Profiler::SetThreadName("Main");
+		Profiler::SetEnabled(true);
 	}
 
 	App app;
-	if (!app.Init(FullScreen, displayWidth, displayHeight))
+	if (!app.Init(FullScreen, displayWidth, displayHeight, rendererBackend))
 	{
 		printf("ERROR - App failed to initialise\n");
 		app.ShutDown();
 		return 1;
 	}
 
+	if (recordOutputPath && !app.StartRecording(recordOutputPath))
+	{
+		printf("ERROR - Failed to start recording\n");
+	}
+
+	if (numSpectatorBoards > 0 && !app.StartSpectating(numSpectatorBoards))
+	{
+		printf("ERROR - Failed to start spectating\n");
+	}
+
+	if (versusPeerAddress && !app.StartVersus(versusPlayer, (uint16_t)localPort, versusPeerAddress))
+	{
+		printf("ERROR - Failed to start versus mode\n");
+	}
+
+	// only the player's own games are kept
+	if (scoresPath && numSpectatorBoards == 0 && !versusPeerAddress && !app.StartLeaderboard(scoresPath))
+	{
+		printf("ERROR - Failed to open the score log\n");
+	}
+
+	// only single player games can be replayed from their inputs
+	if (inputRecordingPath && numSpectatorBoards == 0 && !versusPeerAddress && !app.StartInputRecording(inputRecordingPath))
+	{
+		printf("ERROR - Failed to start recording inputs\n");
+	}
+
+	if (broadcastPort != 0 && !app.StartBroadcast((uint16_t)broadcastPort))
+	{
+		printf("ERROR - Failed to start broadcasting\n");
+	}
+
 	app.Run();
 	app.ShutDown();
 
+	if (profileOutputPath)
+	{
+		Profiler::WriteChromeTrace(profileOutputPath);
+	}
+
 	return 0;
 }
@@ -0,0 +1,376 @@
+#include "Tournament.h"
+#include "Profiler.h"
+#include "Versus.h"
+#include <stdio.h>
+#include "Debugger.h"
+#include <chrono>
+#include <math.h>
+#include <string.h>
+#include <thread>
+
+// rating fit iterations, it settles well before this
+static const unsigned int s_kMaxRatingIterations = 1000;
+
+//Helper functions
+//================================================================================
+
+// spreads nearby values out so neighbouring deals have unrelated pieces
+static uint32_t MixSeed(uint32_t seed, uint32_t value)
+{
+	uint32_t x = seed ^ (value * 0x9e3779b9u);
+	x ^= x >> 16;
+	x *= 0x7feb352du;
+	x ^= x >> 15;
+	x *= 0x846ca68bu;
+	x ^= x >> 16;
+	return x;
+}
+
+// per minute of play at 60 frames a second
+static double PerMinute(uint64_t count, uint64_t numFrames)
+{
+	return numFrames ? count * 3600.0 / numFrames : 0.0;
+}
+
+//================================================================================
+
+Tournament::Tournament()
+	: m_numPairs(0)
+	, m_matchesPerPair(0)
+	, m_seed(0)
+	, m_nextMatch(0)
+	, m_numFinished(0)
+	, m_runSeconds(0.0)
+{
+}
+
+bool Tournament::Init(const std::vector<unsigned int>& entrants, unsigned int matchesPerPair, uint32_t seed)
+{
+	if (entrants.size() < 2 || matchesPerPair == 0)
+	{
+		fprintf(stderr, "A tournament needs at least two bots and one match per pair\n");
+		return false;
+	}
+	for (size_t i = 0; i < entrants.size(); ++i)
+	{
+		if (entrants[i] >= GetNumGameBotStyles())
+		{
+			fprintf(stderr, "No bot style %u\n", entrants[i]);
+			return false;
+		}
+		for (size_t j = 0; j < i; ++j)
+		{
+			if (entrants[j] == entrants[i])
+			{
+				fprintf(stderr, "Bot %s is entered twice\n", GetGameBotStyle(entrants[i]).name);
+				return false;
+			}
+		}
+	}
+
+	m_entrants = entrants;
+	m_numPairs = (unsigned int)(entrants.size() * (entrants.size() - 1) / 2);
+	m_matchesPerPair = matchesPerPair;
+	m_seed = seed;
+	m_results.clear();
+	return true;
+}
+
+void Tournament::GetMatch(unsigned int index, unsigned int entrants[2], uint32_t& seed) const
+{
+	HP_ASSERT(index < GetNumMatches());
+	unsigned int pair = index / m_matchesPerPair;
+	const unsigned int game = index % m_matchesPerPair;
+
+	// pairs in order 0-1, 0-2, ... 1-2, ...
+	const unsigned int numEntrants = (unsigned int)m_entrants.size();
+	unsigned int first = 0;
+	while (pair >= numEntrants - 1 - first)
+	{
+		pair -= numEntrants - 1 - first;
+		++first;
+	}
+	const unsigned int second = first + 1 + pair;
+
+	// each deal is played once from each side
+	const bool swapSides = (game & 1) != 0;
+	entrants[0] = swapSides ? second : first;
+	entrants[1] = swapSides ? first : second;
+	seed = MixSeed(m_seed, game / 2);
+}
+
+void Tournament::Run(unsigned int numThreads)
+{
+	if (numThreads == 0)
+		numThreads = 1;
+	const unsigned int numMatches = GetNumMatches();
+	m_results.assign(numMatches, TournamentMatchResult());
+	m_nextMatch = 0;
+	m_numFinished = 0;
+
+	printf("Playing %u matches on %u threads\n", numMatches, numThreads);
+	const uint64_t beginNs = Profiler::GetTimeNs();
+	std::vector<std::thread> threads;
+	for (unsigned int i = 0; i < numThreads; ++i)
+	{
+		threads.push_back(std::thread(&Tournament::WorkerThread, this));
+	}
+
+	// a line every tenth of the way, so long runs show they're moving
+	const unsigned int reportStep = numMatches / 10 > 0 ? numMatches / 10 : 1;
+	unsigned int nextReport = reportStep;
+	unsigned int numFinished = 0;
+	while (numFinished < numMatches)
+	{
+		std::this_thread::sleep_for(std::chrono::milliseconds(10));
+		numFinished = m_numFinished.load(std::memory_order_acquire);
+		if (numFinished >= nextReport)
+		{
+			printf("  %u / %u matches, %.1f s\n", numFinished, numMatches, (Profiler::GetTimeNs() - beginNs) * 1e-9);
+			while (nextReport <= numFinished)
+				nextReport += reportStep;
+		}
+	}
+
+	for (size_t i = 0; i < threads.size(); ++i)
+	{
+		threads[i].join();
+	}
+	m_runSeconds = (Profiler::GetTimeNs() - beginNs) * 1e-9;
+}
+
+void Tournament::RunMatch(unsigned int index, TournamentMatchResult& result) const
+{
+	unsigned int entrants[2];
+	uint32_t seed;
+	GetMatch(index, entrants, seed);
+	PlayMatch(GetGameBotStyle(m_entrants[entrants[0]]), GetGameBotStyle(m_entrants[entrants[1]]), seed, result);
+	result.entrants[0] = entrants[0];
+	result.entrants[1] = entrants[1];
+}
+
+void Tournament::WorkerThread()
+{
+	const unsigned int numMatches = GetNumMatches();
+	for (;;)
+	{
+		const unsigned int index = m_nextMatch.fetch_add(1, std::memory_order_relaxed);
+		if (index >= numMatches)
+			break;
+
+		// each match has its own slot, so where it lands doesn't depend on timing
+		RunMatch(index, m_results[index]);
+		m_numFinished.fetch_add(1, std::memory_order_release);
+	}
+}
+
+void Tournament::PlayMatch(const GameBotStyle& styleA, const GameBotStyle& styleB, uint32_t seed, TournamentMatchResult& result)
+{
+	VersusMatch match;
+	match.Init(seed);
+	GameBot bots[VersusMatch::kNumPlayers] = { GameBot(styleA), GameBot(styleB) };
+
+	bool toppedOut[VersusMatch::kNumPlayers] = { false, false };
+	while (match.GetFrame() < kMaxFrames)
+	{
+		GameInput inputs[VersusMatch::kNumPlayers];
+		for (unsigned int i = 0; i < VersusMatch::kNumPlayers; ++i)
+		{
+			inputs[i] = bots[i].Think(match.GetGame(i));
+		}
+		match.Step(inputs);
+
+		// the bots would press start on the game over screen, so stop at the first top out
+		for (unsigned int i = 0; i < VersusMatch::kNumPlayers; ++i)
+		{
+			toppedOut[i] = match.GetGame(i).IsGameOver();
+		}
+		if (toppedOut[0] || toppedOut[1])
+			break;
+	}
+
+	result.seed = seed;
+	// both topping out on the same frame is a draw, like running out of time
+	result.winner = toppedOut[0] == toppedOut[1] ? -1 : (toppedOut[0] ? 1 : 0);
+	result.numFrames = match.GetFrame();
+	for (unsigned int i = 0; i < VersusMatch::kNumPlayers; ++i)
+	{
+		const Game& game = match.GetGame(i);
+		result.numLinesCleared[i] = game.GetNumLinesCleared();
+		result.garbageLinesSent[i] = game.GetGarbageLinesSent();
+		result.score[i] = game.GetScore();
+	}
+	match.Shutdown();
+}
+
+void Tournament::GetRatings(std::vector<double>& ratings) const
+{
+	// Minorisation-maximisation for Bradley-Terry strengths, with draws as half
+	// a win each. Every entrant also draws once with a fixed entrant of strength
+	// 1, which keeps a bot that won or lost everything at a finite rating.
+	const unsigned int numEntrants = (unsigned int)m_entrants.size();
+	std::vector<double> wins(numEntrants * numEntrants, 0.0);
+	for (size_t i = 0; i < m_results.size(); ++i)
+	{
+		const TournamentMatchResult& result = m_results[i];
+		const unsigned int a = result.entrants[0];
+		const unsigned int b = result.entrants[1];
+		const double aWins = result.winner < 0 ? 0.5 : (result.winner == 0 ? 1.0 : 0.0);
+		wins[a * numEntrants + b] += aWins;
+		wins[b * numEntrants + a] += 1.0 - aWins;
+	}
+
+	std::vector<double> strengths(numEntrants, 1.0);
+	std::vector<double> newStrengths(numEntrants);
+	for (unsigned int iteration = 0; iteration < s_kMaxRatingIterations; ++iteration)
+	{
+		double largestChange = 0.0;
+		for (unsigned int i = 0; i < numEntrants; ++i)
+		{
+			double totalWins = 0.5;
+			double denominator = 1.0 / (strengths[i] + 1.0);
+			for (unsigned int j = 0; j < numEntrants; ++j)
+			{
+				const double numGames = wins[i * numEntrants + j] + wins[j * numEntrants + i];
+				if (j == i || numGames == 0.0)
+					continue;
+				totalWins += wins[i * numEntrants + j];
+				denominator += numGames / (strengths[i] + strengths[j]);
+			}
+			newStrengths[i] = totalWins / denominator;
+			largestChange = fmax(largestChange, fabs(log(newStrengths[i] / strengths[i])));
+		}
+		strengths.swap(newStrengths);
+		if (largestChange < 1e-9)
+			break;
+	}
+
+	double meanRating = 0.0;
+	ratings.resize(numEntrants);
+	for (unsigned int i = 0; i < numEntrants; ++i)
+	{
+		ratings[i] = 400.0 * log10(strengths[i]);
+		meanRating += ratings[i] / numEntrants;
+	}
+	for (unsigned int i = 0; i < numEntrants; ++i)
+	{
+		ratings[i] += 1500.0 - meanRating;
+	}
+}
+
+void Tournament::PrintResults() const
+{
+	const unsigned int numEntrants = (unsigned int)m_entrants.size();
+	std::vector<unsigned int> numWins(numEntrants, 0);
+	std::vector<unsigned int> numLosses(numEntrants, 0);
+	std::vector<unsigned int> numDraws(numEntrants, 0);
+	std::vector<uint64_t> numFrames(numEntrants, 0);
+	std::vector<uint64_t> numLines(numEntrants, 0);
+	std::vector<uint64_t> numGarbage(numEntrants, 0);
+	std::vector<double> pairWins(numEntrants * numEntrants, 0.0);
+	std::vector<unsigned int> pairGames(numEntrants * numEntrants, 0);
+	uint64_t totalFrames = 0;
+	unsigned int numTimeouts = 0;
+	for (size_t i = 0; i < m_results.size(); ++i)
+	{
+		const TournamentMatchResult& result = m_results[i];
+		totalFrames += result.numFrames;
+		numTimeouts += result.numFrames >= kMaxFrames;
+		for (unsigned int side = 0; side < 2; ++side)
+		{
+			const unsigned int entrant = result.entrants[side];
+			const unsigned int opponent = result.entrants[side ^ 1];
+			const double win = result.winner < 0 ? 0.5 : (result.winner == (int)side ? 1.0 : 0.0);
+			numWins[entrant] += win == 1.0;
+			numLosses[entrant] += win == 0.0;
+			numDraws[entrant] += win == 0.5;
+			numFrames[entrant] += result.numFrames;
+			numLines[entrant] += result.numLinesCleared[side];
+			numGarbage[entrant] += result.garbageLinesSent[side];
+			pairWins[entrant * numEntrants + opponent] += win;
+			++pairGames[entrant * numEntrants + opponent];
+		}
+	}
+
+	std::vector<double> ratings;
+	GetRatings(ratings);
+	std::vector<unsigned int> order(numEntrants);
+	for (unsigned int i = 0; i < numEntrants; ++i)
+	{
+		order[i] = i;
+	}
+	for (unsigned int i = 1; i < numEntrants; ++i)
+	{
+		for (unsigned int j = i; j > 0 && ratings[order[j]] > ratings[order[j - 1]]; --j)
+		{
+			const unsigned int swap = order[j];
+			order[j] = order[j - 1];
+			order[j - 1] = swap;
+		}
+	}
+
+	const unsigned int numMatches = (unsigned int)m_results.size();
+	printf("%u matches, %u per pair, seed %u\n", numMatches, m_matchesPerPair, m_seed);
+	printf("  %-32s %12.1f\n", "Seconds", m_runSeconds);
+	printf("  %-32s %12.0f\n", "Matches / s", m_runSeconds > 0.0 ? numMatches / m_runSeconds : 0.0);
+	printf("  %-32s %12.0f\n", "Mean frames per match", numMatches ? (double)totalFrames / numMatches : 0.0);
+	printf("  %-32s %12u\n", "Draws on time", numTimeouts);
+
+	printf("\n  %-12s %8s %8s %8s %8s %8s %10s %10s\n", "Bot", "Elo", "Won", "Lost", "Drawn", "Win %", "Lines/min", "Sent/min");
+	for (unsigned int i = 0; i < numEntrants; ++i)
+	{
+		const unsigned int entrant = order[i];
+		const unsigned int numGames = numWins[entrant] + numLosses[entrant] + numDraws[entrant];
+		printf("  %-12s %8.0f %8u %8u %8u %8.1f %10.1f %10.1f\n", GetGameBotStyle(m_entrants[entrant]).name, ratings[entrant],
+			numWins[entrant], numLosses[entrant], numDraws[entrant],
+			numGames ? 100.0 * (numWins[entrant] + 0.5 * numDraws[entrant]) / numGames : 0.0,
+			PerMinute(numLines[entrant], numFrames[entrant]), PerMinute(numGarbage[entrant], numFrames[entrant]));
+	}
+
+	// row against column, draws counting half
+	printf("\n  %-12s", "Win % vs");
+	for (unsigned int i = 0; i < numEntrants; ++i)
+	{
+		printf(" %8.8s", GetGameBotStyle(m_entrants[order[i]]).name);
+	}
+	printf("\n");
+	for (unsigned int i = 0; i < numEntrants; ++i)
+	{
+		printf("  %-12s", GetGameBotStyle(m_entrants[order[i]]).name);
+		for (unsigned int j = 0; j < numEntrants; ++j)
+		{
+			const unsigned int pair = order[i] * numEntrants + order[j];
+			if (i == j || pairGames[pair] == 0)
+				printf(" %8s", "-");
+			else
+				printf(" %8.1f", 100.0 * pairWins[pair] / pairGames[pair]);
+		}
+		printf("\n");
+	}
+}
+
+bool Tournament::WriteCsv(const char* path) const
+{
+	FILE* file = fopen(path, "w");
+	if (!file)
+	{
+		fprintf(stderr, "Failed to open %s for writing\n", path);
+		return false;
+	}
+
+	fprintf(file, "match,seed,bot_a,bot_b,winner,frames,lines_a,lines_b,garbage_a,garbage_b,score_a,score_b\n");
+	for (size_t i = 0; i < m_results.size(); ++i)
+	{
+		const TournamentMatchResult& result = m_results[i];
+		const char* winner = result.winner < 0 ? "draw" : GetGameBotStyle(m_entrants[result.entrants[result.winner]]).name;
+		fprintf(file, "%u,%u,%s,%s,%s,%u,%u,%u,%u,%u,%u,%u\n", (unsigned int)i, result.seed,
+			GetGameBotStyle(m_entrants[result.entrants[0]]).name, GetGameBotStyle(m_entrants[result.entrants[1]]).name, winner,
+			result.numFrames, result.numLinesCleared[0], result.numLinesCleared[1],
+			result.garbageLinesSent[0], result.garbageLinesSent[1], result.score[0], result.score[1]);
+	}
+
+	const bool written = fclose(file) == 0;
+	if (!written)
+		fprintf(stderr, "Failed to write %s\n", path);
+	return written;
+}
@@ -0,0 +1,71 @@
+#pragma once
+#ifndef TOURNAMENT_H_INCLUDED
+#define TOURNAMENT_H_INCLUDED
+
+#include "GameBot.h"
+#include <atomic>
+#include <stdint.h>
+#include <vector>
+
+struct TournamentMatchResult
+{
+	// which entrant played each side
+	unsigned int entrants[2];
+	uint32_t seed;
+	// the side that outlasted the other, or -1 for a draw
+	int winner;
+	unsigned int numFrames;
+	unsigned int numLinesCleared[2];
+	unsigned int garbageLinesSent[2];
+	unsigned int score[2];
+};
+
+// Plays every pair of bot styles against each other in headless versus
+// matches, where cleared lines become garbage on the other board, and rates
+// them. Each pair plays matchesPerPair matches, swapping sides every match and
+// playing each deal of pieces from both sides, and every pair gets the same
+// deals. A match only depends on its bots and seed, so any match can be played
+// again on its own and the results don't depend on how many threads ran them.
+class Tournament
+{
+public:
+	// five minutes of play, after which the match is a draw
+	static const unsigned int kMaxFrames = 60 * 60 * 5;
+
+	Tournament();
+
+	// entrants are indices of GameBotStyles, at least two and all different
+	bool Init(const std::vector<unsigned int>& entrants, unsigned int matchesPerPair, uint32_t seed);
+
+	unsigned int GetNumMatches() const { return m_numPairs * m_matchesPerPair; }
+	void GetMatch(unsigned int index, unsigned int entrants[2], uint32_t& seed) const;
+
+	// plays every match on numThreads threads
+	void Run(unsigned int numThreads);
+	// plays one match, as it was played in Run
+	void RunMatch(unsigned int index, TournamentMatchResult& result) const;
+
+	// ratings, records and the win rate of each entrant against each other
+	void PrintResults() const;
+	// one line per match
+	bool WriteCsv(const char* path) const;
+
+	static void PlayMatch(const GameBotStyle& styleA, const GameBotStyle& styleB, uint32_t seed, TournamentMatchResult& result);
+
+private:
+	void WorkerThread();
+	// Bradley-Terry ratings on the Elo scale, averaging 1500
+	void GetRatings(std::vector<double>& ratings) const;
+
+	std::vector<unsigned int> m_entrants;
+	unsigned int m_numPairs;
+	unsigned int m_matchesPerPair;
+	uint32_t m_seed;
+
+	std::vector<TournamentMatchResult> m_results;
+	std::atomic<unsigned int> m_nextMatch;
+	std::atomic<unsigned int> m_numFinished;
+	double m_runSeconds;
+};
+
+#endif // TOURNAMENT_H_INCLUDED
@@ -0,0 +1,101 @@
+#include "Versus.h"
+#include "Debugger.h"
+#include <stdio.h>
+#include <string.h>
+
+// a fixed step so replays match whatever the frame rate was
+static const float s_kStepSeconds = 1.0f / 60.0f;
+
+//================================================================================
+
+uint8_t PackGameInput(const GameInput& input)
+{
+	return (uint8_t)((input.start ? 0x01 : 0)
+		| (input.moveLeft ? 0x02 : 0)
+		| (input.moveRight ? 0x04 : 0)
+		| (input.rotClockwise ? 0x08 : 0)
+		| (input.rotAnticlockwise ? 0x10 : 0)
+		| (input.hardDrop ? 0x20 : 0)
+		| (input.softDrop ? 0x40 : 0)
+		| (input.pause ? 0x80 : 0));
+}
+
+GameInput UnpackGameInput(uint8_t packed)
+{
+	GameInput input;
+	memset(&input, 0, sizeof(input));
+	input.start = (packed & 0x01) != 0;
+	input.moveLeft = (packed & 0x02) != 0;
+	input.moveRight = (packed & 0x04) != 0;
+	input.rotClockwise = (packed & 0x08) != 0;
+	input.rotAnticlockwise = (packed & 0x10) != 0;
+	input.hardDrop = (packed & 0x20) != 0;
+	input.softDrop = (packed & 0x40) != 0;
+	input.pause = (packed & 0x80) != 0;
+	return input;
+}
+
+//================================================================================
+
+VersusMatch::VersusMatch()
+	: m_frame(0)
+{
+}
+
+void VersusMatch::Init(uint32_t seed)
+{
+	for (unsigned int i = 0; i < kNumPlayers; ++i)
+	{
+		m_games[i].Init();
+		m_games[i].SetSeed(seed);
+	}
+	m_frame = 0;
+}
+
+void VersusMatch::Shutdown()
+{
+	for (unsigned int i = 0; i < kNumPlayers; ++i)
+	{
+		m_games[i].Shutdown();
+	}
+}
+
+void VersusMatch::Step(const GameInput inputs[kNumPlayers])
+{
+	unsigned int garbageSentBefore[kNumPlayers];
+	for (unsigned int i = 0; i < kNumPlayers; ++i)
+	{
+		garbageSentBefore[i] = m_games[i].GetGarbageLinesSent();
+		m_games[i].Update(inputs[i], s_kStepSeconds);
+	}
+
+	// garbage arrives the frame after it was sent, whichever player updated first
+	for (unsigned int i = 0; i < kNumPlayers; ++i)
+	{
+		const unsigned int garbageSent = m_games[i].GetGarbageLinesSent();
+		if (garbageSent > garbageSentBefore[i])
+		{
+			m_games[i ^ 1].AddGarbageLines(garbageSent - garbageSentBefore[i]);
+		}
+	}
+
+	++m_frame;
+}
+
+void VersusMatch::SaveSnapshot(Snapshot& snapshot) const
+{
+	for (unsigned int i = 0; i < kNumPlayers; ++i)
+	{
+		m_games[i].SaveSnapshot(snapshot.games[i]);
+	}
+	snapshot.frame = m_frame;
+}
+
+void VersusMatch::LoadSnapshot(const Snapshot& snapshot)
+{
+	for (unsigned int i = 0; i < kNumPlayers; ++i)
+	{
+		m_games[i].LoadSnapshot(snapshot.games[i]);
+	}
+	m_frame = snapshot.frame;
+}
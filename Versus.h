@@ -0,0 +1,44 @@
+#pragma once
+#ifndef VERSUS_H_INCLUDED
+#define VERSUS_H_INCLUDED
+
+#include "Game.h"
+
+// Two games side by side that send each other garbage. A step depends only on
+// the snapshot it starts from and both players' inputs, which is what lets
+// the rollback session rewind and replay it.
+class VersusMatch
+{
+public:
+	static const unsigned int kNumPlayers = 2;
+
+	struct Snapshot
+	{
+		Game::Snapshot games[kNumPlayers];
+		unsigned int frame;
+	};
+
+	VersusMatch();
+
+	// both games get the same pieces
+	void Init(uint32_t seed);
+	void Shutdown();
+
+	void Step(const GameInput inputs[kNumPlayers]);
+
+	void SaveSnapshot(Snapshot& snapshot) const;
+	void LoadSnapshot(const Snapshot& snapshot);
+
+	unsigned int GetFrame() const { return m_frame; }
+	const Game& GetGame(unsigned int player) const { return m_games[player]; }
+
+private:
+	Game m_games[kNumPlayers];
+	unsigned int m_frame;
+};
+
+// Inputs go over the network and into the rollback history as one byte.
+uint8_t PackGameInput(const GameInput& input);
+GameInput UnpackGameInput(uint8_t packed);
+
+#endif // VERSUS_H_INCLUDED
@@ -0,0 +1,215 @@
+// Bakes the printable ASCII glyphs of a TrueType font into a C++ header of
+// constexpr tables, so the game can draw text without SDL_ttf, FreeType or the
+// font file at run time.
+//
+// Run whenever the font or size changes. With CMake, when FreeType is found:
+//   cmake --build build --target bake_font
+// or build and run it by hand from the repository root:
+//   g++ -O2 tools/BakeFont.cpp $(pkg-config --cflags --libs freetype2) -o BakeFont
+//   ./BakeFont "fonts/Coder's Crux.ttf" 48 BakedFont.h
+#include <ft2build.h>
+#include FT_FREETYPE_H
+#include <algorithm>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <vector>
+
+static const char s_kFirstGlyph = ' ';
+static const char s_kLastGlyph = '~';
+static const unsigned int s_kNumGlyphs = s_kLastGlyph - s_kFirstGlyph + 1;
+static const unsigned int s_kGlyphsPerRow = 16;
+
+struct BakedGlyph
+{
+	int width;
+	int height;
+	int advance;
+	std::vector<uint8_t> alpha;
+};
+
+//Helper functions
+static int FixedCeil(FT_Long value)
+{
+	return (int)((value + 63) >> 6);
+}
+
+static int FixedFloor(FT_Long value)
+{
+	return (int)(value >> 6);
+}
+
+static const char* BaseName(const char* path)
+{
+	const char* name = path;
+	for (const char* c = path; *c; ++c)
+	{
+		if (*c == '/' || *c == '\\')
+			name = c + 1;
+	}
+	return name;
+}
+
+int main(int argc, char** argv)
+{
+	if (argc != 4)
+	{
+		fprintf(stderr, "usage: %s <font.ttf> <point size> <output.h>\n", argv[0]);
+		return 1;
+	}
+
+	const char* fontPath = argv[1];
+	const int pointSize = atoi(argv[2]);
+	const char* outputPath = argv[3];
+
+	FT_Library library;
+	if (FT_Init_FreeType(&library) != 0)
+	{
+		fprintf(stderr, "FT_Init_FreeType failed\n");
+		return 1;
+	}
+
+	FT_Face face;
+	if (FT_New_Face(library, fontPath, 0, &face) != 0)
+	{
+		fprintf(stderr, "Failed to open %s\n", fontPath);
+		return 1;
+	}
+
+	// same size and vertical metrics as SDL_ttf's TTF_OpenFont at 72 dpi
+	FT_Set_Char_Size(face, 0, pointSize * 64, 0, 0);
+	const FT_Fixed scale = face->size->metrics.y_scale;
+	const int ascent = FixedCeil(FT_MulFix(face->ascender, scale));
+	const int descent = FixedCeil(FT_MulFix(face->descender, scale));
+	const int lineHeight = ascent - descent + 1;
+
+	std::vector<BakedGlyph> glyphs(s_kNumGlyphs);
+	int cellWidth = 1;
+	for (unsigned int i = 0; i < s_kNumGlyphs; ++i)
+	{
+		BakedGlyph& glyph = glyphs[i];
+		glyph.width = 0;
+		glyph.height = lineHeight;
+		glyph.advance = 0;
+
+		if (FT_Load_Char(face, s_kFirstGlyph + i, FT_LOAD_DEFAULT) != 0)
+			continue;
+		if (FT_Render_Glyph(face->glyph, FT_RENDER_MODE_NORMAL) != 0)
+			continue;
+
+		const FT_GlyphSlot slot = face->glyph;
+		const FT_Bitmap& bitmap = slot->bitmap;
+		const int left = std::max(0, FixedFloor(slot->metrics.horiBearingX));
+		glyph.advance = FixedCeil(slot->metrics.horiAdvance);
+		glyph.width = std::max(glyph.advance, left + (int)bitmap.width);
+		glyph.alpha.assign(glyph.width * glyph.height, 0);
+
+		// copy the coverage into a cell of the full line height, on the baseline
+		const int top = ascent - slot->bitmap_top;
+		for (int y = 0; y < (int)bitmap.rows; ++y)
+		{
+			const int cellY = top + y;
+			if (cellY < 0 || cellY >= glyph.height)
+				continue;
+			for (int x = 0; x < (int)bitmap.width; ++x)
+			{
+				glyph.alpha[cellY * glyph.width + left + x] = bitmap.buffer[y * bitmap.pitch + x];
+			}
+		}
+
+		cellWidth = std::max(cellWidth, glyph.width);
+	}
+
+	const unsigned int numRows = (s_kNumGlyphs + s_kGlyphsPerRow - 1) / s_kGlyphsPerRow;
+	const unsigned int atlasWidth = s_kGlyphsPerRow * cellWidth;
+	const unsigned int atlasHeight = numRows * lineHeight;
+	std::vector<uint8_t> atlas(atlasWidth * atlasHeight, 0);
+	for (unsigned int i = 0; i < s_kNumGlyphs; ++i)
+	{
+		const BakedGlyph& glyph = glyphs[i];
+		const int atlasX = (i % s_kGlyphsPerRow) * cellWidth;
+		const int atlasY = (i / s_kGlyphsPerRow) * lineHeight;
+		for (int y = 0; y < glyph.height && glyph.width > 0; ++y)
+		{
+			std::copy(&glyph.alpha[y * glyph.width], &glyph.alpha[y * glyph.width] + glyph.width, &atlas[(atlasY + y) * atlasWidth + atlasX]);
+		}
+	}
+
+	// pixel fonts rasterize to pure coverage, which packs eight pixels a byte
+	bool isBinary = true;
+	for (size_t i = 0; i < atlas.size() && isBinary; ++i)
+	{
+		isBinary = (atlas[i] == 0 || atlas[i] == 255);
+	}
+	const unsigned int bitsPerPixel = isBinary ? 1 : 8;
+	const unsigned int rowBytes = (atlasWidth * bitsPerPixel + 7) / 8;
+
+	std::vector<uint8_t> pixels(rowBytes * atlasHeight, 0);
+	for (unsigned int y = 0; y < atlasHeight; ++y)
+	{
+		for (unsigned int x = 0; x < atlasWidth; ++x)
+		{
+			const uint8_t alpha = atlas[y * atlasWidth + x];
+			if (bitsPerPixel == 8)
+				pixels[y * rowBytes + x] = alpha;
+			else if (alpha)
+				pixels[y * rowBytes + x / 8] |= (uint8_t)(0x80 >> (x % 8));
+		}
+	}
+
+	FILE* file = fopen(outputPath, "w");
+	if (!file)
+	{
+		fprintf(stderr, "Failed to open %s for writing\n", outputPath);
+		return 1;
+	}
+
+	fprintf(file, "// Generated by tools/BakeFont.cpp from %s at %d points, do not edit.\n", BaseName(fontPath), pointSize);
+	fprintf(file, "#pragma once\n");
+	fprintf(file, "#ifndef BAKED_FONT_H_INCLUDED\n");
+	fprintf(file, "#define BAKED_FONT_H_INCLUDED\n\n");
+	fprintf(file, "#include \"Font.h\"\n");
+	fprintf(file, "#include <stdint.h>\n\n");
+	fprintf(file, "static constexpr int s_kBakedFontPointSize = %d;\n", pointSize);
+	fprintf(file, "static constexpr unsigned int s_kBakedFontWidth = %u;\n", atlasWidth);
+	fprintf(file, "static constexpr unsigned int s_kBakedFontHeight = %u;\n", atlasHeight);
+	fprintf(file, "static constexpr int s_kBakedFontLineHeight = %d;\n", lineHeight);
+	fprintf(file, "static constexpr unsigned int s_kBakedFontBitsPerPixel = %u;\n\n", bitsPerPixel);
+
+	fprintf(file, "// x, y, width, height, advance\n");
+	fprintf(file, "static constexpr GlyphAtlas::Glyph s_kBakedFontGlyphs[GlyphAtlas::kNumGlyphs] =\n{\n");
+	for (unsigned int i = 0; i < s_kNumGlyphs; ++i)
+	{
+		const BakedGlyph& glyph = glyphs[i];
+		const int atlasX = glyph.width > 0 ? (int)((i % s_kGlyphsPerRow) * cellWidth) : 0;
+		const int atlasY = glyph.width > 0 ? (int)((i / s_kGlyphsPerRow) * lineHeight) : 0;
+		const char c = (char)(s_kFirstGlyph + i);
+		fprintf(file, "\t{ %d, %d, %d, %d, %d },\t// ", atlasX, atlasY, glyph.width, glyph.width > 0 ? glyph.height : 0, glyph.advance);
+		if (c == '\\')
+			fprintf(file, "backslash\n");
+		else
+			fprintf(file, "'%c'\n", c);
+	}
+	fprintf(file, "};\n\n");
+
+	fprintf(file, "// rows of %u bytes, %s\n", rowBytes, bitsPerPixel == 1 ? "one bit per pixel with the leftmost pixel in the high bit" : "one coverage byte per pixel");
+	fprintf(file, "static constexpr uint8_t s_kBakedFontPixels[%u] =\n{\n", (unsigned int)pixels.size());
+	for (size_t i = 0; i < pixels.size(); i += 16)
+	{
+		fprintf(file, "\t");
+		for (size_t j = i; j < std::min(i + 16, pixels.size()); ++j)
+		{
+			fprintf(file, "0x%02x,%s", pixels[j], (j + 1 < std::min(i + 16, pixels.size())) ? " " : "");
+		}
+		fprintf(file, "\n");
+	}
+	fprintf(file, "};\n\n");
+	fprintf(file, "#endif // BAKED_FONT_H_INCLUDED\n");
+	fclose(file);
+
+	FT_Done_Face(face);
+	FT_Done_FreeType(library);
+
+	printf("Baked %u glyphs into %ux%u at %u bpp, %u bytes\n", s_kNumGlyphs, atlasWidth, atlasHeight, bitsPerPixel, (unsigned int)pixels.size());
+	return 0;
+}
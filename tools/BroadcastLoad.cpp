@@ -0,0 +1,335 @@
+// Load generator for the spectator broadcast server. Runs a BroadcastServer
+// over bot played games on one thread and connects many viewers to it from a
+// few more, each reading and checking the message stream, then reports fan-out
+// throughput and memory per viewer. Linux only, like the server.
+//
+// Build and run from the repository root:
+//   g++ -O2 -std=c++17 -I. tools/BroadcastLoad.cpp Broadcast.cpp FieldCodec.cpp FieldKernels.cpp Game.cpp GameBot.cpp Hud.cpp Render.cpp Profiler.cpp -lpthread -o BroadcastLoad
+//   ./BroadcastLoad --clients 2000 --games 100 --seconds 10 [--slow 100] [--hz 60]
+#include "Broadcast.h"
+#include "GameBot.h"
+#include "Profiler.h"
+#include <arpa/inet.h>
+#include <atomic>
+#include <errno.h>
+#include <netinet/in.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/epoll.h>
+#include <sys/resource.h>
+#include <sys/socket.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+static const unsigned int s_kNumClientThreads = 4;
+static const size_t s_kReadBufferBytes = 64 * 1024;
+
+struct Options
+{
+	unsigned int numClients;
+	unsigned int numSlowClients;
+	unsigned int numGames;
+	unsigned int seconds;
+	unsigned int ticksPerSecond;
+};
+
+struct Viewer
+{
+	int socket;
+	std::vector<uint8_t> pending;
+	bool hadKeyframe;
+	uint32_t lastTick;
+};
+
+struct ViewerTotals
+{
+	std::atomic<uint64_t> messages;
+	std::atomic<uint64_t> keyframes;
+	std::atomic<uint64_t> bytes;
+	std::atomic<uint64_t> errors;
+};
+
+//Helper functions
+//================================================================================
+
+static size_t GetResidentBytes()
+{
+	FILE* file = fopen("/proc/self/statm", "r");
+	if (!file)
+		return 0;
+	unsigned long totalPages = 0;
+	unsigned long residentPages = 0;
+	if (fscanf(file, "%lu %lu", &totalPages, &residentPages) != 2)
+		residentPages = 0;
+	fclose(file);
+	return residentPages * (size_t)sysconf(_SC_PAGESIZE);
+}
+
+static uint32_t ReadU32(const uint8_t* data)
+{
+	return (uint32_t)data[0] | ((uint32_t)data[1] << 8) | ((uint32_t)data[2] << 16) | ((uint32_t)data[3] << 24);
+}
+
+static int Connect(uint16_t port)
+{
+	const int socketHandle = socket(AF_INET, SOCK_STREAM, 0);
+	sockaddr_in address;
+	memset(&address, 0, sizeof(address));
+	address.sin_family = AF_INET;
+	address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	address.sin_port = htons(port);
+	if (socketHandle < 0 || connect(socketHandle, (const sockaddr*)&address, sizeof(address)) != 0)
+	{
+		fprintf(stderr, "Connect failed: %s\n", strerror(errno));
+		if (socketHandle >= 0)
+			close(socketHandle);
+		return -1;
+	}
+	return socketHandle;
+}
+
+// splits what has arrived into messages and checks each one
+static void ParseMessages(Viewer& viewer, ViewerTotals& totals)
+{
+	size_t offset = 0;
+	while (viewer.pending.size() - offset >= kBroadcastMessageHeaderBytes)
+	{
+		const uint8_t* message = viewer.pending.data() + offset;
+		const size_t messageBytes = 4 + ReadU32(message);
+		if (messageBytes < kBroadcastMessageHeaderBytes)
+		{
+			++totals.errors;
+			viewer.pending.clear();
+			return;
+		}
+		if (viewer.pending.size() - offset < messageBytes)
+			break;
+
+		const uint32_t tick = ReadU32(message + 4);
+		const uint8_t kind = message[8];
+		if (kind == kBroadcastMessageKind_Keyframe)
+		{
+			viewer.hadKeyframe = true;
+			++totals.keyframes;
+		}
+		else if (kind != kBroadcastMessageKind_Delta || !viewer.hadKeyframe || tick <= viewer.lastTick)
+		{
+			++totals.errors;
+		}
+		viewer.lastTick = tick;
+		++totals.messages;
+		offset += messageBytes;
+	}
+	viewer.pending.erase(viewer.pending.begin(), viewer.pending.begin() + offset);
+}
+
+static void RunViewers(std::vector<Viewer>* viewers, ViewerTotals* totals, const std::atomic<bool>* stop)
+{
+	const int epoll = epoll_create1(0);
+	for (size_t i = 0; i < viewers->size(); ++i)
+	{
+		epoll_event event;
+		memset(&event, 0, sizeof(event));
+		event.events = EPOLLIN;
+		event.data.ptr = &(*viewers)[i];
+		epoll_ctl(epoll, EPOLL_CTL_ADD, (*viewers)[i].socket, &event);
+	}
+
+	std::vector<uint8_t> buffer(s_kReadBufferBytes);
+	epoll_event events[256];
+	while (!*stop)
+	{
+		const int numEvents = epoll_wait(epoll, events, 256, 10);
+		for (int i = 0; i < numEvents; ++i)
+		{
+			Viewer& viewer = *(Viewer*)events[i].data.ptr;
+			const ssize_t numRead = read(viewer.socket, buffer.data(), buffer.size());
+			if (numRead <= 0)
+				continue;
+			totals->bytes += (uint64_t)numRead;
+			viewer.pending.insert(viewer.pending.end(), buffer.data(), buffer.data() + numRead);
+			ParseMessages(viewer, *totals);
+		}
+	}
+	close(epoll);
+}
+
+static bool ParseOptions(int argc, char** argv, Options& options)
+{
+	options.numClients = 1000;
+	options.numSlowClients = 0;
+	options.numGames = 100;
+	options.seconds = 10;
+	options.ticksPerSecond = 60;
+	for (int i = 1; i + 1 < argc; i += 2)
+	{
+		const unsigned int value = (unsigned int)atoi(argv[i + 1]);
+		if (strcmp(argv[i], "--clients") == 0)
+			options.numClients = value;
+		else if (strcmp(argv[i], "--slow") == 0)
+			options.numSlowClients = value;
+		else if (strcmp(argv[i], "--games") == 0)
+			options.numGames = value;
+		else if (strcmp(argv[i], "--seconds") == 0)
+			options.seconds = value;
+		else if (strcmp(argv[i], "--hz") == 0)
+			options.ticksPerSecond = value;
+		else
+		{
+			fprintf(stderr, "Unknown option %s\n", argv[i]);
+			return false;
+		}
+	}
+	return options.numGames > 0 && options.ticksPerSecond > 0;
+}
+
+//================================================================================
+
+int main(int argc, char** argv)
+{
+	Options options;
+	if (!ParseOptions(argc, argv, options))
+	{
+		fprintf(stderr, "usage: BroadcastLoad [--clients n] [--slow n] [--games n] [--seconds n] [--hz n]\n");
+		return 1;
+	}
+
+	// every viewer is two descriptors, ours and the server's
+	rlimit fileLimit;
+	getrlimit(RLIMIT_NOFILE, &fileLimit);
+	fileLimit.rlim_cur = fileLimit.rlim_max;
+	setrlimit(RLIMIT_NOFILE, &fileLimit);
+
+	std::vector<Game*> games(options.numGames);
+	std::vector<GameBot*> bots(options.numGames);
+	BroadcastServer server;
+	for (unsigned int i = 0; i < options.numGames; ++i)
+	{
+		games[i] = new Game();
+		games[i]->Init();
+		// mixed speeds, so some game changes on every tick
+		bots[i] = new GameBot(1 + i % 4);
+		server.AddGame(games[i]);
+	}
+	if (!server.Open(0))
+		return 1;
+
+	std::atomic<bool> stopServer(false);
+	std::atomic<uint64_t> serverTickNs(0);
+	std::thread serverThread([&]()
+	{
+		const uint64_t tickNs = 1000000000ull / options.ticksPerSecond;
+		uint64_t nextTickNs = Profiler::GetTimeNs();
+		while (!stopServer)
+		{
+			const uint64_t beginNs = Profiler::GetTimeNs();
+			for (unsigned int i = 0; i < options.numGames; ++i)
+			{
+				games[i]->Update(bots[i]->Think(*games[i]), 1.0f / options.ticksPerSecond);
+			}
+			server.Tick();
+			serverTickNs += Profiler::GetTimeNs() - beginNs;
+
+			nextTickNs += tickNs;
+			for (;;)
+			{
+				const uint64_t nowNs = Profiler::GetTimeNs();
+				if (nowNs >= nextTickNs)
+					break;
+				server.Poll((int)((nextTickNs - nowNs) / 1000000));
+			}
+		}
+	});
+
+	const size_t residentBefore = GetResidentBytes();
+
+	std::vector<Viewer> viewers[s_kNumClientThreads];
+	std::vector<int> slowViewers;
+	for (unsigned int i = 0; i < options.numClients + options.numSlowClients; ++i)
+	{
+		const int socketHandle = Connect(server.GetPort());
+		if (socketHandle < 0)
+			break;
+
+		if (i >= options.numClients)
+		{
+			// connected and never read from
+			slowViewers.push_back(socketHandle);
+			continue;
+		}
+
+		Viewer viewer;
+		viewer.socket = socketHandle;
+		viewer.hadKeyframe = false;
+		viewer.lastTick = 0;
+		viewers[i % s_kNumClientThreads].push_back(viewer);
+	}
+
+	ViewerTotals totals;
+	totals.messages = 0;
+	totals.keyframes = 0;
+	totals.bytes = 0;
+	totals.errors = 0;
+	std::atomic<bool> stopViewers(false);
+	std::thread viewerThreads[s_kNumClientThreads];
+	for (unsigned int i = 0; i < s_kNumClientThreads; ++i)
+	{
+		viewerThreads[i] = std::thread(RunViewers, &viewers[i], &totals, &stopViewers);
+	}
+
+	// let everyone connect and take their keyframe before measuring
+	std::this_thread::sleep_for(std::chrono::seconds(1));
+	const uint64_t messagesBefore = totals.messages;
+	const uint64_t bytesBefore = totals.bytes;
+	const uint64_t serverTickNsBefore = serverTickNs;
+	const size_t residentConnected = GetResidentBytes();
+
+	std::this_thread::sleep_for(std::chrono::seconds(options.seconds));
+	const double seconds = (double)options.seconds;
+	const uint64_t messages = totals.messages - messagesBefore;
+	const uint64_t bytes = totals.bytes - bytesBefore;
+	const uint64_t busyNs = serverTickNs - serverTickNsBefore;
+	const size_t residentAfter = GetResidentBytes();
+
+	stopViewers = true;
+	for (unsigned int i = 0; i < s_kNumClientThreads; ++i)
+	{
+		viewerThreads[i].join();
+	}
+	stopServer = true;
+	serverThread.join();
+
+	const unsigned int numViewers = options.numClients + options.numSlowClients;
+	printf("%u viewers (%u never reading), %u games at %u Hz, %u s\n", numViewers, options.numSlowClients, options.numGames, options.ticksPerSecond, options.seconds);
+	printf("  %-28s %14.0f\n", "Messages received / s", messages / seconds);
+	printf("  %-28s %14.2f\n", "MB received / s", bytes / seconds / (1024.0 * 1024.0));
+	printf("  %-28s %14.1f\n", "Mean message bytes", messages ? (double)bytes / messages : 0.0);
+	printf("  %-28s %14.2f\n", "Server tick busy %", 100.0 * busyNs / (seconds * 1e9));
+	printf("  %-28s %14llu\n", "Keyframes", (unsigned long long)totals.keyframes.load());
+	printf("  %-28s %14llu\n", "Stream errors", (unsigned long long)totals.errors.load());
+	printf("  %-28s %14.0f\n", "RSS per viewer on connect", numViewers ? (double)(residentConnected - residentBefore) / numViewers : 0.0);
+	printf("  %-28s %14.0f\n", "RSS growth while running", (double)residentAfter - (double)residentConnected);
+	server.PrintStats();
+
+	for (unsigned int i = 0; i < s_kNumClientThreads; ++i)
+	{
+		for (size_t j = 0; j < viewers[i].size(); ++j)
+		{
+			close(viewers[i][j].socket);
+		}
+	}
+	for (size_t i = 0; i < slowViewers.size(); ++i)
+	{
+		close(slowViewers[i]);
+	}
+	server.Close();
+	for (unsigned int i = 0; i < options.numGames; ++i)
+	{
+		games[i]->Shutdown();
+		delete games[i];
+		delete bots[i];
+	}
+	return totals.errors == 0 ? 0 : 1;
+}
@@ -0,0 +1,216 @@
+// Measures FieldCodec on real games. Bots play pairs of games that send each
+// other garbage, every field change is encoded and checked against a decoder
+// straight away, then the recorded streams are decoded again to time it.
+// Reports sizes against the raw Field and the old nibble packed rows.
+//
+// Build and run from the repository root:
+//   g++ -O2 -std=c++17 -I. tools/FieldCodecBench.cpp FieldCodec.cpp FieldKernels.cpp Game.cpp GameBot.cpp Hud.cpp Render.cpp Profiler.cpp -lpthread -o FieldCodecBench
+//   ./FieldCodecBench [--games 64] [--frames 36000] [--keyframe-interval 64]
+#include "FieldCodec.h"
+#include "GameBot.h"
+#include "Profiler.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+static const unsigned int s_kNumCells = Game::kFieldWidth * Game::kFieldHeight;
+
+struct Stream
+{
+	Game* game;
+	GameBot* bot;
+	FieldEncoder* encoder;
+	FieldDecoder* checker;
+	unsigned int garbageLinesSent;
+	std::vector<uint8_t> bytes;
+	std::vector<uint8_t> lastCells;
+};
+
+//Helper functions
+//================================================================================
+
+static void GetCells(const Field& field, uint8_t* cells)
+{
+	for (unsigned int i = 0; i < s_kNumCells; ++i)
+	{
+		cells[i] = field.staticBlocks ? GetFieldCellCode(field.staticBlocks[i]) : 0;
+	}
+}
+
+// what the broadcast field record used to cost: the span of changed rows at 4 bits a cell
+static unsigned int GetChangedRowsBytes(const uint8_t* before, const uint8_t* after)
+{
+	int firstRow = -1;
+	int lastRow = -1;
+	for (unsigned int i = 0; i < s_kNumCells; ++i)
+	{
+		if (before[i] != after[i])
+		{
+			const int row = (int)(i / Game::kFieldWidth);
+			if (firstRow < 0)
+				firstRow = row;
+			lastRow = row;
+		}
+	}
+	return firstRow < 0 ? 0 : 2 + ((lastRow - firstRow + 1) * Game::kFieldWidth + 1) / 2;
+}
+
+//================================================================================
+
+int main(int argc, char** argv)
+{
+	unsigned int numGames = 64;
+	unsigned int numFrames = 36000;
+	unsigned int keyframeInterval = 64;
+	for (int i = 1; i + 1 < argc; i += 2)
+	{
+		const unsigned int value = (unsigned int)atoi(argv[i + 1]);
+		if (strcmp(argv[i], "--games") == 0)
+			numGames = value;
+		else if (strcmp(argv[i], "--frames") == 0)
+			numFrames = value;
+		else if (strcmp(argv[i], "--keyframe-interval") == 0)
+			keyframeInterval = value;
+		else
+		{
+			fprintf(stderr, "usage: FieldCodecBench [--games n] [--frames n] [--keyframe-interval n]\n");
+			return 1;
+		}
+	}
+	numGames = (numGames + 1) & ~1u;
+
+	std::vector<Stream> streams(numGames);
+	for (unsigned int i = 0; i < numGames; ++i)
+	{
+		Stream& stream = streams[i];
+		stream.game = new Game();
+		stream.game->Init();
+		stream.game->SetSeed(1234 + i);
+		stream.bot = new GameBot();
+		stream.encoder = new FieldEncoder(Game::kFieldWidth, Game::kFieldHeight, keyframeInterval);
+		stream.checker = new FieldDecoder(Game::kFieldWidth, Game::kFieldHeight);
+		stream.garbageLinesSent = 0;
+		stream.lastCells.assign(s_kNumCells, 0);
+		// so growing the stream isn't timed as encoding
+		stream.bytes.reserve(numFrames * 4);
+	}
+
+	uint64_t numUpdates = 0;
+	uint64_t encodeNs = 0;
+	uint64_t unchangedEncodeNs = 0;
+	uint64_t changedRowsBytes = 0;
+	unsigned int numMismatches = 0;
+	std::vector<uint8_t> cells(s_kNumCells);
+	for (unsigned int frame = 0; frame < numFrames; ++frame)
+	{
+		for (unsigned int i = 0; i < numGames; ++i)
+		{
+			Stream& stream = streams[i];
+			stream.game->Update(stream.bot->Think(*stream.game), 1.0f / 60.0f);
+
+			// pairs send each other their garbage
+			const unsigned int sent = stream.game->GetGarbageLinesSent();
+			if (sent > stream.garbageLinesSent)
+			{
+				streams[i ^ 1].game->AddGarbageLines(sent - stream.garbageLinesSent);
+				stream.garbageLinesSent = sent;
+			}
+		}
+
+		for (unsigned int i = 0; i < numGames; ++i)
+		{
+			Stream& stream = streams[i];
+			const size_t packetBegin = stream.bytes.size();
+			const uint64_t beginNs = Profiler::GetTimeNs();
+			const bool changed = stream.encoder->Encode(stream.game->GetField(), stream.bytes);
+			const uint64_t elapsedNs = Profiler::GetTimeNs() - beginNs;
+			if (!changed)
+			{
+				unchangedEncodeNs += elapsedNs;
+				continue;
+			}
+			encodeNs += elapsedNs;
+
+			++numUpdates;
+			GetCells(stream.game->GetField(), cells.data());
+			changedRowsBytes += GetChangedRowsBytes(stream.lastCells.data(), cells.data());
+			stream.lastCells = cells;
+
+			const size_t packetBytes = stream.bytes.size() - packetBegin;
+			if (stream.checker->Decode(&stream.bytes[packetBegin], packetBytes) != packetBytes
+				|| memcmp(stream.checker->GetCells(), cells.data(), s_kNumCells) != 0)
+			{
+				++numMismatches;
+			}
+		}
+	}
+
+	// decode every stream again from the start, as a reader of stored games would
+	uint64_t decodeNs = 0;
+	uint64_t numDecoded = 0;
+	for (unsigned int i = 0; i < numGames; ++i)
+	{
+		Stream& stream = streams[i];
+		FieldDecoder decoder(Game::kFieldWidth, Game::kFieldHeight);
+		const uint64_t beginNs = Profiler::GetTimeNs();
+		size_t offset = 0;
+		while (offset < stream.bytes.size())
+		{
+			const size_t packetBytes = decoder.Decode(&stream.bytes[offset], stream.bytes.size() - offset);
+			if (packetBytes == 0)
+				break;
+			offset += packetBytes;
+			++numDecoded;
+		}
+		decodeNs += Profiler::GetTimeNs() - beginNs;
+		if (offset != stream.bytes.size() || memcmp(decoder.GetCells(), stream.checker->GetCells(), s_kNumCells) != 0)
+			++numMismatches;
+	}
+
+	FieldCodecStats stats;
+	memset(&stats, 0, sizeof(stats));
+	unsigned int numLines = 0;
+	for (unsigned int i = 0; i < numGames; ++i)
+	{
+		const FieldCodecStats& streamStats = streams[i].encoder->GetStats();
+		stats.numKeyframes += streamStats.numKeyframes;
+		stats.numDeltas += streamStats.numDeltas;
+		for (unsigned int op = 0; op < kNumFieldOps; ++op)
+		{
+			stats.numOps[op] += streamStats.numOps[op];
+		}
+		stats.bytes += streamStats.bytes;
+		numLines += streams[i].game->GetNumLinesCleared();
+	}
+
+	const double updates = numUpdates ? (double)numUpdates : 1.0;
+	const double rawBytes = updates * s_kNumCells * sizeof(int);
+	printf("%u games, %u frames, keyframe every %u packets\n", numGames, numFrames, keyframeInterval);
+	printf("  %-32s %12llu\n", "Field changes", (unsigned long long)numUpdates);
+	printf("  %-32s %12u\n", "Keyframes", stats.numKeyframes);
+	printf("  %-32s %12u\n", "Deltas", stats.numDeltas);
+	printf("  %-32s %12u\n", "Cell set ops", stats.numOps[kFieldOp_SetCells]);
+	printf("  %-32s %12u\n", "Row removal ops", stats.numOps[kFieldOp_RemoveRows]);
+	printf("  %-32s %12u\n", "Garbage insertion ops", stats.numOps[kFieldOp_InsertGarbage]);
+	printf("  %-32s %12u\n", "Lines in games still running", numLines);
+	printf("  %-32s %12.2f\n", "Mean bytes per change", stats.bytes / updates);
+	printf("  %-32s %12.1f\n", "Ratio to raw Field (800 B)", rawBytes / (double)stats.bytes);
+	printf("  %-32s %12.1f\n", "Ratio to full nibble board", updates * s_kNumCells / 2 / (double)stats.bytes);
+	printf("  %-32s %12.1f\n", "Ratio to changed nibble rows", (double)changedRowsBytes / (double)stats.bytes);
+	printf("  %-32s %12.0f\n", "Encode ns when unchanged", (double)unchangedEncodeNs / ((double)numFrames * numGames - updates));
+	printf("  %-32s %12.0f\n", "Encode ns per change", (double)encodeNs / updates);
+	printf("  %-32s %12.0f\n", "Decode ns per change", numDecoded ? (double)decodeNs / numDecoded : 0.0);
+	printf("  %-32s %12.1f\n", "Decoded raw MB / s", decodeNs ? numDecoded * s_kNumCells * sizeof(int) / (decodeNs * 1e-9) / (1024.0 * 1024.0) : 0.0);
+	printf("  %-32s %12u\n", "Mismatches", numMismatches);
+
+	for (unsigned int i = 0; i < numGames; ++i)
+	{
+		streams[i].game->Shutdown();
+		delete streams[i].game;
+		delete streams[i].bot;
+		delete streams[i].encoder;
+		delete streams[i].checker;
+	}
+	return numMismatches == 0 ? 0 : 1;
+}
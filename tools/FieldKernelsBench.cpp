@@ -0,0 +1,185 @@
+// Times the work a piece lock does on fields of different widths: checking
+// the rows the piece landed in and, for one lock in four, clearing a line.
+// Compares each FieldKernels set with the cell by cell scan of every row that
+// Game used before, and checks every set gives the same fields.
+//
+// Build and run from the repository root:
+//   g++ -O2 -std=c++17 -I. tools/FieldKernelsBench.cpp FieldKernels.cpp Profiler.cpp -lpthread -o FieldKernelsBench
+//   ./FieldKernelsBench [--locks 2000000] [--height 20]
+#include "FieldKernels.h"
+#include "Profiler.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+static const unsigned int s_kWidths[] = { 10, 16, 32, 64, 128 };
+static const unsigned int s_kNumWidths = sizeof(s_kWidths) / sizeof(s_kWidths[0]);
+
+struct LockResult
+{
+	double nsPerLock;
+	unsigned int numLinesCleared;
+	uint32_t checksum;
+};
+
+//Helper functions
+//================================================================================
+
+static uint32_t NextRandom(uint32_t& state)
+{
+	state ^= state << 13;
+	state ^= state >> 17;
+	state ^= state << 5;
+	return state;
+}
+
+// how Game cleared lines before, every row checked a cell at a time
+static unsigned int RemoveFullRowsPerCell(int* blocks, unsigned int width, unsigned int height)
+{
+	unsigned int numRemoved = 0;
+	for (unsigned int y = 0; y < height; ++y)
+	{
+		bool rowFull = true;
+		for (unsigned int x = 0; x < width; ++x)
+		{
+			if (blocks[x + y * width] == -1)
+			{
+				rowFull = false;
+				break;
+			}
+		}
+		if (!rowFull)
+			continue;
+
+		++numRemoved;
+		for (unsigned int yy = y; yy > 0; --yy)
+		{
+			for (unsigned int x = 0; x < width; ++x)
+			{
+				blocks[x + yy * width] = blocks[x + (yy - 1) * width];
+			}
+		}
+		for (unsigned int x = 0; x < width; ++x)
+		{
+			blocks[x] = -1;
+		}
+	}
+	return numRemoved;
+}
+
+static void FillRowWithHole(int* row, unsigned int width, unsigned int hole)
+{
+	for (unsigned int x = 0; x < width; ++x)
+	{
+		row[x] = x == hole ? -1 : 1;
+	}
+}
+
+// The bottom half of the field is rows with one hole each. A lock lands in
+// four of those rows, and one lock in four fills a hole and clears the row,
+// after which a new row with a hole replaces it so the field stays the same.
+// kernelSet -1 uses RemoveFullRowsPerCell.
+static LockResult TimeLocks(int kernelSet, unsigned int width, unsigned int height, unsigned int numLocks)
+{
+	std::vector<int> blocks(width * height, -1);
+	uint32_t state = 12345;
+	const unsigned int firstStackRow = height / 2;
+	for (unsigned int y = firstStackRow; y < height; ++y)
+	{
+		FillRowWithHole(&blocks[y * width], width, NextRandom(state) % width);
+	}
+	if (kernelSet >= 0)
+		SetFieldKernelSet((FieldKernelSet)kernelSet);
+
+	LockResult result;
+	result.numLinesCleared = 0;
+	const uint64_t beginNs = Profiler::GetTimeNs();
+	for (unsigned int i = 0; i < numLocks; ++i)
+	{
+		const uint32_t r = NextRandom(state);
+		const unsigned int rowBegin = firstStackRow + r % (height - firstStackRow - 3);
+		const bool clears = (r >> 8) % 4 == 0;
+		if (clears)
+		{
+			int* row = &blocks[(rowBegin + 3) * width];
+			for (unsigned int x = 0; x < width; ++x)
+			{
+				row[x] = 1;
+			}
+		}
+
+		const unsigned int numCleared = kernelSet < 0 ? RemoveFullRowsPerCell(blocks.data(), width, height)
+			: RemoveFullFieldRows(blocks.data(), width, height, rowBegin, rowBegin + 4);
+		result.numLinesCleared += numCleared;
+		if (numCleared > 0)
+			FillRowWithHole(&blocks[firstStackRow * width], width, (r >> 16) % width);
+	}
+	result.nsPerLock = (double)(Profiler::GetTimeNs() - beginNs) / numLocks;
+
+	result.checksum = 0;
+	for (size_t i = 0; i < blocks.size(); ++i)
+	{
+		result.checksum = result.checksum * 31 + (uint32_t)blocks[i];
+	}
+	return result;
+}
+
+//================================================================================
+
+int main(int argc, char** argv)
+{
+	unsigned int numLocks = 2000000;
+	unsigned int height = 20;
+	for (int i = 1; i + 1 < argc; i += 2)
+	{
+		const unsigned int value = (unsigned int)atoi(argv[i + 1]);
+		if (strcmp(argv[i], "--locks") == 0)
+			numLocks = value;
+		else if (strcmp(argv[i], "--height") == 0)
+			height = value;
+		else
+		{
+			fprintf(stderr, "usage: FieldKernelsBench [--locks n] [--height n]\n");
+			return 1;
+		}
+	}
+	if (height < 8)
+	{
+		fprintf(stderr, "The field needs to be at least 8 rows high\n");
+		return 1;
+	}
+
+	const FieldKernelSet bestSet = GetFieldKernelSet();
+	printf("%u locks a width, %u rows, %s picked at runtime, ns per lock\n", numLocks, height, GetFieldKernelSetName(bestSet));
+	printf("  %-12s %12s", "Width", "per cell");
+	for (unsigned int set = 0; set < kNumFieldKernelSets; ++set)
+	{
+		printf(" %12s", GetFieldKernelSetName((FieldKernelSet)set));
+	}
+	printf("\n");
+
+	unsigned int numMismatches = 0;
+	for (unsigned int w = 0; w < s_kNumWidths; ++w)
+	{
+		const unsigned int width = s_kWidths[w];
+		const LockResult perCell = TimeLocks(-1, width, height, numLocks);
+		printf("  %-12u %12.1f", width, perCell.nsPerLock);
+		for (unsigned int set = 0; set < kNumFieldKernelSets; ++set)
+		{
+			if (!IsFieldKernelSetSupported((FieldKernelSet)set))
+			{
+				printf(" %12s", "-");
+				continue;
+			}
+			const LockResult kernels = TimeLocks((int)set, width, height, numLocks);
+			numMismatches += kernels.checksum != perCell.checksum || kernels.numLinesCleared != perCell.numLinesCleared;
+			printf(" %12.1f", kernels.nsPerLock);
+		}
+		printf("\n");
+	}
+	SetFieldKernelSet(bestSet);
+
+	printf("  %-32s %12u\n", "Mismatches", numMismatches);
+	return numMismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,208 @@
+// Exercises the persistent leaderboard. Submits many scores the way the game
+// does, timing the game thread side, then checks ranks against a sorted copy,
+// reopens the log to time how soon the best scores and the full ranking are
+// back, and finally damages the log the way a crash or a bad disk would and
+// checks what comes back.
+//
+// Build and run from the repository root:
+//   g++ -O2 -std=c++17 -I. tools/LeaderboardBench.cpp Leaderboard.cpp Profiler.cpp -lpthread -o LeaderboardBench
+//   ./LeaderboardBench [--scores 1000000] [--queries 1000000] [--path /tmp/LeaderboardBench.log]
+#include "Leaderboard.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <chrono>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <string>
+#include <thread>
+#include <vector>
+
+static const unsigned int s_kRecordBytes = 32;
+static const unsigned int s_kLogHeaderBytes = 16;
+
+//Helper functions
+//================================================================================
+
+static uint32_t NextRandom(uint32_t& state)
+{
+	state ^= state << 13;
+	state ^= state >> 17;
+	state ^= state << 5;
+	return state;
+}
+
+// roughly how scores spread out, most games are short and a few go on for a long time
+static uint32_t RandomScore(uint32_t& state)
+{
+	const uint32_t lines = NextRandom(state) % 40 + (NextRandom(state) % 8 == 0 ? NextRandom(state) % 400 : 0);
+	return lines * 100 + NextRandom(state) % 100;
+}
+
+static double SecondsSince(uint64_t beginNs)
+{
+	return (Profiler::GetTimeNs() - beginNs) * 1e-9;
+}
+
+static unsigned int CountRankErrors(Leaderboard& leaderboard, const std::vector<uint32_t>& sortedScores, unsigned int numQueries, uint32_t seed)
+{
+	unsigned int numErrors = 0;
+	uint32_t state = seed;
+	for (unsigned int i = 0; i < numQueries; ++i)
+	{
+		const uint32_t score = RandomScore(state);
+		const uint64_t expected = 1 + (sortedScores.end() - std::upper_bound(sortedScores.begin(), sortedScores.end(), score));
+		numErrors += leaderboard.GetRank(score) != expected;
+	}
+	return numErrors;
+}
+
+//================================================================================
+
+int main(int argc, char** argv)
+{
+	unsigned int numScores = 1000000;
+	unsigned int numQueries = 1000000;
+	std::string path = "/tmp/LeaderboardBench.log";
+	for (int i = 1; i + 1 < argc; i += 2)
+	{
+		if (strcmp(argv[i], "--scores") == 0)
+			numScores = (unsigned int)atoi(argv[i + 1]);
+		else if (strcmp(argv[i], "--queries") == 0)
+			numQueries = (unsigned int)atoi(argv[i + 1]);
+		else if (strcmp(argv[i], "--path") == 0)
+			path = argv[i + 1];
+		else
+		{
+			fprintf(stderr, "usage: LeaderboardBench [--scores n] [--queries n] [--path log]\n");
+			return 1;
+		}
+	}
+	remove(path.c_str());
+	remove((path + ".top").c_str());
+
+	unsigned int numFailures = 0;
+	std::vector<uint32_t> scores;
+	scores.reserve(numScores);
+
+	// submitting, as the game thread would
+	{
+		Leaderboard leaderboard;
+		if (!leaderboard.Open(path.c_str()))
+			return 1;
+
+		uint32_t state = 1;
+		std::vector<uint32_t> submitNs;
+		submitNs.reserve(numScores);
+		unsigned int numFullQueue = 0;
+		const uint64_t beginNs = Profiler::GetTimeNs();
+		for (unsigned int i = 0; i < numScores; ++i)
+		{
+			const uint32_t score = RandomScore(state);
+			scores.push_back(score);
+			for (;;)
+			{
+				const uint64_t submitBeginNs = Profiler::GetTimeNs();
+				const bool submitted = leaderboard.Submit(score, score / 100);
+				submitNs.push_back((uint32_t)(Profiler::GetTimeNs() - submitBeginNs));
+				if (submitted)
+					break;
+				// far more than a game ever submits, so wait for the writer to catch up
+				++numFullQueue;
+				std::this_thread::sleep_for(std::chrono::microseconds(100));
+			}
+			ScoreSubmitResult result;
+			while (leaderboard.PopResult(result))
+			{
+			}
+		}
+		leaderboard.Flush();
+		const double seconds = SecondsSince(beginNs);
+
+		std::sort(scores.begin(), scores.end());
+		std::sort(submitNs.begin(), submitNs.end());
+		const uint64_t queryBeginNs = Profiler::GetTimeNs();
+		const unsigned int numRankErrors = CountRankErrors(leaderboard, scores, numQueries, 2);
+		const double querySeconds = SecondsSince(queryBeginNs);
+		numFailures += numRankErrors;
+		numFailures += leaderboard.GetNumEntries() != numScores;
+
+		printf("%u scores submitted\n", numScores);
+		printf("  %-32s %12.0f\n", "Scores written / s", numScores / seconds);
+		// the worst case is mostly the writer thread being scheduled in the middle of a Submit
+		printf("  %-32s %12u\n", "Median Submit ns", submitNs[submitNs.size() / 2]);
+		printf("  %-32s %12u\n", "99.9th percentile Submit ns", submitNs[submitNs.size() * 999 / 1000]);
+		printf("  %-32s %12u\n", "Worst Submit ns", submitNs.back());
+		printf("  %-32s %12u\n", "Waits on a full queue", numFullQueue);
+		printf("  %-32s %12.0f\n", "Rank lookup ns, incl. checking", querySeconds * 1e9 / (numQueries ? numQueries : 1));
+		printf("  %-32s %12u\n", "Rank errors", numRankErrors);
+		leaderboard.PrintStats();
+		leaderboard.Close();
+	}
+
+	// reopening, where the best scores come from the index straight away
+	{
+		Leaderboard leaderboard;
+		const uint64_t beginNs = Profiler::GetTimeNs();
+		if (!leaderboard.Open(path.c_str()))
+			return 1;
+		const double openSeconds = SecondsSince(beginNs);
+		const uint32_t highScoreAtOpen = leaderboard.GetHighScore();
+		ScoreEntry topScores[Leaderboard::kNumTopScores];
+		unsigned int numTopScores = 0;
+		leaderboard.GetTopScores(topScores, Leaderboard::kNumTopScores, numTopScores);
+		leaderboard.Flush();
+		const double loadSeconds = SecondsSince(beginNs);
+
+		bool topScoresMatch = numTopScores == (scores.size() < Leaderboard::kNumTopScores ? scores.size() : Leaderboard::kNumTopScores);
+		for (unsigned int i = 0; i < numTopScores && topScoresMatch; ++i)
+		{
+			topScoresMatch = topScores[i].score == scores[scores.size() - 1 - i];
+		}
+		numFailures += !topScoresMatch || highScoreAtOpen != scores.back() || leaderboard.GetNumEntries() != numScores;
+
+		printf("Reopened\n");
+		printf("  %-32s %12.3f\n", "Open ms, best scores ready", openSeconds * 1e3);
+		printf("  %-32s %12.3f\n", "Ms until every score ranked", loadSeconds * 1e3);
+		printf("  %-32s %12s\n", "Index matches sorted scores", topScoresMatch ? "yes" : "NO");
+		leaderboard.Close();
+	}
+
+	// a crash part way through a record, and a record damaged in the middle
+	{
+		FILE* file = fopen(path.c_str(), "r+b");
+		const uint8_t torn[13] = { 0x48, 0x53, 0x43, 0x52 };
+		const bool tornWritten = file && fseek(file, 0, SEEK_END) == 0 && fwrite(torn, sizeof(torn), 1, file) == 1;
+		const uint8_t damage = 0xff;
+		const long damagedOffset = (long)(s_kLogHeaderBytes + (numScores / 2) * s_kRecordBytes + 5);
+		const bool damaged = file && fseek(file, damagedOffset, SEEK_SET) == 0 && fwrite(&damage, 1, 1, file) == 1;
+		if (file)
+			fclose(file);
+
+		Leaderboard leaderboard;
+		if (!leaderboard.Open(path.c_str()))
+			return 1;
+		leaderboard.Flush();
+		const uint64_t numRecovered = leaderboard.GetNumEntries();
+		const LeaderboardStats stats = leaderboard.GetStats();
+		leaderboard.Submit(1, 0);
+		leaderboard.Flush();
+		const uint64_t numAfterSubmit = leaderboard.GetNumEntries();
+		leaderboard.Close();
+
+		const bool recovered = tornWritten && damaged && numRecovered == numScores - 1 && stats.numCorruptRecords == 1
+			&& stats.numTruncatedBytes == sizeof(torn) && numAfterSubmit == numScores;
+		numFailures += !recovered;
+
+		printf("Torn tail and damaged record\n");
+		printf("  %-32s %12llu\n", "Scores recovered", (unsigned long long)numRecovered);
+		printf("  %-32s %12u\n", "Corrupt records skipped", stats.numCorruptRecords);
+		printf("  %-32s %12u\n", "Torn bytes dropped", stats.numTruncatedBytes);
+		printf("  %-32s %12llu\n", "Scores after one more", (unsigned long long)numAfterSubmit);
+	}
+
+	remove(path.c_str());
+	remove((path + ".top").c_str());
+	printf("%s\n", numFailures == 0 ? "OK" : "FAILED");
+	return numFailures == 0 ? 0 : 1;
+}
@@ -0,0 +1,34 @@
+#!/bin/sh
+# Builds tetris_bench and tetris_headless three ways in builds/ (or $1):
+#   o2    plain -O2
+#   lto   -O2 with link time optimization
+#   pgo   -O2 trained on the pgo_train workloads and rebuilt with the profile
+# then runs tetris_bench from each, the last two against the -O2 results, so
+# the speedups are printed and also kept in builds/*.json.
+#
+# Run from anywhere: tools/PgoBuild.sh [build directory]
+set -e
+
+sourceDir=$(cd "$(dirname "$0")/.." && pwd)
+buildDir=${1:-"$sourceDir/builds"}
+mkdir -p "$buildDir"
+buildDir=$(cd "$buildDir" && pwd)
+targets="--target tetris_bench tetris_headless"
+
+cmake -S "$sourceDir" -B "$buildDir/o2" -DCMAKE_BUILD_TYPE=Release
+cmake --build "$buildDir/o2" $targets
+
+cmake -S "$sourceDir" -B "$buildDir/lto" -DCMAKE_BUILD_TYPE=Release -DTETRIS_LTO=ON
+cmake --build "$buildDir/lto" $targets
+
+# the profile is read back from the directory it was trained in
+rm -rf "$buildDir/pgo"
+cmake -S "$sourceDir" -B "$buildDir/pgo" -DCMAKE_BUILD_TYPE=Release -DTETRIS_PGO=GENERATE
+cmake --build "$buildDir/pgo" $targets
+cmake --build "$buildDir/pgo" --target pgo_train
+cmake -S "$sourceDir" -B "$buildDir/pgo" -DTETRIS_PGO=USE
+cmake --build "$buildDir/pgo" $targets
+
+"$buildDir/o2/tetris_bench" --label o2 --json "$buildDir/o2.json"
+"$buildDir/lto/tetris_bench" --label lto --json "$buildDir/lto.json" --compare "$buildDir/o2.json"
+"$buildDir/pgo/tetris_bench" --label pgo --json "$buildDir/pgo.json" --compare "$buildDir/o2.json"
@@ -0,0 +1,343 @@
+// Compares SparseField with a dense int per cell field, the way Game stores
+// one, on boards from 10 x 20 up to sizes a dense field can't allocate.
+// Random pieces are hard dropped at random columns, and separately rows that
+// are one block short are completed to time clearing a line. A small board is
+// also played with both side by side to check they always agree.
+//
+// Build and run from the repository root:
+//   g++ -O2 -std=c++17 -I. tools/SparseFieldBench.cpp SparseField.cpp FieldKernels.cpp Game.cpp Hud.cpp Render.cpp Profiler.cpp -lpthread -o SparseFieldBench
+//   ./SparseFieldBench [--drops 200000] [--clears 20000] [--max-dense-cells 20000000]
+#include "SparseField.h"
+#include "FieldKernels.h"
+#include "Profiler.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+struct BoardSize
+{
+	unsigned int width;
+	unsigned int height;
+};
+
+static const BoardSize s_kSizes[] = { { 10, 20 }, { 256, 256 }, { 1024, 1024 }, { 4096, 4096 }, { 65536, 65536 }, { 1000000, 100000 } };
+static const unsigned int s_kNumSizes = sizeof(s_kSizes) / sizeof(s_kSizes[0]);
+
+// The dense field, an int per cell, with pieces locked the way Game locks them.
+struct DenseField
+{
+	Field field;
+
+	bool Init(unsigned int width, unsigned int height)
+	{
+		field.width = width;
+		field.height = height;
+		field.staticBlocks = new int[(size_t)width * height];
+		memset(field.staticBlocks, 0xff, (size_t)width * height * sizeof(int));
+		return true;
+	}
+
+	void Shutdown()
+	{
+		delete[] field.staticBlocks;
+	}
+
+	bool Overlaps(const TetrominoInstance& instance) const
+	{
+		return DoesTetrominoOverlap(instance, field);
+	}
+
+	unsigned int GetDropDistance(const TetrominoInstance& instance) const
+	{
+		return GetTetrominoDropDistance(instance, field);
+	}
+
+	unsigned int AddTetromino(const TetrominoInstance& instance)
+	{
+		const Tetromino::BlockCoords& blockCoords = GetTetromino(instance.m_tetrominoType).blockCoord[instance.m_rot];
+		unsigned int rowBegin = field.height;
+		unsigned int rowEnd = 0;
+		for (unsigned int i = 0; i < Tetromino::kNumBlocks; ++i)
+		{
+			const unsigned int x = (unsigned int)(instance.m_pos.x + (int)blockCoords[i].x);
+			const unsigned int y = (unsigned int)(instance.m_pos.y + (int)blockCoords[i].y);
+			field.staticBlocks[(size_t)y * field.width + x] = (int)instance.m_tetrominoType;
+			rowBegin = y < rowBegin ? y : rowBegin;
+			rowEnd = y + 1 > rowEnd ? y + 1 : rowEnd;
+		}
+		return RemoveFullFieldRows(field.staticBlocks, field.width, field.height, rowBegin, rowEnd);
+	}
+};
+
+//Helper functions
+//================================================================================
+
+static uint32_t NextRandom(uint32_t& state)
+{
+	state ^= state << 13;
+	state ^= state >> 17;
+	state ^= state << 5;
+	return state;
+}
+
+static TetrominoInstance RandomPiece(uint32_t& state, unsigned int width)
+{
+	TetrominoInstance instance;
+	instance.m_tetrominoType = (TetrominoType)(NextRandom(state) % kNumTetrominoTypes);
+	instance.m_rot = NextRandom(state) % Tetromino::kNumRots;
+	instance.m_pos.x = (int)(NextRandom(state) % (width - 3));
+	instance.m_pos.y = 0;
+	return instance;
+}
+
+static void EmptyField(DenseField& dense)
+{
+	memset(dense.field.staticBlocks, 0xff, (size_t)dense.field.width * dense.field.height * sizeof(int));
+}
+
+static void EmptyField(SparseField& sparse)
+{
+	sparse.Init(sparse.GetWidth(), sparse.GetHeight());
+}
+
+// Hard drops from the top at random columns, emptying the field when a piece
+// can't spawn, which only small boards ever get to. Returns ns per drop and
+// lock, field is either kind.
+template<typename FieldType>
+static double TimeDrops(FieldType& field, unsigned int width, unsigned int numDrops, uint32_t seed)
+{
+	uint32_t state = seed;
+	uint64_t totalNs = 0;
+	unsigned int numDropped = 0;
+	for (unsigned int i = 0; i < numDrops; ++i)
+	{
+		TetrominoInstance instance = RandomPiece(state, width);
+		if (field.Overlaps(instance))
+		{
+			EmptyField(field);
+			continue;
+		}
+
+		const uint64_t beginNs = Profiler::GetTimeNs();
+		instance.m_pos.y += (int)field.GetDropDistance(instance);
+		field.AddTetromino(instance);
+		totalNs += Profiler::GetTimeNs() - beginNs;
+		++numDropped;
+	}
+	return numDropped ? (double)totalNs / numDropped : 0.0;
+}
+
+// refilling the row between clears is a SetCell a cell, so fewer on wide boards
+static unsigned int GetNumClears(unsigned int numClears, unsigned int width)
+{
+	const unsigned int maxClears = 200000000 / width;
+	return numClears < maxClears ? numClears : maxClears;
+}
+
+// Completes a row that is one block short with a vertical I, then refills it
+// outside the timing. Returns ns per lock that cleared a line.
+static double TimeSparseClears(SparseField& field, unsigned int numClears, uint32_t seed)
+{
+	const unsigned int width = field.GetWidth();
+	const unsigned int height = field.GetHeight();
+	uint32_t state = seed;
+	uint64_t totalNs = 0;
+	for (unsigned int i = 0; i < numClears; ++i)
+	{
+		const unsigned int hole = NextRandom(state) % width;
+		const unsigned int row = height - 1;
+		for (unsigned int x = 0; x < width; ++x)
+		{
+			if (x != hole)
+				field.SetCell(x, row, kBlockSprite_Garbage);
+		}
+		// the vertical I is column 2 of its box in this rotation
+		TetrominoInstance instance;
+		instance.m_tetrominoType = kTetrominoType_I;
+		instance.m_rot = 1;
+		instance.m_pos.x = (int)hole - 2;
+		instance.m_pos.y = (int)row - 3;
+		if (instance.m_pos.x < 0 || instance.m_pos.x + 2 >= (int)width || field.Overlaps(instance))
+		{
+			for (unsigned int x = 0; x < width; ++x)
+			{
+				field.SetCell(x, row, -1);
+			}
+			continue;
+		}
+
+		const uint64_t beginNs = Profiler::GetTimeNs();
+		field.AddTetromino(instance);
+		totalNs += Profiler::GetTimeNs() - beginNs;
+		for (unsigned int y = row - 2; y <= row; ++y)
+		{
+			field.SetCell(hole, y, -1);
+		}
+	}
+	return numClears ? (double)totalNs / numClears : 0.0;
+}
+
+static double TimeDenseClears(DenseField& dense, unsigned int numClears, uint32_t seed)
+{
+	const unsigned int width = dense.field.width;
+	const unsigned int height = dense.field.height;
+	int* blocks = dense.field.staticBlocks;
+	uint32_t state = seed;
+	uint64_t totalNs = 0;
+	for (unsigned int i = 0; i < numClears; ++i)
+	{
+		const unsigned int hole = NextRandom(state) % width;
+		const unsigned int row = height - 1;
+		for (unsigned int x = 0; x < width; ++x)
+		{
+			blocks[(size_t)row * width + x] = x != hole ? (int)kBlockSprite_Garbage : -1;
+		}
+		TetrominoInstance instance;
+		instance.m_tetrominoType = kTetrominoType_I;
+		instance.m_rot = 1;
+		instance.m_pos.x = (int)hole - 2;
+		instance.m_pos.y = (int)row - 3;
+		if (instance.m_pos.x < 0 || instance.m_pos.x + 2 >= (int)width || DoesTetrominoOverlap(instance, dense.field))
+		{
+			memset(&blocks[(size_t)row * width], 0xff, width * sizeof(int));
+			continue;
+		}
+
+		const uint64_t beginNs = Profiler::GetTimeNs();
+		dense.AddTetromino(instance);
+		totalNs += Profiler::GetTimeNs() - beginNs;
+		for (unsigned int y = row - 2; y <= row; ++y)
+		{
+			blocks[(size_t)y * width + hole] = -1;
+		}
+	}
+	return numClears ? (double)totalNs / numClears : 0.0;
+}
+
+// plays both side by side on a board narrow enough to clear lines, each piece
+// going where it lands lowest so rows fill up
+static unsigned int CountMismatches(unsigned int numDrops)
+{
+	const unsigned int width = 12;
+	const unsigned int height = 40;
+	SparseField sparse;
+	sparse.Init(width, height);
+	DenseField dense;
+	dense.Init(width, height);
+	Field copy;
+	copy.width = width;
+	copy.height = height;
+	copy.staticBlocks = new int[width * height];
+
+	unsigned int numMismatches = 0;
+	unsigned int numLinesCleared = 0;
+	uint32_t state = 99;
+	for (unsigned int i = 0; i < numDrops; ++i)
+	{
+		TetrominoInstance instance = RandomPiece(state, width);
+		int lowestY = -1;
+		for (int x = -3; x < (int)width; ++x)
+		{
+			TetrominoInstance test = instance;
+			test.m_pos.x = x;
+			if (DoesTetrominoOverlap(test, dense.field))
+				continue;
+			const int landingY = (int)dense.GetDropDistance(test);
+			if (landingY > lowestY)
+			{
+				lowestY = landingY;
+				instance.m_pos.x = x;
+			}
+		}
+
+		const bool overlaps = DoesTetrominoOverlap(instance, dense.field);
+		numMismatches += overlaps != sparse.Overlaps(instance);
+		if (overlaps)
+		{
+			// topped out, start again
+			sparse.Init(width, height);
+			memset(dense.field.staticBlocks, 0xff, width * height * sizeof(int));
+			continue;
+		}
+
+		const unsigned int distance = dense.GetDropDistance(instance);
+		numMismatches += distance != sparse.GetDropDistance(instance);
+		instance.m_pos.y += (int)distance;
+		const unsigned int numCleared = dense.AddTetromino(instance);
+		numMismatches += numCleared != sparse.AddTetromino(instance);
+		numLinesCleared += numCleared;
+
+		sparse.CopyToField(0, 0, copy);
+		numMismatches += memcmp(copy.staticBlocks, dense.field.staticBlocks, width * height * sizeof(int)) != 0;
+	}
+	printf("  %-32s %12u\n", "Lines cleared while checking", numLinesCleared);
+
+	delete[] copy.staticBlocks;
+	dense.Shutdown();
+	return numMismatches;
+}
+
+//================================================================================
+
+int main(int argc, char** argv)
+{
+	unsigned int numDrops = 200000;
+	unsigned int numClears = 20000;
+	double maxDenseCells = 20000000.0;
+	for (int i = 1; i + 1 < argc; i += 2)
+	{
+		const unsigned int value = (unsigned int)atoi(argv[i + 1]);
+		if (strcmp(argv[i], "--drops") == 0)
+			numDrops = value;
+		else if (strcmp(argv[i], "--clears") == 0)
+			numClears = value;
+		else if (strcmp(argv[i], "--max-dense-cells") == 0)
+			maxDenseCells = value;
+		else
+		{
+			fprintf(stderr, "usage: SparseFieldBench [--drops n] [--clears n] [--max-dense-cells n]\n");
+			return 1;
+		}
+	}
+
+	printf("%u drops and %u line clears a board, dense fields up to %.0f cells\n", numDrops, numClears, maxDenseCells);
+	const unsigned int numMismatches = CountMismatches(numDrops / 4);
+	printf("  %-32s %12u\n", "Mismatches with dense", numMismatches);
+
+	printf("\n  %-16s %10s %10s %10s %10s %10s %10s %10s\n", "Board", "Init ms", "Drop ns", "Clear ns", "Init ms", "Drop ns", "Clear ns", "MB");
+	printf("  %-16s %32s %43s\n", "", "--------- dense ---------", "---------------- sparse -----------------");
+	for (unsigned int s = 0; s < s_kNumSizes; ++s)
+	{
+		const BoardSize& size = s_kSizes[s];
+		char name[32];
+		snprintf(name, sizeof(name), "%u x %u", size.width, size.height);
+		printf("  %-16s", name);
+
+		if ((double)size.width * size.height <= maxDenseCells)
+		{
+			DenseField dense;
+			uint64_t beginNs = Profiler::GetTimeNs();
+			dense.Init(size.width, size.height);
+			const double initMs = (Profiler::GetTimeNs() - beginNs) * 1e-6;
+			const double dropNs = TimeDrops(dense, size.width, numDrops, 1);
+			const double clearNs = TimeDenseClears(dense, GetNumClears(numClears, size.width), 2);
+			printf(" %10.3f %10.0f %10.0f", initMs, dropNs, clearNs);
+			dense.Shutdown();
+		}
+		else
+		{
+			printf(" %10s %10s %10s", "-", "-", "-");
+		}
+
+		SparseField sparse;
+		uint64_t beginNs = Profiler::GetTimeNs();
+		sparse.Init(size.width, size.height);
+		const double initMs = (Profiler::GetTimeNs() - beginNs) * 1e-6;
+		const double dropNs = TimeDrops(sparse, size.width, numDrops, 1);
+		const double clearNs = TimeSparseClears(sparse, GetNumClears(numClears, size.width), 2);
+		const SparseFieldStats stats = sparse.GetStats();
+		printf(" %10.3f %10.0f %10.0f %10.1f\n", initMs, dropNs, clearNs, stats.memoryBytes / (1024.0 * 1024.0));
+	}
+	return numMismatches == 0 ? 0 : 1;
+}
@@ -0,0 +1,494 @@
+// Micro benchmarks for the game's hot paths: overlap and drop tests, locking
+// a piece with 0 to 4 line clears, spawning, whole Game::Update ticks and
+// Game::Draw against the null renderer. Each benchmark is warmed up, then
+// timed over many samples of a batch of operations, and reports the median,
+// 99th percentile and fastest ns per operation. Results can also be written
+// as JSON so runs can be compared over time, and --compare reads such a file
+// back and reports each median's speedup over it, which is how optimized
+// builds are measured against plain -O2.
+//
+// Locks reset the four rows they clear from before each operation, which is
+// a 160 byte copy and is included in their times.
+//
+// Build and run from the repository root:
+//   g++ -O2 -std=c++17 -I. tools/TetrisBench.cpp Game.cpp FieldKernels.cpp Hud.cpp Render.cpp NullRenderer.cpp Profiler.cpp -lpthread -o tetris_bench
+//   ./tetris_bench [--samples 50] [--warmup 5] [--sample-us 2000] [--filter text] [--json out.json] [--label text]
+//                  [--compare baseline.json]
+#include "Game.h"
+#include "FieldKernels.h"
+#include "NullRenderer.h"
+#include "Profiler.h"
+#include <algorithm>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <vector>
+
+struct BaselineResult
+{
+	char name[64];
+	double medianNs;
+};
+
+struct BenchSettings
+{
+	unsigned int numSamples;
+	unsigned int numWarmupSamples;
+	// batches are sized so a sample takes about this long
+	unsigned int sampleUs;
+	const char* filter;
+	// from --compare, empty otherwise
+	std::vector<BaselineResult> baseline;
+};
+
+struct BenchResult
+{
+	char name[64];
+	unsigned int numSamples;
+	unsigned int opsPerSample;
+	double medianNs;
+	double p99Ns;
+	double minNs;
+	double meanNs;
+	// baseline median over this one, 0 if the baseline didn't have it
+	double speedup;
+};
+
+// Reaches the Game steps that Update normally calls.
+struct GameBench
+{
+	static void AddTetronimoToField(Game& game, const TetrominoInstance& instance)
+	{
+		game.AddTetronimoToField(game.m_field, instance);
+	}
+
+	static bool SpawnTetromino(Game& game)
+	{
+		return game.SpawnTetromino();
+	}
+};
+
+//Helper functions
+//================================================================================
+
+// Keeps the compiler from dropping work whose result is otherwise unused.
+template<typename T>
+static inline void DoNotOptimize(const T& value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+	asm volatile("" : : "r,m"(value) : "memory");
+#else
+	static const void* volatile s_sink;
+	s_sink = &value;
+#endif
+}
+
+static uint32_t NextRandom(uint32_t& state)
+{
+	state ^= state << 13;
+	state ^= state >> 17;
+	state ^= state << 5;
+	return state;
+}
+
+// Calls sample(numOps), which returns the ns its timed part took, with the
+// batch doubled until a sample takes settings.sampleUs, then warms up and
+// takes settings.numSamples samples.
+template<typename SampleFunction>
+static bool RunBench(const char* name, const BenchSettings& settings, SampleFunction sample, std::vector<BenchResult>& results)
+{
+	if (settings.filter && !strstr(name, settings.filter))
+		return false;
+
+	unsigned int opsPerSample = 1;
+	while (opsPerSample < (1u << 24) && sample(opsPerSample) < (uint64_t)settings.sampleUs * 1000)
+	{
+		opsPerSample *= 2;
+	}
+	for (unsigned int i = 0; i < settings.numWarmupSamples; ++i)
+	{
+		sample(opsPerSample);
+	}
+
+	std::vector<double> nsPerOp(settings.numSamples);
+	double totalNs = 0.0;
+	for (unsigned int i = 0; i < settings.numSamples; ++i)
+	{
+		nsPerOp[i] = (double)sample(opsPerSample) / opsPerSample;
+		totalNs += nsPerOp[i];
+	}
+	std::sort(nsPerOp.begin(), nsPerOp.end());
+
+	BenchResult result;
+	snprintf(result.name, sizeof(result.name), "%s", name);
+	result.numSamples = settings.numSamples;
+	result.opsPerSample = opsPerSample;
+	const size_t middle = nsPerOp.size() / 2;
+	result.medianNs = nsPerOp.size() % 2 ? nsPerOp[middle] : 0.5 * (nsPerOp[middle - 1] + nsPerOp[middle]);
+	const size_t p99Index = (nsPerOp.size() * 99 + 99) / 100 - 1;
+	result.p99Ns = nsPerOp[p99Index];
+	result.minNs = nsPerOp[0];
+	result.meanNs = totalNs / settings.numSamples;
+	result.speedup = 0.0;
+	for (size_t i = 0; i < settings.baseline.size(); ++i)
+	{
+		if (strcmp(settings.baseline[i].name, name) == 0 && result.medianNs > 0.0)
+			result.speedup = settings.baseline[i].medianNs / result.medianNs;
+	}
+	results.push_back(result);
+
+	printf("  %-32s %12.1f %12.1f %12.1f %12u", result.name, result.medianNs, result.p99Ns, result.minNs, result.opsPerSample);
+	if (result.speedup > 0.0)
+		printf(" %11.3fx", result.speedup);
+	printf("\n");
+	fflush(stdout);
+	return true;
+}
+
+static void StartGame(Game& game, uint32_t seed)
+{
+	GameInput input;
+	memset(&input, 0, sizeof(input));
+	game.Reset();
+	game.SetSeed(seed);
+	input.start = true;
+	game.Update(input, 1.0f / 60.0f);
+}
+
+// a few rows of random blocks at the bottom of an empty field, like mid game
+static void FillStack(const Field& field, unsigned int numRows, uint32_t& state)
+{
+	for (unsigned int y = field.height - numRows; y < field.height; ++y)
+	{
+		for (unsigned int x = 0; x < field.width; ++x)
+		{
+			field.staticBlocks[y * field.width + x] = NextRandom(state) % 3 == 0 ? -1 : (int)kBlockSprite_Garbage;
+		}
+	}
+}
+
+// Pieces anywhere in the top part of the field, in every rotation, so some
+// overlap the stack or the walls and some don't.
+static std::vector<TetrominoInstance> MakePieces(const Field& field, bool mustFit, uint32_t& state)
+{
+	std::vector<TetrominoInstance> pieces;
+	while (pieces.size() < 256)
+	{
+		TetrominoInstance instance;
+		instance.m_tetrominoType = (TetrominoType)(NextRandom(state) % kNumTetrominoTypes);
+		instance.m_rot = NextRandom(state) % Tetromino::kNumRots;
+		instance.m_pos.x = (int)(NextRandom(state) % (field.width + 2)) - 2;
+		instance.m_pos.y = (int)(NextRandom(state) % (field.height - 2));
+		if (!mustFit || !DoesTetrominoOverlap(instance, field))
+			pieces.push_back(instance);
+	}
+	return pieces;
+}
+
+// Bottom four rows where a vertical I in column 4 clears numLines of them and
+// the rest still have a second hole.
+static void MakeClearRows(const Field& field, unsigned int numLines, std::vector<int>& rows, TetrominoInstance& instance)
+{
+	const unsigned int holeX = 4;
+	rows.assign(field.width * 4, (int)kBlockSprite_Garbage);
+	for (unsigned int row = 0; row < 4; ++row)
+	{
+		rows[row * field.width + holeX] = -1;
+		// counted from the bottom, so the clears are the lowest rows
+		if (3 - row >= numLines)
+			rows[row * field.width + (holeX + 3) % field.width] = -1;
+	}
+	instance.m_tetrominoType = kTetrominoType_I;
+	instance.m_rot = 1;
+	instance.m_pos.x = (int)holeX - 2;
+	instance.m_pos.y = (int)field.height - 4;
+}
+
+// Mostly waiting and moving with the odd hard drop, the same mix as
+// TetrisEnvBench, so pieces lock every few dozen ticks.
+static std::vector<GameInput> MakeInputs(uint32_t& state)
+{
+	std::vector<GameInput> inputs(4096);
+	for (size_t i = 0; i < inputs.size(); ++i)
+	{
+		GameInput& input = inputs[i];
+		memset(&input, 0, sizeof(input));
+		const uint32_t r = NextRandom(state) % 32;
+		input.moveLeft = r == 0;
+		input.moveRight = r == 1;
+		input.rotClockwise = r == 2;
+		input.rotAnticlockwise = r == 3;
+		input.softDrop = r == 4;
+		input.hardDrop = r == 31;
+	}
+	return inputs;
+}
+
+static const char* GetCompilerName()
+{
+#if defined(__clang__)
+	return "clang " __clang_version__;
+#elif defined(__GNUC__)
+	return "gcc " __VERSION__;
+#elif defined(_MSC_VER)
+	return "msvc";
+#else
+	return "unknown";
+#endif
+}
+
+// Reads the names and medians back from a file WriteJson wrote, which has a
+// result a line.
+static bool LoadBaseline(const char* path, std::vector<BaselineResult>& baseline, char (&label)[128])
+{
+	FILE* file = fopen(path, "r");
+	if (!file)
+	{
+		fprintf(stderr, "Couldn't open %s\n", path);
+		return false;
+	}
+
+	label[0] = 0;
+	char line[512];
+	while (fgets(line, sizeof(line), file))
+	{
+		const char* labelField = strstr(line, "\"label\": \"");
+		if (labelField)
+			sscanf(labelField, "\"label\": \"%127[^\"]", label);
+		const char* nameField = strstr(line, "\"name\": \"");
+		const char* medianField = strstr(line, "\"medianNs\": ");
+		BaselineResult result;
+		if (nameField && medianField && sscanf(nameField, "\"name\": \"%63[^\"]", result.name) == 1
+			&& sscanf(medianField, "\"medianNs\": %lf", &result.medianNs) == 1)
+		{
+			baseline.push_back(result);
+		}
+	}
+	fclose(file);
+
+	if (baseline.empty())
+	{
+		fprintf(stderr, "%s has no tetris_bench results\n", path);
+		return false;
+	}
+	return true;
+}
+
+static bool WriteJson(const char* path, const char* label, const char* baselineLabel, const std::vector<BenchResult>& results)
+{
+	FILE* file = fopen(path, "w");
+	if (!file)
+	{
+		fprintf(stderr, "Couldn't open %s for writing\n", path);
+		return false;
+	}
+
+	fprintf(file, "{\n");
+	fprintf(file, "  \"benchmark\": \"tetris_bench\",\n");
+	fprintf(file, "  \"label\": \"%s\",\n", label);
+	fprintf(file, "  \"compiler\": \"%s\",\n", GetCompilerName());
+	fprintf(file, "  \"fieldKernels\": \"%s\",\n", GetFieldKernelSetName(GetFieldKernelSet()));
+	fprintf(file, "  \"timestamp\": %lld,\n", (long long)time(NULL));
+	if (baselineLabel)
+		fprintf(file, "  \"baseline\": \"%s\",\n", baselineLabel);
+	fprintf(file, "  \"results\": [\n");
+	for (size_t i = 0; i < results.size(); ++i)
+	{
+		const BenchResult& result = results[i];
+		fprintf(file, "    { \"name\": \"%s\", \"samples\": %u, \"opsPerSample\": %u, \"medianNs\": %.2f, \"p99Ns\": %.2f, \"minNs\": %.2f, \"meanNs\": %.2f",
+			result.name, result.numSamples, result.opsPerSample, result.medianNs, result.p99Ns, result.minNs, result.meanNs);
+		if (result.speedup > 0.0)
+			fprintf(file, ", \"speedup\": %.4f", result.speedup);
+		fprintf(file, " }%s\n", i + 1 < results.size() ? "," : "");
+	}
+	fprintf(file, "  ]\n}\n");
+
+	const bool written = fclose(file) == 0;
+	if (!written)
+		fprintf(stderr, "Couldn't write %s\n", path);
+	return written;
+}
+
+//================================================================================
+
+int main(int argc, char** argv)
+{
+	BenchSettings settings;
+	settings.numSamples = 50;
+	settings.numWarmupSamples = 5;
+	settings.sampleUs = 2000;
+	settings.filter = nullptr;
+	const char* jsonPath = nullptr;
+	const char* label = "";
+	const char* baselinePath = nullptr;
+	for (int i = 1; i + 1 < argc; i += 2)
+	{
+		if (strcmp(argv[i], "--samples") == 0)
+			settings.numSamples = (unsigned int)atoi(argv[i + 1]);
+		else if (strcmp(argv[i], "--warmup") == 0)
+			settings.numWarmupSamples = (unsigned int)atoi(argv[i + 1]);
+		else if (strcmp(argv[i], "--sample-us") == 0)
+			settings.sampleUs = (unsigned int)atoi(argv[i + 1]);
+		else if (strcmp(argv[i], "--filter") == 0)
+			settings.filter = argv[i + 1];
+		else if (strcmp(argv[i], "--json") == 0)
+			jsonPath = argv[i + 1];
+		else if (strcmp(argv[i], "--label") == 0)
+			label = argv[i + 1];
+		else if (strcmp(argv[i], "--compare") == 0)
+			baselinePath = argv[i + 1];
+		else
+		{
+			fprintf(stderr, "usage: tetris_bench [--samples n] [--warmup n] [--sample-us n] [--filter text] [--json path] [--label text]\n"
+				"                    [--compare baseline.json]\n");
+			return 1;
+		}
+	}
+	if (settings.numSamples == 0)
+	{
+		fprintf(stderr, "Need at least one sample\n");
+		return 1;
+	}
+	char baselineLabel[128];
+	if (baselinePath && !LoadBaseline(baselinePath, settings.baseline, baselineLabel))
+		return 1;
+
+	NullRenderer renderer(1280, 720);
+	Game game;
+	game.Init();
+	StartGame(game, 1);
+	const Field& field = game.GetField();
+	uint32_t state = 12345;
+	std::vector<BenchResult> results;
+
+	printf("%u samples a benchmark after %u warmup, about %u us a sample, ns per operation\n",
+		settings.numSamples, settings.numWarmupSamples, settings.sampleUs);
+	printf("  %-32s %12s %12s %12s %12s", "Benchmark", "median", "p99", "min", "ops/sample");
+	if (baselinePath)
+		printf(" %12s", "speedup");
+	printf("\n");
+
+	// overlap and drop tests against a mid game stack
+	FillStack(field, 8, state);
+	const std::vector<TetrominoInstance> anyPieces = MakePieces(field, false, state);
+	const std::vector<TetrominoInstance> fittingPieces = MakePieces(field, true, state);
+	RunBench("isOverLap", settings, [&](unsigned int numOps)
+	{
+		const uint64_t beginNs = Profiler::GetTimeNs();
+		for (unsigned int i = 0; i < numOps; ++i)
+		{
+			DoNotOptimize(DoesTetrominoOverlap(anyPieces[i & 255], field));
+		}
+		return Profiler::GetTimeNs() - beginNs;
+	}, results);
+	RunBench("GetTetrominoDropDistance", settings, [&](unsigned int numOps)
+	{
+		const uint64_t beginNs = Profiler::GetTimeNs();
+		for (unsigned int i = 0; i < numOps; ++i)
+		{
+			DoNotOptimize(GetTetrominoDropDistance(fittingPieces[i & 255], field));
+		}
+		return Profiler::GetTimeNs() - beginNs;
+	}, results);
+
+	// locks into an otherwise empty field
+	memset(field.staticBlocks, 0xff, field.width * field.height * sizeof(int));
+	for (unsigned int numLines = 0; numLines <= 4; ++numLines)
+	{
+		std::vector<int> rows;
+		TetrominoInstance instance;
+		MakeClearRows(field, numLines, rows, instance);
+		int* bottomRows = &field.staticBlocks[(field.height - 4) * field.width];
+		char name[64];
+		snprintf(name, sizeof(name), "AddTetronimoToField/%u lines", numLines);
+		RunBench(name, settings, [&](unsigned int numOps)
+		{
+			const uint64_t beginNs = Profiler::GetTimeNs();
+			for (unsigned int i = 0; i < numOps; ++i)
+			{
+				memcpy(bottomRows, rows.data(), rows.size() * sizeof(int));
+				GameBench::AddTetronimoToField(game, instance);
+				DoNotOptimize(field.staticBlocks[0]);
+			}
+			return Profiler::GetTimeNs() - beginNs;
+		}, results);
+	}
+
+	memset(field.staticBlocks, 0xff, field.width * field.height * sizeof(int));
+	RunBench("SpawnTetromino", settings, [&](unsigned int numOps)
+	{
+		const uint64_t beginNs = Profiler::GetTimeNs();
+		for (unsigned int i = 0; i < numOps; ++i)
+		{
+			DoNotOptimize(GameBench::SpawnTetromino(game));
+		}
+		return Profiler::GetTimeNs() - beginNs;
+	}, results);
+
+	// whole ticks, starting a new game whenever one ends
+	const std::vector<GameInput> inputs = MakeInputs(state);
+	uint32_t gameSeed = 1;
+	StartGame(game, gameSeed);
+	size_t inputIndex = 0;
+	RunBench("Game::Update", settings, [&](unsigned int numOps)
+	{
+		const uint64_t beginNs = Profiler::GetTimeNs();
+		for (unsigned int i = 0; i < numOps; ++i)
+		{
+			if (game.IsGameOver())
+				StartGame(game, ++gameSeed);
+			game.Update(inputs[inputIndex], 1.0f / 60.0f);
+			inputIndex = (inputIndex + 1) % inputs.size();
+		}
+		DoNotOptimize(game.GetStateVersion());
+		return Profiler::GetTimeNs() - beginNs;
+	}, results);
+
+	// a tick between frames, only the draws are timed
+	RunBench("Game::Draw", settings, [&](unsigned int numOps)
+	{
+		uint64_t drawNs = 0;
+		for (unsigned int i = 0; i < numOps; ++i)
+		{
+			if (game.IsGameOver())
+				StartGame(game, ++gameSeed);
+			game.Update(inputs[inputIndex], 1.0f / 60.0f);
+			inputIndex = (inputIndex + 1) % inputs.size();
+
+			const uint64_t beginNs = Profiler::GetTimeNs();
+			renderer.Clear();
+			game.Draw(renderer);
+			renderer.Present();
+			drawNs += Profiler::GetTimeNs() - beginNs;
+		}
+		return drawNs;
+	}, results);
+	game.Shutdown();
+
+	// the geometric mean, so no one benchmark's scale dominates
+	if (baselinePath)
+	{
+		double logSum = 0.0;
+		unsigned int numCompared = 0;
+		for (size_t i = 0; i < results.size(); ++i)
+		{
+			if (results[i].speedup > 0.0)
+			{
+				logSum += log(results[i].speedup);
+				++numCompared;
+			}
+		}
+		if (numCompared > 0)
+		{
+			char name[64];
+			snprintf(name, sizeof(name), "Speedup over %s", baselineLabel[0] ? baselineLabel : baselinePath);
+			printf("  %-32s %11.3fx over %u benchmarks\n", name, exp(logSum / numCompared), numCompared);
+		}
+	}
+
+	if (jsonPath && !WriteJson(jsonPath, label, baselinePath ? baselineLabel : nullptr, results))
+		return 1;
+	return 0;
+}
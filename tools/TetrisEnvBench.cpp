@@ -0,0 +1,141 @@
+// Steps batches of TetrisEnv games with random actions through the C ABI the
+// way a trainer would, reports steps per second, and checks that two envs
+// given the same seed and actions produce identical observations.
+//
+// Build and run from the repository root:
+//   g++ -O2 -std=c++17 -I. tools/TetrisEnvBench.cpp TetrisEnv.cpp FieldKernels.cpp Game.cpp Hud.cpp Render.cpp Profiler.cpp -lpthread -o TetrisEnvBench
+//   ./TetrisEnvBench [--games 256] [--steps 20000] [--seed 1]
+#include "TetrisEnv.h"
+#include "Profiler.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <vector>
+
+struct EnvBuffers
+{
+	std::vector<TetrisEnvObservation> observations;
+	std::vector<float> rewards;
+	std::vector<uint8_t> dones;
+};
+
+//Helper functions
+//================================================================================
+
+static uint32_t NextRandom(uint32_t& state)
+{
+	state ^= state << 13;
+	state ^= state >> 17;
+	state ^= state << 5;
+	return state;
+}
+
+// mostly waiting and moving, like an untrained policy, with the odd hard drop
+static void ChooseActions(uint32_t& state, std::vector<uint8_t>& actions)
+{
+	for (size_t i = 0; i < actions.size(); ++i)
+	{
+		const uint32_t r = NextRandom(state) % 32;
+		actions[i] = (uint8_t)(r < 25 ? r % (kNumTetrisEnvActions - 1) : (uint32_t)kTetrisEnvAction_HardDrop);
+	}
+}
+
+static TetrisEnv* CreateEnv(unsigned int numGames, uint32_t seed, EnvBuffers& buffers)
+{
+	TetrisEnv* env = TetrisEnv_Create(numGames);
+	buffers.observations.resize(numGames);
+	buffers.rewards.resize(numGames);
+	buffers.dones.resize(numGames);
+	TetrisEnv_SetBuffers(env, buffers.observations.data(), buffers.rewards.data(), buffers.dones.data());
+	TetrisEnv_Reset(env, seed);
+	return env;
+}
+
+//================================================================================
+
+int main(int argc, char** argv)
+{
+	unsigned int numGames = 256;
+	unsigned int numSteps = 20000;
+	uint32_t seed = 1;
+	for (int i = 1; i + 1 < argc; i += 2)
+	{
+		const unsigned int value = (unsigned int)atoi(argv[i + 1]);
+		if (strcmp(argv[i], "--games") == 0)
+			numGames = value;
+		else if (strcmp(argv[i], "--steps") == 0)
+			numSteps = value;
+		else if (strcmp(argv[i], "--seed") == 0)
+			seed = value;
+		else
+		{
+			fprintf(stderr, "usage: TetrisEnvBench [--games n] [--steps n] [--seed n]\n");
+			return 1;
+		}
+	}
+	if (TetrisEnv_GetAbiVersion() != TETRIS_ENV_ABI_VERSION)
+	{
+		fprintf(stderr, "Built against ABI %u but the library is %u\n", TETRIS_ENV_ABI_VERSION, TetrisEnv_GetAbiVersion());
+		return 1;
+	}
+
+	EnvBuffers buffers;
+	TetrisEnv* env = CreateEnv(numGames, seed, buffers);
+	std::vector<uint8_t> actions(numGames);
+	uint32_t actionState = seed | 1;
+	uint64_t numEpisodes = 0;
+	double totalReward = 0.0;
+	uint64_t actionNs = 0;
+	const uint64_t beginNs = Profiler::GetTimeNs();
+	for (unsigned int step = 0; step < numSteps; ++step)
+	{
+		const uint64_t actionBeginNs = Profiler::GetTimeNs();
+		ChooseActions(actionState, actions);
+		actionNs += Profiler::GetTimeNs() - actionBeginNs;
+		const int32_t numEnded = TetrisEnv_Step(env, actions.data());
+		if (numEnded < 0)
+		{
+			fprintf(stderr, "Step failed\n");
+			return 1;
+		}
+		numEpisodes += (uint64_t)numEnded;
+		for (unsigned int i = 0; i < numGames; ++i)
+		{
+			totalReward += buffers.rewards[i];
+		}
+	}
+	const double seconds = (Profiler::GetTimeNs() - beginNs - actionNs) * 1e-9;
+	TetrisEnv_Destroy(env);
+
+	// the same seed and actions again, a step at a time alongside a second env
+	unsigned int numMismatches = 0;
+	{
+		EnvBuffers buffersA;
+		EnvBuffers buffersB;
+		TetrisEnv* envA = CreateEnv(numGames, seed, buffersA);
+		TetrisEnv* envB = CreateEnv(numGames, seed, buffersB);
+		actionState = seed | 1;
+		const unsigned int numCheckedSteps = numSteps < 5000 ? numSteps : 5000;
+		for (unsigned int step = 0; step < numCheckedSteps; ++step)
+		{
+			ChooseActions(actionState, actions);
+			TetrisEnv_Step(envA, actions.data());
+			TetrisEnv_Step(envB, actions.data());
+			numMismatches += memcmp(buffersA.observations.data(), buffersB.observations.data(), numGames * sizeof(TetrisEnvObservation)) != 0
+				|| memcmp(buffersA.rewards.data(), buffersB.rewards.data(), numGames * sizeof(float)) != 0
+				|| memcmp(buffersA.dones.data(), buffersB.dones.data(), numGames) != 0;
+		}
+		TetrisEnv_Destroy(envA);
+		TetrisEnv_Destroy(envB);
+	}
+
+	const double numGameSteps = (double)numGames * numSteps;
+	printf("%u games, %u steps, seed %u\n", numGames, numSteps, seed);
+	printf("  %-32s %12.0f\n", "Game steps / s", numGameSteps / seconds);
+	printf("  %-32s %12.1f\n", "ns per game step", seconds * 1e9 / numGameSteps);
+	printf("  %-32s %12.1f\n", "us per batch step", seconds * 1e6 / numSteps);
+	printf("  %-32s %12llu\n", "Episodes ended", (unsigned long long)numEpisodes);
+	printf("  %-32s %12.3f\n", "Mean reward per step", totalReward / numGameSteps);
+	printf("  %-32s %12u\n", "Steps that differed on rerun", numMismatches);
+	return numMismatches == 0 ? 0 : 1;
+}